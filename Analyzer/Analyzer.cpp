@@ -2265,6 +2265,15 @@ bool AggExpr::operator==(const Expr& rhs) const {
   if (aggtype != rhs_ae.get_aggtype() || is_distinct != rhs_ae.get_is_distinct()) {
     return false;
   }
+  if (aggtype == kAPPROX_MEDIAN || aggtype == kPERCENTILE_CONT ||
+      aggtype == kPERCENTILE_DISC) {
+    // Quantiles of the same argument are only equal for the same parameter.
+    CHECK(error_rate && rhs_ae.get_error_rate());
+    if (error_rate->get_constval().doubleval !=
+        rhs_ae.get_error_rate()->get_constval().doubleval) {
+      return false;
+    }
+  }
   if (arg.get() == rhs_ae.get_arg()) {
     return true;
   }
@@ -2662,6 +2671,12 @@ std::string AggExpr::toString() const {
     case kSAMPLE:
       agg = "SAMPLE";
       break;
+    case kPERCENTILE_CONT:
+      agg = "PERCENTILE_CONT";
+      break;
+    case kPERCENTILE_DISC:
+      agg = "PERCENTILE_DISC";
+      break;
   }
   std::string str{"(" + agg};
   if (is_distinct) {
@@ -2672,6 +2687,11 @@ std::string AggExpr::toString() const {
   } else {
     str += "*";
   }
+  if ((aggtype == kAPPROX_MEDIAN || aggtype == kPERCENTILE_CONT ||
+       aggtype == kPERCENTILE_DISC) &&
+      error_rate) {
+    str += error_rate->toString();
+  }
   return str + ") ";
 }
 
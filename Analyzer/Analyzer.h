@@ -1129,7 +1129,8 @@ class AggExpr : public Expr {
   SQLAgg aggtype;                       // aggregate type: kAVG, kMIN, kMAX, kSUM, kCOUNT
   std::shared_ptr<Analyzer::Expr> arg;  // argument to aggregate
   bool is_distinct;                     // true only if it is for COUNT(DISTINCT x)
-  std::shared_ptr<Analyzer::Constant> error_rate;  // error rate of kAPPROX_COUNT_DISTINCT
+  // error rate of kAPPROX_COUNT_DISTINCT, quantile of kAPPROX_MEDIAN and kPERCENTILE_*
+  std::shared_ptr<Analyzer::Constant> error_rate;
 };
 
 /*
@@ -40,6 +40,7 @@
 #include <random>
 #include <regex>
 #include <sstream>
+#include <thread>
 
 #if BOOST_VERSION >= 106600
 #include <boost/uuid/detail/sha1.hpp>
@@ -96,6 +97,11 @@ extern bool g_cache_string_hash;
 // under unit testing.
 bool g_serialize_temp_tables{false};
 
+// Vacuum commits its fragments in batches, and can pause between batches to leave the
+// disk and the buffer pool to queries.
+size_t g_vacuum_fragments_per_commit{4};
+size_t g_vacuum_pause_ms{0};
+
 namespace Catalog_Namespace {
 
 const int DEFAULT_INITIAL_VERSION = 1;  // start at version 1
@@ -1193,8 +1199,8 @@ void Catalog::removeTableFromMap(const string& tableName,
   delete td;
 
   std::unique_ptr<StringDictionaryClient> client;
-  if (SysCatalog::instance().isAggregator()) {
-    CHECK(!string_dict_hosts_.empty());
+  // Without a string dictionary server every node owns its dictionaries.
+  if (SysCatalog::instance().isAggregator() && !string_dict_hosts_.empty()) {
     DictRef dict_ref(currentDB_.dbId, -1);
     client.reset(new StringDictionaryClient(string_dict_hosts_.front(), dict_ref, true));
   }
@@ -1825,6 +1831,14 @@ void Catalog::delDictionary(const ColumnDescriptor& cd) {
   }
 
   dictDescriptorMapByRef_.erase(dictRef);
+  // the other dictionaries keep their translations to this one, see
+  // StringDictionary::getTranslationMap()
+  for (const auto& dict_ref_and_descriptor : dictDescriptorMapByRef_) {
+    const auto& string_dict = dict_ref_and_descriptor.second->stringDict;
+    if (string_dict) {
+      string_dict->eraseTranslationMap(dictId);
+    }
+  }
 }
 
 void Catalog::getDictionary(const ColumnDescriptor& cd,
@@ -3321,8 +3335,8 @@ void Catalog::doTruncateTable(const TableDescriptor* td) {
   dataMgr_->removeTableRelatedDS(currentDB_.dbId, tableId);
 
   std::unique_ptr<StringDictionaryClient> client;
-  if (SysCatalog::instance().isAggregator()) {
-    CHECK(!string_dict_hosts_.empty());
+  // Without a string dictionary server every node owns its dictionaries.
+  if (SysCatalog::instance().isAggregator() && !string_dict_hosts_.empty()) {
     DictRef dict_ref(currentDB_.dbId, -1);
     client.reset(new StringDictionaryClient(string_dict_hosts_.front(), dict_ref, true));
   }
@@ -4010,18 +4024,25 @@ void Catalog::vacuumDeletedRows(const TableDescriptor* td) const {
   ChunkKey chunkKeyPrefix = {currentDB_.dbId, td->tableId, cd->columnId};
   ChunkMetadataVector chunkMetadataVec;
   dataMgr_->getChunkMetadataVecForKeyPrefix(chunkMetadataVec, chunkKeyPrefix);
+  // A batch of fragments shares a checkpoint, committing it releases the dirty chunks
+  // of the batch instead of pinning those of the whole table until the end.
+  const size_t fragments_per_commit = std::max(g_vacuum_fragments_per_commit, size_t(1));
+  std::unique_ptr<UpdelRoll> updel_roll;
+  size_t batch_fragment_count{0};
   for (auto cm : chunkMetadataVec) {
     // "delete has occured"
     if (cm.second->chunkStats.max.tinyintval == 1) {
-      UpdelRoll updel_roll;
-      updel_roll.catalog = this;
-      updel_roll.logicalTableId = getLogicalTableId(td->tableId);
-      updel_roll.memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+      if (!updel_roll) {
+        updel_roll = std::make_unique<UpdelRoll>();
+        updel_roll->catalog = this;
+        updel_roll->logicalTableId = getLogicalTableId(td->tableId);
+        updel_roll->memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+      }
       const auto cd = getMetadataForColumn(td->tableId, cm.first[2]);
       const auto chunk = Chunk_NS::Chunk::getChunk(cd,
                                                    &getDataMgr(),
                                                    cm.first,
-                                                   updel_roll.memoryLevel,
+                                                   updel_roll->memoryLevel,
                                                    0,
                                                    cm.second->numBytes,
                                                    cm.second->numElements);
@@ -4029,11 +4050,21 @@ void Catalog::vacuumDeletedRows(const TableDescriptor* td) const {
                                   td,
                                   cm.first[3],
                                   td->fragmenter->getVacuumOffsets(chunk),
-                                  updel_roll.memoryLevel,
-                                  updel_roll);
-      updel_roll.commitUpdate();
+                                  updel_roll->memoryLevel,
+                                  *updel_roll);
+      if (++batch_fragment_count == fragments_per_commit) {
+        updel_roll->commitUpdate();
+        updel_roll.reset();
+        batch_fragment_count = 0;
+        if (g_vacuum_pause_ms) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(g_vacuum_pause_ms));
+        }
+      }
     }
   }
+  if (updel_roll) {
+    updel_roll->commitUpdate();
+  }
 }
 
 void Catalog::buildForeignServerMap() {
@@ -26,7 +26,8 @@ class DistributedLoader : public import_export::Loader {
                     const TableDescriptor* t,
                     LeafAggregator* aggregator)
       : Loader(parent_session_info.getCatalog(), t) {
-    CHECK(false);
+    throw std::runtime_error(
+        "Loading data through the aggregator is not supported yet, use INSERT");
   }
 
   bool load(const std::vector<std::unique_ptr<import_export::TypedImportBuffer>>&
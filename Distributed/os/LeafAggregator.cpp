@@ -0,0 +1,679 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LeafAggregator.h"
+
+#include "Catalog/SessionInfo.h"
+#include "QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
+#include "QueryEngine/RelAlgExecutor.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryEngine/ThriftSerializers.h"
+#include "Shared/ThriftClient.h"
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <unordered_set>
+
+struct LeafAggregator::LeafConnection {
+  LeafConnection(const LeafHostInfo& leaf_host_info) : info(leaf_host_info) {}
+
+  std::string name() const {
+    return info.getHost() + ":" + std::to_string(info.getPort());
+  }
+
+  const LeafHostInfo info;
+  std::mutex mutex;  // thrift clients aren't thread safe
+  ThriftClientConnection connection;
+  mapd::shared_ptr<TTransport> transport;
+  std::unique_ptr<OmniSciClient> client;
+};
+
+LeafAggregator::LeafAggregator(const std::vector<LeafHostInfo>& leaves) {
+  for (const auto& leaf : leaves) {
+    CHECK(leaf.getRole() == NodeRole::DbLeaf);
+    leaves_.emplace_back(std::make_unique<LeafConnection>(leaf));
+  }
+}
+
+LeafAggregator::~LeafAggregator() {}
+
+template <typename Call>
+auto LeafAggregator::callLeaf(const size_t leaf_idx, Call call) {
+  CHECK_LT(leaf_idx, leaves_.size());
+  auto& leaf = *leaves_[leaf_idx];
+  std::lock_guard<std::mutex> lock(leaf.mutex);
+  try {
+    if (!leaf.client) {
+      leaf.transport = leaf.connection.open_buffered_client_transport(
+          leaf.info.getHost(),
+          leaf.info.getPort(),
+          leaf.info.getSSLCertFile(),
+          true,
+          true,
+          leaf.info.getConnectTimeout(0),
+          leaf.info.getRecvTimeout(0),
+          leaf.info.getSendTimeout());
+      leaf.transport->open();
+      leaf.client = std::make_unique<OmniSciClient>(
+          mapd::shared_ptr<TProtocol>(new TBinaryProtocol(leaf.transport)));
+    }
+    return call(*leaf.client);
+  } catch (const TOmniSciException& e) {
+    throw std::runtime_error("Leaf " + leaf.name() + ": " + e.error_msg);
+  } catch (const apache::thrift::TException& e) {
+    // The state of the connection is unknown, open a new one for the next call.
+    leaf.client.reset();
+    leaf.transport.reset();
+    throw std::runtime_error("Leaf " + leaf.name() + ": " + e.what());
+  }
+}
+
+template <typename Call>
+auto LeafAggregator::callLeaves(Call call) {
+  using Ret = decltype(call(std::declval<OmniSciClient&>(), size_t(0)));
+  std::vector<std::future<Ret>> leaf_calls;
+  for (size_t leaf_idx = 0; leaf_idx < leaves_.size(); ++leaf_idx) {
+    leaf_calls.push_back(std::async(std::launch::async, [this, &call, leaf_idx] {
+      return callLeaf(leaf_idx,
+                      [&call, leaf_idx](OmniSciClient& client) -> Ret {
+                        return call(client, leaf_idx);
+                      });
+    }));
+  }
+  for (auto& leaf_call : leaf_calls) {
+    leaf_call.wait();
+  }
+  if constexpr (std::is_void_v<Ret>) {
+    for (auto& leaf_call : leaf_calls) {
+      leaf_call.get();
+    }
+  } else {
+    std::vector<Ret> results;
+    for (auto& leaf_call : leaf_calls) {
+      results.push_back(leaf_call.get());
+    }
+    return results;
+  }
+}
+
+std::vector<TSessionId> LeafAggregator::getLeafSessions(
+    const TSessionId& parent_session) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(leaf_sessions_mutex_);
+  const auto it = leaf_sessions_.find(parent_session);
+  if (it == leaf_sessions_.end()) {
+    throw std::runtime_error("Session isn't connected to the leaves");
+  }
+  return it->second;
+}
+
+namespace {
+
+// Returns the body of the first query step if the query reads a table, nullptr
+// otherwise. Only the first step runs on the leaves, so the table has to be its input and
+// the aggregator has to be able to run all the other steps on the partial results.
+const RelAlgNode* get_leaf_step(const RelAlgExecutor& ra_executor) {
+  if (!ra_executor.getSubqueries().empty()) {
+    throw std::runtime_error("Subqueries are not supported in distributed mode yet");
+  }
+  std::vector<const RelScan*> scans;
+  std::unordered_set<const RelAlgNode*> visited;
+  std::vector<const RelAlgNode*> pending{&ra_executor.getRootRelAlgNode()};
+  while (!pending.empty()) {
+    const auto node = pending.back();
+    pending.pop_back();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    if (dynamic_cast<const RelJoin*>(node) ||
+        dynamic_cast<const RelLeftDeepInnerJoin*>(node)) {
+      throw std::runtime_error("Joins are not supported in distributed mode yet");
+    }
+    if (dynamic_cast<const RelLogicalUnion*>(node)) {
+      throw std::runtime_error("UNION is not supported in distributed mode yet");
+    }
+    if (dynamic_cast<const RelTableFunction*>(node)) {
+      throw std::runtime_error("Table functions not supported in distributed mode yet");
+    }
+    const auto project = dynamic_cast<const RelProject*>(node);
+    if (project && project->hasWindowFunctionExpr()) {
+      throw std::runtime_error(
+          "Window functions are not supported in distributed mode yet");
+    }
+    if (const auto scan = dynamic_cast<const RelScan*>(node)) {
+      scans.push_back(scan);
+    }
+    for (size_t i = 0; i < node->inputCount(); ++i) {
+      pending.push_back(node->getInput(i));
+    }
+  }
+  if (scans.empty()) {
+    return nullptr;
+  }
+  if (scans.size() > 1) {
+    throw std::runtime_error(
+        "Queries over several tables are not supported in distributed mode yet");
+  }
+  const auto td = scans.front()->getTableDescriptor();
+  CHECK(td);
+  if (td->nShards) {
+    throw std::runtime_error("Sharded tables are not supported in distributed mode yet");
+  }
+  if (td->isForeignTable()) {
+    throw std::runtime_error("Foreign tables are not supported in distributed mode yet");
+  }
+  RaExecutionSequence seq(&ra_executor.getRootRelAlgNode());
+  CHECK(!seq.empty());
+  const auto body = seq.getDescriptor(0)->getBody();
+  const auto leaf_node = dynamic_cast<const RelSort*>(body) ? body->getInput(0) : body;
+  if (leaf_node->inputCount() != 1 || leaf_node->getInput(0) != scans.front()) {
+    throw std::runtime_error(
+        "Queries which don't read their table in the first step are not supported in "
+        "distributed mode yet");
+  }
+  return body;
+}
+
+bool is_empty_range(const TColumnRange& column_range) {
+  return column_range.type == TExpressionRangeType::INTEGER
+             ? column_range.int_max < column_range.int_min
+             : column_range.fp_max < column_range.fp_min;
+}
+
+// The leaves must use the same column ranges, otherwise their group by buffers and
+// count distinct bitmaps would have different layouts and couldn't be reduced.
+std::vector<TColumnRange> merge_column_ranges(
+    const std::vector<TPendingQuery>& pending_queries) {
+  std::map<std::pair<int32_t, int32_t>, TColumnRange> merged_ranges;
+  for (const auto& pending_query : pending_queries) {
+    for (const auto& column_range : pending_query.column_ranges) {
+      const auto it_ok = merged_ranges.emplace(
+          std::make_pair(column_range.table_id, column_range.col_id), column_range);
+      if (it_ok.second) {
+        continue;
+      }
+      auto& merged_range = it_ok.first->second;
+      if (merged_range.type != column_range.type ||
+          merged_range.type == TExpressionRangeType::INVALID) {
+        merged_range.type = TExpressionRangeType::INVALID;
+        continue;
+      }
+      const bool has_nulls = merged_range.has_nulls || column_range.has_nulls;
+      if (is_empty_range(column_range)) {
+        merged_range.has_nulls = has_nulls;
+        continue;
+      }
+      if (is_empty_range(merged_range)) {
+        merged_range = column_range;
+        merged_range.has_nulls = has_nulls;
+        continue;
+      }
+      merged_range.has_nulls = has_nulls;
+      if (merged_range.type == TExpressionRangeType::INTEGER) {
+        if (merged_range.bucket != column_range.bucket) {
+          merged_range.type = TExpressionRangeType::INVALID;
+          continue;
+        }
+        merged_range.int_min = std::min(merged_range.int_min, column_range.int_min);
+        merged_range.int_max = std::max(merged_range.int_max, column_range.int_max);
+      } else {
+        merged_range.fp_min = std::min(merged_range.fp_min, column_range.fp_min);
+        merged_range.fp_max = std::max(merged_range.fp_max, column_range.fp_max);
+      }
+    }
+  }
+  std::vector<TColumnRange> column_ranges;
+  for (const auto& merged_range : merged_ranges) {
+    column_ranges.push_back(merged_range.second);
+  }
+  return column_ranges;
+}
+
+void check_same_layout(const std::vector<std::shared_ptr<ResultSet>>& leaf_results) {
+  const auto& first_desc = leaf_results.front()->getQueryMemDesc();
+  for (const auto& leaf_result : leaf_results) {
+    const auto& query_mem_desc = leaf_result->getQueryMemDesc();
+    if (query_mem_desc.getQueryDescriptionType() !=
+            first_desc.getQueryDescriptionType() ||
+        query_mem_desc.didOutputColumnar() != first_desc.didOutputColumnar() ||
+        query_mem_desc.hasKeylessHash() != first_desc.hasKeylessHash() ||
+        query_mem_desc.getRowSize() != first_desc.getRowSize() ||
+        (query_mem_desc.getQueryDescriptionType() !=
+             QueryDescriptionType::GroupByBaselineHash &&
+         query_mem_desc.getQueryDescriptionType() != QueryDescriptionType::Projection &&
+         query_mem_desc.getEntryCount() != first_desc.getEntryCount())) {
+      throw std::runtime_error(
+          "The leaves returned partial results with different layouts");
+    }
+  }
+}
+
+// Reduces or appends the partial results of the leaves, as the executor does with the
+// results of its devices.
+std::shared_ptr<ResultSet> merge_leaf_results(
+    const std::vector<TStepResult>& step_results,
+    const std::vector<TargetMetaInfo>& targets_meta) {
+  auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  std::vector<std::shared_ptr<ResultSet>> leaf_results;
+  for (const auto& step_result : step_results) {
+    // Leaves without rows for the step don't send any buffer.
+    if (step_result.serialized_rows.buffers.empty()) {
+      continue;
+    }
+    leaf_results.emplace_back(
+        ResultSet::unserialize(step_result.serialized_rows, nullptr, row_set_mem_owner));
+  }
+  if (leaf_results.empty()) {
+    std::vector<TargetInfo> target_infos;
+    for (const auto& target_meta : targets_meta) {
+      target_infos.push_back(TargetInfo{false,
+                                        kMIN,
+                                        target_meta.get_type_info(),
+                                        SQLTypeInfo(kNULLT, false),
+                                        false,
+                                        false});
+    }
+    return std::make_shared<ResultSet>(target_infos,
+                                       ExecutorDeviceType::CPU,
+                                       QueryMemoryDescriptor(),
+                                       row_set_mem_owner,
+                                       nullptr,
+                                       0,
+                                       0);
+  }
+  check_same_layout(leaf_results);
+  if (leaf_results.size() == 1) {
+    return leaf_results.front();
+  }
+  if (step_results.front().merge_type == TMergeType::REDUCE) {
+    std::vector<ResultSet*> result_sets;
+    for (const auto& leaf_result : leaf_results) {
+      result_sets.push_back(leaf_result.get());
+    }
+    ResultSetManager rs_manager;
+    const auto reduced = rs_manager.reduce(result_sets);
+    return reduced == leaf_results.front().get() ? leaf_results.front()
+                                                 : rs_manager.getOwnResultSet();
+  }
+  auto& result = leaf_results.front();
+  for (size_t i = 1; i < leaf_results.size(); ++i) {
+    result->append(*leaf_results[i]);
+  }
+  return result;
+}
+
+}  // namespace
+
+AggregatedResult LeafAggregator::execute(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const std::string& query_ra,
+    const ExecutionOptions& eo,
+    const bool is_update_delete) {
+  if (is_update_delete) {
+    throw std::runtime_error(
+        "UPDATE and DELETE are not supported in distributed mode yet");
+  }
+  const auto& cat = parent_session_info.getCatalog();
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+  RelAlgExecutor ra_executor(executor.get(), cat, query_ra);
+  const bool validate_or_explain =
+      eo.just_explain || eo.just_validate || eo.just_calcite_explain;
+  const auto leaf_step = validate_or_explain ? nullptr : get_leaf_step(ra_executor);
+  if (leaf_step) {
+    const auto& parent_session = parent_session_info.get_session_id();
+    const auto leaf_sessions = getLeafSessions(parent_session);
+    auto pending_queries = callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+      TPendingQuery pending_query;
+      client.start_query(
+          pending_query, leaf_sessions[leaf_idx], parent_session, query_ra, false, {});
+      return pending_query;
+    });
+    const auto column_ranges = merge_column_ranges(pending_queries);
+    for (auto& pending_query : pending_queries) {
+      pending_query.column_ranges = column_ranges;
+    }
+    const auto step_results =
+        callLeaves([&pending_queries](OmniSciClient& client, const size_t leaf_idx) {
+          TStepResult step_result;
+          client.execute_query_step(step_result, pending_queries[leaf_idx], 0);
+          return step_result;
+        });
+    CHECK(!step_results.empty());
+    // The leaves either run the whole first step or only the input of its sort.
+    const auto node_id = step_results.front().node_id;
+    const auto sort = dynamic_cast<const RelSort*>(leaf_step);
+    CHECK(static_cast<unsigned>(node_id) == leaf_step->getId() ||
+          (sort && static_cast<unsigned>(node_id) == sort->getInput(0)->getId()));
+    for (const auto& step_result : step_results) {
+      CHECK_EQ(node_id, step_result.node_id);
+      CHECK(step_result.merge_type == step_results.front().merge_type);
+    }
+    const auto targets_meta =
+        ThriftSerializers::target_meta_infos_from_thrift(step_results.front().row_desc);
+    ra_executor.addLeafResult(node_id,
+                              {merge_leaf_results(step_results, targets_meta),
+                               targets_meta});
+  }
+  const auto co = CompilationOptions::defaults(ExecutorDeviceType::CPU);
+  const auto result = ra_executor.executeRelAlgQuery(co, eo, false, nullptr);
+  return {result.getRows(), result.getTargetsMeta()};
+}
+
+void LeafAggregator::leafCatalogConsistencyCheck(
+    const Catalog_Namespace::SessionInfo& parent_session_info) {
+  throw std::runtime_error(
+      "Catalog consistency checks are not supported in distributed mode yet");
+}
+
+std::map<size_t, TQueryResult> LeafAggregator::forwardQueryToLeaves(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const std::string& query_str) {
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  const auto leaf_results =
+      callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+        TQueryResult query_result;
+        client.sql_execute(
+            query_result, leaf_sessions[leaf_idx], query_str, true, "", -1, -1);
+        return query_result;
+      });
+  std::map<size_t, TQueryResult> results;
+  for (size_t leaf_idx = 0; leaf_idx < leaf_results.size(); ++leaf_idx) {
+    results.emplace(leaf_idx, leaf_results[leaf_idx]);
+  }
+  return results;
+}
+
+TQueryResult LeafAggregator::forwardQueryToLeaf(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const std::string& query_str,
+    const size_t leaf_idx) {
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  return callLeaf(leaf_idx, [&](OmniSciClient& client) {
+    TQueryResult query_result;
+    client.sql_execute(
+        query_result, leaf_sessions[leaf_idx], query_str, true, "", -1, -1);
+    return query_result;
+  });
+}
+
+void LeafAggregator::insertDataToLeaf(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const size_t leaf_idx,
+    const TInsertData& thrift_insert_data) {
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  callLeaf(leaf_idx, [&](OmniSciClient& client) {
+    client.insert_data(leaf_sessions[leaf_idx], thrift_insert_data);
+  });
+}
+
+void LeafAggregator::checkpointLeafShardsWithAutoRollback(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const int32_t db_id,
+    const int32_t table_id) {
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  const auto table_epochs = getLeafTableEpochs(parent_session_info, db_id, table_id);
+  try {
+    callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+      client.checkpoint(leaf_sessions[leaf_idx], table_id);
+    });
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Checkpoint of table " << table_id
+               << " failed on the leaves, rolling back to the previous epochs: "
+               << e.what();
+    setLeafTableEpochs(parent_session_info, db_id, table_epochs);
+    throw;
+  }
+}
+
+int32_t LeafAggregator::get_table_epochLeaf(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const int32_t db_id,
+    const int32_t table_id) {
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  const auto leaf_epochs = callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    return client.get_table_epoch(leaf_sessions[leaf_idx], db_id, table_id);
+  });
+  CHECK(!leaf_epochs.empty());
+  return *std::min_element(leaf_epochs.begin(), leaf_epochs.end());
+}
+
+void LeafAggregator::set_table_epochLeaf(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const int32_t db_id,
+    const int32_t table_id,
+    const int32_t new_epoch) {
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    client.set_table_epoch(leaf_sessions[leaf_idx], db_id, table_id, new_epoch);
+  });
+}
+
+std::vector<Catalog_Namespace::TableEpochInfo> LeafAggregator::getLeafTableEpochs(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const int32_t db_id,
+    const int32_t table_id) {
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  const auto leaf_epochs = callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    std::vector<TTableEpochInfo> table_epochs;
+    client.get_table_epochs(table_epochs, leaf_sessions[leaf_idx], db_id, table_id);
+    return table_epochs;
+  });
+  std::vector<Catalog_Namespace::TableEpochInfo> table_epochs;
+  for (size_t leaf_idx = 0; leaf_idx < leaf_epochs.size(); ++leaf_idx) {
+    for (const auto& table_epoch : leaf_epochs[leaf_idx]) {
+      table_epochs.emplace_back(table_epoch.table_id, table_epoch.table_epoch, leaf_idx);
+    }
+  }
+  return table_epochs;
+}
+
+void LeafAggregator::setLeafTableEpochs(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    const int32_t db_id,
+    const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs) {
+  std::vector<std::vector<TTableEpochInfo>> leaf_epochs(leafCount());
+  for (const auto& table_epoch : table_epochs) {
+    if (table_epoch.leaf_index < 0 ||
+        static_cast<size_t>(table_epoch.leaf_index) >= leafCount()) {
+      throw std::runtime_error("Invalid leaf index " +
+                               std::to_string(table_epoch.leaf_index) +
+                               " for the epoch of table " +
+                               std::to_string(table_epoch.table_id));
+    }
+    TTableEpochInfo table_epoch_info;
+    table_epoch_info.table_id = table_epoch.table_id;
+    table_epoch_info.table_epoch = table_epoch.table_epoch;
+    table_epoch_info.leaf_index = table_epoch.leaf_index;
+    leaf_epochs[table_epoch.leaf_index].push_back(table_epoch_info);
+  }
+  const auto leaf_sessions = getLeafSessions(parent_session_info.get_session_id());
+  callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    if (!leaf_epochs[leaf_idx].empty()) {
+      client.set_table_epochs(leaf_sessions[leaf_idx], db_id, leaf_epochs[leaf_idx]);
+    }
+  });
+}
+
+void LeafAggregator::connect(const Catalog_Namespace::SessionInfo& parent_session_info,
+                             const std::string& user,
+                             const std::string& passwd,
+                             const std::string& dbname) {
+  std::vector<TSessionId> leaf_sessions(leafCount());
+  try {
+    callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+      client.connect(leaf_sessions[leaf_idx], user, passwd, dbname);
+    });
+  } catch (const std::exception&) {
+    for (size_t leaf_idx = 0; leaf_idx < leaf_sessions.size(); ++leaf_idx) {
+      if (leaf_sessions[leaf_idx].empty()) {
+        continue;
+      }
+      try {
+        callLeaf(leaf_idx, [&](OmniSciClient& client) {
+          client.disconnect(leaf_sessions[leaf_idx]);
+        });
+      } catch (const std::exception& e) {
+        LOG(WARNING) << e.what();
+      }
+    }
+    throw;
+  }
+  mapd_unique_lock<mapd_shared_mutex> write_lock(leaf_sessions_mutex_);
+  leaf_sessions_[parent_session_info.get_session_id()] = leaf_sessions;
+}
+
+void LeafAggregator::disconnect(const TSessionId session) {
+  std::vector<TSessionId> leaf_sessions;
+  {
+    mapd_unique_lock<mapd_shared_mutex> write_lock(leaf_sessions_mutex_);
+    const auto it = leaf_sessions_.find(session);
+    if (it == leaf_sessions_.end()) {
+      return;
+    }
+    leaf_sessions = it->second;
+    leaf_sessions_.erase(it);
+  }
+  // The session is gone on the aggregator, a leaf which can't be reached will expire it.
+  try {
+    callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+      client.disconnect(leaf_sessions[leaf_idx]);
+    });
+  } catch (const std::exception& e) {
+    LOG(WARNING) << e.what();
+  }
+}
+
+void LeafAggregator::switch_database(const TSessionId session,
+                                     const std::string& dbname) {
+  const auto leaf_sessions = getLeafSessions(session);
+  callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    client.switch_database(leaf_sessions[leaf_idx], dbname);
+  });
+}
+
+void LeafAggregator::clone_session(const TSessionId session1,
+                                   const TSessionId session2) {
+  const auto leaf_sessions = getLeafSessions(session1);
+  auto cloned_sessions = callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    TSessionId cloned_session;
+    client.clone_session(cloned_session, leaf_sessions[leaf_idx]);
+    return cloned_session;
+  });
+  mapd_unique_lock<mapd_shared_mutex> write_lock(leaf_sessions_mutex_);
+  leaf_sessions_[session2] = std::move(cloned_sessions);
+}
+
+void LeafAggregator::interrupt(const TSessionId query_session,
+                               const TSessionId interrupt_session) {
+  std::vector<TSessionId> leaf_query_sessions;
+  std::vector<TSessionId> leaf_interrupt_sessions;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(leaf_sessions_mutex_);
+    const auto query_it = leaf_sessions_.find(query_session);
+    const auto interrupt_it = leaf_sessions_.find(interrupt_session);
+    if (query_it == leaf_sessions_.end() || interrupt_it == leaf_sessions_.end()) {
+      return;
+    }
+    leaf_query_sessions = query_it->second;
+    leaf_interrupt_sessions = interrupt_it->second;
+  }
+  callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    client.interrupt(leaf_query_sessions[leaf_idx], leaf_interrupt_sessions[leaf_idx]);
+  });
+}
+
+void LeafAggregator::set_execution_mode(const TSessionId session,
+                                        const TExecuteMode::type mode) {
+  const auto leaf_sessions = getLeafSessions(session);
+  callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    client.set_execution_mode(leaf_sessions[leaf_idx], mode);
+  });
+}
+
+std::vector<TServerStatus> LeafAggregator::getLeafStatus(TSessionId session) {
+  const auto leaf_sessions = getLeafSessions(session);
+  const auto leaf_statuses =
+      callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+        std::vector<TServerStatus> statuses;
+        client.get_status(statuses, leaf_sessions[leaf_idx]);
+        return statuses;
+      });
+  std::vector<TServerStatus> statuses;
+  for (const auto& leaf_status : leaf_statuses) {
+    statuses.insert(statuses.end(), leaf_status.begin(), leaf_status.end());
+  }
+  return statuses;
+}
+
+std::vector<TNodeMemoryInfo> LeafAggregator::getLeafMemoryInfo(
+    TSessionId session,
+    Data_Namespace::MemoryLevel memory_level) {
+  const auto leaf_sessions = getLeafSessions(session);
+  const std::string memory_level_name =
+      memory_level == Data_Namespace::MemoryLevel::GPU_LEVEL ? "gpu" : "cpu";
+  const auto leaf_memory = callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    std::vector<TNodeMemoryInfo> memory_info;
+    client.get_memory(memory_info, leaf_sessions[leaf_idx], memory_level_name);
+    return memory_info;
+  });
+  std::vector<TNodeMemoryInfo> memory_info;
+  for (const auto& leaf_memory_info : leaf_memory) {
+    memory_info.insert(
+        memory_info.end(), leaf_memory_info.begin(), leaf_memory_info.end());
+  }
+  return memory_info;
+}
+
+TClusterHardwareInfo LeafAggregator::getHardwareInfo(TSessionId session) {
+  const auto leaf_sessions = getLeafSessions(session);
+  const auto leaf_hardware =
+      callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+        TClusterHardwareInfo hardware_info;
+        client.get_hardware_info(hardware_info, leaf_sessions[leaf_idx]);
+        return hardware_info;
+      });
+  TClusterHardwareInfo hardware_info;
+  for (const auto& leaf_hardware_info : leaf_hardware) {
+    hardware_info.hardware_info.insert(hardware_info.hardware_info.end(),
+                                       leaf_hardware_info.hardware_info.begin(),
+                                       leaf_hardware_info.hardware_info.end());
+  }
+  return hardware_info;
+}
+
+void LeafAggregator::clear_leaf_cpu_memory(const TSessionId session) {
+  const auto leaf_sessions = getLeafSessions(session);
+  callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    client.clear_cpu_memory(leaf_sessions[leaf_idx]);
+  });
+}
+
+void LeafAggregator::clear_leaf_gpu_memory(const TSessionId session) {
+  const auto leaf_sessions = getLeafSessions(session);
+  callLeaves([&](OmniSciClient& client, const size_t leaf_idx) {
+    client.clear_gpu_memory(leaf_sessions[leaf_idx]);
+  });
+}
+
+std::vector<size_t> LeafAggregator::query_get_outer_fragment_counts(
+    const Catalog_Namespace::SessionInfo& parent_session_info,
+    std::string& sql_query) {
+  throw std::runtime_error(
+      "Outer fragment counts are not supported in distributed mode yet");
+}
@@ -23,144 +23,126 @@
 #include "LeafHostInfo.h"
 #include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/TargetMetaInfo.h"
+#include "Shared/mapd_shared_mutex.h"
 #include "gen-cpp/OmniSci.h"
 
 #include "Logger/Logger.h"
 
+#include <memory>
+#include <unordered_map>
+
 namespace Catalog_Namespace {
 class SessionInfo;
 }  // namespace Catalog_Namespace
 
 class ResultSet;
 
+// Runs queries over the database leaves listed in the cluster configuration. Every leaf
+// owns a part of the rows of each table; the first step of a query runs on all of them
+// and the aggregator reduces the serialized partial results before running the rest of
+// the query locally.
 class LeafAggregator {
  public:
-  LeafAggregator(const std::vector<LeafHostInfo>& leaves) { CHECK(leaves.empty()); }
+  LeafAggregator(const std::vector<LeafHostInfo>& leaves);
+
+  ~LeafAggregator();
 
   AggregatedResult execute(const Catalog_Namespace::SessionInfo& parent_session_info,
                            const std::string& query_ra,
                            const ExecutionOptions& eo,
-                           const bool is_update_delete) {
-    CHECK(false);
-    return {nullptr, {}};
-  }
+                           const bool is_update_delete);
 
   void leafCatalogConsistencyCheck(
-      const Catalog_Namespace::SessionInfo& parent_session_info) {
-    CHECK(false);
-  }
+      const Catalog_Namespace::SessionInfo& parent_session_info);
 
   std::map<size_t, TQueryResult> forwardQueryToLeaves(
       const Catalog_Namespace::SessionInfo& parent_session_info,
-      const std::string& query_str) {
-    CHECK(false);
-    return {};
-  }
+      const std::string& query_str);
 
   TQueryResult forwardQueryToLeaf(
       const Catalog_Namespace::SessionInfo& parent_session_info,
       const std::string& query_str,
-      const size_t leaf_idx) {
-    CHECK(false);
-    return {};
-  }
+      const size_t leaf_idx);
 
   void insertDataToLeaf(const Catalog_Namespace::SessionInfo& parent_session_info,
                         const size_t leaf_idx,
-                        const TInsertData& thrift_insert_data) {
-    CHECK(false);
-  }
+                        const TInsertData& thrift_insert_data);
 
   void checkpointLeafShardsWithAutoRollback(
       const Catalog_Namespace::SessionInfo& parent_session_info,
       const int32_t db_id,
-      const int32_t table_id) {
-    CHECK(false);
-  }
+      const int32_t table_id);
 
   int32_t get_table_epochLeaf(const Catalog_Namespace::SessionInfo& parent_session_info,
                               const int32_t db_id,
-                              const int32_t table_id) {
-    CHECK(false);
-    return 0;
-  }
+                              const int32_t table_id);
 
   void set_table_epochLeaf(const Catalog_Namespace::SessionInfo& parent_session_info,
                            const int32_t db_id,
                            const int32_t table_id,
-                           const int32_t new_epoch) {
-    CHECK(false);
-  }
+                           const int32_t new_epoch);
 
   std::vector<Catalog_Namespace::TableEpochInfo> getLeafTableEpochs(
       const Catalog_Namespace::SessionInfo& parent_session_info,
       const int32_t db_id,
-      const int32_t table_id) {
-    CHECK(false);
-    return {};
-  }
+      const int32_t table_id);
 
   void setLeafTableEpochs(
       const Catalog_Namespace::SessionInfo& parent_session_info,
       const int32_t db_id,
-      const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs) {
-    CHECK(false);
-  }
+      const std::vector<Catalog_Namespace::TableEpochInfo>& table_epochs);
 
   void connect(const Catalog_Namespace::SessionInfo& parent_session_info,
                const std::string& user,
                const std::string& passwd,
-               const std::string& dbname) {
-    CHECK(false);
-  }
+               const std::string& dbname);
 
-  void disconnect(const TSessionId session) { CHECK(false); }
+  void disconnect(const TSessionId session);
 
-  void switch_database(const TSessionId session, const std::string& dbname) {
-    CHECK(false);
-  }
+  void switch_database(const TSessionId session, const std::string& dbname);
 
-  void clone_session(const TSessionId session1, const TSessionId session2) {
-    CHECK(false);
-  };
+  void clone_session(const TSessionId session1, const TSessionId session2);
 
-  void interrupt(const TSessionId query_session, const TSessionId interrupt_session) {
-    CHECK(false);
-  }
+  void interrupt(const TSessionId query_session, const TSessionId interrupt_session);
 
-  void set_execution_mode(const TSessionId session, const TExecuteMode::type mode) {
-    CHECK(false);
-  }
+  void set_execution_mode(const TSessionId session, const TExecuteMode::type mode);
 
-  size_t leafCount() const { return 0; }
+  size_t leafCount() const { return leaves_.size(); }
 
-  std::vector<TServerStatus> getLeafStatus(TSessionId session) {
-    CHECK(false);
-    return {};
-  }
+  std::vector<TServerStatus> getLeafStatus(TSessionId session);
 
   std::vector<TNodeMemoryInfo> getLeafMemoryInfo(
       TSessionId session,
-      Data_Namespace::MemoryLevel memory_level) {
-    CHECK(false);
-    return {};
-  }
+      Data_Namespace::MemoryLevel memory_level);
 
-  TClusterHardwareInfo getHardwareInfo(TSessionId session) {
-    CHECK(false);
-    return {};
-  }
+  TClusterHardwareInfo getHardwareInfo(TSessionId session);
 
-  void clear_leaf_cpu_memory(const TSessionId session) { CHECK(false); }
+  void clear_leaf_cpu_memory(const TSessionId session);
 
-  void clear_leaf_gpu_memory(const TSessionId session) { CHECK(false); }
+  void clear_leaf_gpu_memory(const TSessionId session);
 
   std::vector<size_t> query_get_outer_fragment_counts(
       const Catalog_Namespace::SessionInfo& parent_session_info,
-      std::string& sql_query) {
-    CHECK(false);
-    return {};
-  }
+      std::string& sql_query);
+
+ private:
+  struct LeafConnection;
+
+  // Runs call(client) on the given leaf, connecting to it first if needed. Errors are
+  // rethrown as std::runtime_error naming the leaf.
+  template <typename Call>
+  auto callLeaf(const size_t leaf_idx, Call call);
+
+  // Runs call(client, leaf_idx) on all leaves concurrently and returns the results in
+  // leaf order. The first error is rethrown once all calls are done.
+  template <typename Call>
+  auto callLeaves(Call call);
+
+  std::vector<TSessionId> getLeafSessions(const TSessionId& parent_session) const;
+
+  std::vector<std::unique_ptr<LeafConnection>> leaves_;
+  std::unordered_map<TSessionId, std::vector<TSessionId>> leaf_sessions_;
+  mutable mapd_shared_mutex leaf_sessions_mutex_;
 };
 
 #endif  // LEAFAGGREGATOR_H
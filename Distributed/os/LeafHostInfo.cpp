@@ -0,0 +1,90 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LeafHostInfo.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+NodeRole parse_node_role(const std::string& role) {
+  if (role == "dbleaf") {
+    return NodeRole::DbLeaf;
+  }
+  if (role == "string") {
+    return NodeRole::String;
+  }
+  throw std::runtime_error("Invalid node role " + role +
+                           " in the cluster configuration, expected 'dbleaf' or "
+                           "'string'");
+}
+
+unsigned get_timeout(const rapidjson::Value& node,
+                     const char* name,
+                     const unsigned default_timeout) {
+  if (!node.HasMember(name)) {
+    return default_timeout;
+  }
+  if (!node[name].IsUint()) {
+    throw std::runtime_error(std::string("Invalid ") + name +
+                             " in the cluster configuration");
+  }
+  return node[name].GetUint();
+}
+
+}  // namespace
+
+std::vector<LeafHostInfo> LeafHostInfo::parseClusterConfig(
+    const std::string& file_path,
+    const unsigned connect_timeout,
+    const unsigned recv_timeout,
+    const unsigned send_timeout,
+    const std::string& ca_cert) {
+  std::ifstream config_file(file_path);
+  if (!config_file) {
+    throw std::runtime_error("Could not open the cluster configuration " + file_path);
+  }
+  rapidjson::IStreamWrapper config_stream(config_file);
+  rapidjson::Document config;
+  config.ParseStream(config_stream);
+  if (config.HasParseError() || !config.IsArray()) {
+    throw std::runtime_error("The cluster configuration " + file_path +
+                             " must be a JSON list of nodes");
+  }
+  std::vector<LeafHostInfo> nodes;
+  for (const auto& node : config.GetArray()) {
+    if (!node.IsObject() || !node.HasMember("host") || !node["host"].IsString() ||
+        !node.HasMember("port") || !node["port"].IsUint() ||
+        node["port"].GetUint() > std::numeric_limits<uint16_t>::max() ||
+        !node.HasMember("role") || !node["role"].IsString()) {
+      throw std::runtime_error("Every node of the cluster configuration " + file_path +
+                               " needs a host, a port and a role");
+    }
+    nodes.emplace_back(node["host"].GetString(),
+                       static_cast<uint16_t>(node["port"].GetUint()),
+                       parse_node_role(node["role"].GetString()),
+                       get_timeout(node, "connect_timeout", connect_timeout),
+                       get_timeout(node, "recv_timeout", recv_timeout),
+                       get_timeout(node, "send_timeout", send_timeout),
+                       ca_cert);
+  }
+  return nodes;
+}
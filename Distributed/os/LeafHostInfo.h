@@ -26,14 +26,36 @@
 #ifndef LEAFHOSTINFO_H
 #define LEAFHOSTINFO_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
-enum class NodeRole { NA };
+enum class NodeRole { DbLeaf, String };
 
 class LeafHostInfo {
  public:
-  LeafHostInfo(const std::string& host, const uint16_t port, const NodeRole role) {}
+  LeafHostInfo(const std::string& host, const uint16_t port, const NodeRole role)
+      : host_(host)
+      , port_(port)
+      , role_(role)
+      , connect_timeout_(0)
+      , recv_timeout_(0)
+      , send_timeout_(0) {}
+
+  LeafHostInfo(const std::string& host,
+               const uint16_t port,
+               const NodeRole role,
+               const unsigned connect_timeout,
+               const unsigned recv_timeout,
+               const unsigned send_timeout,
+               const std::string& ssl_cert_file)
+      : host_(host)
+      , port_(port)
+      , role_(role)
+      , connect_timeout_(connect_timeout)
+      , recv_timeout_(recv_timeout)
+      , send_timeout_(send_timeout)
+      , ssl_cert_file_(ssl_cert_file) {}
 
   const std::string& getHost() const { return host_; }
 
@@ -41,22 +63,34 @@ class LeafHostInfo {
 
   NodeRole getRole() const { return role_; }
 
-  unsigned getConnectTimeout(unsigned connect_timeout) { return 0; }
-  unsigned getRecvTimeout(unsigned recv_timeout) { return 0; }
-  unsigned getSendTimeout() { return 0; }
-  std::string& getSSLCertFile() { return host_; }
+  // The timeouts are in milliseconds, the given value is used when none was configured.
+  unsigned getConnectTimeout(unsigned connect_timeout) const {
+    return connect_timeout_ ? connect_timeout_ : connect_timeout;
+  }
+  unsigned getRecvTimeout(unsigned recv_timeout) const {
+    return recv_timeout_ ? recv_timeout_ : recv_timeout;
+  }
+  unsigned getSendTimeout() const { return send_timeout_; }
+  const std::string& getSSLCertFile() const { return ssl_cert_file_; }
+
+  // Reads a JSON list of nodes, e.g.
+  //   [{"host": "localhost", "port": 16274, "role": "dbleaf"}, ...]
+  // The role is "dbleaf" or "string"; a node may override the timeouts with
+  // "connect_timeout", "recv_timeout" and "send_timeout" members.
   static std::vector<LeafHostInfo> parseClusterConfig(const std::string& file_path,
                                                       const unsigned connect_timeout,
                                                       const unsigned recv_timeout,
                                                       const unsigned send_timeout,
-                                                      const std::string& ca_cert) {
-    return std::vector<LeafHostInfo>{};
-  };
+                                                      const std::string& ca_cert);
 
  private:
   std::string host_;
   uint16_t port_;
   NodeRole role_;
+  unsigned connect_timeout_;
+  unsigned recv_timeout_;
+  unsigned send_timeout_;
+  std::string ssl_cert_file_;
 };
 
 #endif  // LEAFHOSTINFO_H
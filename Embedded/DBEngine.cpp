@@ -18,11 +18,17 @@
 #include <boost/filesystem.hpp>
 #include <boost/variant.hpp>
 #include <iostream>
+#include <mutex>
 #include "Catalog/Catalog.h"
+#include "DataMgr/ForeignStorage/ArrowForeignStorage.h"
+#include "Fragmenter/FragmentDefaultValues.h"
 #include "Logger/Logger.h"
+#include "Parser/ParserWrapper.h"
+#include "QueryEngine/ArrowResultSet.h"
 #include "QueryEngine/CompilationOptions.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/ArrowUtil.h"
 #include "Shared/sqltypes.h"
 
 namespace EmbeddedDatabase {
@@ -35,8 +41,9 @@ enum class ColumnType : uint32_t { Unknown, Integer, Double, Float, String, Arra
 class CursorImpl : public Cursor {
  public:
   CursorImpl(std::shared_ptr<ResultSet> result_set,
+             std::vector<std::string> col_names,
              std::shared_ptr<Data_Namespace::DataMgr> data_mgr)
-      : result_set_(result_set), data_mgr_(data_mgr) {}
+      : result_set_(result_set), col_names_(col_names), data_mgr_(data_mgr) {}
 
   size_t getColCount() { return result_set_->colCount(); }
 
@@ -50,6 +57,42 @@ class CursorImpl : public Cursor {
     return Row(row);
   }
 
+  std::shared_ptr<arrow::RecordBatch> getArrowRecordBatch() {
+    if (record_batch_) {
+      return record_batch_;
+    }
+    if (!result_set_) {
+      return nullptr;
+    }
+    auto data_mgr = data_mgr_.lock();
+    if (!data_mgr) {
+      return nullptr;
+    }
+    // The converter owns the buffers of the columns it could not reference directly,
+    // so it is kept alive together with the result set for the cursor lifetime.
+    converter_ = std::make_unique<ArrowResultSetConverter>(result_set_,
+                                                           data_mgr,
+                                                           ExecutorDeviceType::CPU,
+                                                           0,
+                                                           col_names_,
+                                                           -1,
+                                                           ArrowTransport::WIRE);
+    record_batch_ = converter_->convertToArrow();
+    return record_batch_;
+  }
+
+  std::shared_ptr<arrow::Table> getArrowTable() {
+    if (table_) {
+      return table_;
+    }
+    auto record_batch = getArrowRecordBatch();
+    if (!record_batch) {
+      return nullptr;
+    }
+    ARROW_ASSIGN_OR_THROW(table_, arrow::Table::FromRecordBatches({record_batch}));
+    return table_;
+  }
+
   ColumnType getColType(uint32_t col_num) {
     if (col_num < getColCount()) {
       SQLTypeInfo type_info = result_set_->getColType(col_num);
@@ -82,7 +125,11 @@ class CursorImpl : public Cursor {
 
  private:
   std::shared_ptr<ResultSet> result_set_;
+  std::vector<std::string> col_names_;
   std::weak_ptr<Data_Namespace::DataMgr> data_mgr_;
+  std::unique_ptr<ArrowResultSetConverter> converter_;
+  std::shared_ptr<arrow::RecordBatch> record_batch_;
+  std::shared_ptr<arrow::Table> table_;
 };
 
 /**
@@ -110,12 +157,77 @@ class DBEngineImpl : public DBEngine {
   }
 
   Cursor* executeDML(const std::string& query) {
-    if (query_runner_ != nullptr) {
-      auto rs = query_runner_->runSQL(query, ExecutorDeviceType::CPU);
-      cursors_.emplace_back(new CursorImpl(rs, data_mgr_));
-      return cursors_.back();
+    auto cursor = createCursor(query);
+    if (!cursor) {
+      return nullptr;
+    }
+    cursors_.emplace_back(cursor.release());
+    return cursors_.back();
+  }
+
+  std::shared_ptr<arrow::RecordBatch> executeDMLToArrowRecordBatch(
+      const std::string& query) {
+    std::shared_ptr<CursorImpl> cursor = createCursor(query);
+    if (!cursor) {
+      return nullptr;
+    }
+    auto record_batch = cursor->getArrowRecordBatch();
+    if (!record_batch) {
+      return nullptr;
+    }
+    // The batch references the result set and converter buffers held by the cursor,
+    // so the cursor is released together with the last reference to the batch.
+    return std::shared_ptr<arrow::RecordBatch>(cursor, record_batch.get());
+  }
+
+  std::shared_ptr<arrow::Table> executeDMLToArrowTable(const std::string& query) {
+    std::shared_ptr<CursorImpl> cursor = createCursor(query);
+    if (!cursor) {
+      return nullptr;
+    }
+    auto table = cursor->getArrowTable();
+    if (!table) {
+      return nullptr;
+    }
+    return std::shared_ptr<arrow::Table>(cursor, table.get());
+  }
+
+  void importArrowTable(const std::string& name,
+                        std::shared_ptr<arrow::Table> table,
+                        uint64_t fragment_size) {
+    if (query_runner_ == nullptr) {
+      return;
     }
-    return nullptr;
+    // The table is registered with the ARROW foreign storage, which references the
+    // arrow buffers of fixed width columns instead of copying them into chunks.
+    setArrowTable(name, table);
+    try {
+      auto session = query_runner_->getSession();
+      auto catalog = query_runner_->getCatalog();
+      TableDescriptor td;
+      td.tableName = name;
+      td.userId = session->get_currentUser().userId;
+      td.storageType = "ARROW:" + name;
+      td.persistenceLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+      td.isView = false;
+      td.fragmenter = nullptr;
+      td.fragType = Fragmenter_Namespace::FragmenterType::INSERT_ORDER;
+      td.maxFragRows = fragment_size > 0 ? fragment_size : DEFAULT_FRAGMENT_ROWS;
+      td.maxChunkSize = DEFAULT_MAX_CHUNK_SIZE;
+      td.fragPageSize = DEFAULT_PAGE_SIZE;
+      td.maxRows = DEFAULT_MAX_ROWS;
+      td.keyMetainfo = "[]";
+
+      std::list<ColumnDescriptor> cols;
+      std::vector<Parser::SharedDictionaryDef> dictionary_defs;
+      catalog->createTable(td, cols, dictionary_defs, true);
+      Catalog_Namespace::SysCatalog::instance().createDBObject(
+          session->get_currentUser(), td.tableName, TableDBObjectType, *catalog);
+    } catch (...) {
+      releaseArrowTable(name);
+      throw;
+    }
+    releaseArrowTable(name);
   }
 
   DBEngineImpl(const std::string& base_path)
@@ -124,6 +236,8 @@ class DBEngineImpl : public DBEngine {
       std::cerr << "Catalog basepath " + base_path_ + " does not exist.\n";
       // TODO: Create database if it does not exist
     } else {
+      static std::once_flag arrow_storage_registered;
+      std::call_once(arrow_storage_registered, registerArrowForeignStorage);
       SystemParameters system_parameters;
       std::string data_path = base_path_ + OMNISCI_DATA_PATH;
       data_mgr_ = std::make_shared<Data_Namespace::DataMgr>(
@@ -150,6 +264,25 @@ class DBEngineImpl : public DBEngine {
   }
 
  private:
+  std::unique_ptr<CursorImpl> createCursor(const std::string& query) {
+    if (query_runner_ == nullptr) {
+      return nullptr;
+    }
+    ParserWrapper pw{query};
+    if (pw.isCalcitePathPermissable()) {
+      const auto execution_result =
+          query_runner_->runSelectQuery(query, ExecutorDeviceType::CPU, true, true);
+      std::vector<std::string> col_names;
+      for (const auto& target : execution_result->getTargetsMeta()) {
+        col_names.push_back(target.get_resname());
+      }
+      return std::make_unique<CursorImpl>(
+          execution_result->getRows(), col_names, data_mgr_);
+    }
+    auto rs = query_runner_->runSQL(query, ExecutorDeviceType::CPU);
+    return std::make_unique<CursorImpl>(rs, std::vector<std::string>{}, data_mgr_);
+  }
+
   std::string base_path_;
   std::shared_ptr<Data_Namespace::DataMgr> data_mgr_;
   Catalog_Namespace::DBMetadata database_;
@@ -193,6 +326,24 @@ Cursor* DBEngine::executeDML(std::string query) {
   return engine->executeDML(query);
 }
 
+std::shared_ptr<arrow::RecordBatch> DBEngine::executeDMLToArrowRecordBatch(
+    std::string query) {
+  DBEngineImpl* engine = getImpl(this);
+  return engine->executeDMLToArrowRecordBatch(query);
+}
+
+std::shared_ptr<arrow::Table> DBEngine::executeDMLToArrowTable(std::string query) {
+  DBEngineImpl* engine = getImpl(this);
+  return engine->executeDMLToArrowTable(query);
+}
+
+void DBEngine::importArrowTable(std::string name,
+                                std::shared_ptr<arrow::Table> table,
+                                uint64_t fragment_size) {
+  DBEngineImpl* engine = getImpl(this);
+  engine->importArrowTable(name, table, fragment_size);
+}
+
 /********************************************* Row methods */
 
 Row::Row() {}
@@ -261,4 +412,14 @@ int Cursor::getColType(uint32_t col_num) {
   CursorImpl* cursor = getImpl(this);
   return (int)cursor->getColType(col_num);
 }
+
+std::shared_ptr<arrow::RecordBatch> Cursor::getArrowRecordBatch() {
+  CursorImpl* cursor = getImpl(this);
+  return cursor->getArrowRecordBatch();
+}
+
+std::shared_ptr<arrow::Table> Cursor::getArrowTable() {
+  CursorImpl* cursor = getImpl(this);
+  return cursor->getArrowTable();
+}
 }  // namespace EmbeddedDatabase
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <arrow/api.h>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -43,6 +44,8 @@ class Cursor {
   size_t getRowCount();
   Row getNextRow();
   int getColType(uint32_t col_num);
+  std::shared_ptr<arrow::RecordBatch> getArrowRecordBatch();
+  std::shared_ptr<arrow::Table> getArrowTable();
 };
 
 class DBEngine {
@@ -50,6 +53,11 @@ class DBEngine {
   void reset();
   void executeDDL(std::string query);
   Cursor* executeDML(std::string query);
+  std::shared_ptr<arrow::RecordBatch> executeDMLToArrowRecordBatch(std::string query);
+  std::shared_ptr<arrow::Table> executeDMLToArrowTable(std::string query);
+  void importArrowTable(std::string name,
+                        std::shared_ptr<arrow::Table> table,
+                        uint64_t fragment_size = 0);
   static DBEngine* create(std::string path);
 
  protected:
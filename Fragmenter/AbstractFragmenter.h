@@ -178,6 +178,20 @@ class AbstractFragmenter {
                             const Data_Namespace::MemoryLevel memory_level,
                             UpdelRoll& updel_roll) = 0;
 
+  /**
+   * @brief Updates the fragment offsets of a fixed width column with values packed in
+   * the physical representation of the column, without per-value type conversion. The
+   * column type must satisfy InsertOrderFragmenter::isColumnarUpdatePossible.
+   */
+  virtual void updateColumn(const Catalog_Namespace::Catalog* catalog,
+                            const TableDescriptor* td,
+                            const ColumnDescriptor* cd,
+                            const int fragment_id,
+                            const std::vector<uint64_t>& frag_offsets,
+                            const int8_t* rhs_buffer,
+                            const Data_Namespace::MemoryLevel memory_level,
+                            UpdelRoll& updel_roll) = 0;
+
   virtual void updateColumnMetadata(const ColumnDescriptor* cd,
                                     FragmentInfo& fragment,
                                     std::shared_ptr<Chunk_NS::Chunk> chunk,
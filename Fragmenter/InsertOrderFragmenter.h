@@ -143,6 +143,22 @@ class InsertOrderFragmenter : public AbstractFragmenter {
                     const Data_Namespace::MemoryLevel memory_level,
                     UpdelRoll& updel_roll) override;
 
+  void updateColumn(const Catalog_Namespace::Catalog* catalog,
+                    const TableDescriptor* td,
+                    const ColumnDescriptor* cd,
+                    const int fragment_id,
+                    const std::vector<uint64_t>& frag_offsets,
+                    const int8_t* rhs_buffer,
+                    const Data_Namespace::MemoryLevel memory_level,
+                    UpdelRoll& updel_roll) override;
+
+  /**
+   * @brief true if values of rhs_type can be copied into a column of lhs_type as is,
+   * i.e. both share a nullable, unencoded fixed width physical representation
+   */
+  static bool isColumnarUpdatePossible(const SQLTypeInfo& lhs_type,
+                                       const SQLTypeInfo& rhs_type);
+
   void updateColumnMetadata(const ColumnDescriptor* cd,
                             FragmentInfo& fragment,
                             std::shared_ptr<Chunk_NS::Chunk> chunk,
@@ -207,6 +223,19 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   std::unordered_map<int, size_t> varLenColInfo_;
   std::shared_ptr<std::mutex> mutex_access_inmem_states;
 
+  /**
+   * @brief Rewrites the chunk of a none encoded string column with the updated values
+   * substituted, keeping every row at its fragment offset.
+   */
+  void updateNoneEncodedStringColumn(const Catalog_Namespace::Catalog* catalog,
+                                     const TableDescriptor* td,
+                                     const ColumnDescriptor* cd,
+                                     const int fragment_id,
+                                     const std::vector<uint64_t>& frag_offsets,
+                                     const std::vector<ScalarTargetValue>& rhs_values,
+                                     const SQLTypeInfo& rhs_type,
+                                     UpdelRoll& updel_roll);
+
   /**
    * @brief creates new fragment, calling createChunk()
    * method of BufferMgr to make a new chunk for each column
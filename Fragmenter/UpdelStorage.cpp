@@ -36,6 +36,8 @@
 
 extern bool g_enable_experimental_string_functions;
 
+size_t g_max_vacuum_threads{0};  // 0 uses all hardware threads
+
 namespace Fragmenter_Namespace {
 
 inline void wait_cleanup_threads(std::vector<std::future<void>>& threads) {
@@ -49,6 +51,11 @@ inline bool is_integral(const SQLTypeInfo& t) {
   return t.is_integer() || t.is_boolean() || t.is_time() || t.is_timeinterval();
 }
 
+inline size_t get_vacuum_thread_count() {
+  const size_t ncore = cpu_threads();
+  return g_max_vacuum_threads ? std::min(ncore, g_max_vacuum_threads) : ncore;
+}
+
 bool FragmentInfo::unconditionalVacuum_{false};
 
 void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catalog,
@@ -589,6 +596,12 @@ void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catal
   }
   CHECK(nrow == n_rhs_values || 1 == n_rhs_values);
 
+  if (cd->columnType.is_string() && kENCODING_NONE == cd->columnType.get_compression()) {
+    updateNoneEncodedStringColumn(
+        catalog, td, cd, fragment_id, frag_offsets, rhs_values, rhs_type, updel_roll);
+    return;
+  }
+
   auto fragment_ptr = getFragmentInfo(fragment_id);
   auto& fragment = *fragment_ptr;
   auto chunk_meta_it = fragment.getChunkMetadataMapPhysical().find(cd->columnId);
@@ -899,6 +912,325 @@ void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catal
                        updel_roll);
 }
 
+void InsertOrderFragmenter::updateNoneEncodedStringColumn(
+    const Catalog_Namespace::Catalog* catalog,
+    const TableDescriptor* td,
+    const ColumnDescriptor* cd,
+    const int fragment_id,
+    const std::vector<uint64_t>& frag_offsets,
+    const std::vector<ScalarTargetValue>& rhs_values,
+    const SQLTypeInfo& rhs_type,
+    UpdelRoll& updel_roll) {
+  const auto nrow = frag_offsets.size();
+  const auto n_rhs_values = rhs_values.size();
+
+  auto fragment_ptr = getFragmentInfo(fragment_id);
+  auto& fragment = *fragment_ptr;
+  auto chunk_meta_it = fragment.getChunkMetadataMapPhysical().find(cd->columnId);
+  CHECK(chunk_meta_it != fragment.getChunkMetadataMapPhysical().end());
+  ChunkKey chunk_key{
+      catalog->getCurrentDB().dbId, td->tableId, cd->columnId, fragment.fragmentId};
+  auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                         &catalog->getDataMgr(),
+                                         chunk_key,
+                                         Data_Namespace::CPU_LEVEL,
+                                         0,
+                                         chunk_meta_it->second->numBytes,
+                                         chunk_meta_it->second->numElements);
+
+  StringDictionary* rhs_dict{nullptr};
+  std::vector<std::string> new_strings(n_rhs_values);
+  for (size_t i = 0; i < n_rhs_values; ++i) {
+    const auto sv = &rhs_values[i];
+    if (const auto vp = boost::get<NullableString>(sv)) {
+      const auto s = boost::get<std::string>(vp);
+      if (!s && cd->columnType.get_notnull()) {
+        throw std::runtime_error("NULL value on NOT NULL column '" + cd->columnName +
+                                 "'");
+      }
+      new_strings[i] = s ? *s : std::string("");
+    } else if (const auto vp = boost::get<int64_t>(sv)) {
+      if (!rhs_type.is_string()) {
+        throw std::runtime_error("UPDATE does not support cast to string.");
+      }
+      if (!rhs_dict) {
+        auto dictDesc = catalog->getMetadataForDict(rhs_type.get_comp_param());
+        if (nullptr == dictDesc) {
+          throw std::runtime_error(
+              "UPDATE does not support cast from string literal to string column.");
+        }
+        rhs_dict = dictDesc->stringDict.get();
+        CHECK(rhs_dict);
+      }
+      new_strings[i] = rhs_dict->getString(*vp);
+    } else {
+      throw std::runtime_error("UPDATE does not support cast to string.");
+    }
+  }
+
+  // The rows of the chunk stay where they are: unchanged runs of the payload are
+  // copied over as blocks and only their offsets are shifted, so the update neither
+  // moves rows into a new fragment nor leaves deleted rows behind for vacuum.
+  std::vector<std::pair<uint64_t, size_t>> updated_rows(nrow);
+  for (size_t r = 0; r < nrow; ++r) {
+    updated_rows[r] = {frag_offsets[r], 1 == n_rhs_values ? 0 : r};
+  }
+  std::sort(updated_rows.begin(), updated_rows.end());
+
+  auto data_buffer = chunk->getBuffer();
+  auto index_buffer = chunk->getIndexBuf();
+  CHECK(index_buffer);
+  const auto data_addr = data_buffer->getMemoryPtr();
+  const auto index_array = reinterpret_cast<StringOffsetT*>(index_buffer->getMemoryPtr());
+  const auto nrows_in_chunk = data_buffer->getEncoder()->getNumElems();
+  CHECK_LT(updated_rows.back().first, nrows_in_chunk);
+
+  std::vector<int8_t> new_data;
+  std::vector<StringOffsetT> new_index(nrows_in_chunk + 1);
+  new_data.reserve(data_buffer->size());
+  auto copy_unchanged_rows = [&](const size_t rbegin, const size_t rend) {
+    if (rbegin >= rend) {
+      return;
+    }
+    const int64_t delta = static_cast<int64_t>(new_data.size()) - index_array[rbegin];
+    for (size_t r = rbegin; r < rend; ++r) {
+      new_index[r] = index_array[r] + delta;
+    }
+    new_data.insert(new_data.end(),
+                    data_addr + index_array[rbegin],
+                    data_addr + index_array[rend]);
+  };
+  size_t next_row = 0;
+  for (const auto& [row, value_idx] : updated_rows) {
+    copy_unchanged_rows(next_row, row);
+    new_index[row] = new_data.size();
+    const auto& str = new_strings[value_idx];
+    new_data.insert(new_data.end(), str.begin(), str.end());
+    next_row = row + 1;
+  }
+  copy_unchanged_rows(next_row, nrows_in_chunk);
+  if (new_data.size() > static_cast<size_t>(std::numeric_limits<StringOffsetT>::max())) {
+    throw std::runtime_error("String data of column '" + cd->columnName +
+                             "' exceeds the maximum chunk payload size.");
+  }
+  new_index[nrows_in_chunk] = new_data.size();
+
+  if (!new_data.empty()) {
+    data_buffer->write(new_data.data(), new_data.size(), 0);
+  }
+  data_buffer->setSize(new_data.size());
+  data_buffer->setUpdated();
+  index_buffer->write(reinterpret_cast<int8_t*>(new_index.data()),
+                      new_index.size() * sizeof(StringOffsetT),
+                      0);
+  index_buffer->setUpdated();
+
+  {
+    std::lock_guard<std::mutex> lck(updel_roll.mutex);
+    if (updel_roll.dirtyChunks.count(chunk.get()) == 0) {
+      updel_roll.dirtyChunks.emplace(chunk.get(), chunk);
+    }
+    updel_roll.dirtyChunkeys.insert(chunk_key);
+  }
+  data_buffer->getEncoder()->updateStats(&new_strings, 0, new_strings.size());
+  updateColumnMetadata(cd,
+                       fragment,
+                       chunk,
+                       false,
+                       std::numeric_limits<double>::lowest(),
+                       std::numeric_limits<double>::max(),
+                       std::numeric_limits<int64_t>::min(),
+                       std::numeric_limits<int64_t>::max(),
+                       cd->columnType,
+                       updel_roll);
+}
+
+namespace {
+
+// Scatters the packed values of rhs_buffer[rbegin, rend) into the chunk buffer at
+// their fragment offsets and folds them into the per-thread stats. The stats pass
+// reads the source sequentially, so it stays a tight typed loop.
+template <typename T, typename STATS_TYPE>
+void scatter_fixlen_values(int8_t* dbuf_addr,
+                           const int8_t* rhs_buffer,
+                           const std::vector<uint64_t>& frag_offsets,
+                           const size_t rbegin,
+                           const size_t rend,
+                           const T null_sentinel,
+                           int8_t& has_null,
+                           STATS_TYPE& min,
+                           STATS_TYPE& max) {
+  auto dst = reinterpret_cast<T*>(dbuf_addr);
+  const auto src = reinterpret_cast<const T*>(rhs_buffer);
+  for (size_t r = rbegin; r < rend; ++r) {
+    dst[frag_offsets[r]] = src[r];
+  }
+  T local_min = std::numeric_limits<T>::max();
+  T local_max = std::numeric_limits<T>::lowest();
+  for (size_t r = rbegin; r < rend; ++r) {
+    set_minmax(local_min, local_max, has_null, src[r], null_sentinel);
+  }
+  if (local_min <= local_max) {
+    min = std::min<STATS_TYPE>(min, local_min);
+    max = std::max<STATS_TYPE>(max, local_max);
+  }
+}
+
+}  // namespace
+
+bool InsertOrderFragmenter::isColumnarUpdatePossible(const SQLTypeInfo& lhs_type,
+                                                     const SQLTypeInfo& rhs_type) {
+  if (!(lhs_type.is_integer() || lhs_type.is_fp() || lhs_type.is_boolean() ||
+        lhs_type.is_time())) {
+    return false;
+  }
+  return !lhs_type.get_notnull() && lhs_type.get_compression() == kENCODING_NONE &&
+         rhs_type.get_compression() == kENCODING_NONE &&
+         lhs_type.get_type() == rhs_type.get_type() &&
+         lhs_type.get_size() == rhs_type.get_size() &&
+         lhs_type.get_dimension() == rhs_type.get_dimension();
+}
+
+void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catalog,
+                                         const TableDescriptor* td,
+                                         const ColumnDescriptor* cd,
+                                         const int fragment_id,
+                                         const std::vector<uint64_t>& frag_offsets,
+                                         const int8_t* rhs_buffer,
+                                         const Data_Namespace::MemoryLevel memory_level,
+                                         UpdelRoll& updel_roll) {
+  const auto& lhs_type = cd->columnType;
+  CHECK(isColumnarUpdatePossible(lhs_type, lhs_type));
+  CHECK(rhs_buffer);
+  updel_roll.catalog = catalog;
+  updel_roll.logicalTableId = catalog->getLogicalTableId(td->tableId);
+  updel_roll.memoryLevel = memory_level;
+
+  const size_t ncore = cpu_threads();
+  const auto nrow = frag_offsets.size();
+  if (0 == nrow) {
+    return;
+  }
+
+  auto fragment_ptr = getFragmentInfo(fragment_id);
+  auto& fragment = *fragment_ptr;
+  auto chunk_meta_it = fragment.getChunkMetadataMapPhysical().find(cd->columnId);
+  CHECK(chunk_meta_it != fragment.getChunkMetadataMapPhysical().end());
+  ChunkKey chunk_key{
+      catalog->getCurrentDB().dbId, td->tableId, cd->columnId, fragment.fragmentId};
+  auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                         &catalog->getDataMgr(),
+                                         chunk_key,
+                                         Data_Namespace::CPU_LEVEL,
+                                         0,
+                                         chunk_meta_it->second->numBytes,
+                                         chunk_meta_it->second->numElements);
+
+  std::vector<int8_t> has_null_per_thread(ncore, 0);
+  std::vector<double> max_double_per_thread(ncore, std::numeric_limits<double>::lowest());
+  std::vector<double> min_double_per_thread(ncore, std::numeric_limits<double>::max());
+  std::vector<int64_t> max_int64t_per_thread(ncore, std::numeric_limits<int64_t>::min());
+  std::vector<int64_t> min_int64t_per_thread(ncore, std::numeric_limits<int64_t>::max());
+
+  std::vector<std::future<void>> threads;
+
+  const auto segsz = (nrow + ncore - 1) / ncore;
+  auto dbuf = chunk->getBuffer();
+  auto dbuf_addr = dbuf->getMemoryPtr();
+  dbuf->setUpdated();
+  {
+    std::lock_guard<std::mutex> lck(updel_roll.mutex);
+    if (updel_roll.dirtyChunks.count(chunk.get()) == 0) {
+      updel_roll.dirtyChunks.emplace(chunk.get(), chunk);
+    }
+
+    ChunkKey chunkey{updel_roll.catalog->getCurrentDB().dbId,
+                     cd->tableId,
+                     cd->columnId,
+                     fragment.fragmentId};
+    updel_roll.dirtyChunkeys.insert(chunkey);
+  }
+  for (size_t rbegin = 0, c = 0; rbegin < nrow; ++c, rbegin += segsz) {
+    threads.emplace_back(std::async(std::launch::async, [&, rbegin, c] {
+      const auto rend = std::min(rbegin + segsz, nrow);
+      auto scatter_int = [&](auto null_sentinel) {
+        scatter_fixlen_values(dbuf_addr,
+                              rhs_buffer,
+                              frag_offsets,
+                              rbegin,
+                              rend,
+                              null_sentinel,
+                              has_null_per_thread[c],
+                              min_int64t_per_thread[c],
+                              max_int64t_per_thread[c]);
+      };
+      auto scatter_fp = [&](auto null_sentinel) {
+        scatter_fixlen_values(dbuf_addr,
+                              rhs_buffer,
+                              frag_offsets,
+                              rbegin,
+                              rend,
+                              null_sentinel,
+                              has_null_per_thread[c],
+                              min_double_per_thread[c],
+                              max_double_per_thread[c]);
+      };
+      if (lhs_type.is_fp()) {
+        if (lhs_type.get_type() == kFLOAT) {
+          scatter_fp(inline_fp_null_value<float>());
+        } else {
+          scatter_fp(inline_fp_null_value<double>());
+        }
+        return;
+      }
+      switch (lhs_type.get_size()) {
+        case 1:
+          scatter_int(inline_int_null_value<int8_t>());
+          break;
+        case 2:
+          scatter_int(inline_int_null_value<int16_t>());
+          break;
+        case 4:
+          scatter_int(inline_int_null_value<int32_t>());
+          break;
+        case 8:
+          scatter_int(inline_int_null_value<int64_t>());
+          break;
+        default:
+          UNREACHABLE() << lhs_type.to_string();
+      }
+    }));
+  }
+  wait_cleanup_threads(threads);
+
+  bool has_null_per_chunk{false};
+  double max_double_per_chunk{std::numeric_limits<double>::lowest()};
+  double min_double_per_chunk{std::numeric_limits<double>::max()};
+  int64_t max_int64t_per_chunk{std::numeric_limits<int64_t>::min()};
+  int64_t min_int64t_per_chunk{std::numeric_limits<int64_t>::max()};
+  for (size_t c = 0; c < ncore; ++c) {
+    has_null_per_chunk = has_null_per_chunk || has_null_per_thread[c];
+    max_double_per_chunk =
+        std::max<double>(max_double_per_chunk, max_double_per_thread[c]);
+    min_double_per_chunk =
+        std::min<double>(min_double_per_chunk, min_double_per_thread[c]);
+    max_int64t_per_chunk =
+        std::max<int64_t>(max_int64t_per_chunk, max_int64t_per_thread[c]);
+    min_int64t_per_chunk =
+        std::min<int64_t>(min_int64t_per_chunk, min_int64t_per_thread[c]);
+  }
+  updateColumnMetadata(cd,
+                       fragment,
+                       chunk,
+                       has_null_per_chunk,
+                       max_double_per_chunk,
+                       min_double_per_chunk,
+                       max_int64t_per_chunk,
+                       min_int64t_per_chunk,
+                       cd->columnType,
+                       updel_roll);
+}
+
 void InsertOrderFragmenter::updateColumnMetadata(const ColumnDescriptor* cd,
                                                  FragmentInfo& fragment,
                                                  std::shared_ptr<Chunk_NS::Chunk> chunk,
@@ -1027,22 +1359,6 @@ const std::vector<uint64_t> InsertOrderFragmenter::getVacuumOffsets(
   return all_deleted_offsets;
 }
 
-template <typename T>
-static void set_chunk_stats(const SQLTypeInfo& col_type,
-                            int8_t* data_addr,
-                            int8_t& has_null,
-                            T& min,
-                            T& max) {
-  T v;
-  const auto can_be_null = !col_type.get_notnull();
-  const auto is_null = get_scalar<T>(data_addr, col_type, v);
-  if (is_null) {
-    has_null = has_null || (can_be_null && is_null);
-  } else {
-    set_minmax(min, max, v);
-  }
-}
-
 static void set_chunk_metadata(const Catalog_Namespace::Catalog* catalog,
                                FragmentInfo& fragment,
                                const std::shared_ptr<Chunk_NS::Chunk>& chunk,
@@ -1167,75 +1483,19 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
   auto chunks = getChunksForAllColumns(td, fragment, memory_level);
   const auto ncol = chunks.size();
 
-  std::vector<int8_t> has_null_per_thread(ncol, 0);
-  std::vector<double> max_double_per_thread(ncol, std::numeric_limits<double>::lowest());
-  std::vector<double> min_double_per_thread(ncol, std::numeric_limits<double>::max());
-  std::vector<int64_t> max_int64t_per_thread(ncol, std::numeric_limits<uint64_t>::min());
-  std::vector<int64_t> min_int64t_per_thread(ncol, std::numeric_limits<uint64_t>::max());
-
-  // parallel delete columns
-  std::vector<std::future<void>> threads;
   auto nrows_to_vacuum = frag_offsets.size();
   auto nrows_in_fragment = fragment.getPhysicalNumTuples();
   auto nrows_to_keep = nrows_in_fragment - nrows_to_vacuum;
 
-  for (size_t ci = 0; ci < chunks.size(); ++ci) {
+  auto vacuum_chunk = [&](const size_t ci) {
     auto chunk = chunks[ci];
-    const auto cd = chunk->getColumnDesc();
-    const auto& col_type = cd->columnType;
+    const auto& col_type = chunk->getColumnDesc()->columnType;
     auto data_buffer = chunk->getBuffer();
-    auto index_buffer = chunk->getIndexBuf();
-    auto data_addr = data_buffer->getMemoryPtr();
-    auto indices_addr = index_buffer ? index_buffer->getMemoryPtr() : nullptr;
-    auto index_array = (StringOffsetT*)indices_addr;
-    bool is_varlen = col_type.is_varlen_indeed();
-
-    auto fixlen_vacuum = [=,
-                          &has_null_per_thread,
-                          &max_double_per_thread,
-                          &min_double_per_thread,
-                          &min_int64t_per_thread,
-                          &max_int64t_per_thread,
-                          &updel_roll,
-                          &frag_offsets,
-                          &fragment] {
-      size_t nbytes_fix_data_to_keep;
-      nbytes_fix_data_to_keep = vacuum_fixlen_rows(fragment, chunk, frag_offsets);
-
-      data_buffer->getEncoder()->setNumElems(nrows_to_keep);
-      data_buffer->setSize(nbytes_fix_data_to_keep);
-      data_buffer->setUpdated();
-
-      set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
-
-      auto daddr = data_addr;
-      auto element_size =
-          col_type.is_fixlen_array() ? col_type.get_size() : get_element_size(col_type);
-      for (size_t irow = 0; irow < nrows_to_keep; ++irow, daddr += element_size) {
-        if (col_type.is_fixlen_array()) {
-          auto encoder =
-              dynamic_cast<FixedLengthArrayNoneEncoder*>(data_buffer->getEncoder());
-          CHECK(encoder);
-          encoder->updateMetadata((int8_t*)daddr);
-        } else if (col_type.is_fp()) {
-          set_chunk_stats(col_type,
-                          data_addr,
-                          has_null_per_thread[ci],
-                          min_double_per_thread[ci],
-                          max_double_per_thread[ci]);
-        } else {
-          set_chunk_stats(col_type,
-                          data_addr,
-                          has_null_per_thread[ci],
-                          min_int64t_per_thread[ci],
-                          max_int64t_per_thread[ci]);
-        }
-      }
-    };
-
-    auto varlen_vacuum = [=, &updel_roll, &frag_offsets, &fragment] {
-      size_t nbytes_var_data_to_keep;
-      nbytes_var_data_to_keep = vacuum_varlen_rows(fragment, chunk, frag_offsets);
+    if (col_type.is_varlen_indeed()) {
+      auto index_buffer = chunk->getIndexBuf();
+      auto index_array = reinterpret_cast<StringOffsetT*>(index_buffer->getMemoryPtr());
+      const auto nbytes_var_data_to_keep =
+          vacuum_varlen_rows(fragment, chunk, frag_offsets);
 
       data_buffer->getEncoder()->setNumElems(nrows_to_keep);
       data_buffer->setSize(nbytes_var_data_to_keep);
@@ -1245,20 +1505,43 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
       index_buffer->setSize(sizeof(*index_array) *
                             (nrows_to_keep ? 1 + nrows_to_keep : 0));
       index_buffer->setUpdated();
+    } else {
+      const auto nbytes_fix_data_to_keep =
+          vacuum_fixlen_rows(fragment, chunk, frag_offsets);
 
-      set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
-    };
+      data_buffer->getEncoder()->setNumElems(nrows_to_keep);
+      data_buffer->setSize(nbytes_fix_data_to_keep);
+      data_buffer->setUpdated();
 
-    if (is_varlen) {
-      threads.emplace_back(std::async(std::launch::async, varlen_vacuum));
-    } else {
-      threads.emplace_back(std::async(std::launch::async, fixlen_vacuum));
-    }
-    if (threads.size() >= (size_t)cpu_threads()) {
-      wait_cleanup_threads(threads);
+      if (col_type.is_fixlen_array()) {
+        // Fixed length arrays keep their stats in the encoder, which are fed row by row.
+        auto encoder =
+            dynamic_cast<FixedLengthArrayNoneEncoder*>(data_buffer->getEncoder());
+        CHECK(encoder);
+        auto daddr = data_buffer->getMemoryPtr();
+        for (size_t irow = 0; irow < nrows_to_keep; ++irow) {
+          encoder->updateMetadata(daddr);
+          daddr += col_type.get_size();
+        }
+      }
     }
-  }
+    // The kept rows are a subset of the chunk, so the existing min/max/null stats of
+    // scalar columns still bound them and need not be recomputed row by row.
+    set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+  };
 
+  // Columns are handed out to a fixed set of workers, so a wide table neither
+  // oversubscribes the host nor stalls on the slowest column of a batch.
+  const size_t nworkers = std::min(ncol, get_vacuum_thread_count());
+  std::atomic<size_t> next_chunk{0};
+  std::vector<std::future<void>> threads;
+  for (size_t i = 0; i < nworkers; ++i) {
+    threads.emplace_back(std::async(std::launch::async, [&] {
+      for (auto ci = next_chunk++; ci < ncol; ci = next_chunk++) {
+        vacuum_chunk(ci);
+      }
+    }));
+  }
   wait_cleanup_threads(threads);
 
   auto key = std::make_pair(td, &fragment);
@@ -1270,11 +1553,11 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
       updateColumnMetadata(cd,
                            fragment,
                            chunk,
-                           has_null_per_thread[ci],
-                           max_double_per_thread[ci],
-                           min_double_per_thread[ci],
-                           max_int64t_per_thread[ci],
-                           min_int64t_per_thread[ci],
+                           false,
+                           std::numeric_limits<double>::lowest(),
+                           std::numeric_limits<double>::max(),
+                           std::numeric_limits<int64_t>::min(),
+                           std::numeric_limits<int64_t>::max(),
                            cd->columnType,
                            updel_roll);
     }
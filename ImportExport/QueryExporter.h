@@ -18,7 +18,11 @@
 
 #include <Distributed/AggregatedResult.h>
 #include <ImportExport/CopyParams.h>
+#include <QueryEngine/ResultSet.h>
+#include <Shared/Intervals.h>
+#include <Shared/thread_count.h>
 
+#include <future>
 #include <string>
 #include <unordered_set>
 
@@ -58,6 +62,70 @@ class QueryExporter {
       const std::string& file_type,
       const std::unordered_set<std::string>& valid_extensions) const;
   std::string safeColumnName(const std::string& resname, const int column_index);
+
+  // Converts the rows of a result set into batches and hands the batches to
+  // write_batch in row order on the calling thread. Unless LIMIT or OFFSET have to be
+  // applied by getNextRow, disjoint row ranges are converted (convert_row) and
+  // finished (finish_batch) on all CPU threads, so only writing is serial.
+  template <typename BATCH,
+            typename CONVERT_ROW,
+            typename FINISH_BATCH,
+            typename WRITE_BATCH>
+  static void exportRowsInBatches(const ResultSet& results,
+                                  CONVERT_ROW convert_row,
+                                  FINISH_BATCH finish_batch,
+                                  WRITE_BATCH write_batch) {
+    constexpr size_t rows_per_batch = 64 * 1024;
+    if (!result_set::use_parallel_algorithms(results)) {
+      while (true) {
+        BATCH batch;
+        size_t row_count = 0;
+        for (; row_count < rows_per_batch; ++row_count) {
+          auto const crt_row = results.getNextRow(true, true);
+          if (crt_row.empty()) {
+            break;
+          }
+          convert_row(batch, crt_row);
+        }
+        finish_batch(batch);
+        write_batch(batch);
+        if (row_count < rows_per_batch) {
+          return;
+        }
+      }
+    }
+    // bound memory use by converting up to one batch per thread ahead of the writer
+    auto const entry_count = results.entryCount();
+    size_t const worker_count = cpu_threads();
+    size_t const entries_per_round = worker_count * rows_per_batch;
+    for (size_t round_begin = 0; round_begin < entry_count;
+         round_begin += entries_per_round) {
+      auto const round_end = std::min(round_begin + entries_per_round, entry_count);
+      std::vector<std::future<BATCH>> converters;
+      for (auto const& interval : makeIntervals(round_begin, round_end, worker_count)) {
+        converters.push_back(std::async(
+            std::launch::async,
+            [&results, &convert_row, &finish_batch](size_t const begin,
+                                                    size_t const end) {
+              BATCH batch;
+              for (size_t i = begin; i < end; ++i) {
+                auto const crt_row = results.getRowAtWithTranslations(i, true);
+                if (!crt_row.empty()) {
+                  convert_row(batch, crt_row);
+                }
+              }
+              finish_batch(batch);
+              return batch;
+            },
+            interval.begin,
+            interval.end));
+      }
+      for (auto& converter : converters) {
+        auto batch = converter.get();
+        write_batch(batch);
+      }
+    }
+  }
 };
 
 }  // namespace import_export
@@ -16,7 +16,11 @@
 
 #include <ImportExport/QueryExporterCSV.h>
 
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/variant/get.hpp>
+#include <sstream>
 
 #include <QueryEngine/GroupByAndAggregate.h>
 #include <QueryEngine/ResultSet.h>
@@ -38,19 +42,27 @@ void QueryExporterCSV::beginExport(const std::string& file_path,
 
   // compression?
   auto actual_file_path{file_path};
-  if (file_compression != FileCompression::kNone) {
-    // @TODO(se) implement post-export compression
-    throw std::runtime_error("Compression not yet supported for this file type");
+  switch (file_compression) {
+    case FileCompression::kNone:
+      gzip_ = false;
+      break;
+    case FileCompression::kGZip:
+      gzip_ = true;
+      actual_file_path.append(".gz");
+      break;
+    default:
+      throw std::runtime_error("Compression not yet supported for this file type");
   }
 
   // open file
-  outfile_.open(actual_file_path);
+  outfile_.open(actual_file_path, std::ios::binary);
   if (!outfile_) {
     throw std::runtime_error("Failed to create file '" + actual_file_path + "'");
   }
 
   // write header?
   if (copy_params.has_header == import_export::ImportHeaderRow::HAS_HEADER) {
+    std::ostringstream header;
     bool not_first{false};
     int column_index = 0;
     for (auto const& column_info : column_infos) {
@@ -58,143 +70,174 @@ void QueryExporterCSV::beginExport(const std::string& file_path,
       auto column_name = safeColumnName(column_info.get_resname(), column_index + 1);
       // output to header line
       if (not_first) {
-        outfile_ << copy_params.delimiter;
+        header << copy_params.delimiter;
       } else {
         not_first = true;
       }
-      outfile_ << column_name;
+      header << column_name;
       column_index++;
     }
-    outfile_ << copy_params.line_delim;
+    header << copy_params.line_delim;
+    writeData(gzip_ ? gzipCompress(header.str()) : header.str());
   }
 
   // keep these
   copy_params_ = copy_params;
 }
 
-void QueryExporterCSV::exportResults(const std::vector<AggregatedResult>& query_results) {
-  for (auto& agg_result : query_results) {
-    auto results = agg_result.rs;
-    auto const& targets = agg_result.targets_meta;
+std::string QueryExporterCSV::gzipCompress(const std::string& data) {
+  std::string compressed;
+  {
+    boost::iostreams::filtering_ostream gzip_stream;
+    gzip_stream.push(boost::iostreams::gzip_compressor());
+    gzip_stream.push(boost::iostreams::back_inserter(compressed));
+    gzip_stream.write(data.data(), data.size());
+  }
+  return compressed;
+}
 
-    while (true) {
-      auto const crt_row = results->getNextRow(true, true);
-      if (crt_row.empty()) {
-        break;
+void QueryExporterCSV::writeData(const std::string& data) {
+  if (!outfile_.write(data.data(), data.size())) {
+    throw std::runtime_error("Failed to write exported data");
+  }
+}
+
+void QueryExporterCSV::writeRow(std::ostream& os,
+                                std::vector<TargetValue> const& crt_row,
+                                std::vector<TargetMetaInfo> const& targets) const {
+  bool not_first = false;
+  for (size_t i = 0; i < crt_row.size(); ++i) {
+    bool is_null{false};
+    auto const tv = crt_row[i];
+    auto const scalar_tv = boost::get<ScalarTargetValue>(&tv);
+    if (not_first) {
+      os << copy_params_.delimiter;
+    } else {
+      not_first = true;
+    }
+    if (copy_params_.quoted) {
+      os << copy_params_.quote;
+    }
+    auto const& ti = targets[i].get_type_info();
+    if (!scalar_tv) {
+      os << datum_to_string(crt_row[i], ti, " | ");
+      if (copy_params_.quoted) {
+        os << copy_params_.quote;
       }
-      bool not_first = false;
-      for (size_t i = 0; i < results->colCount(); ++i) {
-        bool is_null{false};
-        auto const tv = crt_row[i];
-        auto const scalar_tv = boost::get<ScalarTargetValue>(&tv);
-        if (not_first) {
-          outfile_ << copy_params_.delimiter;
-        } else {
-          not_first = true;
-        }
-        if (copy_params_.quoted) {
-          outfile_ << copy_params_.quote;
-        }
-        auto const& ti = targets[i].get_type_info();
-        if (!scalar_tv) {
-          outfile_ << datum_to_string(crt_row[i], ti, " | ");
-          if (copy_params_.quoted) {
-            outfile_ << copy_params_.quote;
-          }
-          continue;
-        }
-        if (boost::get<int64_t>(scalar_tv)) {
-          auto int_val = *(boost::get<int64_t>(scalar_tv));
-          switch (ti.get_type()) {
-            case kBOOLEAN:
-              is_null = (int_val == NULL_BOOLEAN);
-              break;
-            case kTINYINT:
-              is_null = (int_val == NULL_TINYINT);
-              break;
-            case kSMALLINT:
-              is_null = (int_val == NULL_SMALLINT);
-              break;
-            case kINT:
-              is_null = (int_val == NULL_INT);
-              break;
-            case kBIGINT:
-              is_null = (int_val == NULL_BIGINT);
-              break;
-            case kTIME:
-            case kTIMESTAMP:
-            case kDATE:
-              is_null = (int_val == NULL_BIGINT);
-              break;
-            default:
-              is_null = false;
-          }
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else if (ti.get_type() == kTIME) {
-            constexpr size_t buf_size = 9;
-            char buf[buf_size];
-            size_t const len = shared::formatHMS(buf, buf_size, int_val);
-            CHECK_EQ(8u, len);  // 8 == strlen("HH:MM:SS")
-            outfile_ << buf;
-          } else {
-            outfile_ << int_val;
-          }
-        } else if (boost::get<double>(scalar_tv)) {
-          auto real_val = *(boost::get<double>(scalar_tv));
-          if (ti.get_type() == kFLOAT) {
-            is_null = (real_val == NULL_FLOAT);
-          } else {
-            is_null = (real_val == NULL_DOUBLE);
-          }
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else if (ti.get_type() == kNUMERIC) {
-            outfile_ << std::setprecision(ti.get_precision()) << real_val;
-          } else {
-            outfile_ << std::setprecision(std::numeric_limits<double>::digits10 + 1)
-                     << real_val;
-          }
-        } else if (boost::get<float>(scalar_tv)) {
-          CHECK_EQ(kFLOAT, ti.get_type());
-          auto real_val = *(boost::get<float>(scalar_tv));
-          if (real_val == NULL_FLOAT) {
-            outfile_ << copy_params_.null_str;
-          } else {
-            outfile_ << std::setprecision(std::numeric_limits<float>::digits10 + 1)
-                     << real_val;
-          }
+      continue;
+    }
+    if (boost::get<int64_t>(scalar_tv)) {
+      auto int_val = *(boost::get<int64_t>(scalar_tv));
+      switch (ti.get_type()) {
+        case kBOOLEAN:
+          is_null = (int_val == NULL_BOOLEAN);
+          break;
+        case kTINYINT:
+          is_null = (int_val == NULL_TINYINT);
+          break;
+        case kSMALLINT:
+          is_null = (int_val == NULL_SMALLINT);
+          break;
+        case kINT:
+          is_null = (int_val == NULL_INT);
+          break;
+        case kBIGINT:
+          is_null = (int_val == NULL_BIGINT);
+          break;
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          is_null = (int_val == NULL_BIGINT);
+          break;
+        default:
+          is_null = false;
+      }
+      if (is_null) {
+        os << copy_params_.null_str;
+      } else if (ti.get_type() == kTIME) {
+        constexpr size_t buf_size = 9;
+        char buf[buf_size];
+        size_t const len = shared::formatHMS(buf, buf_size, int_val);
+        CHECK_EQ(8u, len);  // 8 == strlen("HH:MM:SS")
+        os << buf;
+      } else {
+        os << int_val;
+      }
+    } else if (boost::get<double>(scalar_tv)) {
+      auto real_val = *(boost::get<double>(scalar_tv));
+      if (ti.get_type() == kFLOAT) {
+        is_null = (real_val == NULL_FLOAT);
+      } else {
+        is_null = (real_val == NULL_DOUBLE);
+      }
+      if (is_null) {
+        os << copy_params_.null_str;
+      } else if (ti.get_type() == kNUMERIC) {
+        os << std::setprecision(ti.get_precision()) << real_val;
+      } else {
+        os << std::setprecision(std::numeric_limits<double>::digits10 + 1) << real_val;
+      }
+    } else if (boost::get<float>(scalar_tv)) {
+      CHECK_EQ(kFLOAT, ti.get_type());
+      auto real_val = *(boost::get<float>(scalar_tv));
+      if (real_val == NULL_FLOAT) {
+        os << copy_params_.null_str;
+      } else {
+        os << std::setprecision(std::numeric_limits<float>::digits10 + 1) << real_val;
+      }
+    } else {
+      auto s = boost::get<NullableString>(scalar_tv);
+      is_null = !s || boost::get<void*>(s);
+      if (is_null) {
+        os << copy_params_.null_str;
+      } else {
+        auto s_notnull = boost::get<std::string>(s);
+        CHECK(s_notnull);
+        if (!copy_params_.quoted) {
+          os << *s_notnull;
         } else {
-          auto s = boost::get<NullableString>(scalar_tv);
-          is_null = !s || boost::get<void*>(s);
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
+          size_t q = s_notnull->find(copy_params_.quote);
+          if (q == std::string::npos) {
+            os << *s_notnull;
           } else {
-            auto s_notnull = boost::get<std::string>(s);
-            CHECK(s_notnull);
-            if (!copy_params_.quoted) {
-              outfile_ << *s_notnull;
-            } else {
-              size_t q = s_notnull->find(copy_params_.quote);
-              if (q == std::string::npos) {
-                outfile_ << *s_notnull;
-              } else {
-                std::string str(*s_notnull);
-                while (q != std::string::npos) {
-                  str.insert(q, 1, copy_params_.escape);
-                  q = str.find(copy_params_.quote, q + 2);
-                }
-                outfile_ << str;
-              }
+            std::string str(*s_notnull);
+            while (q != std::string::npos) {
+              str.insert(q, 1, copy_params_.escape);
+              q = str.find(copy_params_.quote, q + 2);
             }
+            os << str;
           }
         }
-        if (copy_params_.quoted) {
-          outfile_ << copy_params_.quote;
-        }
       }
-      outfile_ << copy_params_.line_delim;
     }
+    if (copy_params_.quoted) {
+      os << copy_params_.quote;
+    }
+  }
+  os << copy_params_.line_delim;
+}
+
+void QueryExporterCSV::exportResults(const std::vector<AggregatedResult>& query_results) {
+  struct Batch {
+    std::ostringstream rows;
+    std::string data;
+  };
+  for (auto& agg_result : query_results) {
+    auto results = agg_result.rs;
+    auto const& targets = agg_result.targets_meta;
+    exportRowsInBatches<Batch>(
+        *results,
+        [this, &targets](Batch& batch, std::vector<TargetValue> const& crt_row) {
+          writeRow(batch.rows, crt_row, targets);
+        },
+        [this](Batch& batch) {
+          batch.data = batch.rows.str();
+          // gzip members compressed on the worker threads concatenate to a valid file
+          if (gzip_ && !batch.data.empty()) {
+            batch.data = gzipCompress(batch.data);
+          }
+        },
+        [this](Batch& batch) { writeData(batch.data); });
   }
 }
 
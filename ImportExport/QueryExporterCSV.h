@@ -37,8 +37,15 @@ class QueryExporterCSV : public QueryExporter {
   void endExport() final;
 
  private:
+  void writeRow(std::ostream& os,
+                std::vector<TargetValue> const& crt_row,
+                std::vector<TargetMetaInfo> const& targets) const;
+  void writeData(const std::string& data);
+  static std::string gzipCompress(const std::string& data);
+
   std::ofstream outfile_;
   CopyParams copy_params_;
+  bool gzip_{false};
 };
 
 }  // namespace import_export
@@ -646,56 +646,64 @@ void QueryExporterGDAL::exportResults(
       // configure ResultSet to return geo as raw data
       results->setGeoReturnType(ResultSet::GeoReturnType::GeoTargetValue);
 
-      while (true) {
-        auto const crt_row = results->getNextRow(true, true);
-        if (crt_row.empty()) {
-          break;
-        }
+      // fetch rows on all threads; features are created serially as OGR layers
+      // are not thread safe
+      using RowBatch = std::vector<std::vector<TargetValue>>;
+      exportRowsInBatches<RowBatch>(
+          *results,
+          [](RowBatch& batch, std::vector<TargetValue> const& crt_row) {
+            batch.push_back(crt_row);
+          },
+          [](RowBatch&) {},
+          [&](RowBatch& batch) {
+            for (auto const& crt_row : batch) {
+              // create feature for this row
+              auto ogr_feature =
+                  OGRFeature::CreateFeature(ogr_layer_->GetLayerDefn());
+              CHECK(ogr_feature);
+
+              // destroy feature on exiting this scope
+              ScopeGuard destroy_feature = [ogr_feature] {
+                OGRFeature::DestroyFeature(ogr_feature);
+              };
+
+              for (size_t i = 0; i < crt_row.size(); ++i) {
+                auto const tv = crt_row[i];
+                auto const& ti = targets[i].get_type_info();
+                auto const column_name =
+                    safeColumnName(targets[i].get_resname(), i + 1);
+                auto const field_index = field_indices_[i];
+
+                // insert this column into the feature
+                auto const scalar_tv = boost::get<ScalarTargetValue>(&tv);
+                if (scalar_tv) {
+                  insert_scalar_column(scalar_tv, ti, field_index, ogr_feature);
+                } else {
+                  auto const array_tv = boost::get<ArrayTargetValue>(&tv);
+                  if (array_tv) {
+                    insert_array_column(array_tv,
+                                        ti,
+                                        field_index,
+                                        ogr_feature,
+                                        column_name,
+                                        array_null_handling_);
+                  } else {
+                    auto const geo_tv = boost::get<GeoTargetValue>(&tv);
+                    if (geo_tv && geo_tv->is_initialized()) {
+                      insert_geo_column(geo_tv, ti, field_index, ogr_feature);
+                    } else {
+                      ogr_feature->SetGeometry(nullptr);
+                    }
+                  }
+                }
+              }
 
-        // create feature for this row
-        auto ogr_feature = OGRFeature::CreateFeature(ogr_layer_->GetLayerDefn());
-        CHECK(ogr_feature);
-
-        // destroy feature on exiting this scope
-        ScopeGuard destroy_feature = [ogr_feature] {
-          OGRFeature::DestroyFeature(ogr_feature);
-        };
-
-        for (size_t i = 0; i < results->colCount(); ++i) {
-          auto const tv = crt_row[i];
-          auto const& ti = targets[i].get_type_info();
-          auto const column_name = safeColumnName(targets[i].get_resname(), i + 1);
-          auto const field_index = field_indices_[i];
-
-          // insert this column into the feature
-          auto const scalar_tv = boost::get<ScalarTargetValue>(&tv);
-          if (scalar_tv) {
-            insert_scalar_column(scalar_tv, ti, field_index, ogr_feature);
-          } else {
-            auto const array_tv = boost::get<ArrayTargetValue>(&tv);
-            if (array_tv) {
-              insert_array_column(array_tv,
-                                  ti,
-                                  field_index,
-                                  ogr_feature,
-                                  column_name,
-                                  array_null_handling_);
-            } else {
-              auto const geo_tv = boost::get<GeoTargetValue>(&tv);
-              if (geo_tv && geo_tv->is_initialized()) {
-                insert_geo_column(geo_tv, ti, field_index, ogr_feature);
-              } else {
-                ogr_feature->SetGeometry(nullptr);
+              // add feature to layer
+              if (ogr_layer_->CreateFeature(ogr_feature) != OGRERR_NONE) {
+                throw std::runtime_error("Failed to create Feature");
               }
             }
-          }
-        }
-
-        // add feature to layer
-        if (ogr_layer_->CreateFeature(ogr_feature) != OGRERR_NONE) {
-          throw std::runtime_error("Failed to create Feature");
-        }
-      }
+          });
     }
   } catch (std::exception& e) {
     LOG(INFO) << "GDAL Query Export failed: " << e.what();
@@ -55,6 +55,7 @@
 #include "LockMgr/LockMgr.h"
 #include "QueryEngine/CalciteAdapter.h"
 #include "QueryEngine/CalciteDeserializerUtils.h"
+#include "QueryEngine/ColumnarResults.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/JsonAccessors.h"
@@ -2736,6 +2737,29 @@ std::list<ColumnDescriptor> LocalConnector::getColumnDescriptors(AggregatedResul
   return column_descriptors;
 }
 
+namespace {
+
+// A source column can bypass the per-cell TargetValueConverters when the target
+// takes exactly the logical values held in the result set: fixed width, no
+// encoding and no conversion. NOT NULL targets are excluded as nulls are rejected
+// row by row by the converters.
+bool is_columnar_insertable(const SQLTypeInfo& source_ti,
+                            const ColumnDescriptor* target_cd) {
+  const auto& target_ti = target_cd->columnType;
+  if (!target_ti.is_number() && !target_ti.is_boolean() && !target_ti.is_time()) {
+    return false;
+  }
+  if (target_ti.get_notnull() || target_ti.get_compression() != kENCODING_NONE ||
+      source_ti.get_compression() != kENCODING_NONE) {
+    return false;
+  }
+  return source_ti.get_type() == target_ti.get_type() &&
+         source_ti.get_dimension() == target_ti.get_dimension() &&
+         source_ti.get_scale() == target_ti.get_scale();
+}
+
+}  // namespace
+
 void InsertIntoTableAsSelectStmt::populateData(QueryStateProxy query_state_proxy,
                                                const TableDescriptor* td,
                                                bool validate_table) {
@@ -2951,6 +2975,55 @@ void InsertIntoTableAsSelectStmt::populateData(QueryStateProxy query_state_proxy
         // ensure that at least one row is being processed
         num_rows_to_process = std::max(num_rows_to_process, 1UL);
 
+        // columnarize the result set once and hand the column buffers to the
+        // loader, rather than boxing every cell as a TargetValue
+        bool all_columns_insertable = true;
+        for (size_t i = 0; i < target_column_descriptors.size(); ++i) {
+          // direct columnarization copies slots as is, so widths must match
+          const auto target_cd = target_column_descriptors[i];
+          all_columns_insertable =
+              all_columns_insertable &&
+              is_columnar_insertable(res.targets_meta[i].get_type_info(), target_cd) &&
+              (!result_rows->isDirectColumnarConversionPossible() ||
+               result_rows->getPaddedSlotWidthBytes(i) ==
+                   target_cd->columnType.get_size());
+        }
+        if (all_columns_insertable) {
+          const auto translate_clock_begin = timer_start();
+          std::vector<SQLTypeInfo> target_types;
+          for (const auto target_cd : target_column_descriptors) {
+            target_types.push_back(target_cd->columnType);
+          }
+          ColumnarResults columnar_results(result_rows->getRowSetMemOwner(),
+                                           *result_rows,
+                                           target_types.size(),
+                                           target_types);
+          const auto& column_buffers = columnar_results.getColumnBuffers();
+          total_target_value_translate_time_ms += timer_stop(translate_clock_begin);
+          for (size_t package_start = 0; package_start < columnar_results.size();
+               package_start += num_rows_to_process) {
+            Fragmenter_Namespace::InsertData insert_data;
+            insert_data.databaseId = catalog.getCurrentDB().dbId;
+            CHECK(td);
+            insert_data.tableId = td->tableId;
+            insert_data.numRows =
+                std::min(columnar_results.size() - package_start, num_rows_to_process);
+            for (size_t col_idx = 0; col_idx < target_column_descriptors.size();
+                 ++col_idx) {
+              DataBlockPtr data_block;
+              data_block.numbersPtr = column_buffers[col_idx] +
+                                      package_start * target_types[col_idx].get_size();
+              insert_data.data.push_back(data_block);
+              insert_data.columnIds.push_back(
+                  target_column_descriptors[col_idx]->columnId);
+            }
+            const auto data_load_clock_begin = timer_start();
+            insertDataLoader.insertData(*session, insert_data);
+            total_data_load_time_ms += timer_stop(data_load_clock_begin);
+          }
+          continue;
+        }
+
         std::vector<std::unique_ptr<TargetValueConverter>> value_converters;
 
         TargetValueConverterFactory factory;
@@ -1364,7 +1364,8 @@ class DumpRestoreTableStmtBase : public DDLStmt {
     };
     std::unique_ptr<std::list<NameValueAssign*>, decltype(options_deleter)> options_ptr(
         options, options_deleter);
-    std::vector<std::string> allowed_compression_programs{"lz4", "gzip", "none"};
+    std::vector<std::string> allowed_compression_programs{
+        "lz4", "gzip", "none", "blosc"};
     // specialize decompressor or break on osx bsdtar...
     if (options) {
       for (const auto option : *options) {
@@ -1399,6 +1400,9 @@ class DumpRestoreTableStmtBase : public DDLStmt {
     }
     if (boost::iequals(compression, "none")) {
       compression.clear();
+    } else if (boost::iequals(compression, "blosc")) {
+      // archived in process by TableArchiver; no external program needed
+      compression = "blosc";
     } else {
       std::map<std::string, std::string> decompression{{"lz4", "unlz4"},
                                                        {"gzip", "gunzip"}};
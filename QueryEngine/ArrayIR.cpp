@@ -20,6 +20,11 @@
 llvm::Value* CodeGenerator::codegenUnnest(const Analyzer::UOper* uoper,
                                           const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
+  for (const auto& unnest_element : cgen_state_->unnest_elements_) {
+    if (*unnest_element.array == *uoper->get_operand()) {
+      return unnest_element.lv;
+    }
+  }
   return codegen(uoper->get_operand(), true, co).front();
 }
 
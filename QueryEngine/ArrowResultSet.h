@@ -197,6 +197,11 @@ class ArrowResultSetConverter {
 
   ArrowResult getArrowResult() const;
 
+  // Builds an in-process record batch. Columnar projection buffers are referenced
+  // directly where possible, so the batch must not outlive the converter and the
+  // result set it was built from.
+  std::shared_ptr<arrow::RecordBatch> convertToArrow() const;
+
   // TODO(adb): Proper namespacing for this set of functionality. For now, make this
   // public and leverage the converter class as namespace
   struct ColumnBuilder {
@@ -212,8 +217,6 @@ class ArrowResultSetConverter {
                           const int32_t first_n)
       : results_(results), col_names_(col_names), top_n_(first_n) {}
 
-  std::shared_ptr<arrow::RecordBatch> convertToArrow() const;
-
   std::shared_ptr<arrow::RecordBatch> getArrowBatch(
       const std::shared_ptr<arrow::Schema>& schema) const;
 
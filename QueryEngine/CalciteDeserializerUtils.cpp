@@ -38,6 +38,8 @@ SQLTypeInfo get_agg_type(const SQLAgg agg_kind, const Analyzer::Expr* arg_expr)
     case kAPPROX_COUNT_DISTINCT:
       return SQLTypeInfo(kBIGINT, false);
     case kAPPROX_MEDIAN:
+    case kPERCENTILE_CONT:
+    case kPERCENTILE_DISC:
       return SQLTypeInfo(kDOUBLE, false);
     case kSINGLE_VALUE:
       if (arg_expr->get_type_info().is_varlen()) {
@@ -110,9 +110,16 @@ inline SQLAgg to_agg_kind(const std::string& agg_name) {
   if (agg_name == std::string("APPROX_COUNT_DISTINCT")) {
     return kAPPROX_COUNT_DISTINCT;
   }
-  if (agg_name == std::string("APPROX_MEDIAN")) {
+  if (agg_name == std::string("APPROX_MEDIAN") ||
+      agg_name == std::string("APPROX_QUANTILE")) {
     return kAPPROX_MEDIAN;
   }
+  if (agg_name == std::string("PERCENTILE_CONT")) {
+    return kPERCENTILE_CONT;
+  }
+  if (agg_name == std::string("PERCENTILE_DISC")) {
+    return kPERCENTILE_DISC;
+  }
   if (agg_name == std::string("SAMPLE") || agg_name == std::string("LAST_SAMPLE")) {
     return kSAMPLE;
   }
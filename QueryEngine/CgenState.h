@@ -18,6 +18,7 @@
 
 #include "IRCodegenUtils.h"
 #include "InValuesBitmap.h"
+#include "InValuesHashSet.h"
 #include "InputMetadata.h"
 #include "LLVMGlobalContext.h"
 
@@ -217,6 +218,23 @@ struct CgenState {
     in_values_bitmaps_.emplace_back(std::move(in_values_bitmap));
     return in_values_bitmaps_.back().get();
   }
+
+  const InValuesHashSet* addInValuesHashSet(
+      std::unique_ptr<InValuesHashSet>& in_values_hash_set) {
+    if (in_values_hash_set->isEmpty()) {
+      return in_values_hash_set.get();
+    }
+    in_values_hash_sets_.emplace_back(std::move(in_values_hash_set));
+    return in_values_hash_sets_.back().get();
+  }
+
+  // The streaming top-n heap reads the sort ranks of the dictionaries it orders by.
+  const std::vector<int32_t>* addTopNSortRanks(
+      std::shared_ptr<const std::vector<int32_t>> sort_ranks) {
+    top_n_sort_ranks_.emplace_back(std::move(sort_ranks));
+    return top_n_sort_ranks_.back().get();
+  }
+
   // look up a runtime function based on the name, return type and type of
   // the arguments and call it; x64 only, don't call from GPU codegen
   llvm::Value* emitExternalCall(
@@ -333,7 +351,19 @@ struct CgenState {
     llvm::Value* lv;
   };
   std::vector<FunctionOperValue> ext_call_cache_;
+  struct ExprValues {
+    const Analyzer::Expr* expr;
+    bool fetch_columns;
+    std::vector<llvm::Value*> lvs;
+  };
+  std::vector<ExprValues> expr_cache_;
   std::vector<llvm::Value*> group_by_expr_cache_;
+  struct UnnestElementValue {
+    const Analyzer::Expr* array;
+    llvm::Value* lv;
+  };
+  // current element of the array a projection or an aggregate unnests
+  std::vector<UnnestElementValue> unnest_elements_;
   std::vector<llvm::Value*> str_constants_;
   std::vector<llvm::Value*> frag_offsets_;
   const bool contains_left_deep_outer_join_;
@@ -341,6 +371,8 @@ struct CgenState {
   std::unordered_map<int, llvm::Value*> scan_idx_to_hash_pos_;
   InsertionOrderedMap filter_func_args_;
   std::vector<std::unique_ptr<const InValuesBitmap>> in_values_bitmaps_;
+  std::vector<std::unique_ptr<const InValuesHashSet>> in_values_hash_sets_;
+  std::vector<std::shared_ptr<const std::vector<int32_t>>> top_n_sort_ranks_;
   bool needs_error_check_;
   bool needs_geos_;
 
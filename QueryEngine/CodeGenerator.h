@@ -18,6 +18,8 @@
 
 #include <llvm/IR/Value.h>
 
+#include <optional>
+
 #include "../Analyzer/Analyzer.h"
 #include "Execute.h"
 
@@ -104,6 +106,17 @@ class CodeGenerator {
                               CgenState* cgen_state,
                               llvm::Linker::Flags flags = llvm::Linker::Flags::None);
 
+  // Declares the functions of the UDF module in the query module, the code generator
+  // only needs their signatures.
+  static void link_udf_declarations(const std::unique_ptr<llvm::Module>& udf_module,
+                                    llvm::Module& module);
+
+  // Links the definitions of the UDFs the generated code calls, and of the functions
+  // they need in turn, and drops the declarations of the other ones.
+  static void link_used_udf_functions(const std::unique_ptr<llvm::Module>& udf_module,
+                                      llvm::Module& module,
+                                      CgenState* cgen_state);
+
   static bool prioritizeQuals(const RelAlgExecutionUnit& ra_exe_unit,
                               std::vector<Analyzer::Expr*>& primary_quals,
                               std::vector<Analyzer::Expr*>& deferred_quals);
@@ -130,6 +143,12 @@ class CodeGenerator {
   };
 
  private:
+  // Generates IR value(s) for the given analyzer expression, ignoring the values
+  // already generated for equal expressions.
+  std::vector<llvm::Value*> codegenExpr(const Analyzer::Expr*,
+                                        const bool fetch_columns,
+                                        const CompilationOptions&);
+
   std::vector<llvm::Value*> codegen(const Analyzer::Constant*,
                                     const EncodingType enc_type,
                                     const int dict_id,
@@ -363,6 +382,14 @@ class CodeGenerator {
                                                        const SQLTypeInfo&,
                                                        const DatetruncField&);
 
+  // Range of a date or timestamp operand according to the fragment metadata, if known.
+  std::optional<std::pair<int64_t, int64_t>> getDateTimeOperandRange(
+      const Analyzer::Expr*);
+
+  // Folds the extraction to a constant, or to a day count, when the operand range is
+  // narrow enough; nullptr otherwise.
+  llvm::Value* codegenExtractFromRange(llvm::Value*, const Analyzer::ExtractExpr*);
+
   llvm::Value* codegenCmpDecimalConst(const SQLOps,
                                       const SQLQualifier,
                                       const Analyzer::Expr*,
@@ -424,8 +451,13 @@ class CodeGenerator {
       const Analyzer::ColumnVar* rhs,
       const Analyzer::BinOper* tautological_eq) const;
 
-  std::unique_ptr<InValuesBitmap> createInValuesBitmap(const Analyzer::InValues*,
-                                                       const CompilationOptions&);
+  // Probes a bitmap or a hash set of the IN list values, nullptr if the list is short
+  // or has values other than constants of the supported types.
+  llvm::Value* codegenInValuesSet(const Analyzer::InValues*,
+                                  std::vector<llvm::Value*> lhs_lvs,
+                                  const CompilationOptions&);
+
+  std::optional<std::vector<int64_t>> getInValuesKeys(const Analyzer::InValues*);
 
   bool checkExpressionRanges(const Analyzer::UOper*, int64_t, int64_t);
 
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompressedBitmap.h"
+
+#include <iterator>
+
+bool CompressedBitmap::add(const int64_t value) {
+  const auto encoded = encode(value);
+  const auto key = encoded >> 16;
+  if (last_container_idx_ >= keys_.size() || keys_[last_container_idx_] != key) {
+    last_container_idx_ = getContainerIndex(key);
+  }
+  if (containers_[last_container_idx_].add(static_cast<uint16_t>(encoded))) {
+    ++cardinality_;
+    return true;
+  }
+  return false;
+}
+
+bool CompressedBitmap::contains(const int64_t value) const {
+  const auto encoded = encode(value);
+  const auto it = container_index_.find(encoded >> 16);
+  if (it == container_index_.end()) {
+    return false;
+  }
+  return containers_[it->second].contains(static_cast<uint16_t>(encoded));
+}
+
+void CompressedBitmap::unionWith(const CompressedBitmap& other) {
+  if (other.empty() || &other == this) {
+    return;
+  }
+  for (size_t i = 0; i < other.keys_.size(); ++i) {
+    const auto old_container_count = containers_.size();
+    const auto idx = getContainerIndex(other.keys_[i]);
+    if (idx == old_container_count) {
+      containers_[idx] = other.containers_[i];
+    } else {
+      containers_[idx].unionWith(other.containers_[i]);
+    }
+  }
+  cardinality_ = 0;
+  for (const auto& container : containers_) {
+    cardinality_ += container.size();
+  }
+}
+
+uint32_t CompressedBitmap::getContainerIndex(const uint64_t key) {
+  const auto it_ok =
+      container_index_.emplace(key, static_cast<uint32_t>(containers_.size()));
+  if (it_ok.second) {
+    keys_.push_back(key);
+    containers_.emplace_back();
+  }
+  return it_ok.first->second;
+}
+
+bool CompressedBitmap::Container::add(const uint16_t low) {
+  if (bitmap_.empty()) {
+    const auto it = std::lower_bound(array_.begin(), array_.end(), low);
+    if (it != array_.end() && *it == low) {
+      return false;
+    }
+    if (array_.size() < kMaxArraySize) {
+      array_.insert(it, low);
+      ++cardinality_;
+      return true;
+    }
+    convertToBitmap();
+  }
+  auto& word = bitmap_[low >> 6];
+  const uint64_t mask = uint64_t(1) << (low & 63);
+  if (word & mask) {
+    return false;
+  }
+  word |= mask;
+  ++cardinality_;
+  return true;
+}
+
+bool CompressedBitmap::Container::contains(const uint16_t low) const {
+  if (bitmap_.empty()) {
+    return std::binary_search(array_.begin(), array_.end(), low);
+  }
+  return bitmap_[low >> 6] & (uint64_t(1) << (low & 63));
+}
+
+void CompressedBitmap::Container::unionWith(const Container& other) {
+  if (bitmap_.empty() && other.bitmap_.empty()) {
+    std::vector<uint16_t> merged;
+    merged.reserve(array_.size() + other.array_.size());
+    std::set_union(array_.begin(),
+                   array_.end(),
+                   other.array_.begin(),
+                   other.array_.end(),
+                   std::back_inserter(merged));
+    array_.swap(merged);
+    cardinality_ = array_.size();
+    if (array_.size() > kMaxArraySize) {
+      convertToBitmap();
+    }
+    return;
+  }
+  if (bitmap_.empty()) {
+    convertToBitmap();
+  }
+  if (other.bitmap_.empty()) {
+    for (const auto low : other.array_) {
+      add(low);
+    }
+    return;
+  }
+  cardinality_ = 0;
+  for (size_t i = 0; i < kBitmapWords; ++i) {
+    bitmap_[i] |= other.bitmap_[i];
+    cardinality_ += __builtin_popcountll(bitmap_[i]);
+  }
+}
+
+void CompressedBitmap::Container::convertToBitmap() {
+  bitmap_.assign(kBitmapWords, 0);
+  for (const auto low : array_) {
+    bitmap_[low >> 6] |= uint64_t(1) << (low & 63);
+  }
+  std::vector<uint16_t>().swap(array_);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    CompressedBitmap.h
+ * @brief   Roaring-style compressed bitmap of 64-bit integers.
+ *
+ * Values are split into a 48-bit key and a 16-bit low part. Every key owns a
+ * container which holds the low parts as a sorted array while it has at most
+ * kMaxArraySize values and as a dense 2^16 bit bitmap afterwards. Memory use
+ * therefore follows the number of values rather than their range, and unions
+ * of dense containers are plain word-wise ORs. Containers are found through a
+ * hash index, so inserting into very sparse bitmaps stays constant time.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+class CompressedBitmap {
+ public:
+  // Returns true if value was not in the bitmap before.
+  bool add(const int64_t value);
+
+  bool contains(const int64_t value) const;
+
+  size_t size() const { return cardinality_; }
+
+  bool empty() const { return cardinality_ == 0; }
+
+  // Adds all the values of other to this bitmap.
+  void unionWith(const CompressedBitmap& other);
+
+  // Calls func with every value, in ascending order.
+  template <typename FUNC>
+  void forEach(FUNC func) const {
+    std::vector<uint32_t> order(keys_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](const uint32_t lhs, const uint32_t rhs) {
+      return keys_[lhs] < keys_[rhs];
+    });
+    for (const auto idx : order) {
+      containers_[idx].forEach(keys_[idx] << 16, func);
+    }
+  }
+
+  static constexpr size_t kMaxArraySize{4096};
+
+ private:
+  static constexpr size_t kBitmapWords{(1 << 16) / 64};
+
+  class Container {
+   public:
+    bool add(const uint16_t low);
+
+    bool contains(const uint16_t low) const;
+
+    void unionWith(const Container& other);
+
+    size_t size() const { return cardinality_; }
+
+    template <typename FUNC>
+    void forEach(const uint64_t high, FUNC& func) const {
+      if (bitmap_.empty()) {
+        for (const auto low : array_) {
+          func(decode(high | low));
+        }
+        return;
+      }
+      for (size_t word_idx = 0; word_idx < kBitmapWords; ++word_idx) {
+        for (uint64_t word = bitmap_[word_idx]; word; word &= word - 1) {
+          func(decode(high | (word_idx << 6) | __builtin_ctzll(word)));
+        }
+      }
+    }
+
+   private:
+    void convertToBitmap();
+
+    std::vector<uint16_t> array_;   // sorted low parts, while bitmap_ is empty
+    std::vector<uint64_t> bitmap_;  // kBitmapWords words once converted
+    uint32_t cardinality_{0};
+  };
+
+  // Maps signed values to unsigned ones of the same order.
+  static uint64_t encode(const int64_t value) {
+    return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+  }
+
+  static int64_t decode(const uint64_t value) {
+    return static_cast<int64_t>(value ^ (uint64_t(1) << 63));
+  }
+
+  // Returns the index of the container for key, creating it if needed.
+  uint32_t getContainerIndex(const uint64_t key);
+
+  std::vector<uint64_t> keys_;  // keys_[i] is the key of containers_[i]
+  std::vector<Container> containers_;
+  std::unordered_map<uint64_t, uint32_t> container_index_;
+  size_t cardinality_{0};
+  uint32_t last_container_idx_{0};  // consecutive values usually share a container
+};
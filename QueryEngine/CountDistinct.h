@@ -25,15 +25,18 @@
 #ifndef QUERYENGINE_COUNTDISTINCT_H
 #define QUERYENGINE_COUNTDISTINCT_H
 
+#include "CompressedBitmap.h"
 #include "Descriptors/CountDistinctDescriptor.h"
 #include "HyperLogLog.h"
 
 #include <bitset>
-#include <set>
 #include <vector>
 
 using CountDistinctDescriptors = std::vector<CountDistinctDescriptor>;
 
+// Storage of CountDistinctImplType::StdSet targets.
+using CountDistinctSet = CompressedBitmap;
+
 inline size_t bitmap_set_size(const int8_t* bitmap, const size_t bitmap_byte_sz) {
   const auto bitmap_word_count = bitmap_byte_sz >> 3;
   const auto bitmap_rem_bytes = bitmap_byte_sz & 7;
@@ -94,7 +97,7 @@ inline int64_t count_distinct_set_size(
     return bitmap_set_size(set_vals, count_distinct_desc.bitmapSizeBytes());
   }
   CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
-  return reinterpret_cast<std::set<int64_t>*>(set_handle)->size();
+  return reinterpret_cast<CountDistinctSet*>(set_handle)->size();
 }
 
 inline void count_distinct_set_union(
@@ -143,10 +146,10 @@ inline void count_distinct_set_union(
     }
   } else {
     CHECK(old_count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
-    auto old_set = reinterpret_cast<std::set<int64_t>*>(old_set_handle);
-    auto new_set = reinterpret_cast<std::set<int64_t>*>(new_set_handle);
-    new_set->insert(old_set->begin(), old_set->end());
-    old_set->insert(new_set->begin(), new_set->end());
+    auto old_set = reinterpret_cast<CountDistinctSet*>(old_set_handle);
+    auto new_set = reinterpret_cast<CountDistinctSet*>(new_set_handle);
+    new_set->unionWith(*old_set);
+    *old_set = *new_set;
   }
 }
 
@@ -17,7 +17,10 @@
 #include "CodeGenerator.h"
 
 #include "DateTimeUtils.h"
+#include "DateTruncate.h"
 #include "Execute.h"
+#include "ExpressionRange.h"
+#include "ExtractFromTime.h"
 
 using namespace DateTimeUtils;
 
@@ -68,8 +71,88 @@ const char* get_extract_function_name(ExtractField field) {
   return "";
 }
 
+// The truncation within which the extracted field doesn't change.
+std::optional<DatetruncField> get_extract_bucket_field(const ExtractField field) {
+  switch (field) {
+    case kYEAR:
+      return dtYEAR;
+    case kQUARTER:
+      return dtQUARTER;
+    case kMONTH:
+      return dtMONTH;
+    case kDAY:
+    case kDOW:
+    case kISODOW:
+    case kDOY:
+      return dtDAY;
+    case kQUARTERDAY:
+      return dtQUARTERDAY;
+    case kHOUR:
+      return dtHOUR;
+    case kMINUTE:
+      return dtMINUTE;
+    case kWEEK:
+      return dtWEEK;
+    case kWEEK_SUNDAY:
+      return dtWEEK_SUNDAY;
+    case kWEEK_SATURDAY:
+      return dtWEEK_SATURDAY;
+    default:
+      return std::nullopt;
+  }
+}
+
 }  // namespace
 
+std::optional<std::pair<int64_t, int64_t>> CodeGenerator::getDateTimeOperandRange(
+    const Analyzer::Expr* expr) {
+  const auto& ti = expr->get_type_info();
+  if (!executor_ || !plan_state_ || plan_state_->query_infos_.empty() ||
+      (ti.get_type() != kTIMESTAMP && ti.get_type() != kDATE) ||
+      ti.is_high_precision_timestamp()) {
+    return std::nullopt;
+  }
+  const auto range = getExpressionRange(expr, plan_state_->query_infos_, executor());
+  if (range.getType() != ExpressionRangeType::Integer ||
+      range.getIntMin() > range.getIntMax()) {
+    return std::nullopt;
+  }
+  return std::make_pair(range.getIntMin(), range.getIntMax());
+}
+
+llvm::Value* CodeGenerator::codegenExtractFromRange(
+    llvm::Value* ts_lv,
+    const Analyzer::ExtractExpr* extract_expr) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto field = extract_expr->get_field();
+  const auto bucket_field = get_extract_bucket_field(field);
+  if (!bucket_field) {
+    return nullptr;
+  }
+  const auto ts_range = getDateTimeOperandRange(extract_expr->get_from_expr());
+  if (!ts_range) {
+    return nullptr;
+  }
+  const auto [ts_min, ts_max] = *ts_range;
+  if (DateTruncate(*bucket_field, ts_min) == DateTruncate(*bucket_field, ts_max)) {
+    return cgen_state_->llInt(ExtractFromTime(field, ts_min));
+  }
+  // Within a single month or year, the day of either is a division by the day length.
+  const auto period_field =
+      field == kDAY ? dtMONTH : field == kDOY ? dtYEAR : dtINVALID;
+  if (period_field != dtINVALID) {
+    const int64_t period_start = DateTruncate(period_field, ts_min);
+    if (period_start == DateTruncate(period_field, ts_max)) {
+      auto& ir_builder = cgen_state_->ir_builder_;
+      const auto days_lv = ir_builder.CreateSDiv(
+          ir_builder.CreateSub(ts_lv, cgen_state_->llInt(period_start)),
+          cgen_state_->llInt(kSecsPerDay));
+      return ir_builder.CreateAdd(days_lv, cgen_state_->llInt(int64_t(1)));
+    }
+  }
+  return nullptr;
+}
+
 llvm::Value* CodeGenerator::codegen(const Analyzer::ExtractExpr* extract_expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
@@ -131,10 +214,13 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::ExtractExpr* extract_expr,
       cgen_state_->ir_builder_.SetInsertPoint(null_check.cond_true_);
       cgen_state_->ir_builder_.CreateBr(extract_nullcheck_bb);
       cgen_state_->ir_builder_.SetInsertPoint(null_check.cond_false_);
-      auto extract_call =
-          cgen_state_->emitExternalCall(extract_fname,
-                                        get_int_type(64, cgen_state_->context_),
-                                        std::vector<llvm::Value*>{from_expr});
+      auto extract_call = codegenExtractFromRange(from_expr, extract_expr);
+      if (!extract_call) {
+        extract_call =
+            cgen_state_->emitExternalCall(extract_fname,
+                                          get_int_type(64, cgen_state_->context_),
+                                          std::vector<llvm::Value*>{from_expr});
+      }
       cgen_state_->ir_builder_.CreateBr(extract_nullcheck_bb);
 
       cgen_state_->ir_builder_.SetInsertPoint(extract_nullcheck_bb);
@@ -152,6 +238,9 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::ExtractExpr* extract_expr,
     CHECK(extract_nullcheck_value);
     return extract_nullcheck_value;
   } else {
+    if (auto extract_lv = codegenExtractFromRange(from_expr, extract_expr)) {
+      return extract_lv;
+    }
     return cgen_state_->emitExternalCall(extract_fname,
                                          get_int_type(64, cgen_state_->context_),
                                          std::vector<llvm::Value*>{from_expr});
@@ -243,9 +332,17 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::DatetruncExpr* datetrunc_exp
     nullcheck_codegen = std::make_unique<NullCheckCodegen>(
         cgen_state_, executor(), from_expr, datetrunc_expr_ti, "date_trunc_nullcheck");
   }
-  char const* const fname = datetrunc_fname_lookup.at(field);
-  auto ret = cgen_state_->emitExternalCall(
-      fname, get_int_type(64, cgen_state_->context_), {from_expr});
+  llvm::Value* ret{nullptr};
+  const auto ts_range = getDateTimeOperandRange(datetrunc_expr->get_from_expr());
+  if (ts_range && DateTruncate(field, ts_range->first) ==
+                      DateTruncate(field, ts_range->second)) {
+    // the metadata proves all the values fall into the same bucket
+    ret = cgen_state_->llInt(DateTruncate(field, ts_range->first));
+  } else {
+    char const* const fname = datetrunc_fname_lookup.at(field);
+    ret = cgen_state_->emitExternalCall(
+        fname, get_int_type(64, cgen_state_->context_), {from_expr});
+  }
   if (is_nullable) {
     ret = nullcheck_codegen->finalize(ll_int(NULL_BIGINT, cgen_state_->context_), ret);
   }
@@ -38,6 +38,8 @@ inline size_t bitmap_bits_to_bytes(const size_t bitmap_sz) {
   return bitmap_byte_sz;
 }
 
+// Bitmap is a dense bitmap (or HyperLogLog registers) over the value range, StdSet
+// a CountDistinctSet of the values, which is used for large and sparse ranges.
 enum class CountDistinctImplType { Invalid, Bitmap, StdSet };
 
 struct CountDistinctDescriptor {
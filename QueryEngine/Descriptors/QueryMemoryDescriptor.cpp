@@ -142,8 +142,37 @@ int8_t pick_baseline_key_width(const RelAlgExecutionUnit& ra_exe_unit,
   return compact_width;
 }
 
+// Dictionary encoded string columns are ordered in the heap by the sort ranks of their
+// dictionary; other string expressions can produce transient ids, which aren't ranked.
+// Ranking sorts the whole dictionary, like ResultSet::getDictionaryRanks only do it if
+// the dictionary isn't much bigger than the table, the rows are sorted afterwards
+// otherwise.
+bool can_rank_heap_key(const Analyzer::Expr* order_entry_expr,
+                       const std::vector<InputTableInfo>& query_infos,
+                       const Executor* executor) {
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(order_entry_expr);
+  const auto& oe_ti = order_entry_expr->get_type_info();
+  if (!col_var || !oe_ti.is_dict_encoded_string()) {
+    return false;
+  }
+  const auto table_info_it = std::find_if(
+      query_infos.begin(), query_infos.end(), [col_var](const InputTableInfo& info) {
+        return info.table_id == col_var->get_table_id();
+      });
+  if (table_info_it == query_infos.end()) {
+    return false;
+  }
+  const auto sdp = executor->getStringDictionaryProxy(
+      oe_ti.get_comp_param(), executor->getRowSetMemoryOwner(), true);
+  return sdp &&
+         sdp->storageEntryCount() <= 4 * table_info_it->info.getNumTuplesUpperBound() &&
+         sdp->getSortedRanks();
+}
+
 bool use_streaming_top_n(const RelAlgExecutionUnit& ra_exe_unit,
-                         const bool output_columnar) {
+                         const std::vector<InputTableInfo>& query_infos,
+                         const ExecutorDeviceType device_type,
+                         const Executor* executor) {
   if (g_cluster) {
     return false;  // TODO(miyu)
   }
@@ -157,24 +186,35 @@ bool use_streaming_top_n(const RelAlgExecutionUnit& ra_exe_unit,
     }
   }
 
-  // TODO: Allow streaming top n for columnar output
-  if (!output_columnar && ra_exe_unit.sort_info.order_entries.size() == 1 &&
-      ra_exe_unit.sort_info.limit &&
-      ra_exe_unit.sort_info.algorithm == SortAlgorithm::StreamingTopN) {
-    const auto only_order_entry = ra_exe_unit.sort_info.order_entries.front();
-    CHECK_GT(only_order_entry.tle_no, int(0));
-    CHECK_LE(static_cast<size_t>(only_order_entry.tle_no),
-             ra_exe_unit.target_exprs.size());
-    const auto order_entry_expr = ra_exe_unit.target_exprs[only_order_entry.tle_no - 1];
-    const auto n = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
-    if ((order_entry_expr->get_type_info().is_number() ||
-         order_entry_expr->get_type_info().is_time()) &&
-        n <= 100000) {  // TODO(miyu): relax?
-      return true;
+  const auto& sort_info = ra_exe_unit.sort_info;
+  if (sort_info.order_entries.empty() || !sort_info.limit ||
+      sort_info.algorithm != SortAlgorithm::StreamingTopN) {
+    return false;
+  }
+  const auto n = sort_info.offset + sort_info.limit;
+  if (n > 100000) {  // TODO(miyu): relax?
+    return false;
+  }
+  // The device heaps are merged by a single numeric key, heaps ordered by several keys
+  // or by strings are only kept on CPU.
+  if (sort_info.order_entries.size() > 1 && device_type != ExecutorDeviceType::CPU) {
+    return false;
+  }
+  for (const auto& order_entry : sort_info.order_entries) {
+    CHECK_GT(order_entry.tle_no, int(0));
+    CHECK_LE(static_cast<size_t>(order_entry.tle_no), ra_exe_unit.target_exprs.size());
+    const auto order_entry_expr = ra_exe_unit.target_exprs[order_entry.tle_no - 1];
+    const auto& oe_ti = order_entry_expr->get_type_info();
+    if (oe_ti.is_number() || oe_ti.is_time()) {
+      continue;
+    }
+    if (device_type != ExecutorDeviceType::CPU ||
+        !can_rank_heap_key(order_entry_expr, query_infos, executor)) {
+      return false;
     }
   }
 
-  return false;
+  return true;
 }
 
 }  // namespace
@@ -325,8 +365,11 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
     case QueryDescriptionType::Projection: {
       CHECK(!must_use_baseline_sort);
 
-      if (streaming_top_n_hint && use_streaming_top_n(ra_exe_unit, output_columnar)) {
+      if (streaming_top_n_hint &&
+          use_streaming_top_n(ra_exe_unit, query_infos, device_type, executor)) {
         streaming_top_n = true;
+        // the heaps keep their rows rowwise
+        output_columnar = false;
         entry_count = ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit;
       } else {
         if (ra_exe_unit.use_bump_allocator) {
@@ -375,10 +418,10 @@ std::unique_ptr<QueryMemoryDescriptor> QueryMemoryDescriptor::init(
 }
 
 namespace {
-bool anyOf(std::vector<Analyzer::Expr*> const& target_exprs, SQLAgg const agg_kind) {
-  return boost::algorithm::any_of(target_exprs, [agg_kind](Analyzer::Expr const* expr) {
+bool anyQuantile(std::vector<Analyzer::Expr*> const& target_exprs) {
+  return boost::algorithm::any_of(target_exprs, [](Analyzer::Expr const* expr) {
     auto const* const agg = dynamic_cast<Analyzer::AggExpr const*>(expr);
-    return agg && agg->get_aggtype() == agg_kind;
+    return agg && is_quantile_agg(agg->get_aggtype());
   });
 }
 }  // namespace
@@ -442,7 +485,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(
         output_columnar_ = output_columnar_hint &&
                            QueryMemoryDescriptor::countDescriptorsLogicallyEmpty(
                                count_distinct_descriptors_) &&
-                           !anyOf(ra_exe_unit.target_exprs, kAPPROX_MEDIAN);
+                           !anyQuantile(ra_exe_unit.target_exprs);
         break;
       case QueryDescriptionType::GroupByBaselineHash:
         output_columnar_ = output_columnar_hint;
@@ -451,7 +494,7 @@ QueryMemoryDescriptor::QueryMemoryDescriptor(
         output_columnar_ = output_columnar_hint &&
                            QueryMemoryDescriptor::countDescriptorsLogicallyEmpty(
                                count_distinct_descriptors_) &&
-                           !anyOf(ra_exe_unit.target_exprs, kAPPROX_MEDIAN);
+                           !anyQuantile(ra_exe_unit.target_exprs);
         break;
       default:
         output_columnar_ = false;
@@ -30,6 +30,7 @@
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
+#include "QueryEngine/CountDistinct.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "Shared/quantile.h"
 #include "StringDictionary/StringDictionaryProxy.h"
@@ -69,7 +70,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
         CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
   }
 
-  void addCountDistinctSet(std::set<int64_t>* count_distinct_set) {
+  void addCountDistinctSet(CountDistinctSet* count_distinct_set) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     count_distinct_sets_.push_back(count_distinct_set);
   }
@@ -186,7 +187,9 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     return string_dictionary_generations_;
   }
 
-  quantile::TDigest* nullTDigest();
+  quantile::TDigest* nullTDigest(double const q);
+
+  quantile::ExactQuantile* nullExactQuantile(double const q, bool const interpolate);
 
  private:
   struct CountDistinctBitmapBuffer {
@@ -196,7 +199,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   };
 
   std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
-  std::vector<std::set<int64_t>*> count_distinct_sets_;
+  std::vector<CountDistinctSet*> count_distinct_sets_;
   std::vector<int64_t*> group_by_buffers_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
@@ -207,6 +210,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   std::vector<void*> col_buffers_;
   std::vector<Data_Namespace::AbstractBuffer*> varlen_input_buffers_;
   std::vector<std::unique_ptr<quantile::TDigest>> t_digests_;
+  std::vector<std::unique_ptr<quantile::ExactQuantile>> exact_quantiles_;
 
   size_t arena_block_size_;  // for cloning
   std::unique_ptr<Arena> allocator_;
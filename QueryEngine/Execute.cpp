@@ -31,12 +31,14 @@
 #include "JoinHashTable/BaselineJoinHashTable.h"
 #include "JoinHashTable/OverlapsJoinHashTable.h"
 #include "JsonAccessors.h"
+#include "LiteralSpecializationTracker.h"
 #include "OutputBufferInitialization.h"
 #include "QueryEngine/QueryDispatchQueue.h"
 #include "QueryRewrite.h"
 #include "QueryTemplateGenerator.h"
 #include "ResultSetReductionJIT.h"
 #include "RuntimeFunctions.h"
+#include "ScalarExprVisitor.h"
 #include "SpeculativeTopN.h"
 
 #include "TableFunctions/TableFunctionCompilationContext.h"
@@ -97,6 +99,8 @@ size_t g_overlaps_max_table_size_bytes{1024 * 1024 * 1024};
 double g_overlaps_target_entries_per_bin{1.3};
 bool g_strip_join_covered_quals{false};
 size_t g_constrained_by_in_threshold{10};
+bool g_enable_group_key_packing{true};
+bool g_enable_eager_aggregation{false};
 size_t g_big_group_threshold{20000};
 bool g_enable_window_functions{true};
 bool g_enable_table_functions{false};
@@ -128,6 +132,9 @@ bool g_is_test_env{false};  // operating under a unit test environment. Currentl
 
 size_t g_approx_quantile_buffer{1000};
 size_t g_approx_quantile_centroids{300};
+size_t g_sorted_result_cache_size{0};  // number of sorted results kept for paging
+size_t g_sorted_result_cache_max_bytes{1UL << 30};  // memory held by the kept results
+size_t g_literal_specialization_threshold{0};  // executions before inlining literals
 
 extern bool g_cache_string_hash;
 
@@ -239,11 +246,19 @@ StringDictionaryProxy* RowSetMemoryOwner::getOrAddStringDictProxy(
   return lit_str_dict_proxy_.get();
 }
 
-quantile::TDigest* RowSetMemoryOwner::nullTDigest() {
+quantile::TDigest* RowSetMemoryOwner::nullTDigest(double const q) {
   std::lock_guard<std::mutex> lock(state_mutex_);
   return t_digests_
       .emplace_back(std::make_unique<quantile::TDigest>(
-          this, g_approx_quantile_buffer, g_approx_quantile_centroids))
+          q, this, g_approx_quantile_buffer, g_approx_quantile_centroids))
+      .get();
+}
+
+quantile::ExactQuantile* RowSetMemoryOwner::nullExactQuantile(double const q,
+                                                              bool const interpolate) {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  return exact_quantiles_
+      .emplace_back(std::make_unique<quantile::ExactQuantile>(q, interpolate))
       .get();
 }
 
@@ -1336,7 +1351,54 @@ RelAlgExecutionUnit replace_scan_limit(const RelAlgExecutionUnit& ra_exe_unit_in
           ra_exe_unit_in.query_hint,
           ra_exe_unit_in.use_bump_allocator,
           ra_exe_unit_in.union_all,
-          ra_exe_unit_in.query_state};
+          ra_exe_unit_in.query_state,
+          ra_exe_unit_in.use_baseline_groupby};
+}
+
+class InIntegerSetDetector : public ScalarExprVisitor<bool> {
+ protected:
+  bool visitInIntegerSet(const Analyzer::InIntegerSet*) const override { return true; }
+
+  bool aggregateResult(const bool& aggregate, const bool& next_result) const override {
+    return aggregate || next_result;
+  }
+};
+
+// Returns true if the kernel of the step can't be compiled without literal hoisting:
+// IN sets probed through a bitmap or a hash set, even empty ones which register
+// neither, and count distinct buffers on GPU.
+bool needs_hoisted_literals(const RelAlgExecutionUnit& ra_exe_unit,
+                            const QueryMemoryDescriptor& query_mem_desc,
+                            const CgenState& cgen_state,
+                            const ExecutorDeviceType device_type) {
+  if (!cgen_state.in_values_bitmaps_.empty() ||
+      !cgen_state.in_values_hash_sets_.empty()) {
+    return true;
+  }
+  if (device_type == ExecutorDeviceType::GPU) {
+    for (size_t i = 0; i < query_mem_desc.getCountDistinctDescriptorsSize(); ++i) {
+      if (query_mem_desc.getCountDistinctDescriptor(i).impl_type_ !=
+          CountDistinctImplType::Invalid) {
+        return true;
+      }
+    }
+  }
+  InIntegerSetDetector in_integer_set_detector;
+  const auto has_in_integer_set = [&in_integer_set_detector](const auto& exprs) {
+    return std::any_of(
+        exprs.begin(), exprs.end(), [&in_integer_set_detector](const auto& expr) {
+          return expr && in_integer_set_detector.visit(&*expr);
+        });
+  };
+  for (const auto& join_condition : ra_exe_unit.join_quals) {
+    if (has_in_integer_set(join_condition.quals)) {
+      return true;
+    }
+  }
+  return has_in_integer_set(ra_exe_unit.simple_quals) ||
+         has_in_integer_set(ra_exe_unit.quals) ||
+         has_in_integer_set(ra_exe_unit.groupby_exprs) ||
+         has_in_integer_set(ra_exe_unit.target_exprs);
 }
 
 }  // namespace
@@ -1359,6 +1421,8 @@ ResultSetPtr Executor::executeWorkUnit(size_t& max_groups_buffer_entry_guess,
     plan_state_.reset(nullptr);
     if (cgen_state_) {
       cgen_state_->in_values_bitmaps_.clear();
+      cgen_state_->in_values_hash_sets_.clear();
+      cgen_state_->top_n_sort_ranks_.clear();
     }
   };
 
@@ -1433,6 +1497,18 @@ ResultSetPtr Executor::executeWorkUnitImpl(
     max_groups_buffer_entry_guess = compute_buffer_entry_guess(query_infos);
   }
 
+  // Steps which keep running with the same literals get compiled with them inlined.
+  std::string literal_specialization_key;
+  bool specialize_literals{false};
+  if (g_literal_specialization_threshold && co.hoist_literals && !eo.just_explain &&
+      eo.executor_type == ExecutorType::Native) {
+    literal_specialization_key =
+        std::to_string(cat.getCurrentDB().dbId) + ";" +
+        (device_type == ExecutorDeviceType::GPU ? "GPU;" : "CPU;") +
+        ra_exec_unit_desc_for_caching(ra_exe_unit);
+    specialize_literals = LiteralSpecializationTracker::isHot(literal_specialization_key);
+  }
+
   int8_t crt_min_byte_width{get_min_byte_width()};
   do {
     SharedKernelContext shared_context(query_infos);
@@ -1455,7 +1531,7 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                            deleted_cols_map,
                                            column_fetcher,
                                            {device_type,
-                                            co.hoist_literals,
+                                            co.hoist_literals && !specialize_literals,
                                             co.opt_level,
                                             co.with_dynamic_watchdog,
                                             co.allow_lazy_fetch,
@@ -1466,6 +1542,15 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                            render_info,
                                            this);
         CHECK(query_mem_desc_owned);
+        if (specialize_literals) {
+          LiteralSpecializationTracker::recordSpecializedExecution();
+        } else if (!literal_specialization_key.empty()) {
+          LiteralSpecializationTracker::recordExecution(
+              literal_specialization_key,
+              !cgen_state_->getLiterals().empty() &&
+                  !needs_hoisted_literals(
+                      ra_exe_unit, *query_mem_desc_owned, *cgen_state_, device_type));
+        }
         crt_min_byte_width = query_comp_desc_owned->getMinByteWidth();
       } catch (CompilationRetryNoCompaction&) {
         crt_min_byte_width = MAX_BYTE_WIDTH_SUPPORTED;
@@ -1721,13 +1806,30 @@ void fill_entries_for_empty_input(std::vector<TargetInfo>& target_infos,
         continue;
       }
       if (count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet) {
-        auto count_distinct_set = new std::set<int64_t>();
+        auto count_distinct_set = new CountDistinctSet();
         CHECK(row_set_mem_owner);
         row_set_mem_owner->addCountDistinctSet(count_distinct_set);
         entry.push_back(reinterpret_cast<int64_t>(count_distinct_set));
         continue;
       }
     }
+    if (is_quantile_agg(agg_info.agg_kind)) {
+      // The slot holds the state of the quantile, an empty one reads as NULL.
+      const auto executor = query_mem_desc.getExecutor();
+      CHECK(executor);
+      auto row_set_mem_owner = executor->getRowSetMemoryOwner();
+      CHECK(row_set_mem_owner);
+      const auto q_expr =
+          static_cast<const Analyzer::AggExpr*>(target_expr)->get_error_rate();
+      CHECK(q_expr);
+      const auto q = q_expr->get_constval().doubleval;
+      entry.push_back(
+          agg_info.agg_kind == kAPPROX_MEDIAN
+              ? reinterpret_cast<int64_t>(row_set_mem_owner->nullTDigest(q))
+              : reinterpret_cast<int64_t>(row_set_mem_owner->nullExactQuantile(
+                    q, agg_info.agg_kind == kPERCENTILE_CONT)));
+      continue;
+    }
     const bool float_argument_input = takes_float_argument(agg_info);
     if (agg_info.agg_kind == kCOUNT || agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
       entry.push_back(0);
@@ -2823,10 +2925,10 @@ int32_t Executor::executePlanWithoutGroupBy(
       for (int i = 0; i < num_iterations; i++) {
         int64_t val1;
         const bool float_argument_input = takes_float_argument(agg_info);
-        if (is_distinct_target(agg_info) || agg_info.agg_kind == kAPPROX_MEDIAN) {
+        if (is_distinct_target(agg_info) || is_quantile_agg(agg_info.agg_kind)) {
           CHECK(agg_info.agg_kind == kCOUNT ||
                 agg_info.agg_kind == kAPPROX_COUNT_DISTINCT ||
-                agg_info.agg_kind == kAPPROX_MEDIAN);
+                is_quantile_agg(agg_info.agg_kind));
           val1 = out_vec[out_vec_idx][0];
           error_code = 0;
         } else {
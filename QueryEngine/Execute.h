@@ -990,12 +990,19 @@ class Executor {
   class FetchCacheAnchor {
    public:
     FetchCacheAnchor(CgenState* cgen_state)
-        : cgen_state_(cgen_state), saved_fetch_cache(cgen_state_->fetch_cache_) {}
-    ~FetchCacheAnchor() { cgen_state_->fetch_cache_.swap(saved_fetch_cache); }
+        : cgen_state_(cgen_state)
+        , saved_fetch_cache(cgen_state_->fetch_cache_)
+        , saved_expr_cache_size(cgen_state_->expr_cache_.size()) {}
+    ~FetchCacheAnchor() {
+      cgen_state_->fetch_cache_.swap(saved_fetch_cache);
+      // expressions are only appended, drop the ones generated in this scope
+      cgen_state_->expr_cache_.resize(saved_expr_cache_size);
+    }
 
    private:
     CgenState* cgen_state_;
     std::unordered_map<int, std::vector<llvm::Value*>> saved_fetch_cache;
+    size_t saved_expr_cache_size;
   };
 
   llvm::Value* spillDoubleElement(llvm::Value* elem_val, llvm::Type* elem_ty);
@@ -1101,6 +1108,7 @@ class Executor {
   friend class QueryExecutionContext;
   friend class ResultSet;
   friend class InValuesBitmap;
+  friend class InValuesHashSet;
   friend class LeafAggregator;
   friend class PerfectJoinHashTable;
   friend class QueryRewriter;
@@ -58,6 +58,100 @@ bool need_to_hold_chunk(const Chunk_NS::Chunk* chunk,
   return false;
 }
 
+// First order key of a streaming top-n query on CPU if the chunk stats of the fragments
+// bound it, that is if it's an integer or timestamp column of the only table.
+const Analyzer::ColumnVar* get_top_n_fragment_key(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const ExecutorDeviceType device_type,
+    const ExecutorDispatchMode dispatch_mode) {
+  if (!query_mem_desc.useStreamingTopN() || device_type != ExecutorDeviceType::CPU ||
+      dispatch_mode != ExecutorDispatchMode::KernelPerFragment ||
+      ra_exe_unit.input_descs.size() != 1 || ra_exe_unit.union_all) {
+    return nullptr;
+  }
+  const auto& first_order_entry = ra_exe_unit.sort_info.order_entries.front();
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(
+      ra_exe_unit.target_exprs[first_order_entry.tle_no - 1]);
+  if (!col_var || dynamic_cast<const Analyzer::Var*>(col_var) ||
+      col_var->get_table_id() <= 0 || col_var->get_rte_idx() ||
+      col_var->get_table_id() != ra_exe_unit.input_descs[0].getTableId()) {
+    return nullptr;
+  }
+  const auto& col_ti = col_var->get_type_info();
+  return col_ti.is_integer() || col_ti.is_timestamp() ? col_var : nullptr;
+}
+
+// True if no row of the fragments can come before the threshold row.
+bool can_skip_top_n_fragments(
+    const Analyzer::ColumnVar* key,
+    const Analyzer::OrderEntry& order_entry,
+    const int64_t threshold,
+    const std::vector<size_t>& frag_ids,
+    const std::vector<Fragmenter_Namespace::FragmentInfo>& fragments) {
+  for (const auto frag_id : frag_ids) {
+    CHECK_LT(frag_id, fragments.size());
+    const auto& chunk_metadata_map = fragments[frag_id].getChunkMetadataMap();
+    const auto chunk_meta_it = chunk_metadata_map.find(key->get_column_id());
+    if (chunk_meta_it == chunk_metadata_map.end()) {
+      return false;
+    }
+    const auto& chunk_stats = chunk_meta_it->second->chunkStats;
+    if (chunk_stats.has_nulls && order_entry.nulls_first) {
+      return false;
+    }
+    const auto chunk_min = extract_min_stat(chunk_stats, key->get_type_info());
+    const auto chunk_max = extract_max_stat(chunk_stats, key->get_type_info());
+    if (chunk_min > chunk_max) {
+      return false;
+    }
+    if (order_entry.is_desc ? chunk_max >= threshold : chunk_min <= threshold) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Nth best value of the key over the rows of a kernel's heap, none if the heap isn't full
+// or its Nth row is null.
+std::optional<int64_t> get_top_n_threshold(const ResultSet& rows,
+                                           const RelAlgExecutionUnit& ra_exe_unit,
+                                           const Analyzer::ColumnVar* key) {
+  const auto& order_entry = ra_exe_unit.sort_info.order_entries.front();
+  const size_t key_idx = order_entry.tle_no - 1;
+  std::vector<bool> targets_to_skip(ra_exe_unit.target_exprs.size(), true);
+  targets_to_skip[key_idx] = false;
+  const auto null_val = inline_int_null_val(get_logical_type_info(key->get_type_info()));
+  size_t row_count{0};
+  std::optional<int64_t> threshold;
+  for (size_t i = 0; i < rows.entryCount(); ++i) {
+    if (rows.isRowAtEmpty(i)) {
+      continue;
+    }
+    ++row_count;
+    const auto row = rows.getRowAtNoTranslations(i, targets_to_skip);
+    CHECK_LT(key_idx, row.size());
+    const auto scalar_tv = boost::get<ScalarTargetValue>(&row[key_idx]);
+    CHECK(scalar_tv);
+    const auto val_ptr = boost::get<int64_t>(scalar_tv);
+    CHECK(val_ptr);
+    if (*val_ptr == null_val) {
+      if (!order_entry.nulls_first) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    if (!threshold || (order_entry.is_desc ? *val_ptr < *threshold
+                                           : *val_ptr > *threshold)) {
+      threshold = *val_ptr;
+    }
+  }
+  if (row_count < ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit) {
+    return std::nullopt;
+  }
+  return threshold;
+}
+
 }  // namespace
 
 const std::vector<uint64_t>& SharedKernelContext::getFragOffsets() {
@@ -87,6 +181,19 @@ SharedKernelContext::getFragmentResults() {
   return all_fragment_results_;
 }
 
+std::optional<int64_t> SharedKernelContext::getTopNThreshold() {
+  std::lock_guard<std::mutex> lock(top_n_threshold_mutex_);
+  return top_n_threshold_;
+}
+
+void SharedKernelContext::updateTopNThreshold(const int64_t value, const bool is_desc) {
+  std::lock_guard<std::mutex> lock(top_n_threshold_mutex_);
+  if (!top_n_threshold_ ||
+      (is_desc ? value > *top_n_threshold_ : value < *top_n_threshold_)) {
+    top_n_threshold_ = value;
+  }
+}
+
 void ExecutionKernel::run(Executor* executor, SharedKernelContext& shared_context) {
   DEBUG_TIMER("ExecutionKernel::run");
   INJECT_TIMER(kernel_run);
@@ -135,6 +242,24 @@ void ExecutionKernel::runImpl(Executor* executor, SharedKernelContext& shared_co
   auto catalog = executor->getCatalog();
   CHECK(catalog);
 
+  // The heap of each kernel keeps the best rows of its fragments, a fragment whose chunk
+  // stats are all worse than the Nth row found so far can't contribute to the result.
+  const auto top_n_key = get_top_n_fragment_key(
+      ra_exe_unit_, query_mem_desc, chosen_device_type, kernel_dispatch_mode);
+  if (top_n_key) {
+    const auto threshold = shared_context.getTopNThreshold();
+    if (threshold &&
+        can_skip_top_n_fragments(top_n_key,
+                                 ra_exe_unit_.sort_info.order_entries.front(),
+                                 *threshold,
+                                 outer_tab_frag_ids,
+                                 shared_context.getQueryInfos().front().info.fragments)) {
+      VLOG(1) << "Skipping fragments which can't enter the top "
+              << ra_exe_unit_.sort_info.offset + ra_exe_unit_.sort_info.limit;
+      return;
+    }
+  }
+
   // need to own them while query executes
   auto chunk_iterators_ptr = std::make_shared<std::list<ChunkIter>>();
   std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks;
@@ -331,5 +456,12 @@ void ExecutionKernel::runImpl(Executor* executor, SharedKernelContext& shared_co
   if (err) {
     throw QueryExecutionError(err);
   }
+  if (top_n_key && device_results_) {
+    const auto threshold = get_top_n_threshold(*device_results_, ra_exe_unit_, top_n_key);
+    if (threshold) {
+      shared_context.updateTopNThreshold(
+          *threshold, ra_exe_unit_.sort_info.order_entries.front().is_desc);
+    }
+  }
   shared_context.addDeviceResults(std::move(device_results_), outer_tab_frag_ids);
 }
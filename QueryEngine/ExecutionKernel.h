@@ -20,6 +20,8 @@
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
 
+#include <optional>
+
 class SharedKernelContext {
  public:
   SharedKernelContext(const std::vector<InputTableInfo>& query_infos)
@@ -34,6 +36,12 @@ class SharedKernelContext {
 
   const std::vector<InputTableInfo>& getQueryInfos() const { return query_infos_; }
 
+  // Value of the first order key of a streaming top-n query which the rows of a fragment
+  // have to beat, the Nth best over the kernels done so far.
+  std::optional<int64_t> getTopNThreshold();
+
+  void updateTopNThreshold(const int64_t value, const bool is_desc);
+
   std::atomic_flag dynamic_watchdog_set = ATOMIC_FLAG_INIT;
 
  private:
@@ -42,6 +50,8 @@ class SharedKernelContext {
 
   std::vector<uint64_t> all_frag_row_offsets_;
   std::mutex all_frag_row_offsets_mutex_;
+  std::optional<int64_t> top_n_threshold_;
+  std::mutex top_n_threshold_mutex_;
   const std::vector<InputTableInfo>& query_infos_;
   const QueryHint query_hint_;
 };
@@ -208,21 +208,59 @@ ExpressionRange ExpressionRange::operator/(const ExpressionRange& other) const {
       other.type_ != ExpressionRangeType::Integer) {
     return ExpressionRange::makeInvalidRange();
   }
-  if (other.int_min_ * other.int_max_ <= 0) {
-    // if the other interval contains 0, the rule is more complicated;
-    // punt for now, we can revisit by splitting the other interval and
-    // taking the convex hull of the resulting two intervals
-    return ExpressionRange::makeInvalidRange();
-  }
-  auto div_range = binOp<int64_t>(other, [](const int64_t x, const int64_t y) {
+  const auto div = [](const int64_t x, const int64_t y) {
     return int64_t(checked_int64_t(x) / y);
-  });
+  };
+  if (other.int_min_ <= 0 && other.int_max_ >= 0) {
+    // if the other interval contains 0, take the convex hull of the divisions by its
+    // negative and its positive parts; a division by 0 is an error or a null
+    if (other.int_min_ == 0 && other.int_max_ == 0) {
+      return ExpressionRange::makeInvalidRange();
+    }
+    auto div_range = ExpressionRange::makeInvalidRange();
+    for (const auto& part : {std::make_pair(other.int_min_, int64_t(-1)),
+                             std::make_pair(int64_t(1), other.int_max_)}) {
+      if (part.first > part.second) {
+        continue;
+      }
+      const auto part_range = binOp<int64_t>(
+          ExpressionRange::makeIntRange(part.first, part.second, 0, other.has_nulls_),
+          div);
+      if (part_range.getType() == ExpressionRangeType::Invalid) {
+        return part_range;
+      }
+      div_range = div_range.getType() == ExpressionRangeType::Invalid
+                      ? part_range
+                      : div_range || part_range;
+    }
+    div_range.setHasNulls();
+    return div_range;
+  }
+  auto div_range = binOp<int64_t>(other, div);
   if (g_null_div_by_zero) {
     div_range.setHasNulls();
   }
   return div_range;
 }
 
+ExpressionRange ExpressionRange::operator%(const ExpressionRange& other) const {
+  if (type_ != ExpressionRangeType::Integer ||
+      other.type_ != ExpressionRangeType::Integer) {
+    return ExpressionRange::makeInvalidRange();
+  }
+  if (other.int_min_ <= 0 && other.int_max_ >= 0) {
+    return ExpressionRange::makeInvalidRange();
+  }
+  // the remainder has the sign of the dividend and is smaller than the divisor
+  const int64_t rem_bound =
+      other.int_min_ > 0 ? other.int_max_ - 1 : -(other.int_min_ + 1);
+  return ExpressionRange::makeIntRange(
+      int_min_ >= 0 ? 0 : std::max(int_min_, -rem_bound),
+      int_max_ <= 0 ? 0 : std::min(int_max_, rem_bound),
+      0,
+      has_nulls_ || other.has_nulls_);
+}
+
 ExpressionRange ExpressionRange::operator||(const ExpressionRange& other) const {
   if (type_ != other.type_) {
     return ExpressionRange::makeInvalidRange();
@@ -300,9 +338,11 @@ ExpressionRange getExpressionRange(
 
 ExpressionRange getExpressionRange(const Analyzer::LikeExpr* like_expr);
 
-ExpressionRange getExpressionRange(const Analyzer::CaseExpr* case_expr,
-                                   const std::vector<InputTableInfo>& query_infos,
-                                   const Executor*);
+ExpressionRange getExpressionRange(
+    const Analyzer::CaseExpr* case_expr,
+    const std::vector<InputTableInfo>& query_infos,
+    const Executor*,
+    boost::optional<std::list<std::shared_ptr<Analyzer::Expr>>> simple_quals);
 
 ExpressionRange getExpressionRange(
     const Analyzer::UOper* u_expr,
@@ -349,7 +389,7 @@ ExpressionRange getExpressionRange(
   }
   auto case_expr = dynamic_cast<const Analyzer::CaseExpr*>(expr);
   if (case_expr) {
-    return getExpressionRange(case_expr, query_infos, executor);
+    return getExpressionRange(case_expr, query_infos, executor, simple_quals);
   }
   auto u_expr = dynamic_cast<const Analyzer::UOper*>(expr);
   if (u_expr) {
@@ -363,6 +403,11 @@ ExpressionRange getExpressionRange(
   if (datetrunc_expr) {
     return getExpressionRange(datetrunc_expr, query_infos, executor, simple_quals);
   }
+  auto key_for_string_expr = dynamic_cast<const Analyzer::KeyForStringExpr*>(expr);
+  if (key_for_string_expr) {
+    return getExpressionRange(
+        key_for_string_expr->get_arg(), query_infos, executor, simple_quals);
+  }
   return ExpressionRange::makeInvalidRange();
 }
 
@@ -390,6 +435,12 @@ ExpressionRange getExpressionRange(
       return lhs - rhs;
     case kMULTIPLY:
       return lhs * rhs;
+    case kMODULO: {
+      if (!expr->get_type_info().is_integer()) {
+        break;
+      }
+      return lhs % rhs;
+    }
     case kDIVIDE: {
       const auto& lhs_type = expr->get_left_operand()->get_type_info();
       if (lhs_type.is_decimal() && lhs.getType() != ExpressionRangeType::Invalid) {
@@ -662,16 +713,18 @@ ExpressionRange getExpressionRange(const Analyzer::LikeExpr* like_expr) {
       arg_ti.get_notnull() ? 0 : inline_int_null_val(ti), 1, 0, false);
 }
 
-ExpressionRange getExpressionRange(const Analyzer::CaseExpr* case_expr,
-                                   const std::vector<InputTableInfo>& query_infos,
-                                   const Executor* executor) {
+ExpressionRange getExpressionRange(
+    const Analyzer::CaseExpr* case_expr,
+    const std::vector<InputTableInfo>& query_infos,
+    const Executor* executor,
+    boost::optional<std::list<std::shared_ptr<Analyzer::Expr>>> simple_quals) {
   const auto& expr_pair_list = case_expr->get_expr_pair_list();
   auto expr_range = ExpressionRange::makeInvalidRange();
   bool has_nulls = false;
   for (const auto& expr_pair : expr_pair_list) {
     CHECK_EQ(expr_pair.first->get_type_info().get_type(), kBOOLEAN);
     const auto crt_range =
-        getExpressionRange(expr_pair.second.get(), query_infos, executor);
+        getExpressionRange(expr_pair.second.get(), query_infos, executor, simple_quals);
     if (crt_range.getType() == ExpressionRangeType::Null) {
       has_nulls = true;
       continue;
@@ -693,7 +746,8 @@ ExpressionRange getExpressionRange(const Analyzer::CaseExpr* case_expr,
     expr_range.setHasNulls();
     return expr_range;
   }
-  return expr_range || getExpressionRange(else_expr, query_infos, executor);
+  return expr_range ||
+         getExpressionRange(else_expr, query_infos, executor, simple_quals);
 }
 
 namespace {
@@ -769,6 +823,22 @@ ExpressionRange getExpressionRange(
   if (u_expr->get_optype() == kUNNEST) {
     return getExpressionRange(u_expr->get_operand(), query_infos, executor, simple_quals);
   }
+  if (u_expr->get_optype() == kUMINUS) {
+    const auto arg_range =
+        getExpressionRange(u_expr->get_operand(), query_infos, executor, simple_quals);
+    switch (arg_range.getType()) {
+      case ExpressionRangeType::Integer:
+        return ExpressionRange::makeIntRange(0, 0, 0, false) - arg_range;
+      case ExpressionRangeType::Float:
+        return ExpressionRange::makeFloatRange(
+            -arg_range.getFpMax(), -arg_range.getFpMin(), arg_range.hasNulls());
+      case ExpressionRangeType::Double:
+        return ExpressionRange::makeDoubleRange(
+            -arg_range.getFpMax(), -arg_range.getFpMin(), arg_range.hasNulls());
+      default:
+        return ExpressionRange::makeInvalidRange();
+    }
+  }
   if (u_expr->get_optype() != kCAST) {
     return ExpressionRange::makeInvalidRange();
   }
@@ -855,17 +925,62 @@ ExpressionRange getExpressionRange(
   return ExpressionRange::makeInvalidRange();
 }
 
+namespace {
+
+// The truncation within which the extracted field grows with the time.
+std::optional<DatetruncField> get_extract_monotonic_period(const ExtractField field) {
+  switch (field) {
+    case kQUARTER:
+    case kMONTH:
+    case kDOY:
+      return dtYEAR;
+    case kDAY:
+      return dtMONTH;
+    case kDOW:
+      return dtWEEK_SUNDAY;
+    case kISODOW:
+      return dtWEEK;
+    case kQUARTERDAY:
+    case kHOUR:
+      return dtDAY;
+    case kMINUTE:
+      return dtHOUR;
+    case kSECOND:
+      return dtMINUTE;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
 ExpressionRange getExpressionRange(
     const Analyzer::ExtractExpr* extract_expr,
     const std::vector<InputTableInfo>& query_infos,
     const Executor* executor,
     boost::optional<std::list<std::shared_ptr<Analyzer::Expr>>> simple_quals) {
-  const int32_t extract_field{extract_expr->get_field()};
+  const auto extract_field = extract_expr->get_field();
   const auto arg_range = getExpressionRange(
       extract_expr->get_from_expr(), query_infos, executor, simple_quals);
   const bool has_nulls =
       arg_range.getType() == ExpressionRangeType::Invalid || arg_range.hasNulls();
   const auto& extract_expr_ti = extract_expr->get_from_expr()->get_type_info();
+  const auto period_field = get_extract_monotonic_period(extract_field);
+  if (period_field && arg_range.getType() == ExpressionRangeType::Integer &&
+      arg_range.getIntMin() <= arg_range.getIntMax()) {
+    const int64_t scale =
+        extract_expr_ti.is_high_precision_timestamp()
+            ? get_timestamp_precision_scale(extract_expr_ti.get_dimension())
+            : 1;
+    const int64_t ts_min = floor_div(arg_range.getIntMin(), scale);
+    const int64_t ts_max = floor_div(arg_range.getIntMax(), scale);
+    if (DateTruncate(*period_field, ts_min) == DateTruncate(*period_field, ts_max)) {
+      return ExpressionRange::makeIntRange(ExtractFromTime(extract_field, ts_min),
+                                           ExtractFromTime(extract_field, ts_max),
+                                           0,
+                                           arg_range.hasNulls());
+    }
+  }
   switch (extract_field) {
     case kYEAR: {
       if (arg_range.getType() == ExpressionRangeType::Invalid) {
@@ -134,6 +134,7 @@ class ExpressionRange {
   ExpressionRange operator-(const ExpressionRange& other) const;
   ExpressionRange operator*(const ExpressionRange& other) const;
   ExpressionRange operator/(const ExpressionRange& other) const;
+  ExpressionRange operator%(const ExpressionRange& other) const;
   ExpressionRange operator||(const ExpressionRange& other) const;
 
   bool operator==(const ExpressionRange& other) const;
@@ -996,3 +996,47 @@ const int get_max_rte_scan_table(
   }
   return ret;
 }
+
+namespace {
+
+class UnnestCollector : public ScalarExprVisitor<std::vector<const Analyzer::UOper*>> {
+ protected:
+  std::vector<const Analyzer::UOper*> visitUOper(
+      const Analyzer::UOper* uoper) const override {
+    if (uoper->get_optype() == kUNNEST) {
+      return {uoper};
+    }
+    return ScalarExprVisitor::visitUOper(uoper);
+  }
+
+  std::vector<const Analyzer::UOper*> aggregateResult(
+      const std::vector<const Analyzer::UOper*>& aggregate,
+      const std::vector<const Analyzer::UOper*>& next_result) const override {
+    auto result = aggregate;
+    result.insert(result.end(), next_result.begin(), next_result.end());
+    return result;
+  }
+};
+
+}  // namespace
+
+const Analyzer::Expr* get_unnest_array(const std::vector<Analyzer::Expr*>& target_exprs) {
+  const Analyzer::Expr* unnest_array{nullptr};
+  UnnestCollector unnest_collector;
+  for (const auto target_expr : target_exprs) {
+    for (const auto unnest : unnest_collector.visit(target_expr)) {
+      const auto array = unnest->get_operand();
+      if (unnest_array && !(*unnest_array == *array)) {
+        throw std::runtime_error(
+            "UNNEST of different arrays not supported in the same projection yet.");
+      }
+      unnest_array = array;
+    }
+  }
+  return unnest_array;
+}
+
+bool contains_unnest(const Analyzer::Expr* expr) {
+  UnnestCollector unnest_collector;
+  return !unnest_collector.visit(expr).empty();
+}
@@ -65,4 +65,11 @@ bool self_join_not_covered_by_left_deep_tree(const Analyzer::ColumnVar* lhs,
 const int get_max_rte_scan_table(
     std::unordered_map<int, llvm::Value*>& scan_idx_to_hash_pos);
 
+// Returns the array expanded by the UNNEST calls in the target expressions, or null if
+// there are none. All the calls must expand the same array, their elements go together.
+const Analyzer::Expr* get_unnest_array(const std::vector<Analyzer::Expr*>& target_exprs);
+
+// Returns true if the expression is or contains an UNNEST call.
+bool contains_unnest(const Analyzer::Expr* expr);
+
 #endif  // QUERYENGINE_EXPRESSIONREWRITE_H
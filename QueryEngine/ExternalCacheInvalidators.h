@@ -28,16 +28,22 @@
 #include "JoinHashTable/BaselineJoinHashTable.h"
 #include "JoinHashTable/OverlapsJoinHashTable.h"
 #include "JoinHashTable/PerfectJoinHashTable.h"
+#include "SortedResultCache.h"
 
-using UpdateTriggeredCacheInvalidator =
-    CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
+using UpdateTriggeredCacheInvalidator = CacheInvalidator<OverlapsJoinHashTable,
+                                                         BaselineJoinHashTable,
+                                                         PerfectJoinHashTable,
+                                                         SortedResultCache>;
 using DeleteTriggeredCacheInvalidator = UpdateTriggeredCacheInvalidator;
 
-// Note that this is functionally the same as the above two invalidators. The
+// Note that this is functionally the same as the above two invalidators. Sorted results
+// are included since they hold CPU memory which isn't managed by the buffer manager. The
 // JoinHashTableCacheInvalidator is a generic invalidator used during `clear_cpu` calls.
 // The above cache invalidators are specific invalidators called during update/delete and
 // will likely be extended in the future.
-using JoinHashTableCacheInvalidator =
-    CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
+using JoinHashTableCacheInvalidator = CacheInvalidator<OverlapsJoinHashTable,
+                                                       BaselineJoinHashTable,
+                                                       PerfectJoinHashTable,
+                                                       SortedResultCache>;
 
 #endif
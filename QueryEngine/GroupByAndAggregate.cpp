@@ -28,6 +28,7 @@
 #include "MaxwellCodegenPatch.h"
 #include "OutputBufferInitialization.h"
 #include "TargetExprBuilder.h"
+#include "TopKRuntime.h"
 
 #include "../CudaMgr/CudaMgr.h"
 #include "../Shared/checked_alloc.h"
@@ -186,6 +187,15 @@ ColRangeInfo GroupByAndAggregate::getColRangeInfo() {
   if (!ra_exe_unit_.groupby_exprs.front()) {
     return col_range_info;
   }
+  if (ra_exe_unit_.use_baseline_groupby &&
+      col_range_info.hash_type_ == QueryDescriptionType::GroupByPerfectHash) {
+    // a sparse packed key, see QueryRewriter::rewriteGroupByKeyPacking
+    return {QueryDescriptionType::GroupByBaselineHash,
+            col_range_info.min,
+            col_range_info.max,
+            0,
+            col_range_info.has_nulls};
+  }
   static const int64_t MAX_BUFFER_SIZE = 1 << 30;
   const int64_t col_count =
       ra_exe_unit_.groupby_exprs.size() + ra_exe_unit_.target_exprs.size();
@@ -573,6 +583,22 @@ void add_transient_string_literals_for_expression(
   }
 }
 
+// Returns true if the input cannot fill a dense bitmap of bitmap_sz_bits to more than
+// one value per 64-bit word. Every group would own such a mostly empty bitmap, so a
+// compressed bitmap is used instead.
+bool is_sparse_count_distinct_bitmap(const int64_t bitmap_sz_bits,
+                                     const std::vector<InputTableInfo>& query_infos) {
+  const int64_t MIN_SPARSE_BITMAP_BITS{int64_t(1) << 23};  // 1MB per group
+  if (bitmap_sz_bits < MIN_SPARSE_BITMAP_BITS) {
+    return false;
+  }
+  size_t max_tuple_count{0};
+  for (const auto& query_info : query_infos) {
+    max_tuple_count = std::max(max_tuple_count, query_info.info.getNumTuplesUpperBound());
+  }
+  return static_cast<int64_t>(max_tuple_count) < bitmap_sz_bits / 64;
+}
+
 }  // namespace
 
 void GroupByAndAggregate::addTransientStringLiterals(
@@ -630,6 +656,7 @@ CountDistinctDescriptors GroupByAndAggregate::initCountDistinctDescriptors() {
           arg_ti.is_fp() ? no_range_info : getExprRangeInfo(agg_expr->get_arg());
       CountDistinctImplType count_distinct_impl_type{CountDistinctImplType::StdSet};
       int64_t bitmap_sz_bits{0};
+      bool sparse_range{false};
       if (agg_info.agg_kind == kAPPROX_COUNT_DISTINCT) {
         const auto error_rate = agg_expr->get_error_rate();
         if (error_rate) {
@@ -659,6 +686,11 @@ CountDistinctDescriptors GroupByAndAggregate::initCountDistinctDescriptors() {
           const int64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000L};
           if (bitmap_sz_bits <= 0 || bitmap_sz_bits > MAX_BITMAP_BITS) {
             count_distinct_impl_type = CountDistinctImplType::StdSet;
+          } else if (device_type_ == ExecutorDeviceType::CPU &&
+                     !ra_exe_unit_.groupby_exprs.empty() &&
+                     is_sparse_count_distinct_bitmap(bitmap_sz_bits, query_infos_)) {
+            count_distinct_impl_type = CountDistinctImplType::StdSet;
+            sparse_range = true;
           }
         }
       }
@@ -668,7 +700,7 @@ CountDistinctDescriptors GroupByAndAggregate::initCountDistinctDescriptors() {
         count_distinct_impl_type = CountDistinctImplType::Bitmap;
       }
 
-      if (g_enable_watchdog && !(arg_range_info.isEmpty()) &&
+      if (g_enable_watchdog && !(arg_range_info.isEmpty()) && !sparse_range &&
           count_distinct_impl_type == CountDistinctImplType::StdSet) {
         throw WatchdogException("Cannot use a fast path for COUNT distinct");
       }
@@ -972,6 +1004,25 @@ bool GroupByAndAggregate::codegen(llvm::Value* filter_result,
                               false);
     filter_false = filter_cfg.cond_false_;
 
+    const auto unnest_array = get_unnest_array(ra_exe_unit_.target_exprs);
+    // the key of a group by an unnested array already loops over its elements
+    const bool unnested_by_group_key = std::any_of(
+        ra_exe_unit_.groupby_exprs.begin(),
+        ra_exe_unit_.groupby_exprs.end(),
+        [unnest_array](const std::shared_ptr<Analyzer::Expr>& groupby_expr) {
+          return unnest_array && is_unnest(groupby_expr.get()) &&
+                 *static_cast<const Analyzer::UOper*>(groupby_expr.get())
+                          ->get_operand() == *unnest_array;
+        });
+    if (unnest_array && !unnested_by_group_key) {
+      if (is_group_by &&
+          query_mem_desc.getQueryDescriptionType() != QueryDescriptionType::Projection) {
+        throw std::runtime_error(
+            "UNNEST not supported in the aggregates of a group by yet.");
+      }
+      codegenUnnestLoop(unnest_array, filter_cfg, co);
+    }
+
     if (is_group_by) {
       if (query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection &&
           !query_mem_desc.useStreamingTopN()) {
@@ -1069,6 +1120,63 @@ bool GroupByAndAggregate::codegen(llvm::Value* filter_result,
   return can_return_error;
 }
 
+// Loops over the elements of the unnested array of the row, the rest of the row function
+// runs for every element: a projection outputs a row for each of them and aggregates
+// accumulate them. The false edge of the filter goes back to the head of the loop.
+void GroupByAndAggregate::codegenUnnestLoop(const Analyzer::Expr* arr_expr,
+                                            DiamondCodegen& filter_cfg,
+                                            const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  auto cgen_state = executor_->cgen_state_.get();
+  CodeGenerator code_generator(executor_);
+  const auto arr_lv = code_generator.codegen(arr_expr, true, co).front();
+  auto preheader = LL_BUILDER.GetInsertBlock();
+  auto unnest_loop_head = llvm::BasicBlock::Create(LL_CONTEXT,
+                                                   "unnest_loop_head",
+                                                   cgen_state->current_func_,
+                                                   preheader->getNextNode());
+  filter_cfg.setFalseTarget(unnest_loop_head);
+  const auto i32_type = get_int_type(32, LL_CONTEXT);
+  auto array_idx_ptr = LL_BUILDER.CreateAlloca(i32_type);
+  LL_BUILDER.CreateStore(LL_INT(int32_t(0)), array_idx_ptr);
+  const auto& array_ti = arr_expr->get_type_info();
+  CHECK(array_ti.is_array());
+  const auto& elem_ti = array_ti.get_elem_type();
+  // zero for null arrays, fixed length ones included
+  auto array_len = cgen_state->emitExternalCall(
+      "array_size",
+      i32_type,
+      {arr_lv,
+       code_generator.posArg(arr_expr),
+       LL_INT(log2_bytes(elem_ti.get_logical_size()))});
+  LL_BUILDER.CreateBr(unnest_loop_head);
+  LL_BUILDER.SetInsertPoint(unnest_loop_head);
+  auto array_idx = LL_BUILDER.CreateLoad(array_idx_ptr);
+  auto bound_check =
+      LL_BUILDER.CreateICmp(llvm::ICmpInst::ICMP_SLT, array_idx, array_len);
+  auto unnest_loop_body =
+      llvm::BasicBlock::Create(LL_CONTEXT, "unnest_loop_body", cgen_state->current_func_);
+  LL_BUILDER.CreateCondBr(bound_check, unnest_loop_body, filter_cfg.orig_cond_false_);
+  LL_BUILDER.SetInsertPoint(unnest_loop_body);
+  LL_BUILDER.CreateStore(LL_BUILDER.CreateAdd(array_idx, LL_INT(int32_t(1))),
+                         array_idx_ptr);
+  auto array_at_fname = "array_at_" + numeric_type_name(elem_ti);
+  if (array_ti.get_size() < 0) {
+    if (array_ti.get_notnull()) {
+      array_at_fname = "notnull_" + array_at_fname;
+    }
+    array_at_fname = "varlen_" + array_at_fname;
+  }
+  const auto elem_type =
+      elem_ti.is_fp()
+          ? (elem_ti.get_type() == kDOUBLE ? llvm::Type::getDoubleTy(LL_CONTEXT)
+                                           : llvm::Type::getFloatTy(LL_CONTEXT))
+          : get_int_type(elem_ti.get_logical_size() * 8, LL_CONTEXT);
+  const auto elem_lv = cgen_state->emitExternalCall(
+      array_at_fname, elem_type, {arr_lv, code_generator.posArg(arr_expr), array_idx});
+  cgen_state->unnest_elements_.push_back({arr_expr, elem_lv});
+}
+
 llvm::Value* GroupByAndAggregate::codegenOutputSlot(
     llvm::Value* groups_buffer,
     const QueryMemoryDescriptor& query_mem_desc,
@@ -1087,7 +1195,15 @@ llvm::Value* GroupByAndAggregate::codegenOutputSlot(
                                     : query_mem_desc.getRowSize() / sizeof(int64_t);
   CodeGenerator code_generator(executor_);
   if (query_mem_desc.useStreamingTopN()) {
-    const auto& only_order_entry = ra_exe_unit_.sort_info.order_entries.front();
+    const auto& order_entries = ra_exe_unit_.sort_info.order_entries;
+    CHECK_GE(order_entries.front().tle_no, int(1));
+    if (order_entries.size() > 1 ||
+        ra_exe_unit_.target_exprs[order_entries.front().tle_no - 1]
+            ->get_type_info()
+            .is_string()) {
+      return codegenMultiKeyHeapSlot(groups_buffer, query_mem_desc, co, row_size_quad);
+    }
+    const auto& only_order_entry = order_entries.front();
     CHECK_GE(only_order_entry.tle_no, int(1));
     const size_t target_idx = only_order_entry.tle_no - 1;
     CHECK_LT(target_idx, ra_exe_unit_.target_exprs.size());
@@ -1161,6 +1277,102 @@ llvm::Value* GroupByAndAggregate::codegenOutputSlot(
   }
 }
 
+llvm::Value* GroupByAndAggregate::codegenMultiKeyHeapSlot(
+    llvm::Value* groups_buffer,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const CompilationOptions& co,
+    const int32_t row_size_quad) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  CHECK(co.device_type == ExecutorDeviceType::CPU);
+  CHECK(!query_mem_desc.didOutputColumnar());
+  const auto& order_entries = ra_exe_unit_.sort_info.order_entries;
+  const auto key_count = static_cast<int32_t>(order_entries.size());
+  auto i64_type = get_int_type(64, LL_CONTEXT);
+  // the descriptors are constants, see TopKRuntime.h; the keys are the current row's
+  auto key_descs = LL_BUILDER.CreateAlloca(
+      i64_type, LL_INT(static_cast<int32_t>(key_count * HEAP_KEY_DESC_WORDS)));
+  auto keys = LL_BUILDER.CreateAlloca(i64_type, LL_INT(key_count));
+  CodeGenerator code_generator(executor_);
+  int32_t key_idx{0};
+  for (const auto& order_entry : order_entries) {
+    CHECK_GE(order_entry.tle_no, int(1));
+    const size_t target_idx = order_entry.tle_no - 1;
+    CHECK_LT(target_idx, ra_exe_unit_.target_exprs.size());
+    const auto order_entry_expr = ra_exe_unit_.target_exprs[target_idx];
+    const auto& oe_ti = order_entry_expr->get_type_info();
+    const auto key_slot_idx =
+        get_heap_key_slot_index(ra_exe_unit_.target_exprs, target_idx);
+    const auto chosen_bytes =
+        static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(key_slot_idx));
+    CHECK(chosen_bytes == sizeof(int32_t) || chosen_bytes == sizeof(int64_t));
+    auto key_lv = executor_->cgen_state_->castToTypeIn(
+        code_generator.codegen(order_entry_expr, true, co).front(), chosen_bytes * 8);
+    int64_t flags{0};
+    int64_t null_key{0};
+    int64_t ranks{0};
+    int64_t rank_count{0};
+    if (oe_ti.is_fp()) {
+      flags |= HEAP_KEY_FP;
+      const double null_val = inline_fp_null_val(oe_ti);
+      std::memcpy(&null_key, &null_val, sizeof(null_key));
+      if (!key_lv->getType()->isDoubleTy()) {
+        key_lv = LL_BUILDER.CreateFPExt(key_lv, llvm::Type::getDoubleTy(LL_CONTEXT));
+      }
+      key_lv = LL_BUILDER.CreateBitCast(key_lv, i64_type);
+    } else {
+      null_key = inline_int_null_val(oe_ti);
+      if (oe_ti.is_string()) {
+        CHECK(oe_ti.is_dict_encoded_string());
+        const auto sdp = executor_->getStringDictionaryProxy(
+            oe_ti.get_comp_param(), row_set_mem_owner_, true);
+        CHECK(sdp);
+        auto sort_ranks = sdp->getSortedRanks();
+        CHECK(sort_ranks);
+        rank_count = sort_ranks->size();
+        ranks = reinterpret_cast<int64_t>(
+            executor_->cgen_state_->addTopNSortRanks(std::move(sort_ranks))->data());
+      }
+      key_lv = executor_->cgen_state_->castToTypeIn(key_lv, 64);
+    }
+    if (chosen_bytes == sizeof(int64_t)) {
+      flags |= HEAP_KEY_WIDE;
+    }
+    if (order_entry.is_desc) {
+      flags |= HEAP_KEY_DESC;
+    }
+    if (order_entry.nulls_first) {
+      flags |= HEAP_KEY_NULLS_FIRST;
+    }
+    if (!oe_ti.get_notnull()) {
+      flags |= HEAP_KEY_NULLABLE;
+    }
+    const std::vector<int64_t> key_desc{
+        static_cast<int64_t>(query_mem_desc.getColOffInBytes(key_slot_idx)),
+        flags,
+        null_key,
+        ranks,
+        rank_count};
+    CHECK_EQ(key_desc.size(), size_t(HEAP_KEY_DESC_WORDS));
+    for (size_t i = 0; i < key_desc.size(); ++i) {
+      LL_BUILDER.CreateStore(
+          LL_INT(key_desc[i]),
+          LL_BUILDER.CreateGEP(key_descs,
+                               LL_INT(static_cast<int32_t>(
+                                   key_idx * HEAP_KEY_DESC_WORDS + i))));
+    }
+    LL_BUILDER.CreateStore(key_lv, LL_BUILDER.CreateGEP(keys, LL_INT(key_idx)));
+    ++key_idx;
+  }
+  const uint32_t n = ra_exe_unit_.sort_info.offset + ra_exe_unit_.sort_info.limit;
+  return emitCall("get_bin_from_k_heap_multi_key",
+                  {groups_buffer,
+                   LL_INT(n),
+                   LL_INT(row_size_quad),
+                   key_descs,
+                   LL_INT(static_cast<uint32_t>(key_count)),
+                   keys});
+}
+
 std::tuple<llvm::Value*, llvm::Value*> GroupByAndAggregate::codegenGroupBy(
     const QueryMemoryDescriptor& query_mem_desc,
     const CompilationOptions& co,
@@ -1711,7 +1923,7 @@ void GroupByAndAggregate::codegenEstimator(
 }
 
 extern "C" void agg_count_distinct(int64_t* agg, const int64_t val) {
-  reinterpret_cast<std::set<int64_t>*>(*agg)->insert(val);
+  reinterpret_cast<CountDistinctSet*>(*agg)->add(val);
 }
 
 extern "C" void agg_count_distinct_skip_val(int64_t* agg,
@@ -1796,6 +2008,21 @@ void GroupByAndAggregate::codegenApproxMedian(const size_t target_idx,
                                               std::vector<llvm::Value*>& agg_args,
                                               const QueryMemoryDescriptor& query_mem_desc,
                                               const ExecutorDeviceType device_type) {
+  codegenQuantile("agg_approx_median", target_expr, agg_args, device_type);
+}
+
+void GroupByAndAggregate::codegenPercentile(const size_t target_idx,
+                                            const Analyzer::Expr* target_expr,
+                                            std::vector<llvm::Value*>& agg_args,
+                                            const QueryMemoryDescriptor& query_mem_desc,
+                                            const ExecutorDeviceType device_type) {
+  codegenQuantile("agg_percentile", target_expr, agg_args, device_type);
+}
+
+void GroupByAndAggregate::codegenQuantile(const std::string& agg_fname,
+                                          const Analyzer::Expr* target_expr,
+                                          std::vector<llvm::Value*>& agg_args,
+                                          const ExecutorDeviceType device_type) {
   if (device_type == ExecutorDeviceType::GPU) {
     throw QueryMustRunOnCpu();
   }
@@ -1812,8 +2039,8 @@ void GroupByAndAggregate::codegenApproxMedian(const size_t target_idx,
     auto* const skip_cond = arg_ti.is_fp()
                                 ? irb.CreateFCmpOEQ(agg_args.back(), null_value)
                                 : irb.CreateICmpEQ(agg_args.back(), null_value);
-    calc = llvm::BasicBlock::Create(cs->context_, "calc_approx_median");
-    skip = llvm::BasicBlock::Create(cs->context_, "skip_approx_median");
+    calc = llvm::BasicBlock::Create(cs->context_, "calc_" + agg_fname);
+    skip = llvm::BasicBlock::Create(cs->context_, "skip_" + agg_fname);
     irb.CreateCondBr(skip_cond, skip, calc);
     cs->current_func_->getBasicBlockList().push_back(calc);
     irb.SetInsertPoint(calc);
@@ -1822,7 +2049,7 @@ void GroupByAndAggregate::codegenApproxMedian(const size_t target_idx,
     auto const agg_info = get_target_info(target_expr, g_bigint_count);
     agg_args.back() = executor_->castToFP(agg_args.back(), arg_ti, agg_info.sql_type);
   }
-  emitCall("agg_approx_median", agg_args);
+  emitCall(agg_fname, agg_args);
   if (nullable) {
     irb.CreateBr(skip);
     cs->current_func_->getBasicBlockList().push_back(skip);
@@ -197,6 +197,13 @@ class GroupByAndAggregate {
                                  const CompilationOptions& co,
                                  DiamondCodegen& diamond_codegen);
 
+  // Streaming top-n slot of a projection ordered by several keys or by dictionary
+  // encoded strings; CPU only.
+  llvm::Value* codegenMultiKeyHeapSlot(llvm::Value* groups_buffer,
+                                       const QueryMemoryDescriptor& query_mem_desc,
+                                       const CompilationOptions& co,
+                                       const int32_t row_size_quad);
+
   std::tuple<llvm::Value*, llvm::Value*> codegenGroupBy(
       const QueryMemoryDescriptor& query_mem_desc,
       const CompilationOptions& co,
@@ -261,6 +268,10 @@ class GroupByAndAggregate {
       const size_t agg_out_off,
       const size_t target_idx);
 
+  void codegenUnnestLoop(const Analyzer::Expr* arr_expr,
+                         GroupByAndAggregate::DiamondCodegen& filter_cfg,
+                         const CompilationOptions& co);
+
   void codegenEstimator(std::stack<llvm::BasicBlock*>& array_loops,
                         GroupByAndAggregate::DiamondCodegen& diamond_codegen,
                         const QueryMemoryDescriptor& query_mem_desc,
@@ -278,6 +289,18 @@ class GroupByAndAggregate {
                            const QueryMemoryDescriptor& query_mem_desc,
                            const ExecutorDeviceType device_type);
 
+  void codegenPercentile(const size_t target_idx,
+                         const Analyzer::Expr* target_expr,
+                         std::vector<llvm::Value*>& agg_args,
+                         const QueryMemoryDescriptor& query_mem_desc,
+                         const ExecutorDeviceType device_type);
+
+  // Calls agg_fname with the argument cast to double unless it's null, CPU only.
+  void codegenQuantile(const std::string& agg_fname,
+                       const Analyzer::Expr* target_expr,
+                       std::vector<llvm::Value*>& agg_args,
+                       const ExecutorDeviceType device_type);
+
   llvm::Value* getAdditionalLiteral(const int32_t off);
 
   std::vector<llvm::Value*> codegenAggArg(const Analyzer::Expr* target_expr,
@@ -20,13 +20,68 @@
 #include "ExternalExecutor.h"
 #include "MaxwellCodegenPatch.h"
 #include "RelAlgTranslator.h"
+#include "WindowContext.h"
 
 // Driver methods for the IR generation.
 
+namespace {
+
+// Expressions whose values only depend on the row, worth generating once per row.
+// Columns and function calls have caches of their own.
+bool is_shareable_expr(const Analyzer::Expr* expr) {
+  if (const auto u_oper = dynamic_cast<const Analyzer::UOper*>(expr)) {
+    return u_oper->get_optype() != kUNNEST;
+  }
+  return dynamic_cast<const Analyzer::BinOper*>(expr) ||
+         dynamic_cast<const Analyzer::CaseExpr*>(expr) ||
+         dynamic_cast<const Analyzer::ExtractExpr*>(expr) ||
+         dynamic_cast<const Analyzer::DateaddExpr*>(expr) ||
+         dynamic_cast<const Analyzer::DatediffExpr*>(expr) ||
+         dynamic_cast<const Analyzer::DatetruncExpr*>(expr) ||
+         dynamic_cast<const Analyzer::CharLengthExpr*>(expr) ||
+         dynamic_cast<const Analyzer::KeyForStringExpr*>(expr) ||
+         dynamic_cast<const Analyzer::LowerExpr*>(expr) ||
+         dynamic_cast<const Analyzer::CardinalityExpr*>(expr) ||
+         dynamic_cast<const Analyzer::LikeExpr*>(expr) ||
+         dynamic_cast<const Analyzer::RegexpExpr*>(expr) ||
+         dynamic_cast<const Analyzer::InValues*>(expr) ||
+         dynamic_cast<const Analyzer::InIntegerSet*>(expr);
+}
+
+}  // namespace
+
 std::vector<llvm::Value*> CodeGenerator::codegen(const Analyzer::Expr* expr,
                                                  const bool fetch_columns,
                                                  const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
+  if (!executor_ || !expr || !is_shareable_expr(expr) ||
+      WindowProjectNodeContext::getActiveWindowFunctionContext(executor_)) {
+    return codegenExpr(expr, fetch_columns, co);
+  }
+  // Equal subexpressions, in filters and targets alike, reuse the values generated for
+  // the first one still in scope. Scopes are delimited by FetchCacheAnchor, like for the
+  // fetched columns. Expression equality ignores the types of the operands, which the
+  // descriptions include.
+  for (const auto& cached_expr : cgen_state_->expr_cache_) {
+    if (cached_expr.fetch_columns != fetch_columns) {
+      continue;
+    }
+    if (cached_expr.expr == expr ||
+        (cached_expr.expr->get_type_info() == expr->get_type_info() &&
+         *cached_expr.expr == *expr &&
+         cached_expr.expr->toString() == expr->toString())) {
+      return cached_expr.lvs;
+    }
+  }
+  const auto expr_lvs = codegenExpr(expr, fetch_columns, co);
+  cgen_state_->expr_cache_.push_back({expr, fetch_columns, expr_lvs});
+  return expr_lvs;
+}
+
+std::vector<llvm::Value*> CodeGenerator::codegenExpr(const Analyzer::Expr* expr,
+                                                     const bool fetch_columns,
+                                                     const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
   if (!expr) {
     return {posArg(expr)};
   }
@@ -773,6 +828,7 @@ Executor::GroupColLLVMValue Executor::groupByColumnCodegen(
         array_at_fname,
         ar_ret_ty,
         {group_key, code_generator.posArg(arr_expr), array_idx});
+    cgen_state_->unnest_elements_.push_back({arr_expr, group_key});
     if (need_patch_unnest_double(
             elem_ti, isArchMaxwell(co.device_type), thread_mem_shared)) {
       key_to_cache = spillDoubleElement(group_key, ar_ret_ty);
@@ -81,6 +81,13 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
   if (bitmap_sz_bits > MAX_BITMAP_BITS) {
     throw FailedToCreateBitmap();
   }
+  // Past a few megabits, leave sparse sets to InValuesHashSet, which takes at most 256
+  // bits per value.
+  const int64_t MAX_SPARSE_BITMAP_BITS{8 * 1024 * 1024L};
+  if (bitmap_sz_bits > MAX_SPARSE_BITMAP_BITS &&
+      bitmap_sz_bits / 256 > static_cast<int64_t>(values.size())) {
+    throw FailedToCreateBitmap();
+  }
   const auto bitmap_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
   auto cpu_bitset = static_cast<int8_t*>(checked_calloc(bitmap_sz_bytes, 1));
   for (const auto value : values) {
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InValuesHashSet.h"
+#include "CodeGenerator.h"
+#include "Execute.h"
+#ifdef HAVE_CUDA
+#include "GpuMemUtils.h"
+#endif  // HAVE_CUDA
+#include "../Parser/ParserNode.h"
+#include "Logger/Logger.h"
+#include "InValuesHashSetInl.h"
+
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+// Smallest power of two number of slots which keeps the set at most half full.
+int64_t get_slot_count(const size_t key_count) {
+  int64_t slot_count{2};
+  while (static_cast<size_t>(slot_count) < 2 * key_count) {
+    slot_count *= 2;
+  }
+  return slot_count;
+}
+
+}  // namespace
+
+InValuesHashSet::InValuesHashSet(const std::vector<int64_t>& values,
+                                 const int64_t null_val,
+                                 const Data_Namespace::MemoryLevel memory_level,
+                                 const int device_count,
+                                 Data_Namespace::DataMgr* data_mgr)
+    : is_string_set_(false)
+    , rhs_has_null_(false)
+    , slot_count_(0)
+    , str_count_(0)
+    , null_val_(null_val)
+    , memory_level_(memory_level)
+    , device_count_(device_count)
+    , data_mgr_(data_mgr) {
+#ifdef HAVE_CUDA
+  CHECK(memory_level_ == Data_Namespace::CPU_LEVEL ||
+        memory_level == Data_Namespace::GPU_LEVEL);
+#else
+  CHECK_EQ(Data_Namespace::CPU_LEVEL, memory_level_);
+#endif  // HAVE_CUDA
+  size_t key_count{0};
+  for (const auto value : values) {
+    if (value == null_val) {
+      rhs_has_null_ = true;
+    } else {
+      ++key_count;
+    }
+  }
+  if (!key_count) {
+    return;
+  }
+  slot_count_ = get_slot_count(key_count);
+  cpu_buffer_.assign(slot_count_, null_val);
+  const uint64_t slot_mask = slot_count_ - 1;
+  for (const auto value : values) {
+    if (value == null_val) {
+      continue;
+    }
+    for (auto slot = in_values_int_hash(value) & slot_mask;;
+         slot = (slot + 1) & slot_mask) {
+      if (cpu_buffer_[slot] == null_val) {
+        cpu_buffer_[slot] = value;
+        break;
+      }
+      if (cpu_buffer_[slot] == value) {
+        break;
+      }
+    }
+  }
+  copyToDevices();
+}
+
+InValuesHashSet::InValuesHashSet(const std::vector<std::string>& values,
+                                 const bool rhs_has_null,
+                                 const Data_Namespace::MemoryLevel memory_level,
+                                 const int device_count,
+                                 Data_Namespace::DataMgr* data_mgr)
+    : is_string_set_(true)
+    , rhs_has_null_(rhs_has_null)
+    , slot_count_(0)
+    , str_count_(0)
+    , null_val_(0)
+    , memory_level_(memory_level)
+    , device_count_(device_count)
+    , data_mgr_(data_mgr) {
+#ifdef HAVE_CUDA
+  CHECK(memory_level_ == Data_Namespace::CPU_LEVEL ||
+        memory_level == Data_Namespace::GPU_LEVEL);
+#else
+  CHECK_EQ(Data_Namespace::CPU_LEVEL, memory_level_);
+#endif  // HAVE_CUDA
+  if (values.empty()) {
+    return;
+  }
+  slot_count_ = get_slot_count(values.size());
+  std::vector<int64_t> slots(slot_count_, -1);
+  std::vector<std::string_view> strings;
+  const uint64_t slot_mask = slot_count_ - 1;
+  for (const auto& value : values) {
+    for (auto slot = in_values_str_hash(value.data(), value.size()) & slot_mask;;
+         slot = (slot + 1) & slot_mask) {
+      if (slots[slot] < 0) {
+        slots[slot] = strings.size();
+        strings.emplace_back(value);
+        break;
+      }
+      if (strings[slots[slot]] == value) {
+        break;
+      }
+    }
+  }
+  str_count_ = strings.size();
+  size_t chars_size{0};
+  for (const auto& str : strings) {
+    chars_size += str.size();
+  }
+  // the slots, the offsets of the strings and their bytes, rounded up to 64-bit words
+  cpu_buffer_.resize(slot_count_ + str_count_ + 1 + (chars_size + 7) / 8);
+  std::copy(slots.begin(), slots.end(), cpu_buffer_.begin());
+  auto offsets = cpu_buffer_.data() + slot_count_;
+  auto chars = reinterpret_cast<char*>(offsets + str_count_ + 1);
+  int64_t offset{0};
+  for (int64_t i = 0; i < str_count_; ++i) {
+    offsets[i] = offset;
+    std::memcpy(chars + offset, strings[i].data(), strings[i].size());
+    offset += strings[i].size();
+  }
+  offsets[str_count_] = offset;
+  copyToDevices();
+}
+
+void InValuesHashSet::copyToDevices() {
+  const auto buffer_size = cpu_buffer_.size() * sizeof(int64_t);
+#ifdef HAVE_CUDA
+  if (memory_level_ == Data_Namespace::GPU_LEVEL) {
+    for (int device_id = 0; device_id < device_count_; ++device_id) {
+      gpu_buffers_.emplace_back(
+          CudaAllocator::allocGpuAbstractBuffer(data_mgr_, buffer_size, device_id));
+      auto gpu_buffer = gpu_buffers_.back()->getMemoryPtr();
+      copy_to_gpu(data_mgr_,
+                  reinterpret_cast<CUdeviceptr>(gpu_buffer),
+                  cpu_buffer_.data(),
+                  buffer_size,
+                  device_id);
+      buffers_.push_back(gpu_buffer);
+    }
+    std::vector<int64_t>().swap(cpu_buffer_);
+  } else {
+    buffers_.push_back(reinterpret_cast<int8_t*>(cpu_buffer_.data()));
+  }
+#else
+  CHECK_EQ(1, device_count_);
+  CHECK_GT(buffer_size, size_t(0));
+  buffers_.push_back(reinterpret_cast<int8_t*>(cpu_buffer_.data()));
+#endif  // HAVE_CUDA
+}
+
+InValuesHashSet::~InValuesHashSet() {
+  for (auto& gpu_buffer : gpu_buffers_) {
+    CHECK(data_mgr_);
+    data_mgr_->free(gpu_buffer);
+  }
+}
+
+llvm::Value* InValuesHashSet::codegen(const std::vector<llvm::Value*>& needle_lvs,
+                                      Executor* executor) const {
+  AUTOMATIC_IR_METADATA(executor->cgen_state_.get());
+  CHECK(!isEmpty());
+  std::vector<std::shared_ptr<const Analyzer::Constant>> constants_owned;
+  std::vector<const Analyzer::Constant*> constants;
+  for (const auto buffer : buffers_) {
+    const int64_t buffer_handle = reinterpret_cast<int64_t>(buffer);
+    const auto buffer_handle_literal = std::dynamic_pointer_cast<Analyzer::Constant>(
+        Parser::IntLiteral::analyzeValue(buffer_handle));
+    CHECK(buffer_handle_literal);
+    CHECK_EQ(kENCODING_NONE, buffer_handle_literal->get_type_info().get_compression());
+    constants_owned.push_back(buffer_handle_literal);
+    constants.push_back(buffer_handle_literal.get());
+  }
+  auto cgen_state = executor->cgen_state_.get();
+  CodeGenerator code_generator(executor);
+  const auto buffer_handle_lvs =
+      code_generator.codegenHoistedConstants(constants, kENCODING_NONE, 0);
+  CHECK_EQ(size_t(1), buffer_handle_lvs.size());
+  const auto buffer_handle_lv = cgen_state->castToTypeIn(buffer_handle_lvs.front(), 64);
+  const auto null_bool_val =
+      static_cast<int8_t>(inline_int_null_val(SQLTypeInfo(kBOOLEAN, false)));
+  // like a chain of equality comparisons, a miss is null if the list has a null
+  const auto not_found_val = rhs_has_null_ ? null_bool_val : int8_t(0);
+  if (is_string_set_) {
+    CHECK_EQ(size_t(2), needle_lvs.size());
+    return cgen_state->emitCall("str_hash_set_contains",
+                                {buffer_handle_lv,
+                                 cgen_state->llInt(slot_count_),
+                                 cgen_state->llInt(str_count_),
+                                 needle_lvs[0],
+                                 needle_lvs[1],
+                                 cgen_state->llInt(null_bool_val),
+                                 cgen_state->llInt(not_found_val)});
+  }
+  CHECK_EQ(size_t(1), needle_lvs.size());
+  return cgen_state->emitCall("int_hash_set_contains",
+                              {buffer_handle_lv,
+                               cgen_state->castToTypeIn(needle_lvs.front(), 64),
+                               cgen_state->llInt(slot_count_),
+                               cgen_state->llInt(null_val_),
+                               cgen_state->llInt(null_bool_val),
+                               cgen_state->llInt(not_found_val)});
+}
+
+bool InValuesHashSet::isEmpty() const {
+  return buffers_.empty();
+}
+
+bool InValuesHashSet::hasNull() const {
+  return rhs_has_null_;
+}
+
+int64_t InValuesHashSet::fpKey(const double value) {
+  const double normalized_value = value == 0 ? 0. : value;
+  int64_t key;
+  std::memcpy(&key, &normalized_value, sizeof(key));
+  return key;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    InValuesHashSet.h
+ * @brief   Open addressing hash set of IN list values, probed by the generated code.
+ *
+ * Used for the IN lists which InValuesBitmap can't cover: integers spread over a range
+ * much wider than their count, floating point values and none encoded strings. The set
+ * is a power of two number of 64-bit slots at most half full, probed linearly from the
+ * hash of the key (see InValuesHashSetInl.h). Integer keys are stored in the slots,
+ * with the null value of the type marking the empty ones; floating point values are
+ * keyed by the bit pattern of their double representation. For strings the slots hold
+ * indices into an offsets array which follows them, and the string bytes follow the
+ * offsets.
+ */
+
+#pragma once
+
+#include "../DataMgr/DataMgr.h"
+
+#include <llvm/IR/Value.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Executor;
+
+class InValuesHashSet {
+ public:
+  InValuesHashSet(const std::vector<int64_t>& values,
+                  const int64_t null_val,
+                  const Data_Namespace::MemoryLevel memory_level,
+                  const int device_count,
+                  Data_Namespace::DataMgr* data_mgr);
+  InValuesHashSet(const std::vector<std::string>& values,
+                  const bool rhs_has_null,
+                  const Data_Namespace::MemoryLevel memory_level,
+                  const int device_count,
+                  Data_Namespace::DataMgr* data_mgr);
+  ~InValuesHashSet();
+
+  // The needle is a 64-bit integer key for integer sets, a string pointer and length
+  // for string sets.
+  llvm::Value* codegen(const std::vector<llvm::Value*>& needle_lvs,
+                       Executor* executor) const;
+
+  bool isEmpty() const;
+
+  bool hasNull() const;
+
+  // Maps a floating point value to its key, zero and negative zero share theirs.
+  static int64_t fpKey(const double value);
+
+ private:
+  void copyToDevices();
+
+  std::vector<int64_t> cpu_buffer_;  // freed once copied to the GPUs
+  std::vector<Data_Namespace::AbstractBuffer*> gpu_buffers_;
+  std::vector<int8_t*> buffers_;
+  bool is_string_set_;
+  bool rhs_has_null_;
+  int64_t slot_count_;
+  int64_t str_count_;
+  const int64_t null_val_;
+  const Data_Namespace::MemoryLevel memory_level_;
+  const int device_count_;
+  Data_Namespace::DataMgr* data_mgr_;
+};
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "../Shared/funcannotations.h"
+#include "MurmurHash1Inl.h"
+
+// Hashes shared by InValuesHashSet and the probes of the generated code.
+
+FORCE_INLINE DEVICE uint64_t in_values_int_hash(const int64_t key) {
+  return MurmurHash64AImpl(&key, sizeof(key), 0);
+}
+
+// FNV-1a, strings aren't aligned and the GPU doesn't allow unaligned wide loads.
+FORCE_INLINE DEVICE uint64_t in_values_str_hash(const char* str, const int32_t len) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (int32_t i = 0; i < len; ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
@@ -17,6 +17,7 @@
 #include "CodeGenerator.h"
 #include "Execute.h"
 
+#include <cmath>
 #include <future>
 #include <memory>
 
@@ -39,16 +40,9 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::InValues* expr,
   }
   CHECK(result);
   if (co.hoist_literals) {  // TODO(alex): remove this constraint
-    auto in_vals_bitmap = createInValuesBitmap(expr, co);
-    if (in_vals_bitmap) {
-      if (in_vals_bitmap->isEmpty()) {
-        return in_vals_bitmap->hasNull()
-                   ? cgen_state_->inlineIntNull(SQLTypeInfo(kBOOLEAN, false))
-                   : result;
-      }
-      CHECK_EQ(size_t(1), lhs_lvs.size());
-      return cgen_state_->addInValuesBitmap(in_vals_bitmap)
-          ->codegen(lhs_lvs.front(), executor());
+    const auto in_vals_set_lv = codegenInValuesSet(expr, lhs_lvs, co);
+    if (in_vals_set_lv) {
+      return in_vals_set_lv;
     }
   }
   if (expr_ti.get_notnull()) {
@@ -85,13 +79,21 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::InIntegerSet* in_integer_set
         "IN subquery with many right-hand side values not supported when literal "
         "hoisting is disabled");
   }
-  auto in_vals_bitmap = std::make_unique<InValuesBitmap>(
-      in_integer_set->get_value_list(),
-      needle_null_val,
-      co.device_type == ExecutorDeviceType::GPU ? Data_Namespace::GPU_LEVEL
-                                                : Data_Namespace::CPU_LEVEL,
-      executor()->deviceCount(co.device_type),
-      &executor()->getCatalog()->getDataMgr());
+  const auto memory_level = co.device_type == ExecutorDeviceType::GPU
+                                ? Data_Namespace::GPU_LEVEL
+                                : Data_Namespace::CPU_LEVEL;
+  const auto device_count = executor()->deviceCount(co.device_type);
+  auto data_mgr = &executor()->getCatalog()->getDataMgr();
+  std::unique_ptr<InValuesBitmap> in_vals_bitmap;
+  try {
+    in_vals_bitmap = std::make_unique<InValuesBitmap>(in_integer_set->get_value_list(),
+                                                      needle_null_val,
+                                                      memory_level,
+                                                      device_count,
+                                                      data_mgr);
+  } catch (const FailedToCreateBitmap&) {
+    // too sparse for a bitmap, probe a hash set instead
+  }
   const auto& in_integer_set_ti = in_integer_set->get_type_info();
   CHECK(in_integer_set_ti.is_boolean());
   const auto lhs_lvs = codegen(in_arg, true, co);
@@ -104,102 +106,220 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::InIntegerSet* in_integer_set
   }
   CHECK(result);
   CHECK_EQ(size_t(1), lhs_lvs.size());
-  return cgen_state_->addInValuesBitmap(in_vals_bitmap)
-      ->codegen(lhs_lvs.front(), executor());
+  if (in_vals_bitmap) {
+    return cgen_state_->addInValuesBitmap(in_vals_bitmap)
+        ->codegen(lhs_lvs.front(), executor());
+  }
+  auto in_vals_hash_set =
+      std::make_unique<InValuesHashSet>(in_integer_set->get_value_list(),
+                                        needle_null_val,
+                                        memory_level,
+                                        device_count,
+                                        data_mgr);
+  if (in_vals_hash_set->isEmpty()) {
+    return in_vals_hash_set->hasNull()
+               ? cgen_state_->inlineIntNull(SQLTypeInfo(kBOOLEAN, false))
+               : result;
+  }
+  return cgen_state_->addInValuesHashSet(in_vals_hash_set)
+      ->codegen({lhs_lvs.front()}, executor());
 }
 
-std::unique_ptr<InValuesBitmap> CodeGenerator::createInValuesBitmap(
-    const Analyzer::InValues* in_values,
-    const CompilationOptions& co) {
+llvm::Value* CodeGenerator::codegenInValuesSet(const Analyzer::InValues* in_values,
+                                               std::vector<llvm::Value*> lhs_lvs,
+                                               const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
   const auto& value_list = in_values->get_value_list();
-  const auto val_count = value_list.size();
   const auto& ti = in_values->get_arg()->get_type_info();
-  if (!(ti.is_integer() || (ti.is_string() && ti.get_compression() == kENCODING_DICT))) {
+  if (value_list.size() <= 3) {
+    return nullptr;
+  }
+  const auto memory_level = co.device_type == ExecutorDeviceType::GPU
+                                ? Data_Namespace::GPU_LEVEL
+                                : Data_Namespace::CPU_LEVEL;
+  const auto device_count = executor()->deviceCount(co.device_type);
+  auto data_mgr = &executor()->getCatalog()->getDataMgr();
+  const auto null_bool_lv = cgen_state_->inlineIntNull(SQLTypeInfo(kBOOLEAN, false));
+  const auto false_lv =
+      in_values->get_type_info().get_notnull()
+          ? llvm::ConstantInt::get(llvm::IntegerType::getInt1Ty(cgen_state_->context_),
+                                   false)
+          : cgen_state_->llInt(int8_t(0));
+  if (ti.is_string() && ti.get_compression() == kENCODING_NONE) {
+    std::vector<std::string> values;
+    bool rhs_has_null{false};
+    for (const auto& in_val : value_list) {
+      const auto in_val_const =
+          dynamic_cast<const Analyzer::Constant*>(extract_cast_arg(in_val.get()));
+      if (!in_val_const) {
+        return nullptr;
+      }
+      if (in_val_const->get_is_null()) {
+        rhs_has_null = true;
+        continue;
+      }
+      values.push_back(*in_val_const->get_constval().stringval);
+    }
+    auto in_vals_hash_set = std::make_unique<InValuesHashSet>(
+        values, rhs_has_null, memory_level, device_count, data_mgr);
+    if (in_vals_hash_set->isEmpty()) {
+      return rhs_has_null ? null_bool_lv : false_lv;
+    }
+    // unpack pointer + length if necessary
+    if (lhs_lvs.size() != 3) {
+      CHECK_EQ(size_t(1), lhs_lvs.size());
+      lhs_lvs.push_back(cgen_state_->emitCall("extract_str_ptr", {lhs_lvs.front()}));
+      lhs_lvs.push_back(cgen_state_->emitCall("extract_str_len", {lhs_lvs.front()}));
+    }
+    return cgen_state_->addInValuesHashSet(in_vals_hash_set)
+        ->codegen({lhs_lvs[1], lhs_lvs[2]}, executor());
+  }
+  const auto keys = getInValuesKeys(in_values);
+  if (!keys) {
     return nullptr;
   }
+  CHECK_EQ(size_t(1), lhs_lvs.size());
+  if (ti.is_fp()) {
+    auto in_vals_hash_set =
+        std::make_unique<InValuesHashSet>(*keys,
+                                          InValuesHashSet::fpKey(inline_fp_null_val(ti)),
+                                          memory_level,
+                                          device_count,
+                                          data_mgr);
+    if (in_vals_hash_set->isEmpty()) {
+      return in_vals_hash_set->hasNull() ? null_bool_lv : false_lv;
+    }
+    // same key as InValuesHashSet::fpKey: adding zero turns negative zero into zero
+    auto needle_lv = lhs_lvs.front();
+    const auto double_ty = llvm::Type::getDoubleTy(cgen_state_->context_);
+    if (needle_lv->getType()->isFloatTy()) {
+      needle_lv = cgen_state_->ir_builder_.CreateFPExt(needle_lv, double_ty);
+    }
+    needle_lv = cgen_state_->ir_builder_.CreateFAdd(needle_lv,
+                                                    llvm::ConstantFP::get(double_ty, 0.));
+    needle_lv = cgen_state_->ir_builder_.CreateBitCast(
+        needle_lv, get_int_type(64, cgen_state_->context_));
+    return cgen_state_->addInValuesHashSet(in_vals_hash_set)
+        ->codegen({needle_lv}, executor());
+  }
+  const auto needle_null_val = inline_int_null_val(ti);
+  try {
+    auto in_vals_bitmap = std::make_unique<InValuesBitmap>(
+        *keys, needle_null_val, memory_level, device_count, data_mgr);
+    if (in_vals_bitmap->isEmpty()) {
+      return in_vals_bitmap->hasNull() ? null_bool_lv : false_lv;
+    }
+    return cgen_state_->addInValuesBitmap(in_vals_bitmap)
+        ->codegen(lhs_lvs.front(), executor());
+  } catch (const FailedToCreateBitmap&) {
+    // too sparse for a bitmap, probe a hash set instead
+  }
+  auto in_vals_hash_set = std::make_unique<InValuesHashSet>(
+      *keys, needle_null_val, memory_level, device_count, data_mgr);
+  CHECK(!in_vals_hash_set->isEmpty());
+  return cgen_state_->addInValuesHashSet(in_vals_hash_set)
+      ->codegen({lhs_lvs.front()}, executor());
+}
+
+std::optional<std::vector<int64_t>> CodeGenerator::getInValuesKeys(
+    const Analyzer::InValues* in_values) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto& value_list = in_values->get_value_list();
+  const auto val_count = value_list.size();
+  const auto& ti = in_values->get_arg()->get_type_info();
+  if (!(ti.is_integer() || ti.is_decimal() || ti.is_fp() ||
+        (ti.is_string() && ti.get_compression() == kENCODING_DICT))) {
+    return std::nullopt;
+  }
   const auto sdp =
       ti.is_string() ? executor()->getStringDictionaryProxy(
                            ti.get_comp_param(), executor()->getRowSetMemoryOwner(), true)
                      : nullptr;
-  if (val_count > 3) {
-    using ListIterator = decltype(value_list.begin());
-    std::vector<int64_t> values;
-    const auto needle_null_val = inline_int_null_val(ti);
-    const int worker_count = val_count > 10000 ? cpu_threads() : int(1);
-    std::vector<std::vector<int64_t>> values_set(worker_count, std::vector<int64_t>());
-    std::vector<std::future<bool>> worker_threads;
-    auto start_it = value_list.begin();
-    for (size_t i = 0,
-                start_val = 0,
-                stride = (val_count + worker_count - 1) / worker_count;
-         i < val_count && start_val < val_count;
-         ++i, start_val += stride, std::advance(start_it, stride)) {
-      auto end_it = start_it;
-      std::advance(end_it, std::min(stride, val_count - start_val));
-      const auto do_work = [&](std::vector<int64_t>& out_vals,
-                               const ListIterator start,
-                               const ListIterator end) -> bool {
-        for (auto val_it = start; val_it != end; ++val_it) {
-          const auto& in_val = *val_it;
-          const auto in_val_const =
-              dynamic_cast<const Analyzer::Constant*>(extract_cast_arg(in_val.get()));
-          if (!in_val_const) {
+  using ListIterator = decltype(value_list.begin());
+  std::vector<int64_t> values;
+  const auto needle_null_val = ti.is_fp()
+                                   ? InValuesHashSet::fpKey(inline_fp_null_val(ti))
+                                   : inline_int_null_val(ti);
+  const int worker_count = val_count > 10000 ? cpu_threads() : int(1);
+  std::vector<std::vector<int64_t>> values_set(worker_count, std::vector<int64_t>());
+  std::vector<std::future<bool>> worker_threads;
+  auto start_it = value_list.begin();
+  for (size_t i = 0,
+              start_val = 0,
+              stride = (val_count + worker_count - 1) / worker_count;
+       i < val_count && start_val < val_count;
+       ++i, start_val += stride, std::advance(start_it, stride)) {
+    auto end_it = start_it;
+    std::advance(end_it, std::min(stride, val_count - start_val));
+    const auto do_work = [&](std::vector<int64_t>& out_vals,
+                             const ListIterator start,
+                             const ListIterator end) -> bool {
+      for (auto val_it = start; val_it != end; ++val_it) {
+        const auto& in_val = *val_it;
+        const auto in_val_const =
+            dynamic_cast<const Analyzer::Constant*>(extract_cast_arg(in_val.get()));
+        if (!in_val_const) {
+          return false;
+        }
+        const auto& in_val_ti = in_val->get_type_info();
+        CHECK(in_val_ti == ti || get_nullable_type_info(in_val_ti) == ti);
+        if (ti.is_string()) {
+          CHECK(sdp);
+          const auto string_id =
+              in_val_const->get_is_null()
+                  ? needle_null_val
+                  : sdp->getIdOfString(*in_val_const->get_constval().stringval);
+          if (string_id != StringDictionary::INVALID_STR_ID) {
+            out_vals.push_back(string_id);
+          }
+        } else if (ti.is_fp()) {
+          if (in_val_const->get_is_null()) {
+            out_vals.push_back(needle_null_val);
+            continue;
+          }
+          const auto& const_ti = in_val_const->get_type_info();
+          if (!const_ti.is_fp()) {
             return false;
           }
-          const auto& in_val_ti = in_val->get_type_info();
-          CHECK(in_val_ti == ti || get_nullable_type_info(in_val_ti) == ti);
-          if (ti.is_string()) {
-            CHECK(sdp);
-            const auto string_id =
-                in_val_const->get_is_null()
-                    ? needle_null_val
-                    : sdp->getIdOfString(*in_val_const->get_constval().stringval);
-            if (string_id != StringDictionary::INVALID_STR_ID) {
-              out_vals.push_back(string_id);
-            }
-          } else {
-            out_vals.push_back(CodeGenerator::codegenIntConst(in_val_const, cgen_state_)
-                                   ->getSExtValue());
+          const auto value = const_ti.get_type() == kFLOAT
+                                 ? in_val_const->get_constval().floatval
+                                 : in_val_const->get_constval().doubleval;
+          // NaN isn't equal to anything
+          if (!std::isnan(value)) {
+            out_vals.push_back(InValuesHashSet::fpKey(value));
           }
+        } else {
+          out_vals.push_back(
+              CodeGenerator::codegenIntConst(in_val_const, cgen_state_)->getSExtValue());
         }
-        return true;
-      };
-      if (worker_count > 1) {
-        worker_threads.push_back(std::async(
-            std::launch::async, do_work, std::ref(values_set[i]), start_it, end_it));
-      } else {
-        do_work(std::ref(values), start_it, end_it);
       }
-    }
-    bool success = true;
-    for (auto& worker : worker_threads) {
-      success &= worker.get();
-    }
-    if (!success) {
-      return nullptr;
-    }
+      return true;
+    };
     if (worker_count > 1) {
-      size_t total_val_count = 0;
-      for (auto& vals : values_set) {
-        total_val_count += vals.size();
-      }
-      values.reserve(total_val_count);
-      for (auto& vals : values_set) {
-        values.insert(values.end(), vals.begin(), vals.end());
+      worker_threads.push_back(std::async(
+          std::launch::async, do_work, std::ref(values_set[i]), start_it, end_it));
+    } else {
+      if (!do_work(std::ref(values), start_it, end_it)) {
+        return std::nullopt;
       }
     }
-    try {
-      return std::make_unique<InValuesBitmap>(values,
-                                              needle_null_val,
-                                              co.device_type == ExecutorDeviceType::GPU
-                                                  ? Data_Namespace::GPU_LEVEL
-                                                  : Data_Namespace::CPU_LEVEL,
-                                              executor()->deviceCount(co.device_type),
-                                              &executor()->getCatalog()->getDataMgr());
-    } catch (...) {
-      return nullptr;
+  }
+  bool success = true;
+  for (auto& worker : worker_threads) {
+    success &= worker.get();
+  }
+  if (!success) {
+    return std::nullopt;
+  }
+  if (worker_count > 1) {
+    size_t total_val_count = 0;
+    for (auto& vals : values_set) {
+      total_val_count += vals.size();
+    }
+    values.reserve(total_val_count);
+    for (auto& vals : values_set) {
+      values.insert(values.end(), vals.begin(), vals.end());
     }
   }
-  return nullptr;
+  return values;
 }
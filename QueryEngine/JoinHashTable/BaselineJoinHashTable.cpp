@@ -397,7 +397,6 @@ std::pair<size_t, size_t> BaselineJoinHashTable::approximateTupleCount(
                                 true,
                                 join_columns_gpu,
                                 join_column_types_gpu,
-                                nullptr,
                                 nullptr);
           const auto key_handler_gpu =
               transfer_flat_object_to_gpu(key_handler, allocator);
@@ -571,8 +570,7 @@ int BaselineJoinHashTable::initHashTableForDevice(
                             true,
                             &join_columns[0],
                             &join_column_types[0],
-                            &composite_key_info.sd_inner_proxy_per_key[0],
-                            &composite_key_info.sd_outer_proxy_per_key[0]);
+                            &composite_key_info.sd_translation_map_per_key[0]);
       err = builder.initHashTableOnCpu(&key_handler,
                                        composite_key_info,
                                        join_columns,
@@ -638,7 +636,6 @@ int BaselineJoinHashTable::initHashTableForDevice(
                                                true,
                                                join_columns_gpu,
                                                join_column_types_gpu,
-                                               nullptr,
                                                nullptr);
 
     err = builder.initHashTableOnGpu(&key_handler,
@@ -363,8 +363,7 @@ class BaselineJoinHashTableBuilder {
               join_columns,
               join_column_types,
               join_bucket_info,
-              composite_key_info.sd_inner_proxy_per_key,
-              composite_key_info.sd_outer_proxy_per_key,
+              composite_key_info.sd_translation_map_per_key,
               thread_count);
           break;
         }
@@ -379,8 +378,7 @@ class BaselineJoinHashTableBuilder {
               join_columns,
               join_column_types,
               join_bucket_info,
-              composite_key_info.sd_inner_proxy_per_key,
-              composite_key_info.sd_outer_proxy_per_key,
+              composite_key_info.sd_translation_map_per_key,
               thread_count);
           break;
         }
@@ -190,19 +190,20 @@ class PerfectJoinHashTableBuilder {
                                            0);
 
     auto cpu_hash_table_buff = reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer());
-    const StringDictionaryProxy* sd_inner_proxy{nullptr};
-    const StringDictionaryProxy* sd_outer_proxy{nullptr};
+    const int32_t* sd_translation_map{nullptr};
     const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
     if (ti.is_string() &&
         (outer_col && !(inner_col->get_comp_param() == outer_col->get_comp_param()))) {
       CHECK_EQ(kENCODING_DICT, ti.get_compression());
-      sd_inner_proxy =
+      const auto sd_inner_proxy =
           executor->getStringDictionaryProxy(inner_col->get_comp_param(), true);
       CHECK(sd_inner_proxy);
       CHECK(outer_col);
-      sd_outer_proxy =
+      const auto sd_outer_proxy =
           executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
       CHECK(sd_outer_proxy);
+      sd_translation_map = sd_inner_proxy->getTranslationMap(
+          sd_outer_proxy, outer_col->get_comp_param());
     }
     int thread_count = cpu_threads();
     std::vector<std::thread> init_cpu_buff_threads;
@@ -227,8 +228,7 @@ class PerfectJoinHashTableBuilder {
     for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
       init_cpu_buff_threads.emplace_back([hash_join_invalid_val,
                                           &join_column,
-                                          sd_inner_proxy,
-                                          sd_outer_proxy,
+                                          sd_translation_map,
                                           thread_idx,
                                           thread_count,
                                           &ti,
@@ -248,8 +248,7 @@ class PerfectJoinHashTableBuilder {
                                             is_bitwise_eq,
                                             col_range.getIntMax() + 1,
                                             get_join_column_type_kind(ti)},
-                                           sd_inner_proxy,
-                                           sd_outer_proxy,
+                                           sd_translation_map,
                                            thread_idx,
                                            thread_count,
                                            hash_entry_info.bucket_normalization);
@@ -289,18 +288,21 @@ class PerfectJoinHashTableBuilder {
                                            join_column.num_elems);
 
     auto cpu_hash_table_buff = reinterpret_cast<int32_t*>(hash_table_->getCpuBuffer());
-    const StringDictionaryProxy* sd_inner_proxy{nullptr};
-    const StringDictionaryProxy* sd_outer_proxy{nullptr};
+    const int32_t* sd_translation_map{nullptr};
     if (ti.is_string()) {
       CHECK_EQ(kENCODING_DICT, ti.get_compression());
-      sd_inner_proxy =
-          executor->getStringDictionaryProxy(inner_col->get_comp_param(), true);
-      CHECK(sd_inner_proxy);
       const auto outer_col = dynamic_cast<const Analyzer::ColumnVar*>(cols.second);
       CHECK(outer_col);
-      sd_outer_proxy =
-          executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
-      CHECK(sd_outer_proxy);
+      if (inner_col->get_comp_param() != outer_col->get_comp_param()) {
+        const auto sd_inner_proxy =
+            executor->getStringDictionaryProxy(inner_col->get_comp_param(), true);
+        CHECK(sd_inner_proxy);
+        const auto sd_outer_proxy =
+            executor->getStringDictionaryProxy(outer_col->get_comp_param(), true);
+        CHECK(sd_outer_proxy);
+        sd_translation_map = sd_inner_proxy->getTranslationMap(
+            sd_outer_proxy, outer_col->get_comp_param());
+      }
     }
     int thread_count = cpu_threads();
     std::vector<std::future<void>> init_threads;
@@ -332,8 +334,7 @@ class PerfectJoinHashTableBuilder {
                                               is_bitwise_eq,
                                               col_range.getIntMax() + 1,
                                               get_join_column_type_kind(ti)},
-                                             sd_inner_proxy,
-                                             sd_outer_proxy,
+                                             sd_translation_map,
                                              thread_count);
     } else {
       fill_one_to_many_hash_table(cpu_hash_table_buff,
@@ -347,8 +348,7 @@ class PerfectJoinHashTableBuilder {
                                    is_bitwise_eq,
                                    col_range.getIntMax() + 1,
                                    get_join_column_type_kind(ti)},
-                                  sd_inner_proxy,
-                                  sd_outer_proxy,
+                                  sd_translation_map,
                                   thread_count);
     }
   }
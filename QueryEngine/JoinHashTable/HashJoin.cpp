@@ -319,8 +319,7 @@ CompositeKeyInfo HashJoin::getCompositeKeyInfo(
     const std::vector<InnerOuter>& inner_outer_pairs,
     const Executor* executor) {
   CHECK(executor);
-  std::vector<const void*> sd_inner_proxy_per_key;
-  std::vector<const void*> sd_outer_proxy_per_key;
+  std::vector<const int32_t*> sd_translation_map_per_key;
   std::vector<ChunkKey> cache_key_chunks;  // used for the cache key
   const auto db_id = executor->getCatalog()->getCurrentDB().dbId;
   for (const auto& inner_outer_pair : inner_outer_pairs) {
@@ -340,16 +339,15 @@ CompositeKeyInfo HashJoin::getCompositeKeyInfo(
       const auto sd_outer_proxy = executor->getStringDictionaryProxy(
           outer_ti.get_comp_param(), executor->getRowSetMemoryOwner(), true);
       CHECK(sd_inner_proxy && sd_outer_proxy);
-      sd_inner_proxy_per_key.push_back(sd_inner_proxy);
-      sd_outer_proxy_per_key.push_back(sd_outer_proxy);
+      sd_translation_map_per_key.push_back(
+          sd_inner_proxy->getTranslationMap(sd_outer_proxy, outer_ti.get_comp_param()));
       cache_key_chunks_for_column.push_back(sd_outer_proxy->getGeneration());
     } else {
-      sd_inner_proxy_per_key.emplace_back();
-      sd_outer_proxy_per_key.emplace_back();
+      sd_translation_map_per_key.emplace_back();
     }
     cache_key_chunks.push_back(cache_key_chunks_for_column);
   }
-  return {sd_inner_proxy_per_key, sd_outer_proxy_per_key, cache_key_chunks};
+  return {sd_translation_map_per_key, cache_key_chunks};
 }
 
 std::shared_ptr<Analyzer::ColumnVar> getSyntheticColumnVar(std::string_view table,
@@ -85,8 +85,8 @@ struct HashJoinMatchingSet {
 };
 
 struct CompositeKeyInfo {
-  std::vector<const void*> sd_inner_proxy_per_key;
-  std::vector<const void*> sd_outer_proxy_per_key;
+  // inner to outer dictionary id translation, null for keys which need none
+  std::vector<const int32_t*> sd_translation_map_per_key;
   std::vector<ChunkKey> cache_key_chunks;  // used for the cache key
 };
 
@@ -27,7 +27,6 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "StringDictionary/StringDictionary.h"
-#include "StringDictionary/StringDictionaryProxy.h"
 #endif
 
 #include <cmath>
@@ -41,8 +40,7 @@ struct GenericKeyHandler {
                     const JoinColumnTypeInfo* type_info_per_key
 #ifndef __CUDACC__
                     ,
-                    const void* const* sd_inner_proxy_per_key,
-                    const void* const* sd_outer_proxy_per_key
+                    const int32_t* const* sd_translation_map_per_key
 #endif
                     )
       : key_component_count_(key_component_count)
@@ -50,16 +48,10 @@ struct GenericKeyHandler {
       , join_column_per_key_(join_column_per_key)
       , type_info_per_key_(type_info_per_key) {
 #ifndef __CUDACC__
-    if (sd_inner_proxy_per_key) {
-      CHECK(sd_outer_proxy_per_key);
-      sd_inner_proxy_per_key_ = sd_inner_proxy_per_key;
-      sd_outer_proxy_per_key_ = sd_outer_proxy_per_key;
-    } else
+    sd_translation_map_per_key_ = sd_translation_map_per_key;
+#else
+    sd_translation_map_per_key_ = nullptr;
 #endif
-    {
-      sd_inner_proxy_per_key_ = nullptr;
-      sd_outer_proxy_per_key_ = nullptr;
-    }
   }
 
   template <typename T, typename KEY_BUFF_HANDLER>
@@ -77,20 +69,11 @@ struct GenericKeyHandler {
         break;
       }
 #ifndef __CUDACC__
-      const auto sd_inner_proxy = sd_inner_proxy_per_key_
-                                      ? sd_inner_proxy_per_key_[key_component_index]
-                                      : nullptr;
-      const auto sd_outer_proxy = sd_outer_proxy_per_key_
-                                      ? sd_outer_proxy_per_key_[key_component_index]
+      const auto sd_translation_map =
+          sd_translation_map_per_key_ ? sd_translation_map_per_key_[key_component_index]
                                       : nullptr;
-      if (sd_inner_proxy && elem != join_column_iterator.type_info->null_val) {
-        CHECK(sd_outer_proxy);
-        const auto sd_inner_dict_proxy =
-            static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-        const auto sd_outer_dict_proxy =
-            static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-        const auto elem_str = sd_inner_dict_proxy->getString(elem);
-        const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
+      if (sd_translation_map && elem != join_column_iterator.type_info->null_val) {
+        const auto outer_id = sd_translation_map[elem];
         if (outer_id == StringDictionary::INVALID_STR_ID) {
           skip_entry = true;
           break;
@@ -122,8 +105,7 @@ struct GenericKeyHandler {
   const bool should_skip_entries_;
   const JoinColumn* join_column_per_key_;
   const JoinColumnTypeInfo* type_info_per_key_;
-  const void* const* sd_inner_proxy_per_key_;
-  const void* const* sd_outer_proxy_per_key_;
+  const int32_t* const* sd_translation_map_per_key_;
 };
 
 struct OverlapsKeyHandler {
@@ -32,7 +32,6 @@
 #include "QueryEngine/RuntimeFunctions.h"
 #include "Shared/likely.h"
 #include "StringDictionary/StringDictionary.h"
-#include "StringDictionary/StringDictionaryProxy.h"
 
 #include <future>
 #endif
@@ -55,10 +54,11 @@ namespace {
  *
  * Given two tables t1 and t2, with t1 the outer table and t2 the inner table, and two
  * columns t1.x and t2.x, both dictionary encoded strings without a shared dictionary, we
- * read each value in t2.x and do a lookup in the dictionary for t1.x. If the lookup
- * returns a valid ID, we insert that ID into the hash table. Otherwise, we skip adding an
- * entry into the hash table for the inner column. We can also skip adding any entries
- * that are outside the range of the outer column.
+ * read each value in t2.x and look up its ID in the translation map from the dictionary
+ * of t2.x to the dictionary of t1.x, see StringDictionaryProxy::getTranslationMap(). If
+ * the lookup returns a valid ID, we insert that ID into the hash table. Otherwise, we
+ * skip adding an entry into the hash table for the inner column. We can also skip adding
+ * any entries that are outside the range of the outer column.
  *
  * Consider a join of the form SELECT x, n FROM (SELECT x, COUNT(*) n FROM t1 GROUP BY x
  * HAVING n > 10), t2 WHERE t1.x = t2.x; Let the result of the subquery be t1_s.
@@ -68,18 +68,13 @@ namespace {
  * ignore any element ID that is not in the dictionary corresponding to t1_s.x or is
  * outside the range of column t1_s.
  */
-inline int64_t translate_str_id_to_outer_dict(const int64_t elem,
-                                              const int64_t min_elem,
-                                              const int64_t max_elem,
-                                              const void* sd_inner_proxy,
-                                              const void* sd_outer_proxy) {
-  CHECK(sd_outer_proxy);
-  const auto sd_inner_dict_proxy =
-      static_cast<const StringDictionaryProxy*>(sd_inner_proxy);
-  const auto sd_outer_dict_proxy =
-      static_cast<const StringDictionaryProxy*>(sd_outer_proxy);
-  const auto elem_str = sd_inner_dict_proxy->getString(elem);
-  const auto outer_id = sd_outer_dict_proxy->getIdOfString(elem_str);
+inline int64_t translate_str_id_to_outer_dict(
+    const int64_t elem,
+    const int64_t min_elem,
+    const int64_t max_elem,
+    const int32_t* sd_translation_map) {
+  CHECK(sd_translation_map);
+  const auto outer_id = sd_translation_map[elem];
   if (outer_id > max_elem || outer_id < min_elem) {
     return StringDictionary::INVALID_STR_ID;
   }
@@ -122,8 +117,7 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
                                      const int32_t invalid_slot_val,
                                      const JoinColumn join_column,
                                      const JoinColumnTypeInfo type_info,
-                                     const void* sd_inner_proxy,
-                                     const void* sd_outer_proxy,
+                                     const int32_t* sd_translation_map,
                                      const int32_t cpu_thread_idx,
                                      const int32_t cpu_thread_count,
                                      SLOT_SELECTOR slot_sel) {
@@ -146,10 +140,13 @@ DEVICE auto fill_hash_join_buff_impl(int32_t* buff,
       }
     }
 #ifndef __CUDACC__
-    if (sd_inner_proxy &&
+    if (sd_translation_map &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id =
+          translate_str_id_to_outer_dict(elem,
+                                         type_info.min_val,
+                                         type_info.max_val,
+                                         sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -170,8 +167,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_bucketized)(int32_t* buff,
                                                   const int32_t invalid_slot_val,
                                                   const JoinColumn join_column,
                                                   const JoinColumnTypeInfo type_info,
-                                                  const void* sd_inner_proxy,
-                                                  const void* sd_outer_proxy,
+                                                  const int32_t* sd_translation_map,
                                                   const int32_t cpu_thread_idx,
                                                   const int32_t cpu_thread_count,
                                                   const int64_t bucket_normalization) {
@@ -183,8 +179,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_bucketized)(int32_t* buff,
                                   invalid_slot_val,
                                   join_column,
                                   type_info,
-                                  sd_inner_proxy,
-                                  sd_outer_proxy,
+                                  sd_translation_map,
                                   cpu_thread_idx,
                                   cpu_thread_count,
                                   slot_selector);
@@ -194,8 +189,7 @@ DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
                                        const int32_t invalid_slot_val,
                                        const JoinColumn join_column,
                                        const JoinColumnTypeInfo type_info,
-                                       const void* sd_inner_proxy,
-                                       const void* sd_outer_proxy,
+                                       const int32_t* sd_translation_map,
                                        const int32_t cpu_thread_idx,
                                        const int32_t cpu_thread_count) {
   auto slot_selector = [&](auto elem) {
@@ -205,8 +199,7 @@ DEVICE int SUFFIX(fill_hash_join_buff)(int32_t* buff,
                                   invalid_slot_val,
                                   join_column,
                                   type_info,
-                                  sd_inner_proxy,
-                                  sd_outer_proxy,
+                                  sd_translation_map,
                                   cpu_thread_idx,
                                   cpu_thread_count,
                                   slot_selector);
@@ -218,8 +211,7 @@ DEVICE int fill_hash_join_buff_sharded_impl(int32_t* buff,
                                             const JoinColumn join_column,
                                             const JoinColumnTypeInfo type_info,
                                             const ShardInfo shard_info,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
+                                            const int32_t* sd_translation_map,
                                             const int32_t cpu_thread_idx,
                                             const int32_t cpu_thread_count,
                                             SLOT_SELECTOR slot_sel) {
@@ -246,10 +238,13 @@ DEVICE int fill_hash_join_buff_sharded_impl(int32_t* buff,
       }
     }
 #ifndef __CUDACC__
-    if (sd_inner_proxy &&
+    if (sd_translation_map &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id =
+          translate_str_id_to_outer_dict(elem,
+                                         type_info.min_val,
+                                         type_info.max_val,
+                                         sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -272,8 +267,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded_bucketized)(
     const JoinColumn join_column,
     const JoinColumnTypeInfo type_info,
     const ShardInfo shard_info,
-    const void* sd_inner_proxy,
-    const void* sd_outer_proxy,
+    const int32_t* sd_translation_map,
     const int32_t cpu_thread_idx,
     const int32_t cpu_thread_count,
     const int64_t bucket_normalization) {
@@ -293,8 +287,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded_bucketized)(
                                           join_column,
                                           type_info,
                                           shard_info,
-                                          sd_inner_proxy,
-                                          sd_outer_proxy,
+                                          sd_translation_map,
                                           cpu_thread_idx,
                                           cpu_thread_count,
                                           slot_selector);
@@ -305,8 +298,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded)(int32_t* buff,
                                                const JoinColumn join_column,
                                                const JoinColumnTypeInfo type_info,
                                                const ShardInfo shard_info,
-                                               const void* sd_inner_proxy,
-                                               const void* sd_outer_proxy,
+                                               const int32_t* sd_translation_map,
                                                const int32_t cpu_thread_idx,
                                                const int32_t cpu_thread_count) {
   auto slot_selector = [&](auto elem, auto shard) {
@@ -323,8 +315,7 @@ DEVICE int SUFFIX(fill_hash_join_buff_sharded)(int32_t* buff,
                                           join_column,
                                           type_info,
                                           shard_info,
-                                          sd_inner_proxy,
-                                          sd_outer_proxy,
+                                          sd_translation_map,
                                           cpu_thread_idx,
                                           cpu_thread_count,
                                           slot_selector);
@@ -563,8 +554,7 @@ DEVICE void count_matches_impl(int32_t* count_buff,
                                const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
                                ,
-                               const void* sd_inner_proxy,
-                               const void* sd_outer_proxy,
+                               const int32_t* sd_translation_map,
                                const int32_t cpu_thread_idx,
                                const int32_t cpu_thread_count
 #endif
@@ -588,10 +578,13 @@ DEVICE void count_matches_impl(int32_t* count_buff,
       }
     }
 #ifndef __CUDACC__
-    if (sd_inner_proxy &&
+    if (sd_translation_map &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id =
+          translate_str_id_to_outer_dict(elem,
+                                         type_info.min_val,
+                                         type_info.max_val,
+                                         sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -611,8 +604,7 @@ GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
                                   const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
                                   ,
-                                  const void* sd_inner_proxy,
-                                  const void* sd_outer_proxy,
+                                  const int32_t* sd_translation_map,
                                   const int32_t cpu_thread_idx,
                                   const int32_t cpu_thread_count
 #endif
@@ -626,8 +618,7 @@ GLOBAL void SUFFIX(count_matches)(int32_t* count_buff,
                      type_info
 #ifndef __CUDACC__
                      ,
-                     sd_inner_proxy,
-                     sd_outer_proxy,
+                     sd_translation_map,
                      cpu_thread_idx,
                      cpu_thread_count
 #endif
@@ -641,8 +632,7 @@ GLOBAL void SUFFIX(count_matches_bucketized)(int32_t* count_buff,
                                              const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
                                              ,
-                                             const void* sd_inner_proxy,
-                                             const void* sd_outer_proxy,
+                                             const int32_t* sd_translation_map,
                                              const int32_t cpu_thread_idx,
                                              const int32_t cpu_thread_count
 #endif
@@ -658,8 +648,7 @@ GLOBAL void SUFFIX(count_matches_bucketized)(int32_t* count_buff,
                      type_info
 #ifndef __CUDACC__
                      ,
-                     sd_inner_proxy,
-                     sd_outer_proxy,
+                     sd_translation_map,
                      cpu_thread_idx,
                      cpu_thread_count
 #endif
@@ -674,8 +663,7 @@ GLOBAL void SUFFIX(count_matches_sharded)(int32_t* count_buff,
                                           const ShardInfo shard_info
 #ifndef __CUDACC__
                                           ,
-                                          const void* sd_inner_proxy,
-                                          const void* sd_outer_proxy,
+                                          const int32_t* sd_translation_map,
                                           const int32_t cpu_thread_idx,
                                           const int32_t cpu_thread_count
 #endif
@@ -698,10 +686,13 @@ GLOBAL void SUFFIX(count_matches_sharded)(int32_t* count_buff,
       }
     }
 #ifndef __CUDACC__
-    if (sd_inner_proxy &&
+    if (sd_translation_map &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id =
+          translate_str_id_to_outer_dict(elem,
+                                         type_info.min_val,
+                                         type_info.max_val,
+                                         sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -804,8 +795,7 @@ DEVICE void fill_row_ids_impl(int32_t* buff,
                               const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
                               ,
-                              const void* sd_inner_proxy,
-                              const void* sd_outer_proxy,
+                              const int32_t* sd_translation_map,
                               const int32_t cpu_thread_idx,
                               const int32_t cpu_thread_count
 #endif
@@ -834,10 +824,13 @@ DEVICE void fill_row_ids_impl(int32_t* buff,
       }
     }
 #ifndef __CUDACC__
-    if (sd_inner_proxy &&
+    if (sd_translation_map &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id =
+          translate_str_id_to_outer_dict(elem,
+                                         type_info.min_val,
+                                         type_info.max_val,
+                                         sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -863,8 +856,7 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
                                  const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
                                  ,
-                                 const void* sd_inner_proxy,
-                                 const void* sd_outer_proxy,
+                                 const int32_t* sd_translation_map,
                                  const int32_t cpu_thread_idx,
                                  const int32_t cpu_thread_count
 #endif
@@ -880,8 +872,7 @@ GLOBAL void SUFFIX(fill_row_ids)(int32_t* buff,
                     type_info
 #ifndef __CUDACC__
                     ,
-                    sd_inner_proxy,
-                    sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -896,8 +887,7 @@ GLOBAL void SUFFIX(fill_row_ids_bucketized)(int32_t* buff,
                                             const JoinColumnTypeInfo type_info
 #ifndef __CUDACC__
                                             ,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
+                                            const int32_t* sd_translation_map,
                                             const int32_t cpu_thread_idx,
                                             const int32_t cpu_thread_count
 #endif
@@ -914,8 +904,7 @@ GLOBAL void SUFFIX(fill_row_ids_bucketized)(int32_t* buff,
                     type_info
 #ifndef __CUDACC__
                     ,
-                    sd_inner_proxy,
-                    sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -932,8 +921,7 @@ DEVICE void fill_row_ids_sharded_impl(int32_t* buff,
                                       const ShardInfo shard_info
 #ifndef __CUDACC__
                                       ,
-                                      const void* sd_inner_proxy,
-                                      const void* sd_outer_proxy,
+                                      const int32_t* sd_translation_map,
                                       const int32_t cpu_thread_idx,
                                       const int32_t cpu_thread_count
 #endif
@@ -963,10 +951,13 @@ DEVICE void fill_row_ids_sharded_impl(int32_t* buff,
       }
     }
 #ifndef __CUDACC__
-    if (sd_inner_proxy &&
+    if (sd_translation_map &&
         (!type_info.uses_bw_eq || elem != type_info.translated_null_val)) {
-      const auto outer_id = translate_str_id_to_outer_dict(
-          elem, type_info.min_val, type_info.max_val, sd_inner_proxy, sd_outer_proxy);
+      const auto outer_id =
+          translate_str_id_to_outer_dict(elem,
+                                         type_info.min_val,
+                                         type_info.max_val,
+                                         sd_translation_map);
       if (outer_id == StringDictionary::INVALID_STR_ID) {
         continue;
       }
@@ -993,8 +984,7 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
                                          const ShardInfo shard_info
 #ifndef __CUDACC__
                                          ,
-                                         const void* sd_inner_proxy,
-                                         const void* sd_outer_proxy,
+                                         const int32_t* sd_translation_map,
                                          const int32_t cpu_thread_idx,
                                          const int32_t cpu_thread_count
 #endif
@@ -1015,8 +1005,7 @@ GLOBAL void SUFFIX(fill_row_ids_sharded)(int32_t* buff,
                     type_info
 #ifndef __CUDACC__
                     ,
-                    sd_inner_proxy,
-                    sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -1032,8 +1021,7 @@ GLOBAL void SUFFIX(fill_row_ids_sharded_bucketized)(int32_t* buff,
                                                     const ShardInfo shard_info
 #ifndef __CUDACC__
                                                     ,
-                                                    const void* sd_inner_proxy,
-                                                    const void* sd_outer_proxy,
+                                                    const int32_t* sd_translation_map,
                                                     const int32_t cpu_thread_idx,
                                                     const int32_t cpu_thread_count
 #endif
@@ -1057,8 +1045,7 @@ GLOBAL void SUFFIX(fill_row_ids_sharded_bucketized)(int32_t* buff,
                     type_info
 #ifndef __CUDACC__
                     ,
-                    sd_inner_proxy,
-                    sd_outer_proxy,
+                    sd_translation_map,
                     cpu_thread_idx,
                     cpu_thread_count
 #endif
@@ -1322,8 +1309,7 @@ void fill_one_to_many_hash_table_impl(int32_t* buff,
                                       const int32_t invalid_slot_val,
                                       const JoinColumn& join_column,
                                       const JoinColumnTypeInfo& type_info,
-                                      const void* sd_inner_proxy,
-                                      const void* sd_outer_proxy,
+                                      const int32_t* sd_translation_map,
                                       const unsigned cpu_thread_count,
                                       COUNT_MATCHES_LAUNCH_FUNCTOR count_matches_func,
                                       FILL_ROW_IDS_LAUNCH_FUNCTOR fill_row_ids_func) {
@@ -1383,23 +1369,20 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                  const int32_t invalid_slot_val,
                                  const JoinColumn& join_column,
                                  const JoinColumnTypeInfo& type_info,
-                                 const void* sd_inner_proxy,
-                                 const void* sd_outer_proxy,
+                                 const int32_t* sd_translation_map,
                                  const unsigned cpu_thread_count) {
   auto launch_count_matches = [count_buff = buff + hash_entry_info.hash_entry_count,
                                invalid_slot_val,
                                &join_column,
                                &type_info,
-                               sd_inner_proxy,
-                               sd_outer_proxy](auto cpu_thread_idx,
+                               sd_translation_map](auto cpu_thread_idx,
                                                auto cpu_thread_count) {
     SUFFIX(count_matches)
     (count_buff,
      invalid_slot_val,
      join_column,
      type_info,
-     sd_inner_proxy,
-     sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count);
   };
@@ -1408,8 +1391,7 @@ void fill_one_to_many_hash_table(int32_t* buff,
                               invalid_slot_val,
                               &join_column,
                               &type_info,
-                              sd_inner_proxy,
-                              sd_outer_proxy](auto cpu_thread_idx,
+                              sd_translation_map](auto cpu_thread_idx,
                                               auto cpu_thread_count) {
     SUFFIX(fill_row_ids)
     (buff,
@@ -1417,8 +1399,7 @@ void fill_one_to_many_hash_table(int32_t* buff,
      invalid_slot_val,
      join_column,
      type_info,
-     sd_inner_proxy,
-     sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count);
   };
@@ -1428,8 +1409,7 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                    invalid_slot_val,
                                    join_column,
                                    type_info,
-                                   sd_inner_proxy,
-                                   sd_outer_proxy,
+                                   sd_translation_map,
                                    cpu_thread_count,
                                    launch_count_matches,
                                    launch_fill_row_ids);
@@ -1440,8 +1420,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                             const int32_t invalid_slot_val,
                                             const JoinColumn& join_column,
                                             const JoinColumnTypeInfo& type_info,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
+                                            const int32_t* sd_translation_map,
                                             const unsigned cpu_thread_count) {
   auto bucket_normalization = hash_entry_info.bucket_normalization;
   auto hash_entry_count = hash_entry_info.getNormalizedHashEntryCount();
@@ -1450,16 +1429,14 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                invalid_slot_val,
                                &join_column,
                                &type_info,
-                               sd_inner_proxy,
-                               sd_outer_proxy](auto cpu_thread_idx,
+                               sd_translation_map](auto cpu_thread_idx,
                                                auto cpu_thread_count) {
     SUFFIX(count_matches_bucketized)
     (count_buff,
      invalid_slot_val,
      join_column,
      type_info,
-     sd_inner_proxy,
-     sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count,
      bucket_normalization);
@@ -1470,8 +1447,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                               invalid_slot_val,
                               &join_column,
                               &type_info,
-                              sd_inner_proxy,
-                              sd_outer_proxy](auto cpu_thread_idx,
+                              sd_translation_map](auto cpu_thread_idx,
                                               auto cpu_thread_count) {
     SUFFIX(fill_row_ids_bucketized)
     (buff,
@@ -1479,8 +1455,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
      invalid_slot_val,
      join_column,
      type_info,
-     sd_inner_proxy,
-     sd_outer_proxy,
+     sd_translation_map,
      cpu_thread_idx,
      cpu_thread_count,
      bucket_normalization);
@@ -1491,8 +1466,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                    invalid_slot_val,
                                    join_column,
                                    type_info,
-                                   sd_inner_proxy,
-                                   sd_outer_proxy,
+                                   sd_translation_map,
                                    cpu_thread_count,
                                    launch_count_matches,
                                    launch_fill_row_ids);
@@ -1506,8 +1480,7 @@ void fill_one_to_many_hash_table_sharded_impl(
     const JoinColumn& join_column,
     const JoinColumnTypeInfo& type_info,
     const ShardInfo& shard_info,
-    const void* sd_inner_proxy,
-    const void* sd_outer_proxy,
+    const int32_t* sd_translation_map,
     const unsigned cpu_thread_count,
     COUNT_MATCHES_LAUNCH_FUNCTOR count_matches_launcher,
     FILL_ROW_IDS_LAUNCH_FUNCTOR fill_row_ids_launcher) {
@@ -1564,8 +1537,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                          const JoinColumn& join_column,
                                          const JoinColumnTypeInfo& type_info,
                                          const ShardInfo& shard_info,
-                                         const void* sd_inner_proxy,
-                                         const void* sd_outer_proxy,
+                                         const int32_t* sd_translation_map,
                                          const unsigned cpu_thread_count) {
   auto launch_count_matches = [count_buff = buff + hash_entry_count,
                                invalid_slot_val,
@@ -1574,8 +1546,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                &shard_info
 #ifndef __CUDACC__
                                ,
-                               sd_inner_proxy,
-                               sd_outer_proxy
+                               sd_translation_map
 #endif
   ](auto cpu_thread_idx, auto cpu_thread_count) {
     return SUFFIX(count_matches_sharded)(count_buff,
@@ -1585,8 +1556,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                          shard_info
 #ifndef __CUDACC__
                                          ,
-                                         sd_inner_proxy,
-                                         sd_outer_proxy,
+                                         sd_translation_map,
                                          cpu_thread_idx,
                                          cpu_thread_count
 #endif
@@ -1601,8 +1571,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                               &shard_info
 #ifndef __CUDACC__
                               ,
-                              sd_inner_proxy,
-                              sd_outer_proxy
+                              sd_translation_map
 #endif
   ](auto cpu_thread_idx, auto cpu_thread_count) {
     return SUFFIX(fill_row_ids_sharded)(buff,
@@ -1613,8 +1582,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                         shard_info
 #ifndef __CUDACC__
                                         ,
-                                        sd_inner_proxy,
-                                        sd_outer_proxy,
+                                        sd_translation_map,
                                         cpu_thread_idx,
                                         cpu_thread_count);
 #endif
@@ -1628,8 +1596,7 @@ void fill_one_to_many_hash_table_sharded(int32_t* buff,
                                            shard_info
 #ifndef __CUDACC__
                                            ,
-                                           sd_inner_proxy,
-                                           sd_outer_proxy,
+                                           sd_translation_map,
                                            cpu_thread_count
 #endif
                                            ,
@@ -1759,8 +1726,7 @@ void fill_one_to_many_baseline_hash_table(
     const std::vector<JoinColumn>& join_column_per_key,
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<JoinBucketInfo>& join_buckets_per_key,
-    const std::vector<const void*>& sd_inner_proxy_per_key,
-    const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const int32_t*>& sd_translation_map_per_key,
     const size_t cpu_thread_count) {
   int32_t* pos_buff = buff;
   int32_t* count_buff = buff + hash_entry_count;
@@ -1798,16 +1764,14 @@ void fill_one_to_many_baseline_hash_table(
            &hash_entry_count,
            &join_column_per_key,
            &type_info_per_key,
-           &sd_inner_proxy_per_key,
-           &sd_outer_proxy_per_key,
+           &sd_translation_map_per_key,
            cpu_thread_idx,
            cpu_thread_count] {
             const auto key_handler = GenericKeyHandler(key_component_count,
                                                        true,
                                                        &join_column_per_key[0],
                                                        &type_info_per_key[0],
-                                                       &sd_inner_proxy_per_key[0],
-                                                       &sd_outer_proxy_per_key[0]);
+                                                       &sd_translation_map_per_key[0]);
             count_matches_baseline(count_buff,
                                    composite_key_dict,
                                    hash_entry_count,
@@ -1882,8 +1846,7 @@ void fill_one_to_many_baseline_hash_table(
                                           key_component_count,
                                           &join_column_per_key,
                                           &type_info_per_key,
-                                          &sd_inner_proxy_per_key,
-                                          &sd_outer_proxy_per_key,
+                                          &sd_translation_map_per_key,
                                           cpu_thread_idx,
                                           cpu_thread_count] {
                                            const auto key_handler = GenericKeyHandler(
@@ -1891,8 +1854,7 @@ void fill_one_to_many_baseline_hash_table(
                                                true,
                                                &join_column_per_key[0],
                                                &type_info_per_key[0],
-                                               &sd_inner_proxy_per_key[0],
-                                               &sd_outer_proxy_per_key[0]);
+                                               &sd_translation_map_per_key[0]);
                                            SUFFIX(fill_row_ids_baseline)
                                            (buff,
                                             composite_key_dict,
@@ -1920,8 +1882,7 @@ void fill_one_to_many_baseline_hash_table_32(
     const std::vector<JoinColumn>& join_column_per_key,
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<JoinBucketInfo>& join_bucket_info,
-    const std::vector<const void*>& sd_inner_proxy_per_key,
-    const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const int32_t*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count) {
   fill_one_to_many_baseline_hash_table<int32_t>(buff,
                                                 composite_key_dict,
@@ -1931,8 +1892,7 @@ void fill_one_to_many_baseline_hash_table_32(
                                                 join_column_per_key,
                                                 type_info_per_key,
                                                 join_bucket_info,
-                                                sd_inner_proxy_per_key,
-                                                sd_outer_proxy_per_key,
+                                                sd_translation_map_per_key,
                                                 cpu_thread_count);
 }
 
@@ -1945,8 +1905,7 @@ void fill_one_to_many_baseline_hash_table_64(
     const std::vector<JoinColumn>& join_column_per_key,
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<JoinBucketInfo>& join_bucket_info,
-    const std::vector<const void*>& sd_inner_proxy_per_key,
-    const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const int32_t*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count) {
   fill_one_to_many_baseline_hash_table<int64_t>(buff,
                                                 composite_key_dict,
@@ -1956,8 +1915,7 @@ void fill_one_to_many_baseline_hash_table_64(
                                                 join_column_per_key,
                                                 type_info_per_key,
                                                 join_bucket_info,
-                                                sd_inner_proxy_per_key,
-                                                sd_outer_proxy_per_key,
+                                                sd_translation_map_per_key,
                                                 cpu_thread_count);
 }
 
@@ -1987,7 +1945,6 @@ void approximate_distinct_tuples(uint8_t* hll_buffer_all_cpus,
                                                      false,
                                                      &join_column_per_key[0],
                                                      &type_info_per_key[0],
-                                                     nullptr,
                                                      nullptr);
           approximate_distinct_tuples_impl(hll_buffer,
                                            nullptr,
@@ -195,8 +195,7 @@ void fill_one_to_many_hash_table(int32_t* buff,
                                  const int32_t invalid_slot_val,
                                  const JoinColumn& join_column,
                                  const JoinColumnTypeInfo& type_info,
-                                 const void* sd_inner_proxy,
-                                 const void* sd_outer_proxy,
+                                 const int32_t* sd_translation_map,
                                  const unsigned cpu_thread_count);
 
 void fill_one_to_many_hash_table_bucketized(int32_t* buff,
@@ -204,8 +203,7 @@ void fill_one_to_many_hash_table_bucketized(int32_t* buff,
                                             const int32_t invalid_slot_val,
                                             const JoinColumn& join_column,
                                             const JoinColumnTypeInfo& type_info,
-                                            const void* sd_inner_proxy,
-                                            const void* sd_outer_proxy,
+                                            const int32_t* sd_translation_map,
                                             const unsigned cpu_thread_count);
 
 void fill_one_to_many_hash_table_sharded_bucketized(int32_t* buff,
@@ -214,8 +212,7 @@ void fill_one_to_many_hash_table_sharded_bucketized(int32_t* buff,
                                                     const JoinColumn& join_column,
                                                     const JoinColumnTypeInfo& type_info,
                                                     const ShardInfo& shard_info,
-                                                    const void* sd_inner_proxy,
-                                                    const void* sd_outer_proxy,
+                                                    const int32_t* sd_translation_map,
                                                     const unsigned cpu_thread_count);
 
 void fill_one_to_many_hash_table_on_device(int32_t* buff,
@@ -315,8 +312,7 @@ void fill_one_to_many_baseline_hash_table_32(
     const std::vector<JoinColumn>& join_column_per_key,
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<JoinBucketInfo>& join_bucket_info,
-    const std::vector<const void*>& sd_inner_proxy_per_key,
-    const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const int32_t*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count);
 
 void fill_one_to_many_baseline_hash_table_64(
@@ -328,8 +324,7 @@ void fill_one_to_many_baseline_hash_table_64(
     const std::vector<JoinColumn>& join_column_per_key,
     const std::vector<JoinColumnTypeInfo>& type_info_per_key,
     const std::vector<JoinBucketInfo>& join_bucket_info,
-    const std::vector<const void*>& sd_inner_proxy_per_key,
-    const std::vector<const void*>& sd_outer_proxy_per_key,
+    const std::vector<const int32_t*>& sd_translation_map_per_key,
     const int32_t cpu_thread_count);
 
 void fill_one_to_many_baseline_hash_table_on_device_32(
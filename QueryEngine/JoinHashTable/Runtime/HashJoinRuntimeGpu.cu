@@ -35,7 +35,7 @@ __global__ void fill_hash_join_buff_wrapper(int32_t* buff,
                                             const JoinColumnTypeInfo type_info,
                                             int* err) {
   int partial_err = SUFFIX(fill_hash_join_buff)(
-      buff, invalid_slot_val, join_column, type_info, NULL, NULL, -1, -1);
+      buff, invalid_slot_val, join_column, type_info, NULL, -1, -1);
   atomicCAS(err, 0, partial_err);
 }
 
@@ -51,7 +51,6 @@ __global__ void fill_hash_join_buff_bucketized_wrapper(
                                                            join_column,
                                                            type_info,
                                                            NULL,
-                                                           NULL,
                                                            -1,
                                                            -1,
                                                            bucket_normalization);
@@ -100,7 +99,6 @@ __global__ void fill_hash_join_buff_wrapper_sharded_bucketized(
                                                                    type_info,
                                                                    shard_info,
                                                                    NULL,
-                                                                   NULL,
                                                                    -1,
                                                                    -1,
                                                                    bucket_normalization);
@@ -114,7 +112,7 @@ __global__ void fill_hash_join_buff_wrapper_sharded(int32_t* buff,
                                                     const ShardInfo shard_info,
                                                     int* err) {
   int partial_err = SUFFIX(fill_hash_join_buff_sharded)(
-      buff, invalid_slot_val, join_column, type_info, shard_info, NULL, NULL, -1, -1);
+      buff, invalid_slot_val, join_column, type_info, shard_info, NULL, -1, -1);
   atomicCAS(err, 0, partial_err);
 }
 
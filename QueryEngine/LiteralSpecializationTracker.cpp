@@ -0,0 +1,73 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LiteralSpecializationTracker.h"
+
+namespace {
+
+constexpr size_t kMaxTrackedSteps{4096};
+
+}  // namespace
+
+bool LiteralSpecializationTracker::isHot(const std::string& key) {
+  if (!g_literal_specialization_threshold) {
+    return false;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  const auto it = steps_.find(key);
+  return it != steps_.end() && it->second.can_specialize &&
+         it->second.execution_count >= g_literal_specialization_threshold;
+}
+
+void LiteralSpecializationTracker::recordExecution(const std::string& key,
+                                                   const bool can_specialize) {
+  if (!g_literal_specialization_threshold) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (steps_.size() >= kMaxTrackedSteps && !steps_.count(key)) {
+    steps_.clear();
+  }
+  auto& step_stats = steps_[key];
+  ++step_stats.execution_count;
+  step_stats.can_specialize &= can_specialize;
+}
+
+void LiteralSpecializationTracker::recordSpecializedExecution() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  ++specialized_execution_count_;
+}
+
+size_t LiteralSpecializationTracker::getSpecializedExecutionCount() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return specialized_execution_count_;
+}
+
+size_t LiteralSpecializationTracker::size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return steps_.size();
+}
+
+void LiteralSpecializationTracker::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  steps_.clear();
+  specialized_execution_count_ = 0;
+}
+
+std::unordered_map<std::string, LiteralSpecializationTracker::StepStats>
+    LiteralSpecializationTracker::steps_;
+size_t LiteralSpecializationTracker::specialized_execution_count_{0};
+std::mutex LiteralSpecializationTracker::mutex_;
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    LiteralSpecializationTracker.h
+ * @brief   Counts executions of query steps to find the ones worth compiling with
+ *          their literals inlined.
+ *
+ * Kernels are compiled with the literals hoisted into a buffer, so that one kernel
+ * serves all the values of the literals. A step which keeps running with the same
+ * literals, like a dashboard tile with fixed filters, is better served by a kernel
+ * with the literals as constants, which LLVM can fold. Once a step described by the
+ * same key, literals included, has run g_literal_specialization_threshold times, the
+ * executor compiles it without hoisting. That kernel goes to the code cache like any
+ * other, and the hoisted kernel stays in the cache for other literal values. Steps
+ * which need hoisting, like IN lists probed through a bitmap or a hash set, are never
+ * specialized. A threshold of zero disables the tracking. The counts are dropped once
+ * too many distinct steps are tracked.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+extern size_t g_literal_specialization_threshold;
+
+class LiteralSpecializationTracker {
+ public:
+  // Returns true if the step has run often enough with the same literals to be compiled
+  // with them inlined.
+  static bool isHot(const std::string& key);
+
+  // Counts an execution of a step compiled with hoisted literals; can_specialize is
+  // false if its kernel relies on hoisting.
+  static void recordExecution(const std::string& key, const bool can_specialize);
+
+  // Counts an execution of a step compiled with its literals inlined.
+  static void recordSpecializedExecution();
+
+  static size_t getSpecializedExecutionCount();
+
+  static size_t size();
+
+  static void clear();
+
+ private:
+  struct StepStats {
+    size_t execution_count{0};
+    bool can_specialize{true};
+  };
+
+  static std::unordered_map<std::string, StepStats> steps_;
+  static size_t specialized_execution_count_;
+  static std::mutex mutex_;
+};
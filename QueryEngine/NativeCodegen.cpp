@@ -544,6 +544,99 @@ void CodeGenerator::link_udf_module(const std::unique_ptr<llvm::Module>& udf_mod
   }
 }
 
+void CodeGenerator::link_udf_declarations(const std::unique_ptr<llvm::Module>& udf_module,
+                                          llvm::Module& module) {
+  for (const auto& f : *udf_module) {
+    if (f.isDeclaration() || f.hasLocalLinkage()) {
+      continue;
+    }
+    if (module.getFunction(f.getName())) {
+      LOG(ERROR) << "  Attempt to overwrite " << f.getName().str() << " in "
+                 << module.getModuleIdentifier() << " from `"
+                 << udf_module->getModuleIdentifier() << "`" << std::endl;
+      throw std::runtime_error(
+          "link_udf_module: *** attempt to overwrite a runtime function with a UDF "
+          "function ***");
+    }
+    auto udf_declaration = llvm::Function::Create(
+        f.getFunctionType(), llvm::GlobalValue::ExternalLinkage, f.getName(), module);
+    udf_declaration->setCallingConv(f.getCallingConv());
+    udf_declaration->setAttributes(f.getAttributes());
+  }
+}
+
+namespace {
+
+// Collects the names of the functions defined in the UDF module a value depends on.
+void collect_udf_dependencies(const llvm::Value* value,
+                              std::unordered_set<const llvm::Value*>& visited,
+                              std::unordered_set<std::string>& udf_names) {
+  if (!visited.insert(value).second) {
+    return;
+  }
+  if (const auto func = llvm::dyn_cast<llvm::Function>(value)) {
+    if (func->isDeclaration()) {
+      return;
+    }
+    udf_names.insert(func->getName().str());
+    for (const auto& bb : *func) {
+      for (const auto& inst : bb) {
+        for (const auto& op : inst.operands()) {
+          if (llvm::isa<llvm::Constant>(op.get())) {
+            collect_udf_dependencies(op.get(), visited, udf_names);
+          }
+        }
+      }
+    }
+  } else if (const auto global_var = llvm::dyn_cast<llvm::GlobalVariable>(value)) {
+    if (global_var->hasInitializer()) {
+      collect_udf_dependencies(global_var->getInitializer(), visited, udf_names);
+    }
+  } else if (const auto constant = llvm::dyn_cast<llvm::Constant>(value)) {
+    for (const auto& op : constant->operands()) {
+      collect_udf_dependencies(op.get(), visited, udf_names);
+    }
+  }
+}
+
+}  // namespace
+
+void CodeGenerator::link_used_udf_functions(
+    const std::unique_ptr<llvm::Module>& udf_module,
+    llvm::Module& module,
+    CgenState* cgen_state) {
+  std::unordered_set<const llvm::Value*> visited;
+  std::unordered_set<std::string> used_udf_names;
+  for (const auto& f : *udf_module) {
+    const auto func = module.getFunction(f.getName());
+    if (func && func->isDeclaration() && !func->use_empty()) {
+      collect_udf_dependencies(&f, visited, used_udf_names);
+    }
+  }
+  for (const auto& f : *udf_module) {
+    const auto func = module.getFunction(f.getName());
+    if (func && func->isDeclaration() && func->use_empty() &&
+        !used_udf_names.count(f.getName().str())) {
+      func->eraseFromParent();
+    }
+  }
+  if (used_udf_names.empty()) {
+    return;
+  }
+  auto udf_module_copy = llvm::CloneModule(
+      *udf_module, cgen_state->vmap_, [&used_udf_names](const llvm::GlobalValue* gv) {
+        auto func = llvm::dyn_cast<llvm::Function>(gv);
+        return !func || used_udf_names.count(func->getName().str());
+      });
+  udf_module_copy->setDataLayout(module.getDataLayout());
+  udf_module_copy->setTargetTriple(module.getTargetTriple());
+
+  llvm::Linker ld(module);
+  if (ld.linkInModule(std::move(udf_module_copy), llvm::Linker::Flags::LinkOnlyNeeded)) {
+    throw std::runtime_error("link_udf_module: *** error linking module ***");
+  }
+}
+
 namespace {
 
 std::string cpp_to_llvm_name(const std::string& s) {
@@ -788,6 +881,7 @@ declare void @agg_count_distinct_bitmap_gpu(i64*, i64, i64, i64, i64, i64, i64);
 declare void @agg_count_distinct_bitmap_skip_val_gpu(i64*, i64, i64, i64, i64, i64, i64, i64);
 declare void @agg_approximate_count_distinct_gpu(i64*, i64, i32, i64, i64);
 declare void @agg_approx_median(i64*, double);
+declare void @agg_percentile(i64*, double);
 declare void @record_error_code(i32, i32*);
 declare i32 @get_error_code(i32*);
 declare i1 @dynamic_watchdog();
@@ -800,6 +894,7 @@ declare i64* @get_bin_from_k_heap_int32_t(i64*, i32, i32, i32, i1, i1, i1, i32,
 declare i64* @get_bin_from_k_heap_int64_t(i64*, i32, i32, i32, i1, i1, i1, i64, i64);
 declare i64* @get_bin_from_k_heap_float(i64*, i32, i32, i32, i1, i1, i1, float, float);
 declare i64* @get_bin_from_k_heap_double(i64*, i32, i32, i32, i1, i1, i1, double, double);
+declare i64* @get_bin_from_k_heap_multi_key(i64*, i32, i32, i64*, i32, i64*);
 )" + gen_array_any_all_sigs() +
     gen_translate_null_key_sigs();
 
@@ -1639,6 +1734,10 @@ std::vector<std::string> get_agg_fnames(const std::vector<Analyzer::Expr*>& targ
       case kAPPROX_MEDIAN:
         result.emplace_back("agg_approx_median");
         break;
+      case kPERCENTILE_CONT:
+      case kPERCENTILE_DISC:
+        result.emplace_back("agg_percentile");
+        break;
       default:
         CHECK(false);
     }
@@ -2547,23 +2646,23 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                 func->getLinkage() == llvm::GlobalValue::LinkageTypes::InternalLinkage ||
                 CodeGenerator::alwaysCloneRuntimeFunction(func));
       });
+  // Only the UDF signatures go in the module for now, the definitions of the ones the
+  // query calls are linked once its code has been generated.
   if (co.device_type == ExecutorDeviceType::CPU) {
     if (is_udf_module_present(true)) {
-      CodeGenerator::link_udf_module(udf_cpu_module, *rt_module_copy, cgen_state_.get());
+      CodeGenerator::link_udf_declarations(udf_cpu_module, *rt_module_copy);
     }
     if (is_rt_udf_module_present(true)) {
-      CodeGenerator::link_udf_module(
-          rt_udf_cpu_module, *rt_module_copy, cgen_state_.get());
+      CodeGenerator::link_udf_declarations(rt_udf_cpu_module, *rt_module_copy);
     }
   } else {
     rt_module_copy->setDataLayout(get_gpu_data_layout());
     rt_module_copy->setTargetTriple(get_gpu_target_triple_string());
     if (is_udf_module_present()) {
-      CodeGenerator::link_udf_module(udf_gpu_module, *rt_module_copy, cgen_state_.get());
+      CodeGenerator::link_udf_declarations(udf_gpu_module, *rt_module_copy);
     }
     if (is_rt_udf_module_present()) {
-      CodeGenerator::link_udf_module(
-          rt_udf_gpu_module, *rt_module_copy, cgen_state_.get());
+      CodeGenerator::link_udf_declarations(rt_udf_gpu_module, *rt_module_copy);
     }
   }
 
@@ -2747,6 +2846,26 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
              multifrag_query_func,
              cgen_state_->module_);
 
+  if (co.device_type == ExecutorDeviceType::CPU) {
+    if (is_udf_module_present(true)) {
+      CodeGenerator::link_used_udf_functions(
+          udf_cpu_module, *cgen_state_->module_, cgen_state_.get());
+    }
+    if (is_rt_udf_module_present(true)) {
+      CodeGenerator::link_used_udf_functions(
+          rt_udf_cpu_module, *cgen_state_->module_, cgen_state_.get());
+    }
+  } else {
+    if (is_udf_module_present()) {
+      CodeGenerator::link_used_udf_functions(
+          udf_gpu_module, *cgen_state_->module_, cgen_state_.get());
+    }
+    if (is_rt_udf_module_present()) {
+      CodeGenerator::link_used_udf_functions(
+          rt_udf_gpu_module, *cgen_state_->module_, cgen_state_.get());
+    }
+  }
+
   std::vector<llvm::Function*> root_funcs{query_func, cgen_state_->row_func_};
   if (cgen_state_->filter_func_) {
     root_funcs.push_back(cgen_state_->filter_func_);
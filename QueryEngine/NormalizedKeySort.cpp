@@ -0,0 +1,133 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NormalizedKeySort.h"
+
+#include "Logger/Logger.h"
+#include "Shared/Intervals.h"
+#include "Shared/threadpool.h"
+
+#include <array>
+#include <numeric>
+
+namespace normalized_key_sort {
+
+namespace {
+
+constexpr size_t kRadixBits{8};
+constexpr size_t kRadixSize{1 << kRadixBits};
+
+using Histogram = std::array<size_t, kRadixSize>;
+
+// Runs work on every interval of [0, count), on the calling thread if there's only one.
+template <typename WORK>
+void parallel_for(const size_t count, const size_t thread_count, WORK work) {
+  if (thread_count == 1) {
+    work(Interval<size_t>{0, count, 0});
+    return;
+  }
+  threadpool::FuturesThreadPool<void> thread_pool;
+  for (const auto interval : makeIntervals<size_t>(0, count, thread_count)) {
+    thread_pool.spawn(work, interval);
+  }
+  thread_pool.join();
+}
+
+// One stable counting sort pass over the byte of words at the given shift.
+void radix_pass(const std::vector<uint64_t>& words,
+                const std::vector<uint32_t>& order,
+                std::vector<uint64_t>& sorted_words,
+                std::vector<uint32_t>& sorted_order,
+                const size_t shift,
+                const size_t thread_count) {
+  const auto count = words.size();
+  std::vector<Histogram> histograms(thread_count);
+  parallel_for(count, thread_count, [&](const Interval<size_t> interval) {
+    auto& histogram = histograms[interval.index];
+    histogram.fill(0);
+    for (size_t i = interval.begin; i < interval.end; ++i) {
+      ++histogram[(words[i] >> shift) & (kRadixSize - 1)];
+    }
+  });
+  // Turn the counts into the output offset of every thread and digit. Digits go in
+  // ascending order and, within a digit, threads go in the order of their intervals.
+  size_t offset{0};
+  for (size_t digit = 0; digit < kRadixSize; ++digit) {
+    for (auto& histogram : histograms) {
+      const auto digit_count = histogram[digit];
+      histogram[digit] = offset;
+      offset += digit_count;
+    }
+  }
+  CHECK_EQ(count, offset);
+  parallel_for(count, thread_count, [&](const Interval<size_t> interval) {
+    auto& offsets = histograms[interval.index];
+    for (size_t i = interval.begin; i < interval.end; ++i) {
+      const auto pos = offsets[(words[i] >> shift) & (kRadixSize - 1)]++;
+      sorted_words[pos] = words[i];
+      sorted_order[pos] = order[i];
+    }
+  });
+}
+
+}  // namespace
+
+std::vector<uint32_t> sort_keys(const std::vector<std::vector<uint64_t>>& key_words,
+                                const size_t key_count,
+                                const size_t thread_count) {
+  CHECK_GT(thread_count, size_t(0));
+  std::vector<uint32_t> order(key_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<uint32_t> sorted_order(key_count);
+  std::vector<uint64_t> words(key_count);
+  std::vector<uint64_t> sorted_words(key_count);
+  std::vector<std::pair<uint64_t, uint64_t>> or_and(thread_count, {0, ~uint64_t(0)});
+  // Least significant word first, every pass is stable.
+  for (auto column_it = key_words.rbegin(); column_it != key_words.rend(); ++column_it) {
+    const auto& column = *column_it;
+    CHECK_EQ(key_count, column.size());
+    std::fill(or_and.begin(), or_and.end(), std::make_pair(uint64_t(0), ~uint64_t(0)));
+    parallel_for(key_count, thread_count, [&](const Interval<size_t> interval) {
+      auto [thread_or, thread_and] = or_and[interval.index];
+      for (size_t i = interval.begin; i < interval.end; ++i) {
+        const auto word = column[order[i]];
+        words[i] = word;
+        thread_or |= word;
+        thread_and &= word;
+      }
+      or_and[interval.index] = {thread_or, thread_and};
+    });
+    uint64_t all_or{0};
+    uint64_t all_and{~uint64_t(0)};
+    for (const auto& [thread_or, thread_and] : or_and) {
+      all_or |= thread_or;
+      all_and &= thread_and;
+    }
+    const auto varying_bits = all_or ^ all_and;
+    for (size_t shift = 0; shift < 64; shift += kRadixBits) {
+      if (!((varying_bits >> shift) & (kRadixSize - 1))) {
+        // The byte is the same for all the keys, the pass wouldn't move anything.
+        continue;
+      }
+      radix_pass(words, order, sorted_words, sorted_order, shift, thread_count);
+      words.swap(sorted_words);
+      order.swap(sorted_order);
+    }
+  }
+  return order;
+}
+
+}  // namespace normalized_key_sort
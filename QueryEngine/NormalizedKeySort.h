@@ -0,0 +1,55 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    NormalizedKeySort.h
+ * @brief   Radix sort of multi-column sort keys normalized to unsigned 64-bit words.
+ *
+ * Every column of a sort key is encoded once into words whose unsigned order matches
+ * the order of the column, with the direction and the position of nulls folded in.
+ * Keys are then sorted by an LSD radix sort, one byte per pass, which skips the bytes
+ * that are the same for all the keys and runs the passes on multiple threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace normalized_key_sort {
+
+// Maps integers to unsigned words of the same order.
+inline uint64_t encode_int(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+// Maps doubles to unsigned words of the same order. Negative zero sorts before zero.
+inline uint64_t encode_fp(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & (uint64_t(1) << 63)) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+// Returns the permutation which sorts keys [0, key_count) in ascending order. The keys
+// are given column-wise: key_words[i][j] is word i of key j, most significant word
+// first. Keys which compare equal keep their relative order.
+std::vector<uint32_t> sort_keys(const std::vector<std::vector<uint64_t>>& key_words,
+                                const size_t key_count,
+                                const size_t thread_count);
+
+}  // namespace normalized_key_sort
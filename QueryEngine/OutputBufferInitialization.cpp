@@ -175,6 +175,9 @@ int64_t get_agg_initial_val(const SQLAgg agg,
       return 0;
     case kAPPROX_MEDIAN:
       return {};  // Init value is a quantile::TDigest* set elsewhere.
+    case kPERCENTILE_CONT:
+    case kPERCENTILE_DISC:
+      return {};  // Init value is a quantile::ExactQuantile* set elsewhere.
     case kMIN: {
       switch (byte_width) {
         case 1: {
@@ -277,7 +280,7 @@ std::vector<int64_t> init_agg_val_vec(
           target.is_agg &&
           (target.agg_kind == kMIN || target.agg_kind == kMAX ||
            target.agg_kind == kSUM || target.agg_kind == kAVG ||
-           target.agg_kind == kAPPROX_MEDIAN)) {
+           is_quantile_agg(target.agg_kind))) {
         set_notnull(target, false);
       } else if (constrained_not_null(arg_expr, quals)) {
         set_notnull(target, true);
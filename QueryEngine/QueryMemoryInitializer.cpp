@@ -414,7 +414,7 @@ void QueryMemoryInitializer::initGroups(const QueryMemoryDescriptor& query_mem_d
   const size_t col_base_off{query_mem_desc.getColOffInBytes(0)};
 
   auto agg_bitmap_size = allocateCountDistinctBuffers(query_mem_desc, true, executor);
-  auto tdigest_deferred = allocateTDigests(query_mem_desc, true, executor);
+  auto quantile_params = allocateTDigests(query_mem_desc, true, executor);
   auto buffer_ptr = reinterpret_cast<int8_t*>(groups_buffer);
 
   const auto query_mem_desc_fixedup =
@@ -431,7 +431,7 @@ void QueryMemoryInitializer::initGroups(const QueryMemoryDescriptor& query_mem_d
                          bin,
                          init_vals,
                          agg_bitmap_size,
-                         tdigest_deferred);
+                         quantile_params);
       }
     }
     return;
@@ -446,7 +446,7 @@ void QueryMemoryInitializer::initGroups(const QueryMemoryDescriptor& query_mem_d
                      bin,
                      init_vals,
                      agg_bitmap_size,
-                     tdigest_deferred);
+                     quantile_params);
   }
 }
 
@@ -527,12 +527,13 @@ void QueryMemoryInitializer::initColumnarGroups(
   }
 }
 
-void QueryMemoryInitializer::initColumnPerRow(const QueryMemoryDescriptor& query_mem_desc,
-                                              int8_t* row_ptr,
-                                              const size_t bin,
-                                              const std::vector<int64_t>& init_vals,
-                                              const std::vector<int64_t>& bitmap_sizes,
-                                              const std::vector<bool>& tdigest_deferred) {
+void QueryMemoryInitializer::initColumnPerRow(
+    const QueryMemoryDescriptor& query_mem_desc,
+    int8_t* row_ptr,
+    const size_t bin,
+    const std::vector<int64_t>& init_vals,
+    const std::vector<int64_t>& bitmap_sizes,
+    const std::vector<std::optional<QuantileParam>>& quantile_params) {
   int8_t* col_ptr = row_ptr;
   size_t init_vec_idx = 0;
   for (size_t col_idx = 0; col_idx < query_mem_desc.getSlotCount();
@@ -546,9 +547,9 @@ void QueryMemoryInitializer::initColumnPerRow(const QueryMemoryDescriptor& query
       init_val =
           bm_sz > 0 ? allocateCountDistinctBitmap(bm_sz) : allocateCountDistinctSet();
       ++init_vec_idx;
-    } else if (query_mem_desc.isGroupBy() && tdigest_deferred[col_idx]) {
-      // allocate for APPROX_MEDIAN only when slot is used
-      init_val = reinterpret_cast<int64_t>(row_set_mem_owner_->nullTDigest());
+    } else if (query_mem_desc.isGroupBy() && quantile_params[col_idx]) {
+      // allocate for quantiles only when slot is used
+      init_val = allocateQuantile(*quantile_params[col_idx]);
       ++init_vec_idx;
     } else {
       if (query_mem_desc.getPaddedSlotWidthBytes(col_idx) > 0) {
@@ -669,40 +670,52 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
 }
 
 int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
-  auto count_distinct_set = new std::set<int64_t>();
+  auto count_distinct_set = new CountDistinctSet();
   row_set_mem_owner_->addCountDistinctSet(count_distinct_set);
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
-std::vector<bool> QueryMemoryInitializer::allocateTDigests(
-    const QueryMemoryDescriptor& query_mem_desc,
-    const bool deferred,
-    const Executor* executor) {
+std::vector<std::optional<QueryMemoryInitializer::QuantileParam>>
+QueryMemoryInitializer::allocateTDigests(const QueryMemoryDescriptor& query_mem_desc,
+                                         const bool deferred,
+                                         const Executor* executor) {
   size_t const slot_count = query_mem_desc.getSlotCount();
   size_t const ntargets = executor->plan_state_->target_exprs_.size();
   CHECK_GE(slot_count, ntargets);
-  std::vector<bool> tdigest_deferred(deferred ? slot_count : 0);
+  std::vector<std::optional<QuantileParam>> quantile_params(deferred ? slot_count : 0);
 
   for (size_t target_idx = 0; target_idx < ntargets; ++target_idx) {
     auto const target_expr = executor->plan_state_->target_exprs_[target_idx];
     if (auto const agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr)) {
-      if (agg_expr->get_aggtype() == kAPPROX_MEDIAN) {
+      if (is_quantile_agg(agg_expr->get_aggtype())) {
         size_t const agg_col_idx =
             query_mem_desc.getSlotIndexForSingleSlotCol(target_idx);
         CHECK_LT(agg_col_idx, slot_count);
         CHECK_EQ(query_mem_desc.getLogicalSlotWidthBytes(agg_col_idx),
                  static_cast<int8_t>(sizeof(int64_t)));
+        auto const q_expr =
+            dynamic_cast<const Analyzer::Constant*>(agg_expr->get_error_rate().get());
+        CHECK(q_expr);
+        QuantileParam const quantile_param{agg_expr->get_aggtype(),
+                                           q_expr->get_constval().doubleval};
         if (deferred) {
-          tdigest_deferred[agg_col_idx] = true;
+          quantile_params[agg_col_idx] = quantile_param;
         } else {
-          // allocate for APPROX_MEDIAN only when slot is used
-          init_agg_vals_[agg_col_idx] =
-              reinterpret_cast<int64_t>(row_set_mem_owner_->nullTDigest());
+          // allocate for quantiles only when slot is used
+          init_agg_vals_[agg_col_idx] = allocateQuantile(quantile_param);
         }
       }
     }
   }
-  return tdigest_deferred;
+  return quantile_params;
+}
+
+int64_t QueryMemoryInitializer::allocateQuantile(const QuantileParam& quantile_param) {
+  if (quantile_param.agg_kind == kAPPROX_MEDIAN) {
+    return reinterpret_cast<int64_t>(row_set_mem_owner_->nullTDigest(quantile_param.q));
+  }
+  return reinterpret_cast<int64_t>(row_set_mem_owner_->nullExactQuantile(
+      quantile_param.q, quantile_param.agg_kind == kPERCENTILE_CONT));
 }
 
 #ifdef HAVE_CUDA
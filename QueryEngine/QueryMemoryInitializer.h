@@ -25,6 +25,7 @@
 #include "Rendering/RenderAllocator.h"
 
 #include <memory>
+#include <optional>
 
 #ifdef HAVE_CUDA
 #include <cuda.h>
@@ -128,6 +129,11 @@ class QueryMemoryInitializer {
                                  const bool prepend_index_buffer) const;
 
  private:
+  struct QuantileParam {
+    SQLAgg agg_kind;  // APPROX_MEDIAN, PERCENTILE_CONT or PERCENTILE_DISC
+    double q;
+  };
+
   void initGroupByBuffer(int64_t* buffer,
                          const RelAlgExecutionUnit& ra_exe_unit,
                          const QueryMemoryDescriptor& query_mem_desc,
@@ -152,7 +158,7 @@ class QueryMemoryInitializer {
                         const size_t bin,
                         const std::vector<int64_t>& init_vals,
                         const std::vector<int64_t>& bitmap_sizes,
-                        const std::vector<bool>& tdigest_deferred);
+                        const std::vector<std::optional<QuantileParam>>& quantile_params);
 
   void allocateCountDistinctGpuMem(const QueryMemoryDescriptor& query_mem_desc);
 
@@ -165,9 +171,13 @@ class QueryMemoryInitializer {
 
   int64_t allocateCountDistinctSet();
 
-  std::vector<bool> allocateTDigests(const QueryMemoryDescriptor& query_mem_desc,
-                                     const bool deferred,
-                                     const Executor* executor);
+  // Allocates the quantile::TDigest or quantile::ExactQuantile of quantile slots.
+  std::vector<std::optional<QuantileParam>> allocateTDigests(
+      const QueryMemoryDescriptor& query_mem_desc,
+      const bool deferred,
+      const Executor* executor);
+
+  int64_t allocateQuantile(const QuantileParam& quantile_param);
 
 #ifdef HAVE_CUDA
   GpuGroupByBuffers prepareTopNHeapsDevBuffer(const QueryMemoryDescriptor& query_mem_desc,
@@ -28,6 +28,7 @@
 RelAlgExecutionUnit QueryRewriter::rewrite(
     const RelAlgExecutionUnit& ra_exe_unit_in) const {
   auto rewritten_exe_unit = rewriteConstrainedByIn(ra_exe_unit_in);
+  rewritten_exe_unit = rewriteGroupByKeyPacking(rewritten_exe_unit);
   return rewriteOverlapsJoin(rewritten_exe_unit);
 }
 
@@ -197,6 +198,172 @@ std::shared_ptr<Analyzer::CaseExpr> QueryRewriter::generateCaseForDomainValues(
 
 namespace {
 
+std::shared_ptr<Analyzer::Constant> make_bigint_constant(const int64_t val) {
+  Datum d;
+  d.bigintval = val;
+  return makeExpr<Analyzer::Constant>(SQLTypeInfo(kBIGINT, true), false, d);
+}
+
+}  // namespace
+
+// Multi-column group by keys with integer ranges too wide for the multi-column perfect
+// hash are replaced with a single key which combines them in a mixed radix number, so
+// that the query can probe a baseline hash table with one key, or use the single column
+// perfect hash when the input could fill a good part of the packed range. The targets
+// which were group by keys become samples of the keys.
+RelAlgExecutionUnit QueryRewriter::rewriteGroupByKeyPacking(
+    const RelAlgExecutionUnit& ra_exe_unit_in) const {
+  if (!g_enable_group_key_packing || g_cluster ||
+      ra_exe_unit_in.groupby_exprs.size() < 2 || ra_exe_unit_in.estimator) {
+    return ra_exe_unit_in;
+  }
+  for (const auto& join_condition : ra_exe_unit_in.join_quals) {
+    if (join_condition.type == JoinType::LEFT) {
+      // the keys from the inner table can be null regardless of their type
+      return ra_exe_unit_in;
+    }
+  }
+  for (const auto target_expr : ra_exe_unit_in.target_exprs) {
+    const auto var_expr = dynamic_cast<const Analyzer::Var*>(target_expr);
+    if (!dynamic_cast<const Analyzer::AggExpr*>(target_expr) &&
+        !(var_expr && var_expr->get_which_row() == Analyzer::Var::kGROUPBY)) {
+      return ra_exe_unit_in;
+    }
+  }
+  struct KeyDigit {
+    std::shared_ptr<Analyzer::Expr> key;
+    int64_t min;
+    int64_t bucket;
+    int64_t cardinality;  // one more than the buckets for a nullable key
+  };
+  std::vector<KeyDigit> digits;
+  int64_t packed_cardinality{1};
+  try {
+    checked_int64_t cardinality{1};
+    for (const auto& groupby_expr : ra_exe_unit_in.groupby_exprs) {
+      if (!groupby_expr || contains_unnest(groupby_expr.get())) {
+        // the group by code generator expands an UNNEST key only when it is the key
+        // itself, wrapping it in the packing arithmetic would hide it
+        return ra_exe_unit_in;
+      }
+      const auto& ti = groupby_expr->get_type_info();
+      const bool is_dict_str_col =
+          ti.is_string() && ti.get_compression() == kENCODING_DICT &&
+          dynamic_cast<const Analyzer::ColumnVar*>(groupby_expr.get());
+      if (!ti.is_integer() && !ti.is_boolean() && !ti.is_time() && !is_dict_str_col) {
+        return ra_exe_unit_in;
+      }
+      const auto expr_range =
+          getExpressionRange(groupby_expr.get(),
+                             query_infos_,
+                             executor_,
+                             boost::make_optional(ra_exe_unit_in.simple_quals));
+      if (expr_range.getType() != ExpressionRangeType::Integer ||
+          expr_range.getIntMin() > expr_range.getIntMax()) {
+        return ra_exe_unit_in;
+      }
+      const int64_t bucket = std::max(expr_range.getBucket(), int64_t(1));
+      const int64_t key_cardinality =
+          static_cast<int64_t>((checked_int64_t(expr_range.getIntMax()) -
+                                expr_range.getIntMin()) /
+                                   bucket +
+                               (ti.get_notnull() ? 1 : 2));
+      cardinality *= key_cardinality;
+      digits.push_back({groupby_expr, expr_range.getIntMin(), bucket, key_cardinality});
+    }
+    packed_cardinality = static_cast<int64_t>(cardinality);
+  } catch (...) {  // the keys don't fit in 64 bits
+    return ra_exe_unit_in;
+  }
+  if (packed_cardinality <= static_cast<int64_t>(Executor::baseline_threshold)) {
+    // small enough for the multi-column perfect hash
+    return ra_exe_unit_in;
+  }
+  // the perfect hash has an entry for every value of the packed range, which is mostly
+  // empty unless the input has at least half as many rows
+  size_t max_input_rows{0};
+  for (const auto& query_info : query_infos_) {
+    max_input_rows = std::max(max_input_rows, query_info.info.getNumTuplesUpperBound());
+  }
+  const bool dense_packed_range =
+      static_cast<uint64_t>(packed_cardinality) <= 2 * uint64_t(max_input_rows);
+  std::shared_ptr<Analyzer::Expr> packed_key;
+  int64_t stride{1};
+  for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+    const auto& key_ti = it->key->get_type_info();
+    const SQLTypeInfo key_bigint_ti(kBIGINT, key_ti.get_notnull());
+    std::shared_ptr<Analyzer::Expr> digit =
+        key_ti.is_string() ? makeExpr<Analyzer::KeyForStringExpr>(it->key) : it->key;
+    if (digit->get_type_info().get_type() != kBIGINT) {
+      digit = makeExpr<Analyzer::UOper>(key_bigint_ti, false, kCAST, digit);
+    }
+    digit = makeExpr<Analyzer::BinOper>(
+        key_bigint_ti, false, kMINUS, kONE, digit, make_bigint_constant(it->min));
+    if (it->bucket > 1) {
+      digit = makeExpr<Analyzer::BinOper>(
+          key_bigint_ti, false, kDIVIDE, kONE, digit, make_bigint_constant(it->bucket));
+    }
+    if (!key_ti.get_notnull()) {
+      // null is the last digit value
+      std::list<
+          std::pair<std::shared_ptr<Analyzer::Expr>, std::shared_ptr<Analyzer::Expr>>>
+          null_case{{makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, it->key),
+                     make_bigint_constant(it->cardinality - 1)}};
+      digit = makeExpr<Analyzer::CaseExpr>(
+          SQLTypeInfo(kBIGINT, true), false, null_case, digit);
+    }
+    if (stride > 1) {
+      digit = makeExpr<Analyzer::BinOper>(SQLTypeInfo(kBIGINT, true),
+                                          false,
+                                          kMULTIPLY,
+                                          kONE,
+                                          digit,
+                                          make_bigint_constant(stride));
+    }
+    packed_key = packed_key ? makeExpr<Analyzer::BinOper>(SQLTypeInfo(kBIGINT, true),
+                                                         false,
+                                                         kPLUS,
+                                                         kONE,
+                                                         digit,
+                                                         packed_key)
+                            : digit;
+    stride *= it->cardinality;
+  }
+  std::vector<Analyzer::Expr*> new_target_exprs;
+  for (const auto target_expr : ra_exe_unit_in.target_exprs) {
+    const auto var_expr = dynamic_cast<const Analyzer::Var*>(target_expr);
+    if (!var_expr) {
+      new_target_exprs.push_back(target_expr);
+      continue;
+    }
+    const size_t key_idx = var_expr->get_varno() - 1;
+    CHECK_LT(key_idx, digits.size());
+    auto sample_expr = makeExpr<Analyzer::AggExpr>(
+        var_expr->get_type_info(), kSAMPLE, digits[key_idx].key, false, nullptr);
+    target_exprs_owned_.push_back(sample_expr);
+    new_target_exprs.push_back(sample_expr.get());
+  }
+  VLOG(1) << "Packed " << digits.size() << " group by keys into one, cardinality "
+          << packed_cardinality << (dense_packed_range ? "" : ", baseline hash");
+  return {ra_exe_unit_in.input_descs,
+          ra_exe_unit_in.input_col_descs,
+          ra_exe_unit_in.simple_quals,
+          ra_exe_unit_in.quals,
+          ra_exe_unit_in.join_quals,
+          {packed_key},
+          new_target_exprs,
+          ra_exe_unit_in.estimator,
+          ra_exe_unit_in.sort_info,
+          ra_exe_unit_in.scan_limit,
+          ra_exe_unit_in.query_hint,
+          ra_exe_unit_in.use_bump_allocator,
+          ra_exe_unit_in.union_all,
+          ra_exe_unit_in.query_state,
+          !dense_packed_range};
+}
+
+namespace {
+
 // TODO(adb): centralize and share (e..g with insert_one_dict_str)
 bool check_string_id_overflow(const int32_t string_id, const SQLTypeInfo& ti) {
   switch (ti.get_size()) {
@@ -373,7 +540,8 @@ RelAlgExecutionUnit QueryRewriter::rewriteColumnarUpdate(
                                          ra_exe_unit_in.query_hint,
                                          ra_exe_unit_in.use_bump_allocator,
                                          ra_exe_unit_in.union_all,
-                                         ra_exe_unit_in.query_state};
+                                         ra_exe_unit_in.query_state,
+                                         ra_exe_unit_in.use_baseline_groupby};
   return rewritten_exe_unit;
 }
 
@@ -473,6 +641,7 @@ RelAlgExecutionUnit QueryRewriter::rewriteColumnarDelete(
                                          ra_exe_unit_in.query_hint,
                                          ra_exe_unit_in.use_bump_allocator,
                                          ra_exe_unit_in.union_all,
-                                         ra_exe_unit_in.query_state};
+                                         ra_exe_unit_in.query_state,
+                                         ra_exe_unit_in.use_baseline_groupby};
   return rewritten_exe_unit;
 }
@@ -47,6 +47,9 @@ class QueryRewriter {
   static std::shared_ptr<Analyzer::CaseExpr> generateCaseForDomainValues(
       const Analyzer::InValues*);
 
+  RelAlgExecutionUnit rewriteGroupByKeyPacking(
+      const RelAlgExecutionUnit& ra_exe_unit_in) const;
+
   const std::vector<InputTableInfo>& query_infos_;
   Executor* executor_;
   mutable std::vector<std::shared_ptr<Analyzer::Expr>> target_exprs_owned_;
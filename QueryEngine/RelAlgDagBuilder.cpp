@@ -34,6 +34,7 @@
 #include <unordered_set>
 
 extern bool g_cluster;
+extern bool g_enable_eager_aggregation;
 extern bool g_enable_union;
 
 namespace {
@@ -1008,7 +1009,12 @@ std::unique_ptr<const RexAgg> parse_aggregate_expr(const rapidjson::Value& expr)
   const auto distinct = json_bool(field(expr, "distinct"));
   const auto agg_ti = parse_type(field(expr, "type"));
   const auto operands = indices_from_json_array(field(expr, "operands"));
-  if (operands.size() > 1 && (operands.size() != 2 || agg != kAPPROX_COUNT_DISTINCT)) {
+  // Only the error rate of APPROX_COUNT_DISTINCT and the quantile of APPROX_QUANTILE,
+  // PERCENTILE_CONT and PERCENTILE_DISC can follow the argument.
+  if (operands.size() > 1 &&
+      (operands.size() != 2 ||
+       (agg != kAPPROX_COUNT_DISTINCT && agg != kAPPROX_MEDIAN &&
+        agg != kPERCENTILE_CONT && agg != kPERCENTILE_DISC))) {
     throw QueryNotSupported("Multiple arguments for aggregates aren't supported");
   }
   return std::unique_ptr<const RexAgg>(new RexAgg(agg, distinct, agg_ti, operands));
@@ -2645,6 +2651,9 @@ void RelAlgDagBuilder::build(const rapidjson::Value& query_ast,
   if (filtered_left_deep_joins.empty()) {
     hoist_filter_cond_to_cross_join(nodes_);
   }
+  if (g_enable_eager_aggregation) {
+    pre_aggregate_below_joins(nodes_, cat_);
+  }
   eliminate_dead_columns(nodes_);
   eliminate_dead_subqueries(subqueries_, nodes_.back().get());
   separate_window_function_expressions(nodes_);
@@ -1589,8 +1589,10 @@ class RelModify : public RelAlgNode {
           }
         }
 
-        // Check for valid types
-        if (column_desc->columnType.is_varlen()) {
+        // Check for valid types. None encoded strings are rewritten in place by the
+        // fragmenter, other varlen columns need their rows moved.
+        const auto& column_type = column_desc->columnType;
+        if (column_type.is_varlen() && !column_type.is_string()) {
           varlen_update_required = true;
         }
         if (column_desc->columnType.is_geometry()) {
@@ -79,6 +79,9 @@ struct RelAlgExecutionUnit {
   // empty if not a UNION, true if UNION ALL, false if regular UNION
   const std::optional<bool> union_all;
   std::shared_ptr<const query_state::QueryState> query_state;
+  // set when the group by keys are packed into one key with a range too sparse for the
+  // perfect hash layout
+  bool use_baseline_groupby{false};
 };
 
 std::ostream& operator<<(std::ostream& os, const RelAlgExecutionUnit& ra_exe_unit);
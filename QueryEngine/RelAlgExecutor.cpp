@@ -32,6 +32,7 @@
 #include "QueryEngine/RelAlgTranslator.h"
 #include "QueryEngine/ResultSetBuilder.h"
 #include "QueryEngine/RexVisitor.h"
+#include "QueryEngine/SortedResultCache.h"
 #include "QueryEngine/WindowContext.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/measure.h"
@@ -47,6 +48,7 @@
 
 bool g_skip_intermediate_count{true};
 extern bool g_enable_bump_allocator;
+extern bool g_enable_watchdog;
 bool g_enable_interop{false};
 bool g_enable_union{false};
 
@@ -1504,6 +1506,19 @@ void RelAlgExecutor::executeUpdate(const RelAlgNode* node,
       auto update_transaction_parameters =
           dynamic_cast<UpdateTransactionParameters*>(dml_transaction_parameters_.get());
       CHECK(update_transaction_parameters);
+      const auto& targets_meta = update_transaction_parameters->getTargetsMetaInfo();
+      if (!update_transaction_parameters->isVarlenUpdateRequired() &&
+          std::none_of(targets_meta.begin(),
+                       targets_meta.end(),
+                       [](const TargetMetaInfo& target_meta) {
+                         const auto& ti = target_meta.get_type_info();
+                         return ti.is_string() && !ti.is_dict_encoded_string();
+                       })) {
+        // materialized columnar output lets fixed width targets be copied into the
+        // chunks without going through per-row target values
+        eo.output_columnar_hint = true;
+        co_project.allow_lazy_fetch = false;
+      }
       auto update_callback = yieldUpdateCallback(*update_transaction_parameters);
       executor_->executeUpdate(ra_exe_unit,
                                table_infos,
@@ -2437,6 +2452,39 @@ bool first_oe_is_desc(const std::list<Analyzer::OrderEntry>& order_entries) {
   return !order_entries.empty() && order_entries.front().is_desc;
 }
 
+// Returns the key of the sorted result of the given execution unit in the sorted result
+// cache, or an empty string if the result cannot be cached. The key doesn't include the
+// limit and the offset, so that all the pages of a query share it, but it includes the
+// fragment sizes of the inputs, hence appending to an input changes it.
+std::string sorted_result_cache_key(const RelAlgExecutionUnit& ra_exe_unit,
+                                    const Catalog_Namespace::Catalog& cat,
+                                    Executor* executor) {
+  if (!g_sorted_result_cache_size || g_cluster ||
+      ra_exe_unit.sort_info.order_entries.empty()) {
+    return "";
+  }
+  std::ostringstream os;
+  os << cat.getCurrentDB().dbId << ";" << ra_exec_unit_desc_for_caching(ra_exe_unit);
+  for (const auto& order_entry : ra_exe_unit.sort_info.order_entries) {
+    os << order_entry.toString() << ",";
+  }
+  for (const auto& table_info : get_table_infos(ra_exe_unit, executor)) {
+    if (table_info.table_id < 0) {
+      // intermediate results are identified by the id of the node which produced them
+      return "";
+    }
+    const auto td = cat.getMetadataForTable(table_info.table_id, false);
+    if (!td || td->isForeignTable()) {
+      return "";
+    }
+    os << ";" << table_info.table_id;
+    for (const auto& fragment : table_info.info.fragments) {
+      os << "," << fragment.fragmentId << ":" << fragment.getPhysicalNumTuples();
+    }
+  }
+  return os.str();
+}
+
 }  // namespace
 
 ExecutionResult RelAlgExecutor::executeSort(const RelSort* sort,
@@ -2489,6 +2537,26 @@ ExecutionResult RelAlgExecutor::executeSort(const RelSort* sort,
                              &is_desc]() -> ExecutionResult {
     const auto source_work_unit = createSortInputWorkUnit(sort, eo);
     is_desc = first_oe_is_desc(source_work_unit.exe_unit.sort_info.order_entries);
+    const size_t limit = sort->getLimit();
+    const size_t offset = sort->getOffset();
+    // The inputs of an aggregator don't hold the rows which the leaves return.
+    const auto cache_key =
+        eo.just_explain || eo.just_validate || sort->isEmptyResult() || render_info ||
+                !leaf_results_.empty()
+            ? std::string{}
+            : sorted_result_cache_key(source_work_unit.exe_unit, cat_, executor_);
+    // a cached result which doesn't cover the page means the query is being paged
+    bool paging{offset > 0};
+    if (!cache_key.empty()) {
+      const auto cached_result = SortedResultCache::get(cache_key);
+      if (cached_result && cached_result->hasPage(offset, limit)) {
+        VLOG(1) << "Using cached sorted result for limit " << limit << ", offset "
+                << offset;
+        return {ResultSet::createSortedPage(cached_result->rows, offset, limit),
+                cached_result->targets_meta};
+      }
+      paging = paging || cached_result.has_value();
+    }
     ExecutionOptions eo_copy = {
         eo.output_columnar_hint,
         eo.allow_multifrag,
@@ -2525,14 +2593,38 @@ ExecutionResult RelAlgExecutor::executeSort(const RelSort* sort,
     if (eo.just_explain) {
       return {rows_to_sort, {}};
     }
-    const size_t limit = sort->getLimit();
-    const size_t offset = sort->getOffset();
+    // Cached results must not point into chunk buffers, which can be evicted or deleted
+    // while the result is in the cache.
+    const bool cache_sorted_result =
+        !cache_key.empty() && !rows_to_sort->referencesChunkBuffers();
     if (sort->collationCount() != 0 && !rows_to_sort->definitelyHasNoRows() &&
         !use_speculative_top_n(source_work_unit.exe_unit,
                                rows_to_sort->getQueryMemDesc())) {
-      const size_t top_n = limit == 0 ? 0 : limit + offset;
+      // The first page only needs the top limit rows. Once the query is paged, sort all
+      // the rows of a result which goes to the cache, unless the watchdog would reject
+      // it, so that the next pages can be served from the cache as well.
+      const bool sort_all_rows =
+          cache_sorted_result && paging &&
+          (!g_enable_watchdog ||
+           rows_to_sort->entryCount() <= Executor::baseline_threshold);
+      const size_t top_n = limit == 0 || sort_all_rows ? 0 : limit + offset;
       rows_to_sort->sort(
           source_work_unit.exe_unit.sort_info.order_entries, top_n, executor_);
+      if (cache_sorted_result && !rows_to_sort->isPermutationBufferEmpty()) {
+        const auto permutation_size = rows_to_sort->getPermutationBuffer().size();
+        // A streaming top-n result only holds the first limit + offset rows, like the
+        // permutation of a top-n sort.
+        const bool streaming_top_n = rows_to_sort->getQueryMemDesc().useStreamingTopN();
+        const size_t sorted_rows = streaming_top_n || top_n ? limit + offset : 0;
+        SortedResultCache::put(
+            cache_key,
+            {ResultSet::createSortedPage(rows_to_sort, 0, 0),
+             source_result.getTargetsMeta(),
+             sorted_rows ? std::min(permutation_size, sorted_rows) : permutation_size,
+             !sorted_rows || permutation_size < sorted_rows,
+             rows_to_sort->getBufferSizeBytes(ExecutorDeviceType::CPU) +
+                 permutation_size * sizeof(uint32_t)});
+      }
     }
     if (limit || offset) {
       if (g_cluster && sort->collationCount() == 0) {
@@ -2755,7 +2847,8 @@ inline bool can_use_bump_allocator(const RelAlgExecutionUnit& ra_exe_unit,
                                    const CompilationOptions& co,
                                    const ExecutionOptions& eo) {
   return g_enable_bump_allocator && (co.device_type == ExecutorDeviceType::GPU) &&
-         !eo.output_columnar_hint && ra_exe_unit.sort_info.order_entries.empty();
+         !eo.output_columnar_hint && ra_exe_unit.sort_info.order_entries.empty() &&
+         !get_unnest_array(ra_exe_unit.target_exprs);
 }
 
 }  // namespace
@@ -2826,7 +2919,8 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
         table_infos.front().info.fragments.front().getNumTuples();
     ra_exe_unit.scan_limit = max_groups_buffer_entry_guess;
   } else if (compute_output_buffer_size(ra_exe_unit) && !isRowidLookup(work_unit)) {
-    if (previous_count && !exe_unit_has_quals(ra_exe_unit)) {
+    if (previous_count && !exe_unit_has_quals(ra_exe_unit) &&
+        !get_unnest_array(ra_exe_unit.target_exprs)) {
       ra_exe_unit.scan_limit = *previous_count;
     } else {
       // TODO(adb): enable bump allocator path for render queries
@@ -2935,12 +3029,22 @@ std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_u
                                                           const bool is_agg,
                                                           const CompilationOptions& co,
                                                           const ExecutionOptions& eo) {
+  const auto unnest_array = get_unnest_array(work_unit.exe_unit.target_exprs);
+  // a projection which unnests an array outputs a row for each of its elements
   const auto count =
-      makeExpr<Analyzer::AggExpr>(SQLTypeInfo(g_bigint_count ? kBIGINT : kINT, false),
-                                  kCOUNT,
-                                  nullptr,
-                                  false,
-                                  nullptr);
+      unnest_array
+          ? makeExpr<Analyzer::AggExpr>(
+                SQLTypeInfo(kBIGINT, false),
+                kSUM,
+                makeExpr<Analyzer::CardinalityExpr>(unnest_array->deep_copy()),
+                false,
+                nullptr)
+          : makeExpr<Analyzer::AggExpr>(
+                SQLTypeInfo(g_bigint_count ? kBIGINT : kINT, false),
+                kCOUNT,
+                nullptr,
+                false,
+                nullptr);
   const auto count_all_exe_unit =
       create_count_all_execution_unit(work_unit.exe_unit, count);
   size_t one{1};
@@ -2971,6 +3075,10 @@ std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_u
   CHECK(count_scalar_tv);
   const auto count_ptr = boost::get<int64_t>(count_scalar_tv);
   CHECK(count_ptr);
+  if (unnest_array && *count_ptr == inline_int_null_value<int64_t>()) {
+    // no row has a non-null array
+    return size_t(1);
+  }
   CHECK_GE(*count_ptr, 0);
   auto count_upper_bound = static_cast<size_t>(*count_ptr);
   return std::max(count_upper_bound, size_t(1));
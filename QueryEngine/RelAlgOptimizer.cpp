@@ -19,10 +19,16 @@
 #include "RexVisitor.h"
 #include "Visitors/RexSubQueryIdCollector.h"
 
+#include <algorithm>
+#include <functional>
 #include <numeric>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 
+extern bool g_bigint_count;
+
 namespace {
 
 class RexProjectInputRedirector : public RexDeepCopyVisitor {
@@ -1716,6 +1722,485 @@ void hoist_filter_cond_to_cross_join(
   }
 }
 
+namespace {
+
+// Position in the output of the join of an input which refers to either input of the
+// join, like those of its condition, or to the filter over the join.
+std::optional<size_t> get_join_output_index(const RexInput* input,
+                                            const RelJoin* join,
+                                            const RelFilter* filter) {
+  const auto source = input->getSourceNode();
+  if ((filter && source == filter) || source == join->getInput(0)) {
+    return input->getIndex();
+  }
+  if (source == join->getInput(1)) {
+    return join->getInput(0)->size() + input->getIndex();
+  }
+  return std::nullopt;
+}
+
+class JoinOutputIndexCollector : public RexVisitor<std::set<size_t>> {
+ public:
+  JoinOutputIndexCollector(const RelJoin* join, const RelFilter* filter)
+      : join_(join), filter_(filter) {}
+
+  // Anything which isn't an output of the join shows up as an index past its end.
+  std::set<size_t> visitInput(const RexInput* input) const override {
+    const auto idx = get_join_output_index(input, join_, filter_);
+    return {idx ? *idx : join_->size()};
+  }
+
+  std::set<size_t> visitSubQuery(const RexSubQuery*) const override {
+    return {join_->size()};
+  }
+
+ protected:
+  std::set<size_t> aggregateResult(const std::set<size_t>& aggregate,
+                                   const std::set<size_t>& next_result) const override {
+    auto result = aggregate;
+    result.insert(next_result.begin(), next_result.end());
+    return result;
+  }
+
+ private:
+  const RelJoin* join_;
+  const RelFilter* filter_;
+};
+
+// Renumbers the outputs of the join read by an expression. The inputs which referred to
+// the inputs of the join are bound to new_lhs and new_rhs, or all of them to new_source
+// if set.
+class JoinOutputIndexRemapper : public RexDeepCopyVisitor {
+ public:
+  JoinOutputIndexRemapper(const RelJoin* join,
+                          const RelFilter* filter,
+                          const std::unordered_map<size_t, size_t>& old_to_new_idx,
+                          const RelAlgNode* new_lhs,
+                          const RelAlgNode* new_rhs,
+                          const RelAlgNode* new_source = nullptr)
+      : join_(join)
+      , filter_(filter)
+      , old_to_new_idx_(old_to_new_idx)
+      , new_lhs_(new_lhs)
+      , new_rhs_(new_rhs)
+      , new_source_(new_source) {}
+
+  RetType visitInput(const RexInput* input) const override {
+    const auto old_idx = get_join_output_index(input, join_, filter_);
+    CHECK(old_idx);
+    const auto idx_it = old_to_new_idx_.find(*old_idx);
+    CHECK(idx_it != old_to_new_idx_.end());
+    const auto new_idx = idx_it->second;
+    if (new_source_) {
+      return std::make_unique<RexInput>(new_source_, new_idx);
+    }
+    const auto source = input->getSourceNode();
+    if (filter_ && source == filter_) {
+      return std::make_unique<RexInput>(source, new_idx);
+    }
+    const auto new_lhs_size = new_lhs_->size();
+    return new_idx < new_lhs_size
+               ? std::make_unique<RexInput>(new_lhs_, new_idx)
+               : std::make_unique<RexInput>(new_rhs_, new_idx - new_lhs_size);
+  }
+
+ private:
+  const RelJoin* join_;
+  const RelFilter* filter_;
+  const std::unordered_map<size_t, size_t>& old_to_new_idx_;
+  const RelAlgNode* new_lhs_;
+  const RelAlgNode* new_rhs_;
+  const RelAlgNode* new_source_;
+};
+
+// Collects the join output indices of the fact input which the conjuncts of the
+// condition compare for equality with the other input.
+void collect_equi_join_fact_keys(const RexScalar* condition,
+                                 const JoinOutputIndexCollector& collector,
+                                 const std::function<bool(size_t)>& is_fact_idx,
+                                 std::set<size_t>& fact_join_keys) {
+  const auto oper = dynamic_cast<const RexOperator*>(condition);
+  if (!oper) {
+    return;
+  }
+  if (oper->getOperator() == kAND) {
+    for (size_t i = 0; i < oper->size(); ++i) {
+      collect_equi_join_fact_keys(
+          oper->getOperand(i), collector, is_fact_idx, fact_join_keys);
+    }
+    return;
+  }
+  if (oper->getOperator() != kEQ || oper->size() != 2 ||
+      !dynamic_cast<const RexInput*>(oper->getOperand(0)) ||
+      !dynamic_cast<const RexInput*>(oper->getOperand(1))) {
+    return;
+  }
+  const auto lhs_idx = *collector.visit(oper->getOperand(0)).begin();
+  const auto rhs_idx = *collector.visit(oper->getOperand(1)).begin();
+  if (is_fact_idx(lhs_idx) != is_fact_idx(rhs_idx)) {
+    fact_join_keys.insert(is_fact_idx(lhs_idx) ? lhs_idx : rhs_idx);
+  }
+}
+
+struct PreAggregatedJoinInput {
+  const RelAlgNode* join;
+  std::shared_ptr<RelAlgNode> project;
+  std::shared_ptr<RelAlgNode> aggregate;
+};
+
+// Returns whether values of the type can be the keys of a group by.
+bool is_groupable_type(const SQLTypeInfo& ti) {
+  return !(ti.is_string() && ti.get_compression() == kENCODING_NONE) && !ti.is_array() &&
+         !ti.is_geometry();
+}
+
+// Returns whether a group by can use the given output of the node as a key. Outputs
+// whose type isn't known before translation, like CASE expressions, aren't.
+bool is_groupable_output(const RelAlgNode* node,
+                         const size_t idx,
+                         const Catalog_Namespace::Catalog& cat) {
+  if (const auto scan = dynamic_cast<const RelScan*>(node)) {
+    const auto cd =
+        cat.getMetadataForColumnBySpi(scan->getTableDescriptor()->tableId, idx + 1);
+    return cd && is_groupable_type(cd->columnType);
+  }
+  if (dynamic_cast<const RelFilter*>(node)) {
+    return is_groupable_output(node->getInput(0), idx, cat);
+  }
+  if (const auto aggregate = dynamic_cast<const RelAggregate*>(node)) {
+    const auto groupby_count = aggregate->getGroupByCount();
+    if (idx < groupby_count) {
+      return is_groupable_output(node->getInput(0), idx, cat);
+    }
+    return is_groupable_type(aggregate->getAggExprs()[idx - groupby_count]->getType());
+  }
+  if (const auto project = dynamic_cast<const RelProject*>(node)) {
+    const auto expr = project->getProjectAt(idx);
+    if (const auto input = dynamic_cast<const RexInput*>(expr)) {
+      return is_groupable_output(input->getSourceNode(), input->getIndex(), cat);
+    }
+    if (const auto oper = dynamic_cast<const RexOperator*>(expr)) {
+      return is_groupable_type(oper->getType());
+    }
+    if (const auto literal = dynamic_cast<const RexLiteral*>(expr)) {
+      return !IS_STRING(literal->getType());
+    }
+  }
+  return false;
+}
+
+// Returns the column of a table which the given output of the node passes on unchanged,
+// or null if the output is computed.
+const ColumnDescriptor* get_scanned_column(const RelAlgNode* node,
+                                           const size_t idx,
+                                           const Catalog_Namespace::Catalog& cat) {
+  if (const auto scan = dynamic_cast<const RelScan*>(node)) {
+    return cat.getMetadataForColumnBySpi(scan->getTableDescriptor()->tableId, idx + 1);
+  }
+  if (dynamic_cast<const RelFilter*>(node)) {
+    return get_scanned_column(node->getInput(0), idx, cat);
+  }
+  if (const auto aggregate = dynamic_cast<const RelAggregate*>(node)) {
+    return idx < aggregate->getGroupByCount()
+               ? get_scanned_column(node->getInput(0), idx, cat)
+               : nullptr;
+  }
+  if (const auto project = dynamic_cast<const RelProject*>(node)) {
+    const auto input = dynamic_cast<const RexInput*>(project->getProjectAt(idx));
+    return input ? get_scanned_column(input->getSourceNode(), input->getIndex(), cat)
+                 : nullptr;
+  }
+  return nullptr;
+}
+
+// Rewrites the aggregate if it reads an inner join through a projection, and maybe a
+// filter, and all its aggregates read the same input of the join. Returns the nodes
+// which pre-aggregate that input, or nulls if the aggregate doesn't qualify.
+PreAggregatedJoinInput pre_aggregate_join_input(
+    RelAggregate* aggregate,
+    const std::unordered_map<const RelAlgNode*, std::unordered_set<const RelAlgNode*>>&
+        web,
+    const Catalog_Namespace::Catalog& cat) {
+  auto has_single_user = [&web](const RelAlgNode* node, const RelAlgNode* user) {
+    const auto usrs_it = web.find(node);
+    return usrs_it != web.end() && usrs_it->second.size() == 1 &&
+           *usrs_it->second.begin() == user;
+  };
+  const auto groupby_count = aggregate->getGroupByCount();
+  const auto project = dynamic_cast<const RelProject*>(aggregate->getInput(0));
+  if (!groupby_count || !project || project->hasWindowFunctionExpr() ||
+      !has_single_user(project, aggregate)) {
+    return {};
+  }
+  const auto filter = dynamic_cast<const RelFilter*>(project->getInput(0));
+  const auto join =
+      dynamic_cast<const RelJoin*>(filter ? filter->getInput(0) : project->getInput(0));
+  if (!join || join->getJoinType() != JoinType::INNER ||
+      join->getInput(0) == join->getInput(1) ||
+      !has_single_user(join, filter ? static_cast<const RelAlgNode*>(filter) : project) ||
+      (filter && !has_single_user(filter, project))) {
+    return {};
+  }
+  const auto lhs_size = join->getInput(0)->size();
+  JoinOutputIndexCollector collector(join, filter);
+  // Sums and counts add up over the partial groups, minimums and maximums are taken
+  // again. The aggregates decide which input is pre-aggregated, counts of rows alone
+  // leave it to the probe side.
+  std::optional<bool> fact_is_lhs;
+  std::vector<size_t> operands;
+  for (const auto& agg : aggregate->getAggExprs()) {
+    const auto agg_kind = agg->getKind();
+    if ((agg_kind != kSUM && agg_kind != kCOUNT && agg_kind != kMIN &&
+         agg_kind != kMAX) ||
+        agg->isDistinct() || agg->size() > 1) {
+      return {};
+    }
+    if (!agg->size()) {
+      continue;
+    }
+    const auto operand = agg->getOperand(0);
+    for (const auto idx : collector.visit(project->getProjectAt(operand))) {
+      if (idx >= join->size() || (fact_is_lhs && *fact_is_lhs != (idx < lhs_size))) {
+        return {};
+      }
+      fact_is_lhs = idx < lhs_size;
+    }
+    if (std::find(operands.begin(), operands.end(), operand) == operands.end()) {
+      operands.push_back(operand);
+    }
+  }
+  const bool pre_aggregate_lhs = fact_is_lhs.value_or(true);
+  const auto fact = join->getAndOwnInput(pre_aggregate_lhs ? 0 : 1);
+  if (!dynamic_cast<const RelScan*>(fact.get()) &&
+      !dynamic_cast<const RelProject*>(fact.get()) &&
+      !dynamic_cast<const RelFilter*>(fact.get()) &&
+      !dynamic_cast<const RelAggregate*>(fact.get())) {
+    return {};
+  }
+  const auto dim = join->getInput(pre_aggregate_lhs ? 1 : 0);
+  const size_t fact_base = pre_aggregate_lhs ? 0 : lhs_size;
+  const size_t dim_base = pre_aggregate_lhs ? lhs_size : 0;
+  auto is_fact_idx = [fact_base, &fact](const size_t idx) {
+    return idx >= fact_base && idx < fact_base + fact->size();
+  };
+  // The columns of the fact input read above the join become the keys of the partial
+  // aggregate, the join keys among them.
+  std::vector<const RexScalar*> exprs_above_join{join->getCondition()};
+  if (filter) {
+    exprs_above_join.push_back(filter->getCondition());
+  }
+  for (size_t i = 0; i < groupby_count; ++i) {
+    exprs_above_join.push_back(project->getProjectAt(i));
+  }
+  std::set<size_t> fact_keys;
+  for (const auto expr : exprs_above_join) {
+    for (const auto idx : collector.visit(expr)) {
+      if (idx >= join->size()) {
+        return {};
+      }
+      if (is_fact_idx(idx)) {
+        fact_keys.insert(idx);
+      }
+    }
+  }
+  // None encoded strings, arrays and geo columns can't be the keys of the partial
+  // aggregate.
+  for (const auto idx : fact_keys) {
+    if (!is_groupable_output(fact.get(), idx - fact_base, cat)) {
+      return {};
+    }
+  }
+  std::set<size_t> fact_join_keys;
+  collect_equi_join_fact_keys(
+      join->getCondition(), collector, is_fact_idx, fact_join_keys);
+  if (filter) {
+    collect_equi_join_fact_keys(
+        filter->getCondition(), collector, is_fact_idx, fact_join_keys);
+  }
+  if (fact_join_keys.empty()) {
+    return {};
+  }
+  // The row id is unique and a shard key is chosen to spread the rows of the table, so
+  // a fact input joined on either has about one row per key and nothing to collapse.
+  for (const auto idx : fact_join_keys) {
+    const auto cd = get_scanned_column(fact.get(), idx - fact_base, cat);
+    if (!cd) {
+      continue;
+    }
+    const auto td = cat.getMetadataForTable(cd->tableId, false);
+    if (cd->isVirtualCol || (td && td->nShards && td->shardedColumnId == cd->columnId)) {
+      return {};
+    }
+  }
+
+  std::vector<std::unique_ptr<const RexScalar>> pre_exprs;
+  std::vector<std::string> pre_fields;
+  for (const auto idx : fact_keys) {
+    pre_exprs.push_back(std::make_unique<RexInput>(fact.get(), idx - fact_base));
+    pre_fields.push_back(get_field_name(fact.get(), idx - fact_base));
+  }
+  std::unordered_map<size_t, size_t> fact_input_idx;
+  for (size_t i = 0; i < fact->size(); ++i) {
+    fact_input_idx.emplace(fact_base + i, i);
+  }
+  JoinOutputIndexRemapper to_fact_input(
+      join, filter, fact_input_idx, nullptr, nullptr, fact.get());
+  std::unordered_map<size_t, size_t> operand_to_pre_idx;
+  for (const auto operand : operands) {
+    operand_to_pre_idx.emplace(operand, pre_exprs.size());
+    pre_exprs.push_back(to_fact_input.visit(project->getProjectAt(operand)));
+    pre_fields.push_back(project->getFieldName(operand));
+  }
+  auto pre_project = std::make_shared<RelProject>(pre_exprs, pre_fields, fact);
+
+  std::vector<std::unique_ptr<const RexAgg>> pre_aggs;
+  std::vector<std::unique_ptr<const RexAgg>> final_aggs;
+  std::vector<std::string> pre_agg_fields(pre_fields.begin(),
+                                          pre_fields.begin() + fact_keys.size());
+  for (size_t i = 0; i < aggregate->getAggExprsCount(); ++i) {
+    const auto& agg = aggregate->getAggExprs()[i];
+    std::vector<size_t> pre_operands;
+    if (agg->size()) {
+      pre_operands.push_back(operand_to_pre_idx.at(agg->getOperand(0)));
+    }
+    pre_aggs.push_back(
+        std::make_unique<RexAgg>(agg->getKind(), false, agg->getType(), pre_operands));
+    final_aggs.push_back(
+        std::make_unique<RexAgg>(agg->getKind() == kCOUNT ? kSUM : agg->getKind(),
+                                 false,
+                                 agg->getType(),
+                                 std::vector<size_t>{groupby_count + i}));
+    pre_agg_fields.push_back(aggregate->getFieldName(groupby_count + i));
+  }
+  auto pre_aggregate = std::make_shared<RelAggregate>(
+      fact_keys.size(), pre_aggs, pre_agg_fields, pre_project);
+
+  // Renumber the outputs of the join for the smaller fact input.
+  const size_t new_fact_base = pre_aggregate_lhs ? 0 : dim->size();
+  const size_t new_dim_base = pre_aggregate_lhs ? pre_aggregate->size() : 0;
+  std::unordered_map<size_t, size_t> old_to_new_idx;
+  size_t key_idx = 0;
+  for (const auto idx : fact_keys) {
+    old_to_new_idx.emplace(idx, new_fact_base + key_idx++);
+  }
+  for (size_t i = 0; i < dim->size(); ++i) {
+    old_to_new_idx.emplace(dim_base + i, new_dim_base + i);
+  }
+  JoinOutputIndexRemapper remapper(join,
+                                   filter,
+                                   old_to_new_idx,
+                                   pre_aggregate_lhs ? pre_aggregate.get() : dim,
+                                   pre_aggregate_lhs ? dim : pre_aggregate.get());
+  auto new_condition = remapper.visit(join->getCondition());
+  std::unique_ptr<const RexScalar> new_filter_condition;
+  if (filter) {
+    new_filter_condition = remapper.visit(filter->getCondition());
+  }
+  std::vector<std::unique_ptr<const RexScalar>> new_exprs;
+  std::vector<std::string> new_fields;
+  for (size_t i = 0; i < groupby_count; ++i) {
+    new_exprs.push_back(remapper.visit(project->getProjectAt(i)));
+    new_fields.push_back(project->getFieldName(i));
+  }
+  // Over a filter the projection reads the outputs of the join, else its inputs.
+  for (size_t i = 0; i < aggregate->getAggExprsCount(); ++i) {
+    const auto partial_idx = fact_keys.size() + i;
+    new_exprs.push_back(
+        filter ? std::make_unique<RexInput>(filter, new_fact_base + partial_idx)
+               : std::make_unique<RexInput>(pre_aggregate.get(), partial_idx));
+    new_fields.push_back(aggregate->getFieldName(groupby_count + i));
+  }
+
+  auto mutable_join = const_cast<RelJoin*>(join);
+  mutable_join->setCondition(new_condition);
+  mutable_join->replaceInput(fact, pre_aggregate);
+  if (filter) {
+    const_cast<RelFilter*>(filter)->setCondition(new_filter_condition);
+  }
+  auto mutable_project = const_cast<RelProject*>(project);
+  mutable_project->setExpressions(new_exprs);
+  mutable_project->setFields(new_fields);
+  aggregate->setAggExprs(final_aggs);
+  return {join, pre_project, pre_aggregate};
+}
+
+}  // namespace
+
+// Eager aggregation: an aggregate over an inner join of a large fact input with a
+// dimension input pre-aggregates the fact input by the join keys, so that the join
+// probes one row per key instead of one per fact row:
+//   Aggregate(d.g, SUM(f.a)) <- Project <- Join(f, d, f.k = d.k)
+// becomes
+//   Aggregate(d.g, SUM(s)) <- Project <- Join(Aggregate(f.k, SUM(f.a) AS s), d, ...)
+// Counts become sums of the partial counts. It only pays off when the fact input has
+// many rows per join key. Joins on the row id or the shard key of the fact table are
+// left alone; other key cardinalities aren't known here, hence the flag which enables
+// it.
+void pre_aggregate_below_joins(std::vector<std::shared_ptr<RelAlgNode>>& nodes,
+                               const Catalog_Namespace::Catalog& cat) noexcept {
+  auto web = build_du_web(nodes);
+  std::unordered_map<const RelAlgNode*, PreAggregatedJoinInput> pre_aggregated_inputs;
+  std::unordered_map<const RelAlgNode*, std::shared_ptr<RelAlgNode>> count_casts;
+  for (auto node : nodes) {
+    auto aggregate = std::dynamic_pointer_cast<RelAggregate>(node);
+    if (!aggregate) {
+      continue;
+    }
+    auto pre_aggregated_input = pre_aggregate_join_input(aggregate.get(), web, cat);
+    if (!pre_aggregated_input.aggregate) {
+      continue;
+    }
+    pre_aggregated_inputs.emplace(pre_aggregated_input.join, pre_aggregated_input);
+    const auto& aggs = aggregate->getAggExprs();
+    if (g_bigint_count ||
+        std::none_of(aggs.begin(), aggs.end(), [](const auto& agg) {
+          return agg->getKind() == kCOUNT;
+        })) {
+      continue;
+    }
+    // The sum of the partial counts is a BIGINT, cast it back to the type of a count.
+    std::vector<std::unique_ptr<const RexScalar>> cast_exprs;
+    for (size_t i = 0; i < aggregate->size(); ++i) {
+      auto input = std::make_unique<RexInput>(aggregate.get(), i);
+      const auto groupby_count = aggregate->getGroupByCount();
+      if (i < groupby_count || aggs[i - groupby_count]->getKind() != kCOUNT) {
+        cast_exprs.push_back(std::move(input));
+        continue;
+      }
+      std::vector<std::unique_ptr<const RexScalar>> operands;
+      operands.push_back(std::move(input));
+      cast_exprs.push_back(
+          std::make_unique<RexOperator>(kCAST, operands, SQLTypeInfo(kINT, false)));
+    }
+    auto count_cast =
+        std::make_shared<RelProject>(cast_exprs, aggregate->getFields(), aggregate);
+    const auto usrs_it = web.find(aggregate.get());
+    if (usrs_it != web.end()) {
+      for (auto usr : usrs_it->second) {
+        const_cast<RelAlgNode*>(usr)->replaceInput(aggregate, count_cast);
+      }
+    }
+    count_casts.emplace(aggregate.get(), count_cast);
+  }
+  if (pre_aggregated_inputs.empty()) {
+    return;
+  }
+  std::vector<std::shared_ptr<RelAlgNode>> new_nodes;
+  for (auto node : nodes) {
+    const auto pre_aggregated_it = pre_aggregated_inputs.find(node.get());
+    if (pre_aggregated_it != pre_aggregated_inputs.end()) {
+      new_nodes.push_back(pre_aggregated_it->second.project);
+      new_nodes.push_back(pre_aggregated_it->second.aggregate);
+    }
+    new_nodes.push_back(node);
+    const auto count_cast_it = count_casts.find(node.get());
+    if (count_cast_it != count_casts.end()) {
+      new_nodes.push_back(count_cast_it->second);
+    }
+  }
+  nodes.swap(new_nodes);
+}
+
 // For some reason, Calcite generates Sort, Project, Sort sequences where the
 // two Sort nodes are identical and the Project is identity. Simplify this
 // pattern by re-binding the input of the second sort to the input of the first.
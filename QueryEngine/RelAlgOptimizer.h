@@ -22,6 +22,10 @@
 #include <unordered_set>
 #include <vector>
 
+namespace Catalog_Namespace {
+class Catalog;
+}  // namespace Catalog_Namespace
+
 class RelAlgNode;
 class RexSubQuery;
 
@@ -34,6 +38,8 @@ void eliminate_dead_subqueries(std::vector<std::shared_ptr<RexSubQuery>>& subque
 void fold_filters(std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
 void hoist_filter_cond_to_cross_join(
     std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
+void pre_aggregate_below_joins(std::vector<std::shared_ptr<RelAlgNode>>& nodes,
+                               const Catalog_Namespace::Catalog& cat) noexcept;
 void simplify_sort(std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
 void sink_projected_boolean_expr_to_join(
     std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
@@ -220,6 +220,39 @@ bool is_agg_supported_for_type(const SQLAgg& agg_kind, const SQLTypeInfo& arg_ti
   return true;
 }
 
+// Returns the quantile parameter of APPROX_QUANTILE, PERCENTILE_CONT and PERCENTILE_DISC
+// as a DOUBLE constant; APPROX_MEDIAN is the single argument form with an implied 0.5.
+std::shared_ptr<Analyzer::Constant> make_quantile_constant(
+    const RexAgg* rex,
+    const std::vector<std::shared_ptr<Analyzer::Expr>>& scalar_sources) {
+  SQLTypeInfo const double_ti(kDOUBLE, true);
+  if (rex->size() == 1) {
+    Datum d;
+    d.doubleval = 0.5;
+    return makeExpr<Analyzer::Constant>(double_ti, false, d);
+  }
+  CHECK_EQ(rex->size(), 2u);
+  const auto agg_name =
+      rex->getKind() == kAPPROX_MEDIAN ? "APPROX_QUANTILE" : toString(rex->getKind());
+  const auto operand = rex->getOperand(1);
+  CHECK_LT(operand, scalar_sources.size());
+  auto q_expr =
+      std::dynamic_pointer_cast<Analyzer::Constant>(scalar_sources[operand]);
+  if (!q_expr || !q_expr->get_type_info().is_number() || q_expr->get_is_null()) {
+    throw std::runtime_error(
+        agg_name + "'s second parameter should be a numeric literal between 0 and 1");
+  }
+  // Cast a copy, the scalar source may be shared with other expressions.
+  q_expr = std::dynamic_pointer_cast<Analyzer::Constant>(
+      q_expr->deep_copy()->add_cast(double_ti));
+  CHECK(q_expr);
+  const double q = q_expr->get_constval().doubleval;
+  if (!(0.0 <= q && q <= 1.0)) {
+    throw std::runtime_error(agg_name + "'s second parameter must be between 0 and 1");
+  }
+  return q_expr;
+}
+
 }  // namespace
 
 std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateAggregateRex(
@@ -244,6 +277,8 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateAggregateRex(
             "APPROX_COUNT_DISTINCT's second parameter should be SMALLINT literal between "
             "1 and 100");
       }
+    } else if (is_quantile_agg(agg_kind)) {
+      err_rate = make_quantile_constant(rex, scalar_sources);
     }
     const auto& arg_ti = arg_expr->get_type_info();
     if (!is_agg_supported_for_type(agg_kind, arg_ti)) {
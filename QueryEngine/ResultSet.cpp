@@ -28,6 +28,7 @@
 #include "Execute.h"
 #include "GpuMemUtils.h"
 #include "InPlaceSort.h"
+#include "NormalizedKeySort.h"
 #include "OutputBufferInitialization.h"
 #include "RuntimeFunctions.h"
 #include "Shared/Intervals.h"
@@ -542,6 +543,10 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
 
   permutation_ = initPermutationBuffer(0, 1);
 
+  if (!use_heap && normalizedKeySort(order_entries, executor)) {
+    return;
+  }
+
   auto compare = createComparator(order_entries, use_heap, executor);
 
   if (use_heap) {
@@ -592,6 +597,61 @@ const std::vector<uint32_t>& ResultSet::getPermutationBuffer() const {
   return permutation_;
 }
 
+std::shared_ptr<ResultSet> ResultSet::createSortedPage(
+    const std::shared_ptr<const ResultSet>& rows,
+    const size_t offset,
+    const size_t limit) {
+  CHECK(rows->storage_);
+  CHECK_LT(offset, rows->permutation_.size());
+  auto page = std::make_shared<ResultSet>(rows->targets_,
+                                          rows->lazy_fetch_info_,
+                                          std::vector<std::vector<const int8_t*>>{},
+                                          std::vector<std::vector<int64_t>>{},
+                                          std::vector<int64_t>{},
+                                          rows->device_type_,
+                                          rows->device_id_,
+                                          rows->query_mem_desc_,
+                                          rows->row_set_mem_owner_,
+                                          rows->catalog_,
+                                          rows->block_size_,
+                                          rows->grid_size_);
+  auto share_storage = [&page](const ResultSetStorage& storage) {
+    auto shared_storage = std::unique_ptr<ResultSetStorage>(
+        new ResultSetStorage(page->targets_,
+                             storage.query_mem_desc_,
+                             storage.buff_,
+                             /*buff_is_provided=*/true));
+    shared_storage->target_init_vals_ = storage.target_init_vals_;
+    shared_storage->count_distinct_sets_mapping_ = storage.count_distinct_sets_mapping_;
+    return shared_storage;
+  };
+  page->storage_ = share_storage(*rows->storage_);
+  for (const auto& appended_storage : rows->appended_storage_) {
+    page->appended_storage_.push_back(share_storage(*appended_storage));
+  }
+  page->col_buffers_ = rows->col_buffers_;
+  page->frag_offsets_ = rows->frag_offsets_;
+  page->consistent_frag_sizes_ = rows->consistent_frag_sizes_;
+  page->serialized_varlen_buffer_ = rows->serialized_varlen_buffer_;
+  page->separate_varlen_storage_valid_ = rows->separate_varlen_storage_valid_;
+  const auto page_begin = rows->permutation_.begin() + offset;
+  const auto page_end = limit && limit < rows->permutation_.size() - offset
+                            ? page_begin + limit
+                            : rows->permutation_.end();
+  page->permutation_.assign(page_begin, page_end);
+  page->page_source_ = rows;
+  return page;
+}
+
+bool ResultSet::referencesChunkBuffers() const {
+  return !chunks_.empty() ||
+         std::any_of(lazy_fetch_info_.begin(),
+                     lazy_fetch_info_.end(),
+                     [](const ColumnLazyFetchInfo& col_lazy_fetch) {
+                       return col_lazy_fetch.is_lazily_fetched;
+                     });
+}
+
 void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries,
                             const size_t top_n,
                             const Executor* executor) {
@@ -681,7 +741,7 @@ ResultSet::ApproxMedianBuffers ResultSet::ResultSetComparator<
     BUFFER_ITERATOR_TYPE>::materializeApproxMedianColumns() const {
   ResultSet::ApproxMedianBuffers approx_median_materialized_buffers;
   for (const auto& order_entry : order_entries_) {
-    if (result_set_->targets_[order_entry.tle_no - 1].agg_kind == kAPPROX_MEDIAN) {
+    if (is_quantile_agg(result_set_->targets_[order_entry.tle_no - 1].agg_kind)) {
       approx_median_materialized_buffers.emplace_back(
           materializeApproxMedianColumn(order_entry));
     }
@@ -689,6 +749,25 @@ ResultSet::ApproxMedianBuffers ResultSet::ResultSetComparator<
   return approx_median_materialized_buffers;
 }
 
+template <typename BUFFER_ITERATOR_TYPE>
+ResultSet::DictionaryRanks
+ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeDictionaryRanks() const {
+  ResultSet::DictionaryRanks dictionary_ranks;
+  for (const auto& order_entry : order_entries_) {
+    const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
+    const auto entry_ti = get_compact_type(agg_info);
+    std::shared_ptr<const std::vector<int32_t>> ranks;
+    if (entry_ti.is_string() && entry_ti.get_compression() == kENCODING_DICT &&
+        !is_distinct_target(agg_info) && executor_) {
+      const auto string_dict_proxy = executor_->getStringDictionaryProxy(
+          entry_ti.get_comp_param(), result_set_->row_set_mem_owner_, false);
+      ranks = getDictionaryRanks(string_dict_proxy, result_set_->entryCount());
+    }
+    dictionary_ranks.push_back(std::move(ranks));
+  }
+  return dictionary_ranks;
+}
+
 template <typename BUFFER_ITERATOR_TYPE>
 std::vector<int64_t>
 ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeCountDistinctColumn(
@@ -735,12 +814,25 @@ ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeCountDistinctCo
   return count_distinct_materialized_buffer;
 }
 
-double ResultSet::calculateQuantile(quantile::TDigest* const t_digest, double const q) {
+double ResultSet::calculateQuantile(quantile::TDigest* const t_digest) {
   static_assert(sizeof(int64_t) == sizeof(quantile::TDigest*));
-  CHECK(t_digest) << "t_digest=" << (void*)t_digest << ", q=" << q;
+  CHECK(t_digest);
   t_digest->mergeBuffer();
-  double const median = t_digest->quantile(q);
-  return boost::math::isnan(median) ? NULL_DOUBLE : median;
+  double const quantile = t_digest->quantile();
+  return boost::math::isnan(quantile) ? NULL_DOUBLE : quantile;
+}
+
+double ResultSet::calculateQuantile(quantile::ExactQuantile* const exact_quantile) {
+  static_assert(sizeof(int64_t) == sizeof(quantile::ExactQuantile*));
+  CHECK(exact_quantile);
+  double const quantile = exact_quantile->quantile();
+  return boost::math::isnan(quantile) ? NULL_DOUBLE : quantile;
+}
+
+double ResultSet::calculateQuantile(const SQLAgg agg_kind, const int64_t handle) {
+  return agg_kind == kAPPROX_MEDIAN
+             ? calculateQuantile(reinterpret_cast<quantile::TDigest*>(handle))
+             : calculateQuantile(reinterpret_cast<quantile::ExactQuantile*>(handle));
 }
 
 template <typename BUFFER_ITERATOR_TYPE>
@@ -751,8 +843,9 @@ ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeApproxMedianCol
       result_set_->query_mem_desc_.getEntryCount());
   const size_t size = result_set_->permutation_.size();
   const size_t worker_count = cpu_threads();
-  const auto work = [this, &order_entry, &materialized_buffer](const size_t start,
-                                                               const size_t end) {
+  const auto agg_kind = result_set_->targets_[order_entry.tle_no - 1].agg_kind;
+  const auto work = [this, &order_entry, &materialized_buffer, agg_kind](
+                        const size_t start, const size_t end) {
     for (size_t i = start; i < end; ++i) {
       const uint32_t permuted_idx = result_set_->permutation_[i];
       const auto storage_lookup_result = result_set_->findStorage(permuted_idx);
@@ -761,9 +854,7 @@ ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::materializeApproxMedianCol
       const auto value = buffer_itr_.getColumnInternal(
           storage->buff_, off, order_entry.tle_no - 1, storage_lookup_result);
       materialized_buffer[permuted_idx] =
-          value.i1
-              ? calculateQuantile(reinterpret_cast<quantile::TDigest*>(value.i1), 0.5)
-              : NULL_DOUBLE;
+          value.i1 ? calculateQuantile(agg_kind, value.i1) : NULL_DOUBLE;
     }
   };
   threadpool::FuturesThreadPool<void> thread_pool;
@@ -788,27 +879,14 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
   const auto fixedup_rhs = rhs_storage_lookup_result.fixedup_entry_idx;
   size_t materialized_count_distinct_buffer_idx{0};
   size_t materialized_approx_median_buffer_idx{0};
+  size_t order_entry_idx{0};
 
   for (const auto& order_entry : order_entries_) {
     CHECK_GE(order_entry.tle_no, 1);
+    const auto& dictionary_ranks = dictionary_ranks_[order_entry_idx++];
     const auto& agg_info = result_set_->targets_[order_entry.tle_no - 1];
     const auto entry_ti = get_compact_type(agg_info);
-    bool float_argument_input = takes_float_argument(agg_info);
-    // Need to determine if the float value has been stored as float
-    // or if it has been compacted to a different (often larger 8 bytes)
-    // in distributed case the floats are actually 4 bytes
-    // TODO the above takes_float_argument() is widely used wonder if this problem
-    // exists elsewhere
-    if (entry_ti.get_type() == kFLOAT) {
-      const auto is_col_lazy =
-          !result_set_->lazy_fetch_info_.empty() &&
-          result_set_->lazy_fetch_info_[order_entry.tle_no - 1].is_lazily_fetched;
-      if (result_set_->query_mem_desc_.getPaddedSlotWidthBytes(order_entry.tle_no - 1) ==
-          sizeof(float)) {
-        float_argument_input =
-            result_set_->query_mem_desc_.didOutputColumnar() ? !is_col_lazy : true;
-      }
-    }
+    const bool float_argument_input = result_set_->isFloatSortKey(order_entry.tle_no - 1);
 
     const bool use_desc_cmp = use_heap_ ? !order_entry.is_desc : order_entry.is_desc;
 
@@ -824,7 +902,7 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
         continue;
       }
       return use_desc_cmp ? lhs_sz > rhs_sz : lhs_sz < rhs_sz;
-    } else if (UNLIKELY(agg_info.agg_kind == kAPPROX_MEDIAN)) {
+    } else if (UNLIKELY(is_quantile_agg(agg_info.agg_kind))) {
       CHECK_LT(materialized_approx_median_buffer_idx,
                approx_median_materialized_buffers_.size());
       const auto& approx_median_materialized_buffer =
@@ -872,6 +950,16 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
                    entry_ti.get_compression() == kENCODING_DICT)) {
         CHECK_EQ(4, entry_ti.get_logical_size());
         CHECK(executor_);
+        if (dictionary_ranks && lhs_v.i1 >= 0 && rhs_v.i1 >= 0 &&
+            static_cast<size_t>(std::max(lhs_v.i1, rhs_v.i1)) <
+                dictionary_ranks->size()) {
+          const auto lhs_rank = (*dictionary_ranks)[lhs_v.i1];
+          const auto rhs_rank = (*dictionary_ranks)[rhs_v.i1];
+          if (lhs_rank == rhs_rank) {
+            continue;
+          }
+          return use_desc_cmp ? lhs_rank > rhs_rank : lhs_rank < rhs_rank;
+        }
         const auto string_dict_proxy = executor_->getStringDictionaryProxy(
             entry_ti.get_comp_param(), result_set_->row_set_mem_owner_, false);
         auto lhs_str = string_dict_proxy->getString(lhs_v.i1);
@@ -924,6 +1012,203 @@ bool ResultSet::ResultSetComparator<BUFFER_ITERATOR_TYPE>::operator()(
   return false;
 }
 
+bool ResultSet::isFloatSortKey(const size_t target_idx) const {
+  const auto& agg_info = targets_[target_idx];
+  bool float_argument_input = takes_float_argument(agg_info);
+  // Need to determine if the float value has been stored as float
+  // or if it has been compacted to a different (often larger 8 bytes)
+  // in distributed case the floats are actually 4 bytes
+  // TODO the above takes_float_argument() is widely used wonder if this problem
+  // exists elsewhere
+  if (get_compact_type(agg_info).get_type() == kFLOAT) {
+    const auto is_col_lazy =
+        !lazy_fetch_info_.empty() && lazy_fetch_info_[target_idx].is_lazily_fetched;
+    if (query_mem_desc_.getPaddedSlotWidthBytes(target_idx) == sizeof(float)) {
+      float_argument_input = query_mem_desc_.didOutputColumnar() ? !is_col_lazy : true;
+    }
+  }
+  return float_argument_input;
+}
+
+template <typename BUFFER_ITERATOR_TYPE>
+bool ResultSet::materializeNormalizedKeys(
+    const std::list<Analyzer::OrderEntry>& order_entries,
+    const Executor* executor,
+    const size_t thread_count,
+    std::vector<std::vector<uint64_t>>& key_words) const {
+  const BUFFER_ITERATOR_TYPE buffer_itr(this);
+  const size_t row_count = permutation_.size();
+  for (const auto& order_entry : order_entries) {
+    const size_t target_idx = order_entry.tle_no - 1;
+    const auto entry_ti = get_compact_type(targets_[target_idx]);
+    const bool float_argument_input = isFloatSortKey(target_idx);
+    const bool is_dict_string = entry_ti.is_string();
+    const bool nullable = !entry_ti.get_notnull();
+    // The null word sorts nulls before or after all the values, ahead of the value word.
+    const uint64_t null_word = order_entry.nulls_first ? 0 : 1;
+    std::vector<uint64_t> null_words(nullable ? row_count : 0);
+    std::vector<uint64_t> values(row_count);
+    std::atomic<bool> all_ints{true};
+    auto encode = [&](const size_t start, const size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        const auto storage_lookup_result = findStorage(permutation_[i]);
+        const auto value =
+            buffer_itr.getColumnInternal(storage_lookup_result.storage_ptr->buff_,
+                                         storage_lookup_result.fixedup_entry_idx,
+                                         target_idx,
+                                         storage_lookup_result);
+        if (!value.isInt()) {
+          all_ints = false;
+          return;
+        }
+        if (isNull(entry_ti, value, float_argument_input)) {
+          null_words[i] = null_word;
+          continue;
+        }
+        if (nullable) {
+          null_words[i] = 1 - null_word;
+        }
+        if (is_dict_string) {
+          // replaced by the rank of the string below
+          values[i] = static_cast<uint64_t>(value.i1);
+        } else if (entry_ti.is_fp()) {
+          values[i] = normalized_key_sort::encode_fp(
+              float_argument_input
+                  ? *reinterpret_cast<const float*>(may_alias_ptr(&value.i1))
+                  : *reinterpret_cast<const double*>(may_alias_ptr(&value.i1)));
+        } else {
+          values[i] = normalized_key_sort::encode_int(value.i1);
+        }
+      }
+    };
+    if (thread_count == 1) {
+      encode(0, row_count);
+    } else {
+      threadpool::FuturesThreadPool<void> thread_pool;
+      for (const auto interval : makeIntervals<size_t>(0, row_count, thread_count)) {
+        thread_pool.spawn(encode, interval.begin, interval.end);
+      }
+      thread_pool.join();
+    }
+    if (!all_ints) {
+      return false;
+    }
+    if (is_dict_string) {
+      auto is_null_row = [&](const size_t i) {
+        return nullable && null_words[i] == null_word;
+      };
+      CHECK(executor);
+      const auto string_dict_proxy = executor->getStringDictionaryProxy(
+          entry_ti.get_comp_param(), row_set_mem_owner_, false);
+      const auto dictionary_ranks = getDictionaryRanks(string_dict_proxy, row_count);
+      bool all_ranked{dictionary_ranks != nullptr};
+      for (size_t i = 0; i < row_count && all_ranked; ++i) {
+        all_ranked = is_null_row(i) || values[i] < dictionary_ranks->size();
+      }
+      if (all_ranked) {
+        for (size_t i = 0; i < row_count; ++i) {
+          if (!is_null_row(i)) {
+            values[i] = (*dictionary_ranks)[values[i]];
+          }
+        }
+      } else {
+        // Sort the distinct strings once and use their ranks as values.
+        std::vector<int32_t> string_ids;
+        for (size_t i = 0; i < row_count; ++i) {
+          if (!is_null_row(i)) {
+            string_ids.push_back(static_cast<int32_t>(values[i]));
+          }
+        }
+        std::sort(string_ids.begin(), string_ids.end());
+        string_ids.erase(std::unique(string_ids.begin(), string_ids.end()),
+                         string_ids.end());
+        std::vector<std::string> strings;
+        strings.reserve(string_ids.size());
+        for (const auto string_id : string_ids) {
+          strings.push_back(string_dict_proxy->getString(string_id));
+        }
+        std::vector<uint32_t> string_order(string_ids.size());
+        std::iota(string_order.begin(), string_order.end(), 0);
+        std::sort(string_order.begin(),
+                  string_order.end(),
+                  [&strings](const uint32_t lhs, const uint32_t rhs) {
+                    return strings[lhs] < strings[rhs];
+                  });
+        std::vector<uint64_t> ranks(string_ids.size());
+        for (size_t i = 0; i < string_order.size(); ++i) {
+          const bool same_string =
+              i && strings[string_order[i]] == strings[string_order[i - 1]];
+          ranks[string_order[i]] = same_string ? ranks[string_order[i - 1]] : i;
+        }
+        for (size_t i = 0; i < row_count; ++i) {
+          if (!is_null_row(i)) {
+            const auto it = std::lower_bound(
+                string_ids.begin(), string_ids.end(), static_cast<int32_t>(values[i]));
+            values[i] = ranks[it - string_ids.begin()];
+          }
+        }
+      }
+    }
+    if (order_entry.is_desc) {
+      for (auto& value : values) {
+        value = ~value;
+      }
+    }
+    if (nullable) {
+      key_words.push_back(std::move(null_words));
+    }
+    key_words.push_back(std::move(values));
+  }
+  return true;
+}
+
+std::shared_ptr<const std::vector<int32_t>> ResultSet::getDictionaryRanks(
+    StringDictionaryProxy* string_dict_proxy,
+    const size_t row_count) {
+  CHECK(string_dict_proxy);
+  // Ranking sorts the whole dictionary the first time, later calls only merge in the
+  // strings added since. Sorting the strings of the rows is cheaper for small results.
+  if (string_dict_proxy->storageEntryCount() > 4 * row_count) {
+    return nullptr;
+  }
+  return string_dict_proxy->getSortedRanks();
+}
+
+bool ResultSet::normalizedKeySort(const std::list<Analyzer::OrderEntry>& order_entries,
+                                  const Executor* executor) {
+  for (const auto& order_entry : order_entries) {
+    const auto& agg_info = targets_[order_entry.tle_no - 1];
+    const auto entry_ti = get_compact_type(agg_info);
+    // Count distinct and quantile targets are only known after materialization, and
+    // averages and none encoded strings don't fit a word.
+    if (is_distinct_target(agg_info) || is_quantile_agg(agg_info.agg_kind) ||
+        agg_info.agg_kind == kAVG ||
+        (entry_ti.is_string() && entry_ti.get_compression() != kENCODING_DICT)) {
+      return false;
+    }
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t row_count = permutation_.size();
+  const size_t thread_count = row_count > 100000 ? cpu_threads() : 1;
+  std::vector<std::vector<uint64_t>> key_words;
+  const bool materialized =
+      query_mem_desc_.didOutputColumnar()
+          ? materializeNormalizedKeys<ColumnWiseTargetAccessor>(
+                order_entries, executor, thread_count, key_words)
+          : materializeNormalizedKeys<RowWiseTargetAccessor>(
+                order_entries, executor, thread_count, key_words);
+  if (!materialized) {
+    return false;
+  }
+  const auto order = normalized_key_sort::sort_keys(key_words, row_count, thread_count);
+  std::vector<uint32_t> sorted_permutation(row_count);
+  for (size_t i = 0; i < row_count; ++i) {
+    sorted_permutation[i] = permutation_[order[i]];
+  }
+  permutation_.swap(sorted_permutation);
+  return true;
+}
+
 void ResultSet::topPermutation(
     std::vector<uint32_t>& to_sort,
     const size_t n,
@@ -1105,7 +1390,7 @@ std::tuple<std::vector<bool>, size_t> ResultSet::getSupportedSingleSlotTargetBit
   for (size_t target_idx = 0; target_idx < single_slot_targets.size(); target_idx++) {
     const auto& target = targets_[target_idx];
     if (single_slot_targets[target_idx] &&
-        (is_distinct_target(target) || target.agg_kind == kAPPROX_MEDIAN ||
+        (is_distinct_target(target) || is_quantile_agg(target.agg_kind) ||
          (target.is_agg && target.agg_kind == kSAMPLE && target.sql_type == kFLOAT))) {
       single_slot_targets[target_idx] = false;
       num_single_slot_targets--;
@@ -91,6 +91,8 @@ class Executor;
 
 class ResultSet;
 
+class StringDictionaryProxy;
+
 class ResultSetRowIterator {
  public:
   using value_type = std::vector<TargetValue>;
@@ -245,6 +247,11 @@ class ResultSet {
       const size_t index,
       const std::vector<bool>& targets_to_skip = {}) const;
 
+  // Same conversions as getNextRow for the row at a logical index, so that disjoint
+  // ranges of rows can be read concurrently. LIMIT and OFFSET are not applied.
+  std::vector<TargetValue> getRowAtWithTranslations(const size_t index,
+                                                    const bool decimal_to_double) const;
+
   bool isRowAtEmpty(const size_t index) const;
 
   void sort(const std::list<Analyzer::OrderEntry>& order_entries,
@@ -347,10 +354,26 @@ class ResultSet {
   const std::vector<uint32_t>& getPermutationBuffer() const;
   const bool isPermutationBufferEmpty() const { return permutation_.empty(); };
 
+  // Returns rows [offset, offset + limit) of the sorted result set rows, or all the rows
+  // past offset if limit is zero. The page shares the storage of rows and keeps it
+  // alive, hence creating it only copies the permutation entries of the page.
+  static std::shared_ptr<ResultSet> createSortedPage(
+      const std::shared_ptr<const ResultSet>& rows,
+      const size_t offset,
+      const size_t limit);
+
+  // True if the rows point into chunk buffers of the input tables, either through
+  // lazily fetched columns or through held variable length chunks.
+  bool referencesChunkBuffers() const;
+
   void serialize(TSerializedRows& serialized_rows) const;
 
-  static std::unique_ptr<ResultSet> unserialize(const TSerializedRows& serialized_rows,
-                                                const Executor*);
+  // Result sets which get reduced together must share a row set memory owner; when none
+  // is given, the one of the executor is used, or a new one if the executor has none.
+  static std::unique_ptr<ResultSet> unserialize(
+      const TSerializedRows& serialized_rows,
+      const Executor*,
+      std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner = nullptr);
 
   size_t getLimit() const;
 
@@ -411,7 +434,13 @@ class ResultSet {
                         const size_t target_idx,
                         const size_t slot_idx) const;
 
-  static double calculateQuantile(quantile::TDigest* const t_digest, double const q);
+  static double calculateQuantile(quantile::TDigest* const t_digest);
+
+  static double calculateQuantile(quantile::ExactQuantile* const exact_quantile);
+
+  // Calculates the quantile of the quantile::TDigest or quantile::ExactQuantile handle
+  // of a quantile slot.
+  static double calculateQuantile(const SQLAgg agg_kind, const int64_t handle);
 
  private:
   void advanceCursorToNextEntry(ResultSetRowIterator& iter) const;
@@ -606,6 +635,7 @@ class ResultSet {
   };
 
   using ApproxMedianBuffers = std::vector<std::vector<double>>;
+  using DictionaryRanks = std::vector<std::shared_ptr<const std::vector<int32_t>>>;
 
   template <typename BUFFER_ITERATOR_TYPE>
   struct ResultSetComparator {
@@ -620,12 +650,14 @@ class ResultSet {
         , result_set_(result_set)
         , buffer_itr_(result_set)
         , executor_(executor)
-        , approx_median_materialized_buffers_(materializeApproxMedianColumns()) {
+        , approx_median_materialized_buffers_(materializeApproxMedianColumns())
+        , dictionary_ranks_(materializeDictionaryRanks()) {
       materializeCountDistinctColumns();
     }
 
     void materializeCountDistinctColumns();
     ApproxMedianBuffers materializeApproxMedianColumns() const;
+    DictionaryRanks materializeDictionaryRanks() const;
 
     std::vector<int64_t> materializeCountDistinctColumn(
         const Analyzer::OrderEntry& order_entry) const;
@@ -643,6 +675,8 @@ class ResultSet {
     const Executor* executor_;
     std::vector<std::vector<int64_t>> count_distinct_materialized_buffers_;
     const ApproxMedianBuffers approx_median_materialized_buffers_;
+    // string ranks of every order entry, null unless it's a dictionary encoded string
+    const DictionaryRanks dictionary_ranks_;
   };
 
   std::function<bool(const uint32_t, const uint32_t)> createComparator(
@@ -673,6 +707,28 @@ class ResultSet {
 
   void sortPermutation(const std::function<bool(const uint32_t, const uint32_t)> compare);
 
+  // Sorts permutation_ by the order entries encoded once into unsigned words, using a
+  // radix sort instead of comparisons. Returns false, leaving permutation_ unchanged, if
+  // some order entry can't be encoded that way.
+  bool normalizedKeySort(const std::list<Analyzer::OrderEntry>& order_entries,
+                         const Executor* executor);
+
+  template <typename BUFFER_ITERATOR_TYPE>
+  bool materializeNormalizedKeys(const std::list<Analyzer::OrderEntry>& order_entries,
+                                 const Executor* executor,
+                                 const size_t thread_count,
+                                 std::vector<std::vector<uint64_t>>& key_words) const;
+
+  // True if the sort key at the given target index is stored as a float.
+  bool isFloatSortKey(const size_t target_idx) const;
+
+  // Returns the ranks of the dictionary strings in sorted order, see StringDictionary, or
+  // null if ranking the whole dictionary costs too much compared to sorting row_count
+  // rows by their strings.
+  static std::shared_ptr<const std::vector<int32_t>> getDictionaryRanks(
+      StringDictionaryProxy* string_dict_proxy,
+      const size_t row_count);
+
   std::vector<uint32_t> initPermutationBuffer(const size_t start, const size_t step);
 
   void parallelTop(const std::list<Analyzer::OrderEntry>& order_entries,
@@ -731,6 +787,8 @@ class ResultSet {
 
   std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_;
   std::vector<std::shared_ptr<std::list<ChunkIter>>> chunk_iters_;
+  // owner of the storage of a page created by createSortedPage
+  std::shared_ptr<const ResultSet> page_source_;
   // TODO(miyu): refine by using one buffer and
   //   setting offset instead of ptr in group by buffer.
   std::vector<std::vector<int8_t>> literal_buffers_;
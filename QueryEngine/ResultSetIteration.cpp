@@ -282,6 +282,17 @@ std::vector<TargetValue> ResultSet::getRowAtNoTranslations(
   return getRowAt(entry_idx, false, false, false, targets_to_skip);
 }
 
+std::vector<TargetValue> ResultSet::getRowAtWithTranslations(
+    const size_t logical_index,
+    const bool decimal_to_double) const {
+  if (logical_index >= entryCount()) {
+    return {};
+  }
+  const auto entry_idx =
+      permutation_.empty() ? logical_index : permutation_[logical_index];
+  return getRowAt(entry_idx, true, decimal_to_double, false);
+}
+
 bool ResultSet::isRowAtEmpty(const size_t logical_index) const {
   if (logical_index >= entryCount()) {
     return true;
@@ -1777,8 +1788,9 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
     }
   }
   if (chosen_type.is_fp()) {
-    if (target_info.agg_kind == kAPPROX_MEDIAN) {
-      return calculateQuantile(*reinterpret_cast<quantile::TDigest* const*>(ptr), 0.5);
+    if (is_quantile_agg(target_info.agg_kind)) {
+      return calculateQuantile(target_info.agg_kind,
+                               *reinterpret_cast<const int64_t*>(ptr));
     }
     switch (actual_compact_sz) {
       case 8: {
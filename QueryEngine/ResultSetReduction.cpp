@@ -1500,6 +1500,11 @@ void ResultSetStorage::reduceOneSlot(
         CHECK_EQ(static_cast<int8_t>(sizeof(int64_t)), chosen_bytes);
         reduceOneApproxMedianSlot(this_ptr1, that_ptr1, target_logical_idx, that);
         break;
+      case kPERCENTILE_CONT:
+      case kPERCENTILE_DISC:
+        CHECK_EQ(static_cast<int8_t>(sizeof(int64_t)), chosen_bytes);
+        reduceOnePercentileSlot(this_ptr1, that_ptr1, target_logical_idx);
+        break;
       default:
         UNREACHABLE() << toString(target_info.agg_kind);
     }
@@ -1589,6 +1594,23 @@ void ResultSetStorage::reduceOneApproxMedianSlot(int8_t* this_ptr1,
   }
 }
 
+void ResultSetStorage::reduceOnePercentileSlot(int8_t* this_ptr1,
+                                               const int8_t* that_ptr1,
+                                               const size_t target_logical_idx) const {
+  static_assert(sizeof(int64_t) == sizeof(quantile::ExactQuantile*));
+  auto* incoming = *reinterpret_cast<quantile::ExactQuantile* const*>(that_ptr1);
+  CHECK(incoming) << "this_ptr1=" << (void*)this_ptr1
+                  << ", that_ptr1=" << (void const*)that_ptr1
+                  << ", target_logical_idx=" << target_logical_idx;
+  if (incoming->size()) {
+    auto* accumulator = *reinterpret_cast<quantile::ExactQuantile**>(this_ptr1);
+    CHECK(accumulator) << "this_ptr1=" << (void*)this_ptr1
+                       << ", that_ptr1=" << (void const*)that_ptr1
+                       << ", target_logical_idx=" << target_logical_idx;
+    accumulator->merge(*incoming);
+  }
+}
+
 void ResultSetStorage::reduceOneCountDistinctSlot(int8_t* this_ptr1,
                                                   const int8_t* that_ptr1,
                                                   const size_t target_logical_idx,
@@ -469,6 +469,15 @@ extern "C" void approx_median_jit_rt(const int64_t new_set_handle,
   }
 }
 
+extern "C" void percentile_jit_rt(const int64_t new_set_handle,
+                                  const int64_t old_set_handle) {
+  auto* incoming = reinterpret_cast<quantile::ExactQuantile*>(new_set_handle);
+  if (incoming->size()) {
+    auto* accumulator = reinterpret_cast<quantile::ExactQuantile*>(old_set_handle);
+    accumulator->merge(*incoming);
+  }
+}
+
 extern "C" void get_group_value_reduction_rt(int8_t* groups_buffer,
                                              const int8_t* key,
                                              const uint32_t key_count,
@@ -1148,6 +1157,11 @@ void ResultSetReductionJIT::reduceOneAggregateSlot(Value* this_ptr1,
       reduceOneApproxMedianSlot(
           this_ptr1, that_ptr1, target_logical_idx, ir_reduce_one_entry);
       break;
+    case kPERCENTILE_CONT:
+    case kPERCENTILE_DISC:
+      CHECK_EQ(chosen_bytes, static_cast<int8_t>(sizeof(int64_t)));
+      reduceOnePercentileSlot(this_ptr1, that_ptr1, ir_reduce_one_entry);
+      break;
     case kAVG: {
       // Ignore float argument compaction for count component for fear of its overflow
       emit_aggregate_one_count(this_ptr2,
@@ -1235,6 +1249,19 @@ void ResultSetReductionJIT::reduceOneApproxMedianSlot(
       "");
 }
 
+void ResultSetReductionJIT::reduceOnePercentileSlot(
+    Value* this_ptr1,
+    Value* that_ptr1,
+    Function* ir_reduce_one_entry) const {
+  const auto old_set_handle = emit_load_i64(this_ptr1, ir_reduce_one_entry);
+  const auto new_set_handle = emit_load_i64(that_ptr1, ir_reduce_one_entry);
+  ir_reduce_one_entry->add<ExternalCall>(
+      "percentile_jit_rt",
+      Type::Void,
+      std::vector<const Value*>{new_set_handle, old_set_handle},
+      "");
+}
+
 ReductionCode ResultSetReductionJIT::finalizeReductionCode(
     ReductionCode reduction_code,
     const llvm::Function* ir_is_empty,
@@ -0,0 +1,346 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ResultSetSerialization.cpp
+ * @brief   Serialization of partial result sets to / from thrift, used to ship
+ *          per-node results to the node which performs the final reduction.
+ */
+
+#include "ResultSet.h"
+
+#include "Execute.h"
+#include "ResultSetBufferAccessors.h"
+#include "ThriftSerializers.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+QueryMemoryDescriptor::QueryMemoryDescriptor(
+    const TResultSetBufferDescriptor& thrift_query_memory_descriptor)
+    : executor_(nullptr)
+    , allow_multifrag_(true)
+    , query_desc_type_(
+          ThriftSerializers::layout_from_thrift(thrift_query_memory_descriptor.layout))
+    , keyless_hash_(thrift_query_memory_descriptor.keyless)
+    , interleaved_bins_on_gpu_(false)
+    , idx_target_as_key_(thrift_query_memory_descriptor.idx_target_as_key)
+    , group_col_compact_width_(thrift_query_memory_descriptor.key_bytewidth)
+    , entry_count_(thrift_query_memory_descriptor.entry_count)
+    , min_val_(thrift_query_memory_descriptor.min_val)
+    , max_val_(thrift_query_memory_descriptor.max_val)
+    , bucket_(thrift_query_memory_descriptor.bucket)
+    , has_nulls_(false)
+    , sort_on_gpu_(false)
+    , output_columnar_(false)
+    , render_output_(false)
+    , must_use_baseline_sort_(false)
+    , is_table_function_(false)
+    , use_streaming_top_n_(false)
+    , force_4byte_float_(thrift_query_memory_descriptor.force_4byte_float) {
+  for (const auto group_col_width : thrift_query_memory_descriptor.group_col_widths) {
+    group_col_widths_.push_back(group_col_width);
+  }
+  const auto& thrift_col_slot_context =
+      thrift_query_memory_descriptor.col_slot_context;
+  for (const auto& slots_for_col : thrift_col_slot_context.col_to_slot_map) {
+    std::vector<std::tuple<int8_t, int8_t>> slot_sizes_for_col;
+    for (const auto slot_idx : slots_for_col) {
+      // Slots are assigned in column order, ColSlotContext::addColumn relies on it
+      CHECK_EQ(static_cast<size_t>(slot_idx), col_slot_context_.getSlotCount() +
+                                                  slot_sizes_for_col.size());
+      CHECK_LT(static_cast<size_t>(slot_idx), thrift_col_slot_context.slot_sizes.size());
+      const auto& slot_size = thrift_col_slot_context.slot_sizes[slot_idx];
+      slot_sizes_for_col.emplace_back(slot_size.padded, slot_size.logical);
+    }
+    col_slot_context_.addColumn(slot_sizes_for_col);
+  }
+  for (const auto target_groupby_index :
+       thrift_query_memory_descriptor.target_groupby_indices) {
+    target_groupby_indices_.push_back(target_groupby_index);
+  }
+  for (const auto& thrift_count_distinct_descriptor :
+       thrift_query_memory_descriptor.count_distinct_descriptors) {
+    count_distinct_descriptors_.push_back(
+        ThriftSerializers::count_distinct_descriptor_from_thrift(
+            thrift_count_distinct_descriptor));
+  }
+}
+
+TResultSetBufferDescriptor QueryMemoryDescriptor::toThrift(
+    const QueryMemoryDescriptor& query_mem_desc) {
+  if (query_mem_desc.didOutputColumnar()) {
+    throw std::runtime_error(
+        "Serialization of columnar result sets is not supported yet.");
+  }
+  TResultSetBufferDescriptor thrift_query_memory_descriptor;
+  thrift_query_memory_descriptor.layout =
+      ThriftSerializers::layout_to_thrift(query_mem_desc.query_desc_type_);
+  thrift_query_memory_descriptor.keyless = query_mem_desc.keyless_hash_;
+  thrift_query_memory_descriptor.entry_count = query_mem_desc.entry_count_;
+  thrift_query_memory_descriptor.idx_target_as_key = query_mem_desc.idx_target_as_key_;
+  thrift_query_memory_descriptor.min_val = query_mem_desc.min_val_;
+  thrift_query_memory_descriptor.max_val = query_mem_desc.max_val_;
+  thrift_query_memory_descriptor.bucket = query_mem_desc.bucket_;
+  for (const auto group_col_width : query_mem_desc.group_col_widths_) {
+    thrift_query_memory_descriptor.group_col_widths.push_back(group_col_width);
+  }
+  thrift_query_memory_descriptor.key_bytewidth = query_mem_desc.group_col_compact_width_;
+  const auto& col_slot_context = query_mem_desc.col_slot_context_;
+  for (size_t slot_idx = 0; slot_idx < col_slot_context.getSlotCount(); ++slot_idx) {
+    const auto& slot_info = col_slot_context.getSlotInfo(slot_idx);
+    TSlotSize thrift_slot_size;
+    thrift_slot_size.padded = slot_info.padded_size;
+    thrift_slot_size.logical = slot_info.logical_size;
+    thrift_query_memory_descriptor.col_slot_context.slot_sizes.push_back(
+        thrift_slot_size);
+  }
+  for (size_t col_idx = 0; col_idx < col_slot_context.getColCount(); ++col_idx) {
+    std::vector<int32_t> slots_for_col;
+    for (const auto slot_idx : col_slot_context.getSlotsForCol(col_idx)) {
+      slots_for_col.push_back(slot_idx);
+    }
+    thrift_query_memory_descriptor.col_slot_context.col_to_slot_map.push_back(
+        slots_for_col);
+  }
+  for (const auto target_groupby_index : query_mem_desc.target_groupby_indices_) {
+    thrift_query_memory_descriptor.target_groupby_indices.push_back(
+        target_groupby_index);
+  }
+  for (const auto& count_distinct_descriptor :
+       query_mem_desc.count_distinct_descriptors_) {
+    thrift_query_memory_descriptor.count_distinct_descriptors.push_back(
+        ThriftSerializers::count_distinct_descriptor_to_thrift(
+            count_distinct_descriptor));
+  }
+  thrift_query_memory_descriptor.force_4byte_float = query_mem_desc.force_4byte_float_;
+  return thrift_query_memory_descriptor;
+}
+
+namespace {
+
+bool is_serializable_target(const TargetInfo& target_info) {
+  if (target_info.sql_type.is_varlen() || target_info.sql_type.is_geometry()) {
+    return false;
+  }
+  if (target_info.is_agg && is_quantile_agg(target_info.agg_kind)) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+void ResultSet::serialize(TSerializedRows& serialized_rows) const {
+  serialized_rows.explanation = explanation_;
+  if (just_explain_) {
+    return;
+  }
+  if (!storage_) {
+    return;
+  }
+  if (!appended_storage_.empty() &&
+      (query_mem_desc_.getQueryDescriptionType() != QueryDescriptionType::Projection ||
+       query_mem_desc_.didOutputColumnar())) {
+    throw std::runtime_error("Serialization of appended result sets is not supported.");
+  }
+  for (const auto& col_lazy_fetch : lazy_fetch_info_) {
+    if (col_lazy_fetch.is_lazily_fetched) {
+      throw std::runtime_error(
+          "Serialization of lazily fetched result sets is not supported.");
+    }
+  }
+  for (const auto& target_info : targets_) {
+    if (!is_serializable_target(target_info)) {
+      throw std::runtime_error("Serialization of " + target_info.sql_type.toString() +
+                               " targets is not supported.");
+    }
+  }
+
+  serialized_rows.descriptor = QueryMemoryDescriptor::toThrift(query_mem_desc_);
+  serialized_rows.targets = ThriftSerializers::target_infos_to_thrift(targets_);
+  serialized_rows.target_init_vals = storage_->target_init_vals_;
+
+  // The rows of appended row-wise projection storages follow each other, as if a single
+  // kernel had produced them; the descriptor already counts the entries of all of them.
+  const auto buffer_size = query_mem_desc_.getBufferSizeBytes(ExecutorDeviceType::CPU);
+  std::string buffer;
+  buffer.reserve(buffer_size);
+  auto append_storage = [&buffer](const ResultSetStorage& storage) {
+    buffer.append(reinterpret_cast<const char*>(storage.getUnderlyingBuffer()),
+                  storage.query_mem_desc_.getBufferSizeBytes(ExecutorDeviceType::CPU));
+  };
+  append_storage(*storage_);
+  for (const auto& appended_storage : appended_storage_) {
+    append_storage(*appended_storage);
+  }
+  CHECK_EQ(buffer.size(), buffer_size);
+  serialized_rows.buffers.push_back(std::move(buffer));
+  serialized_rows.buffer_lengths.push_back(buffer_size);
+  serialized_rows.buffers_total_size = buffer_size;
+  serialized_rows.total_compression_time_ms = 0;
+
+  serializeCountDistinctColumns(serialized_rows);
+}
+
+std::unique_ptr<ResultSet> ResultSet::unserialize(
+    const TSerializedRows& serialized_rows,
+    const Executor* executor,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) {
+  if (serialized_rows.buffers.empty()) {
+    return std::make_unique<ResultSet>(serialized_rows.explanation);
+  }
+  CHECK_EQ(serialized_rows.buffers.size(), size_t(1));
+
+  const QueryMemoryDescriptor query_mem_desc(serialized_rows.descriptor);
+  const auto targets = ThriftSerializers::target_infos_from_thrift(serialized_rows.targets);
+  if (!row_set_mem_owner && executor) {
+    row_set_mem_owner = executor->getRowSetMemoryOwner();
+  }
+  if (!row_set_mem_owner) {
+    row_set_mem_owner =
+        std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  }
+  auto result_set =
+      std::make_unique<ResultSet>(targets,
+                                  ExecutorDeviceType::CPU,
+                                  query_mem_desc,
+                                  row_set_mem_owner,
+                                  executor ? executor->getCatalog() : nullptr,
+                                  executor ? executor->blockSize() : 0,
+                                  executor ? executor->gridSize() : 0);
+  const auto storage = result_set->allocateStorage(serialized_rows.target_init_vals);
+  const auto& buffer = serialized_rows.buffers.front();
+  CHECK_EQ(buffer.size(), query_mem_desc.getBufferSizeBytes(ExecutorDeviceType::CPU));
+  std::memcpy(storage->getUnderlyingBuffer(), buffer.data(), buffer.size());
+
+  result_set->unserializeCountDistinctColumns(serialized_rows);
+  return result_set;
+}
+
+int64_t ResultSet::getDistinctBufferRefFromBufferRowwise(
+    int8_t* rowwise_target_ptr,
+    const TargetInfo& target_info) const {
+  CHECK(is_distinct_target(target_info));
+  return *reinterpret_cast<const int64_t*>(rowwise_target_ptr);
+}
+
+void ResultSet::serializeCountDistinctColumns(TSerializedRows& serialized_rows) const {
+  // The group by buffer holds pointers to count distinct bitmaps and sets owned by this
+  // process. Ship their contents keyed by the original pointer; the receiving side maps
+  // them back through ResultSetStorage::addCountDistinctSetPointerMapping.
+  std::map<int64_t, const CountDistinctDescriptor*> count_distinct_active_buffers;
+  const auto key_bytes_with_padding =
+      align_to_int64(get_key_bytes_rowwise(query_mem_desc_));
+  for (size_t entry_idx = 0; entry_idx < query_mem_desc_.getEntryCount(); ++entry_idx) {
+    if (storage_->isEmptyEntry(entry_idx)) {
+      continue;
+    }
+    auto rowwise_target_ptr =
+        row_ptr_rowwise(storage_->buff_, query_mem_desc_, entry_idx) +
+        key_bytes_with_padding;
+    size_t target_slot_idx = 0;
+    for (size_t target_logical_idx = 0; target_logical_idx < targets_.size();
+         ++target_logical_idx) {
+      const auto& target_info = targets_[target_logical_idx];
+      if (is_distinct_target(target_info)) {
+        const auto remote_ptr =
+            getDistinctBufferRefFromBufferRowwise(rowwise_target_ptr, target_info);
+        if (remote_ptr) {
+          count_distinct_active_buffers.emplace(
+              remote_ptr, &query_mem_desc_.getCountDistinctDescriptor(target_logical_idx));
+        }
+      }
+      rowwise_target_ptr = advance_target_ptr_row_wise(
+          rowwise_target_ptr, target_info, target_slot_idx, query_mem_desc_, false);
+      target_slot_idx = advance_slot(target_slot_idx, target_info, false);
+    }
+  }
+
+  for (const auto& active_buffer : count_distinct_active_buffers) {
+    const auto remote_ptr = active_buffer.first;
+    const auto& count_distinct_desc = *active_buffer.second;
+    TCountDistinctSet thrift_count_distinct_set;
+    thrift_count_distinct_set.type =
+        ThriftSerializers::count_distinct_impl_type_to_thrift(
+            count_distinct_desc.impl_type_);
+    thrift_count_distinct_set.remote_ptr = remote_ptr;
+    if (count_distinct_desc.impl_type_ == CountDistinctImplType::Bitmap) {
+      const auto bitmap_byte_sz = count_distinct_desc.sub_bitmap_count == 1
+                                      ? count_distinct_desc.bitmapSizeBytes()
+                                      : count_distinct_desc.bitmapPaddedSizeBytes();
+      const auto bitmap = reinterpret_cast<const char*>(remote_ptr);
+      // Completely zero bitmaps are not shipped, ResultSetStorage::mappedPtr handles
+      // the missing pointers on the receiving side
+      if (std::all_of(
+              bitmap, bitmap + bitmap_byte_sz, [](const char b) { return b == 0; })) {
+        continue;
+      }
+      thrift_count_distinct_set.storage.__set_bitmap(
+          std::string(bitmap, bitmap_byte_sz));
+    } else {
+      CHECK(count_distinct_desc.impl_type_ == CountDistinctImplType::StdSet);
+      const auto count_distinct_set =
+          reinterpret_cast<const CountDistinctSet*>(remote_ptr);
+      std::set<int64_t> sparse_set;
+      count_distinct_set->forEach(
+          [&sparse_set](const int64_t val) { sparse_set.insert(sparse_set.end(), val); });
+      thrift_count_distinct_set.storage.__set_sparse_set(sparse_set);
+    }
+    serialized_rows.count_distinct_sets.push_back(thrift_count_distinct_set);
+  }
+}
+
+void ResultSet::unserializeCountDistinctColumns(const TSerializedRows& serialized_rows) {
+  if (serialized_rows.count_distinct_sets.empty()) {
+    return;
+  }
+  CHECK(storage_);
+  for (const auto& thrift_count_distinct_set : serialized_rows.count_distinct_sets) {
+    const auto impl_type = ThriftSerializers::count_distinct_impl_type_from_thrift(
+        thrift_count_distinct_set.type);
+    int64_t ptr{0};
+    if (impl_type == CountDistinctImplType::Bitmap) {
+      const auto& bitmap = thrift_count_distinct_set.storage.bitmap;
+      auto count_distinct_buffer =
+          row_set_mem_owner_->allocateCountDistinctBuffer(bitmap.size());
+      std::memcpy(count_distinct_buffer, bitmap.data(), bitmap.size());
+      ptr = reinterpret_cast<int64_t>(count_distinct_buffer);
+    } else {
+      CHECK(impl_type == CountDistinctImplType::StdSet);
+      const auto& sparse_set = thrift_count_distinct_set.storage.sparse_set;
+      auto count_distinct_set = new CountDistinctSet();
+      for (const auto val : sparse_set) {
+        count_distinct_set->add(val);
+      }
+      row_set_mem_owner_->addCountDistinctSet(count_distinct_set);
+      ptr = reinterpret_cast<int64_t>(count_distinct_set);
+    }
+    storage_->addCountDistinctSetPointerMapping(thrift_count_distinct_set.remote_ptr,
+                                                ptr);
+  }
+  fixupCountDistinctPointers();
+}
+
+void ResultSet::fixupCountDistinctPointers() {
+  for (size_t entry_idx = 0; entry_idx < query_mem_desc_.getEntryCount(); ++entry_idx) {
+    if (storage_->isEmptyEntry(entry_idx)) {
+      continue;
+    }
+    getRowAt(entry_idx, false, false, true);
+  }
+}
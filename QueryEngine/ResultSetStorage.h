@@ -128,6 +128,10 @@ class ResultSetStorage {
                                  const size_t target_logical_idx,
                                  const ResultSetStorage& that) const;
 
+  void reduceOnePercentileSlot(int8_t* this_ptr1,
+                               const int8_t* that_ptr1,
+                               const size_t target_logical_idx) const;
+
   // Reduces results for a single row when using interleaved bin layouts
   static bool reduceSingleRow(const int8_t* row_ptr,
                               const int8_t warp_count,
@@ -22,6 +22,7 @@
 #include "../Shared/funcannotations.h"
 #include "BufferCompaction.h"
 #include "HyperLogLogRank.h"
+#include "InValuesHashSetInl.h"
 #include "MurmurHash.h"
 #include "Shared/quantile.h"
 #include "TypePunning.h"
@@ -346,6 +347,14 @@ extern "C" ALWAYS_INLINE void agg_approx_median(int64_t* agg, const double val)
   agg_approx_median_impl(agg, val);
 }
 
+extern "C" NEVER_INLINE void agg_percentile_impl(int64_t* agg, const double val) {
+  reinterpret_cast<quantile::ExactQuantile*>(*agg)->add(val);
+}
+
+extern "C" ALWAYS_INLINE void agg_percentile(int64_t* agg, const double val) {
+  agg_percentile_impl(agg, val);
+}
+
 extern "C" ALWAYS_INLINE int8_t bit_is_set(const int64_t bitset,
                                            const int64_t val,
                                            const int64_t min_val,
@@ -368,6 +377,61 @@ extern "C" ALWAYS_INLINE int8_t bit_is_set(const int64_t bitset,
              : 0;
 }
 
+extern "C" ALWAYS_INLINE int8_t int_hash_set_contains(const int64_t hash_set,
+                                                      const int64_t val,
+                                                      const int64_t slot_count,
+                                                      const int64_t null_val,
+                                                      const int8_t null_bool_val,
+                                                      const int8_t not_found_val) {
+  if (val == null_val) {
+    return null_bool_val;
+  }
+  const auto slots = reinterpret_cast<const int64_t*>(hash_set);
+  const uint64_t slot_mask = slot_count - 1;
+  for (auto slot = in_values_int_hash(val) & slot_mask;; slot = (slot + 1) & slot_mask) {
+    if (slots[slot] == val) {
+      return 1;
+    }
+    if (slots[slot] == null_val) {
+      return not_found_val;
+    }
+  }
+}
+
+extern "C" ALWAYS_INLINE int8_t str_hash_set_contains(const int64_t hash_set,
+                                                      const int64_t slot_count,
+                                                      const int64_t str_count,
+                                                      const char* str,
+                                                      const int32_t str_len,
+                                                      const int8_t null_bool_val,
+                                                      const int8_t not_found_val) {
+  if (!str) {
+    return null_bool_val;
+  }
+  const auto slots = reinterpret_cast<const int64_t*>(hash_set);
+  const auto offsets = slots + slot_count;
+  const auto chars = reinterpret_cast<const char*>(offsets + str_count + 1);
+  const uint64_t slot_mask = slot_count - 1;
+  for (auto slot = in_values_str_hash(str, str_len) & slot_mask;;
+       slot = (slot + 1) & slot_mask) {
+    const auto str_idx = slots[slot];
+    if (str_idx < 0) {
+      return not_found_val;
+    }
+    const auto candidate = chars + offsets[str_idx];
+    if (offsets[str_idx + 1] - offsets[str_idx] != str_len) {
+      continue;
+    }
+    int32_t i = 0;
+    while (i < str_len && candidate[i] == str[i]) {
+      ++i;
+    }
+    if (i == str_len) {
+      return 1;
+    }
+  }
+}
+
 extern "C" ALWAYS_INLINE int64_t agg_sum(int64_t* agg, const int64_t val) {
   const auto old = *agg;
   *agg += val;
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SortedResultCache.h"
+
+std::optional<SortedResultCache::CachedResult> SortedResultCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->first == key) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return entries_.front().second;
+    }
+  }
+  return std::nullopt;
+}
+
+void SortedResultCache::put(const std::string& key, const CachedResult& cached_result) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->first == key) {
+      total_bytes_ -= it->second.bytes;
+      entries_.erase(it);
+      break;
+    }
+  }
+  if (cached_result.bytes > g_sorted_result_cache_max_bytes) {
+    VLOG(1) << "Not caching a sorted result of " << cached_result.bytes << " bytes.";
+    return;
+  }
+  entries_.emplace_front(key, cached_result);
+  total_bytes_ += cached_result.bytes;
+  while (entries_.size() > g_sorted_result_cache_size ||
+         total_bytes_ > g_sorted_result_cache_max_bytes) {
+    total_bytes_ -= entries_.back().second.bytes;
+    entries_.pop_back();
+  }
+}
+
+size_t SortedResultCache::size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return entries_.size();
+}
+
+std::list<std::pair<std::string, SortedResultCache::CachedResult>>
+    SortedResultCache::entries_;
+size_t SortedResultCache::total_bytes_{0};
+std::mutex SortedResultCache::mutex_;
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    SortedResultCache.h
+ * @brief   Sorted query results kept around for serving further LIMIT / OFFSET pages.
+ *
+ * A dashboard paging through a large sorted result re-runs the same query with a
+ * different offset for every page. The cache keeps the sorted result set together with
+ * its permutation, so subsequent pages only copy the permutation entries they cover.
+ * Entries are evicted least recently used first once there are more than
+ * g_sorted_result_cache_size of them, or once they hold more than
+ * g_sorted_result_cache_max_bytes together; a size of zero disables the cache.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/TargetMetaInfo.h"
+
+class ResultSet;
+
+extern size_t g_sorted_result_cache_size;
+extern size_t g_sorted_result_cache_max_bytes;
+
+class SortedResultCache {
+ public:
+  struct CachedResult {
+    // Returns true if the page at offset, or all the rows past offset if limit is
+    // zero, is covered by the sorted rows.
+    bool hasPage(const size_t offset, const size_t limit) const {
+      if (offset >= sorted_row_count) {
+        return false;
+      }
+      return complete || (limit && offset + limit <= sorted_row_count);
+    }
+
+    std::shared_ptr<const ResultSet> rows;
+    std::vector<TargetMetaInfo> targets_meta;
+    size_t sorted_row_count;  // leading rows of the permutation known to be in order
+    bool complete;            // the permutation covers all the rows of the query
+    size_t bytes;             // result buffer and permutation held by the entry
+  };
+
+  static std::optional<CachedResult> get(const std::string& key);
+
+  static void put(const std::string& key, const CachedResult& cached_result);
+
+  static size_t size();
+
+  static auto getCacheInvalidator() -> std::function<void()> {
+    return []() -> void {
+      std::lock_guard<std::mutex> guard(mutex_);
+      VLOG(1) << "Invalidating " << entries_.size() << " cached sorted results.";
+      entries_.clear();
+      total_bytes_ = 0;
+    };
+  }
+
+ private:
+  // most recently used first
+  static std::list<std::pair<std::string, CachedResult>> entries_;
+  static size_t total_bytes_;
+  static std::mutex mutex_;
+};
@@ -246,6 +246,19 @@ class StorageIOFacility {
 
         std::atomic<size_t> row_idx{0};
 
+        // Columnar projections let fixed width columns which need no conversion be
+        // scattered straight from the result set buffers into the chunks, skipping the
+        // per-row TargetValue materialization below. Projection rows are compacted at
+        // the front of a single storage, so filtered updates qualify as well.
+        auto rs = update_log.getResultSet();
+        const auto offset_column_index = update_parameters.getUpdateColumnCount();
+        const bool columnar_update_possible =
+            rs->isZeroCopyColumnarConversionPossible(offset_column_index) &&
+            rs->getQueryMemDesc().getSlotCount() == rs->colCount() &&
+            static_cast<size_t>(rs->getPaddedSlotWidthBytes(offset_column_index)) ==
+                sizeof(int64_t);
+        OffsetVector columnar_offsets;
+
         auto process_rows =
             [&update_parameters, &column_offsets, &scalar_target_values, &row_idx](
                 auto get_entry_at_func,
@@ -288,6 +301,37 @@ class StorageIOFacility {
         for (decltype(update_parameters.getUpdateColumnCount()) column_index = 0;
              column_index < update_parameters.getUpdateColumnCount();
              column_index++) {
+          const auto table_id = update_log.getPhysicalTableId();
+          auto const* table_descriptor =
+              catalog_.getMetadataForTable(update_log.getPhysicalTableId());
+          CHECK(table_descriptor);
+          const auto fragmenter = table_descriptor->fragmenter;
+          CHECK(fragmenter);
+          auto const* target_column = catalog_.getMetadataForColumn(
+              table_id, update_parameters.getUpdateColumnNames()[column_index]);
+
+          const auto& column_type = target_column->columnType;
+          if (columnar_update_possible &&
+              rs->isZeroCopyColumnarConversionPossible(column_index) &&
+              rs->getPaddedSlotWidthBytes(column_index) == column_type.get_size() &&
+              Fragmenter_Namespace::InsertOrderFragmenter::isColumnarUpdatePossible(
+                  column_type, update_log.getColumnType(column_index))) {
+            if (columnar_offsets.empty()) {
+              const auto offsets = reinterpret_cast<const int64_t*>(
+                  rs->getColumnarBuffer(offset_column_index));
+              columnar_offsets.assign(offsets, offsets + rows_per_column);
+            }
+            fragmenter->updateColumn(&catalog_,
+                                     table_descriptor,
+                                     target_column,
+                                     update_log.getFragmentId(),
+                                     columnar_offsets,
+                                     rs->getColumnarBuffer(column_index),
+                                     Data_Namespace::MemoryLevel::CPU_LEVEL,
+                                     update_parameters.getTransactionTracker());
+            continue;
+          }
+
           row_idx = 0;
           RowProcessingFuturesVector entry_processing_futures;
           entry_processing_futures.reserve(usable_threads);
@@ -328,15 +372,6 @@ class StorageIOFacility {
 
           CHECK(row_idx == rows_per_column);
 
-          const auto table_id = update_log.getPhysicalTableId();
-          auto const* table_descriptor =
-              catalog_.getMetadataForTable(update_log.getPhysicalTableId());
-          CHECK(table_descriptor);
-          const auto fragmenter = table_descriptor->fragmenter;
-          CHECK(fragmenter);
-          auto const* target_column = catalog_.getMetadataForColumn(
-              table_id, update_parameters.getUpdateColumnNames()[column_index]);
-
           fragmenter->updateColumn(&catalog_,
                                    table_descriptor,
                                    target_column,
@@ -65,6 +65,9 @@ std::vector<std::string> agg_fn_base_names(const TargetInfo& target_info) {
       return {"agg_approximate_count_distinct"};
     case kAPPROX_MEDIAN:
       return {"agg_approx_median"};
+    case kPERCENTILE_CONT:
+    case kPERCENTILE_DISC:
+      return {"agg_percentile"};
     case kSINGLE_VALUE:
       return {"checked_single_agg_id"};
     case kSAMPLE:
@@ -414,6 +417,11 @@ void TargetExprCodegen::codegenAggregate(
       CHECK_EQ(agg_chosen_bytes, sizeof(int64_t));
       group_by_and_agg->codegenApproxMedian(
           target_idx, target_expr, agg_args, query_mem_desc, co.device_type);
+    } else if (target_info.agg_kind == kPERCENTILE_CONT ||
+               target_info.agg_kind == kPERCENTILE_DISC) {
+      CHECK_EQ(agg_chosen_bytes, sizeof(int64_t));
+      group_by_and_agg->codegenPercentile(
+          target_idx, target_expr, agg_args, query_mem_desc, co.device_type);
     } else {
       const auto& arg_ti = target_info.agg_arg_type;
       if (need_skip_null && !arg_ti.is_geometry()) {
@@ -511,10 +519,6 @@ void TargetExprCodegenBuilder::operator()(const Analyzer::Expr* target_expr,
     ++target_index_counter;
     return;
   }
-  if (dynamic_cast<const Analyzer::UOper*>(target_expr) &&
-      static_cast<const Analyzer::UOper*>(target_expr)->get_optype() == kUNNEST) {
-    throw std::runtime_error("UNNEST not supported in the projection list yet.");
-  }
   if ((executor->plan_state_->isLazyFetchColumn(target_expr) || !is_group_by) &&
       (static_cast<size_t>(query_mem_desc.getPaddedSlotWidthBytes(slot_index_counter)) <
        sizeof(int64_t)) &&
@@ -527,7 +531,7 @@ void TargetExprCodegenBuilder::operator()(const Analyzer::Expr* target_expr,
   auto arg_expr = agg_arg(target_expr);
   if (arg_expr) {
     if (target_info.agg_kind == kSINGLE_VALUE || target_info.agg_kind == kSAMPLE ||
-        target_info.agg_kind == kAPPROX_MEDIAN) {
+        is_quantile_agg(target_info.agg_kind)) {
       target_info.skip_null_val = false;
     } else if (query_mem_desc.getQueryDescriptionType() ==
                    QueryDescriptionType::NonGroupedAggregate &&
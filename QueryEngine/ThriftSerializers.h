@@ -33,6 +33,7 @@
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "QueryEngine/TableFunctions/TableFunctionsFactory.h"
+#include "QueryEngine/TableGenerations.h"
 #include "QueryEngine/TargetMetaInfo.h"
 #include "Shared/ThriftTypesConvert.h"
 
@@ -168,6 +169,78 @@ inline StringDictionaryGenerations string_dictionary_generations_from_thrift(
   return string_dictionary_generations;
 }
 
+inline std::vector<TColumnRange> column_ranges_to_thrift(
+    const AggregatedColRange& column_ranges) {
+  std::vector<TColumnRange> thrift_column_ranges;
+  for (const auto& phys_input_and_range : column_ranges.asMap()) {
+    const auto& phys_input = phys_input_and_range.first;
+    const auto& column_range = phys_input_and_range.second;
+    TColumnRange thrift_column_range;
+    thrift_column_range.col_id = phys_input.col_id;
+    thrift_column_range.table_id = phys_input.table_id;
+    switch (column_range.getType()) {
+      case ExpressionRangeType::Integer:
+        thrift_column_range.type = TExpressionRangeType::INTEGER;
+        thrift_column_range.int_min = column_range.getIntMin();
+        thrift_column_range.int_max = column_range.getIntMax();
+        thrift_column_range.bucket = column_range.getBucket();
+        thrift_column_range.has_nulls = column_range.hasNulls();
+        break;
+      case ExpressionRangeType::Float:
+      case ExpressionRangeType::Double:
+        thrift_column_range.type = column_range.getType() == ExpressionRangeType::Float
+                                       ? TExpressionRangeType::FLOAT
+                                       : TExpressionRangeType::DOUBLE;
+        thrift_column_range.fp_min = column_range.getFpMin();
+        thrift_column_range.fp_max = column_range.getFpMax();
+        thrift_column_range.has_nulls = column_range.hasNulls();
+        break;
+      default:
+        thrift_column_range.type = TExpressionRangeType::INVALID;
+        break;
+    }
+    thrift_column_ranges.push_back(thrift_column_range);
+  }
+  return thrift_column_ranges;
+}
+
+inline std::vector<TDictionaryGeneration> string_dictionary_generations_to_thrift(
+    const StringDictionaryGenerations& string_dictionary_generations) {
+  std::vector<TDictionaryGeneration> thrift_string_dictionary_generations;
+  for (const auto& dict_id_and_generation : string_dictionary_generations.asMap()) {
+    TDictionaryGeneration thrift_string_dictionary_generation;
+    thrift_string_dictionary_generation.dict_id = dict_id_and_generation.first;
+    thrift_string_dictionary_generation.entry_count = dict_id_and_generation.second;
+    thrift_string_dictionary_generations.push_back(thrift_string_dictionary_generation);
+  }
+  return thrift_string_dictionary_generations;
+}
+
+inline TableGenerations table_generations_from_thrift(
+    const std::vector<TTableGeneration>& thrift_table_generations) {
+  TableGenerations table_generations;
+  for (const auto& thrift_table_generation : thrift_table_generations) {
+    table_generations.setGeneration(
+        thrift_table_generation.table_id,
+        TableGeneration{thrift_table_generation.tuple_count,
+                        thrift_table_generation.start_rowid});
+  }
+  return table_generations;
+}
+
+inline std::vector<TTableGeneration> table_generations_to_thrift(
+    const TableGenerations& table_generations) {
+  std::vector<TTableGeneration> thrift_table_generations;
+  for (const auto& table_id_and_generation : table_generations.asMap()) {
+    TTableGeneration thrift_table_generation;
+    thrift_table_generation.table_id = table_id_and_generation.first;
+    thrift_table_generation.tuple_count = table_id_and_generation.second.tuple_count;
+    thrift_table_generation.start_rowid = table_id_and_generation.second.start_rowid;
+    thrift_table_generations.push_back(thrift_table_generation);
+  }
+  return thrift_table_generations;
+}
+
 inline TTypeInfo type_info_to_thrift(const SQLTypeInfo& ti) {
   TTypeInfo thrift_ti;
   thrift_ti.type =
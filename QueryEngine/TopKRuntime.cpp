@@ -22,6 +22,8 @@
  * Copyright (c) 2017 MapD Technologies, Inc.  All rights reserved.
  */
 #include "../Shared/funcannotations.h"
+#include "TopKRuntime.h"
+#include "TypePunning.h"
 
 enum class HeapOrdering { MIN, MAX };
 
@@ -79,12 +81,15 @@ struct KeyComparator {
   const NullsOrdering nulls_ordering;
 };
 
-template <typename KeyT = int64_t, typename NodeT = int64_t>
+template <typename KeyT = int64_t,
+          typename NodeT = int64_t,
+          typename Comparator = KeyComparator<KeyT>,
+          typename Accessor = KeyAccessor<KeyT, NodeT>>
 ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
                                     const size_t heap_size,
                                     const NodeT curr_idx,
-                                    const KeyComparator<KeyT>& compare,
-                                    const KeyAccessor<KeyT, NodeT>& accessor) {
+                                    const Comparator& compare,
+                                    const Accessor& accessor) {
   for (NodeT i = curr_idx, last = static_cast<NodeT>(heap_size); i < last;) {
 #ifdef __CUDACC__
     const auto left_child = min(2 * i + 1, last);
@@ -120,11 +125,14 @@ ALWAYS_INLINE DEVICE void sift_down(NodeT* heap,
   }
 }
 
-template <typename KeyT = int64_t, typename NodeT = int64_t>
+template <typename KeyT = int64_t,
+          typename NodeT = int64_t,
+          typename Comparator = KeyComparator<KeyT>,
+          typename Accessor = KeyAccessor<KeyT, NodeT>>
 ALWAYS_INLINE DEVICE void sift_up(NodeT* heap,
                                   const NodeT curr_idx,
-                                  const KeyComparator<KeyT>& compare,
-                                  const KeyAccessor<KeyT, NodeT>& accessor) {
+                                  const Comparator& compare,
+                                  const Accessor& accessor) {
   for (NodeT i = curr_idx; i > 0 && (i - 1) < i;) {
     const auto parent = (i - 1) / 2;
     const auto curr_key = accessor.get(heap[i]);
@@ -261,3 +269,163 @@ DEF_GET_BIN_FROM_K_HEAP(int32_t)
 DEF_GET_BIN_FROM_K_HEAP(int64_t)
 DEF_GET_BIN_FROM_K_HEAP(float)
 DEF_GET_BIN_FROM_K_HEAP(double)
+
+// Keys of the multi-key heap, see TopKRuntime.h.
+
+ALWAYS_INLINE DEVICE int64_t read_heap_key(const int8_t* row_ptr,
+                                           const int64_t* key_desc) {
+  const auto key_ptr = row_ptr + key_desc[HEAP_KEY_OFFSET];
+  const auto flags = key_desc[HEAP_KEY_FLAGS];
+  if (flags & HEAP_KEY_FP) {
+    const double val = (flags & HEAP_KEY_WIDE)
+                           ? *reinterpret_cast<const double*>(key_ptr)
+                           : *reinterpret_cast<const float*>(key_ptr);
+    return *reinterpret_cast<const int64_t*>(may_alias_ptr(&val));
+  }
+  return (flags & HEAP_KEY_WIDE) ? *reinterpret_cast<const int64_t*>(key_ptr)
+                                 : *reinterpret_cast<const int32_t*>(key_ptr);
+}
+
+ALWAYS_INLINE DEVICE void write_heap_key(int8_t* row_ptr,
+                                         const int64_t* key_desc,
+                                         const int64_t key) {
+  const auto key_ptr = row_ptr + key_desc[HEAP_KEY_OFFSET];
+  const auto flags = key_desc[HEAP_KEY_FLAGS];
+  if (flags & HEAP_KEY_FP) {
+    const double val = *reinterpret_cast<const double*>(may_alias_ptr(&key));
+    if (flags & HEAP_KEY_WIDE) {
+      *reinterpret_cast<double*>(key_ptr) = val;
+    } else {
+      *reinterpret_cast<float*>(key_ptr) = static_cast<float>(val);
+    }
+  } else if (flags & HEAP_KEY_WIDE) {
+    *reinterpret_cast<int64_t*>(key_ptr) = key;
+  } else {
+    *reinterpret_cast<int32_t*>(key_ptr) = static_cast<int32_t>(key);
+  }
+}
+
+// Negative if lhs comes first in the requested order, positive if it comes after rhs.
+ALWAYS_INLINE DEVICE int32_t compare_heap_keys(const int64_t lhs,
+                                               const int64_t rhs,
+                                               const int64_t* key_desc) {
+  if (lhs == rhs) {
+    return 0;
+  }
+  const auto flags = key_desc[HEAP_KEY_FLAGS];
+  if (flags & HEAP_KEY_NULLABLE) {
+    const auto null_key = key_desc[HEAP_KEY_NULL];
+    const int32_t null_order = (flags & HEAP_KEY_NULLS_FIRST) ? -1 : 1;
+    if (lhs == null_key) {
+      return null_order;
+    }
+    if (rhs == null_key) {
+      return -null_order;
+    }
+  }
+  int32_t order{0};
+  if (flags & HEAP_KEY_FP) {
+    const double lhs_val = *reinterpret_cast<const double*>(may_alias_ptr(&lhs));
+    const double rhs_val = *reinterpret_cast<const double*>(may_alias_ptr(&rhs));
+    order = lhs_val < rhs_val ? -1 : (lhs_val > rhs_val ? 1 : 0);
+  } else {
+    auto lhs_val = lhs;
+    auto rhs_val = rhs;
+    const auto ranks = reinterpret_cast<const int32_t*>(key_desc[HEAP_KEY_RANKS]);
+    if (ranks) {
+      // ids added to the dictionary after it was ranked sort after the ranked ones
+      const auto rank_count = key_desc[HEAP_KEY_RANK_COUNT];
+      lhs_val = lhs_val >= 0 && lhs_val < rank_count ? ranks[lhs_val] : lhs_val;
+      rhs_val = rhs_val >= 0 && rhs_val < rank_count ? ranks[rhs_val] : rhs_val;
+    }
+    order = lhs_val < rhs_val ? -1 : (lhs_val > rhs_val ? 1 : 0);
+  }
+  return (flags & HEAP_KEY_DESC) ? -order : order;
+}
+
+struct HeapRowAccessor {
+  DEVICE HeapRowAccessor(const int8_t* rows_buff, const size_t row_stride)
+      : buffer(rows_buff), stride(row_stride) {}
+  ALWAYS_INLINE DEVICE const int8_t* get(const int64_t rowid) const {
+    return buffer + stride * rowid;
+  }
+
+  const int8_t* buffer;
+  const size_t stride;
+};
+
+// Orders the rows of the heap by all the keys; the rows which come last in the
+// requested order are on top.
+struct HeapRowComparator {
+  DEVICE HeapRowComparator(const int64_t* descs, const uint32_t count)
+      : key_descs(descs), key_count(count) {}
+  ALWAYS_INLINE DEVICE bool operator()(const int8_t* lhs, const int8_t* rhs) const {
+    for (uint32_t i = 0; i < key_count; ++i) {
+      const auto key_desc = key_descs + i * HEAP_KEY_DESC_WORDS;
+      const auto order = compare_heap_keys(
+          read_heap_key(lhs, key_desc), read_heap_key(rhs, key_desc), key_desc);
+      if (order) {
+        return order > 0;
+      }
+    }
+    return false;
+  }
+  ALWAYS_INLINE DEVICE bool comesAfter(const int64_t* keys, const int8_t* row) const {
+    for (uint32_t i = 0; i < key_count; ++i) {
+      const auto key_desc = key_descs + i * HEAP_KEY_DESC_WORDS;
+      const auto order =
+          compare_heap_keys(keys[i], read_heap_key(row, key_desc), key_desc);
+      if (order) {
+        return order > 0;
+      }
+    }
+    return false;
+  }
+
+  const int64_t* key_descs;
+  const uint32_t key_count;
+};
+
+// Same as get_bin_from_k_heap_impl for an ORDER BY on several keys or on dictionary
+// encoded strings. This function only works on rowwise layout.
+extern "C" NEVER_INLINE DEVICE int64_t* get_bin_from_k_heap_multi_key(
+    int64_t* heaps,
+    const uint32_t k,
+    const uint32_t row_size_quad,
+    const int64_t* key_descs,
+    const uint32_t key_count,
+    const int64_t* curr_keys) {
+  const int32_t thread_global_index = pos_start_impl(nullptr);
+  const int32_t thread_count = pos_step_impl();
+  int64_t& node_count = heaps[thread_global_index];
+  int64_t* heap_ptr = heaps + thread_count + thread_global_index * k;
+  int64_t* rows_ptr =
+      heaps + thread_count + thread_count * k + thread_global_index * row_size_quad * k;
+  HeapRowComparator compare(key_descs, key_count);
+  HeapRowAccessor accessor(reinterpret_cast<int8_t*>(rows_ptr),
+                           row_size_quad * sizeof(int64_t));
+  const bool push{node_count < static_cast<int64_t>(k)};
+  int64_t bin_idx{0};
+  if (push) {
+    bin_idx = node_count++;
+    heap_ptr[bin_idx] = bin_idx;
+  } else {
+    bin_idx = heap_ptr[0];
+    if (compare.comesAfter(curr_keys, accessor.get(bin_idx))) {
+      return nullptr;
+    }
+  }
+  auto row_ptr = rows_ptr + bin_idx * row_size_quad;
+  for (uint32_t i = 0; i < key_count; ++i) {
+    write_heap_key(reinterpret_cast<int8_t*>(row_ptr),
+                   key_descs + i * HEAP_KEY_DESC_WORDS,
+                   curr_keys[i]);
+  }
+  if (push) {
+    sift_up<const int8_t*, int64_t>(heap_ptr, node_count - 1, compare, accessor);
+  } else {
+    sift_down<const int8_t*, int64_t>(heap_ptr, node_count, 0, compare, accessor);
+  }
+  row_ptr[0] = bin_idx;
+  return row_ptr + 1;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Order keys of get_bin_from_k_heap_multi_key, shared by TopKRuntime.cpp and the code
+// generator. Every key is described by HEAP_KEY_DESC_WORDS 64-bit words. The keys of a
+// candidate row are passed widened to 64 bits: integers sign extended, floating point
+// values as the bits of their double representation.
+
+enum HeapKeyDescWord : uint32_t {
+  HEAP_KEY_OFFSET,      // byte offset of the key slot in the row
+  HEAP_KEY_FLAGS,       // HeapKeyFlag bits
+  HEAP_KEY_NULL,        // null value, widened like the keys
+  HEAP_KEY_RANKS,       // sort ranks of a dictionary encoded string, zero otherwise
+  HEAP_KEY_RANK_COUNT,  // number of sort ranks
+  HEAP_KEY_DESC_WORDS
+};
+
+enum HeapKeyFlag : int64_t {
+  HEAP_KEY_FP = 1,
+  HEAP_KEY_WIDE = 2,  // the slot holds 8 bytes
+  HEAP_KEY_DESC = 4,
+  HEAP_KEY_NULLS_FIRST = 8,
+  HEAP_KEY_NULLABLE = 16
+};
@@ -31,8 +31,10 @@
 #include <llvm/Support/Program.h>
 #include <llvm/Support/raw_ostream.h>
 #include <boost/process/search_path.hpp>
+#include <fstream>
 #include <iterator>
 #include <memory>
+#include <sstream>
 
 #if LLVM_VERSION_MAJOR >= 11
 #include <llvm/Support/Host.h>
@@ -40,6 +42,8 @@
 
 #include "Execute.h"
 #include "Logger/Logger.h"
+#include "MapDRelease.h"
+#include "MurmurHash.h"
 
 using namespace clang;
 using namespace clang::tooling;
@@ -211,6 +215,76 @@ std::string UdfCompiler::genCpuIrFilename(const char* udf_fileName) {
   return cpu_file_name;
 }
 
+std::string UdfCompiler::genHashFilename(const char* udf_file_name) {
+  std::string hash_file_name(removeFileExtension(udf_file_name));
+
+  hash_file_name += "_udf.hash";
+  return hash_file_name;
+}
+
+std::string UdfCompiler::genPreprocessedFilename(const char* udf_file_name) {
+  std::string preprocessed_file_name(removeFileExtension(udf_file_name));
+
+  preprocessed_file_name += "_udf.ii";
+  return preprocessed_file_name;
+}
+
+// Returns the source with the headers it includes expanded, or the bare source if it
+// can't be preprocessed; compiling it will report the error then.
+std::string UdfCompiler::readPreprocessedSource(const char* udf_file_name) {
+  const auto preprocessed_file_name = genPreprocessedFilename(udf_file_name);
+  const std::vector<std::string> command_line{clang_path_,
+                                              "-E",
+                                              "-o",
+                                              preprocessed_file_name,
+                                              "-std=c++14",
+                                              "-DNO_BOOST",
+                                              udf_file_name};
+  boost::filesystem::remove(preprocessed_file_name);
+  const auto status = compileFromCommandLine(command_line);
+  std::ifstream source_file(
+      !status && boost::filesystem::exists(preprocessed_file_name)
+          ? preprocessed_file_name
+          : std::string(udf_file_name),
+      std::ios::binary);
+  std::string source((std::istreambuf_iterator<char>(source_file)),
+                     std::istreambuf_iterator<char>());
+  boost::filesystem::remove(preprocessed_file_name);
+  return source;
+}
+
+// Hashes everything the outputs of the compilation depend on: the source and the
+// headers it includes, the compiler and its options, the target and the server which
+// reads the bitcode.
+std::string UdfCompiler::computeCompilationHash() {
+  std::string hashed = readPreprocessedSource(udf_file_name_.c_str());
+  hashed += '\0' + clang_path_;
+  for (const auto& clang_option : clang_options_) {
+    hashed += '\0' + clang_option;
+  }
+  hashed += '\0' + std::to_string(static_cast<int>(target_arch_));
+  hashed += '\0' + MAPD_RELEASE;
+#ifdef HAVE_CUDA
+  hashed += std::string("\0cuda", 5) + get_cuda_home();
+#endif
+  std::ostringstream oss;
+  oss << std::hex << MurmurHash64A(hashed.data(), hashed.size(), 0);
+  return oss.str();
+}
+
+bool UdfCompiler::isCompilationCached(const std::string& compilation_hash) {
+  std::ifstream hash_file(genHashFilename(udf_file_name_.c_str()));
+  std::string cached_hash;
+  if (!(hash_file >> cached_hash) || cached_hash != compilation_hash) {
+    return false;
+  }
+  return boost::filesystem::exists(udf_ast_file_name_) &&
+#ifdef HAVE_CUDA
+         boost::filesystem::exists(genGpuIrFilename(udf_file_name_.c_str())) &&
+#endif
+         boost::filesystem::exists(genCpuIrFilename(udf_file_name_.c_str()));
+}
+
 int UdfCompiler::compileFromCommandLine(const std::vector<std::string>& command_line) {
   UdfClangDriver compiler_driver(clang_path_);
   auto the_driver(compiler_driver.getClangDriver());
@@ -351,6 +425,10 @@ const std::string& UdfCompiler::getAstFileName() const {
   return udf_ast_file_name_;
 }
 
+bool UdfCompiler::usedCachedCompilation() const {
+  return used_cached_compilation_;
+}
+
 void UdfCompiler::init(const std::string& clang_path) {
   replaceExtn(udf_ast_file_name_, "ast");
 
@@ -445,6 +523,21 @@ int UdfCompiler::compileUdf() {
     return 1;
   }
 
+  // The AST and the bitcode files of a previous compilation are reused as long as their
+  // inputs haven't changed; the bitcode was optimized when it was compiled.
+  const auto compilation_hash = computeCompilationHash();
+  const auto hash_file_name = genHashFilename(udf_file_name_.c_str());
+  used_cached_compilation_ = isCompilationCached(compilation_hash);
+  if (used_cached_compilation_) {
+    LOG(INFO) << "UDFCompiler reusing the compilation of " << udf_file_name_;
+    readCpuCompiledModule();
+#ifdef HAVE_CUDA
+    readGpuCompiledModule();
+#endif
+    return 0;
+  }
+  boost::filesystem::remove(hash_file_name);
+
   auto ast_result = parseToAst(udf_file_name_.c_str());
 
   if (ast_result == 0) {
@@ -475,5 +568,7 @@ int UdfCompiler::compileUdf() {
     return 1;
   }
 
+  std::ofstream hash_file(hash_file_name);
+  hash_file << compilation_hash;
   return 0;
 }
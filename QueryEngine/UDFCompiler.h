@@ -58,6 +58,9 @@ class UdfCompiler {
               const std::vector<std::string> clang_options);
   int compileUdf();
   const std::string& getAstFileName() const;
+  // True if compileUdf reused the outputs of a previous compilation of the same source
+  // with the same options.
+  bool usedCachedCompilation() const;
 
  private:
   void init(const std::string& clang_path);
@@ -74,6 +77,11 @@ class UdfCompiler {
   void readGpuCompiledModule();
   void readCpuCompiledModule();
   int compileForGpu();
+  std::string genHashFilename(const char* udf_file_name);
+  std::string genPreprocessedFilename(const char* udf_file_name);
+  std::string readPreprocessedSource(const char* udf_file_name);
+  std::string computeCompilationHash();
+  bool isCompilationCached(const std::string& compilation_hash);
 
  private:
   std::string udf_file_name_;
@@ -81,5 +89,6 @@ class UdfCompiler {
   CudaMgr_Namespace::NvidiaDeviceArch target_arch_;
   std::string clang_path_;
   std::vector<std::string> clang_options_;
+  bool used_cached_compilation_{false};
 };
 #endif
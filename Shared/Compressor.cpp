@@ -46,7 +46,8 @@ BloscCompressor::BloscCompressor() {
   // We chosse faster compressor, accepting slightly lower compression ratio
   // https://lz4.github.io/lz4/
 
-  blosc_set_compressor(BLOSC_LZ4HC_COMPNAME);
+  compressor_name = BLOSC_LZ4HC_COMPNAME;
+  blosc_set_compressor(compressor_name.c_str());
 }
 
 BloscCompressor::~BloscCompressor() {
@@ -143,6 +144,54 @@ size_t BloscCompressor::decompress(const uint8_t* compressed_buffer,
   return decompressed_len;
 }
 
+int64_t BloscCompressor::compressBlock(const uint8_t* buffer,
+                                       const size_t buffer_size,
+                                       uint8_t* compressed_buffer,
+                                       const size_t compressed_buffer_size) {
+  if (compressed_buffer_size < BLOSC_MIN_HEADER_LENGTH) {
+    return 0;
+  }
+  std::string compressor;
+  {
+    std::lock_guard<std::mutex> compressor_lock_(compressor_lock);
+    compressor = compressor_name;
+  }
+  // the context variant keeps no global state, so concurrent callers don't serialize
+  const auto compressed_len = blosc_compress_ctx(5,
+                                                 1,
+                                                 sizeof(unsigned char),
+                                                 buffer_size,
+                                                 buffer,
+                                                 &compressed_buffer[0],
+                                                 compressed_buffer_size,
+                                                 compressor.c_str(),
+                                                 0,
+                                                 1);
+  if (compressed_len <= 0) {
+    throw CompressionFailedError(std::string("failed to compress block of length ") +
+                                 std::to_string(buffer_size));
+  }
+  return compressed_len;
+}
+
+size_t BloscCompressor::decompressBlock(const uint8_t* compressed_buffer,
+                                        uint8_t* decompressed_buffer,
+                                        const size_t decompressed_size) {
+  size_t decompressed_buf_len, compressed_buf_len, block_size, decompressed_len = 0;
+  getBloscBufferSizes(
+      &compressed_buffer[0], &compressed_buf_len, &decompressed_buf_len, &block_size);
+  if (compressed_buf_len > 0 && decompressed_size == decompressed_buf_len) {
+    decompressed_len = blosc_decompress_ctx(
+        &compressed_buffer[0], decompressed_buffer, decompressed_size, 1);
+  }
+  if (decompressed_len != decompressed_size) {
+    throw CompressionFailedError(
+        std::string("failed to decompress block for compressed size: ") +
+        std::to_string(compressed_buf_len));
+  }
+  return decompressed_len;
+}
+
 std::string BloscCompressor::decompress(const std::string& buffer,
                                         const size_t decompressed_size) {
   std::vector<uint8_t> decompressed_buffer(decompressed_size);
@@ -230,5 +279,9 @@ int BloscCompressor::setCompressor(std::string& compressor_name) {
   // Blosc is resilent enough to detect that the comprressor that was provided to it was
   // supported or not. If the compressor is invalid or not supported it will simply keep
   // current compressor.
-  return blosc_set_compressor(compressor_name.c_str());
+  const auto compressor_code = blosc_set_compressor(compressor_name.c_str());
+  if (compressor_code >= 0) {
+    this->compressor_name = compressor_name;
+  }
+  return compressor_code;
 }
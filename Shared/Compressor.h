@@ -62,6 +62,16 @@ class BloscCompressor {
                     const size_t decompressed_size);
   std::string decompress(const std::string& buffer, const size_t decompressed_size);
 
+  // Single threaded variants that don't hold the compressor lock while they run, for
+  // callers that already compress or decompress many blocks in parallel.
+  int64_t compressBlock(const uint8_t* buffer,
+                        const size_t buffer_size,
+                        uint8_t* compressed_buffer,
+                        const size_t compressed_buffer_size);
+  size_t decompressBlock(const uint8_t* compressed_buffer,
+                         uint8_t* decompressed_buffer,
+                         const size_t decompressed_size);
+
   size_t compressOrMemcpy(const uint8_t* input_buffer,
                           uint8_t* output_buffer,
                           const size_t uncompressed_size,
@@ -86,5 +96,7 @@ class BloscCompressor {
  private:
   BloscCompressor();
   std::mutex compressor_lock;
+  // compressor passed to the context functions of compressBlock
+  std::string compressor_name;
   static BloscCompressor* instance;
 };
@@ -75,6 +75,16 @@ inline bool is_agg_domain_range_equivalent(const SQLAgg& agg_kind) {
   return false;
 }
 
+/**
+ * Returns true if the aggregate slot holds a pointer to the state of a quantile: a
+ * quantile::TDigest for APPROX_MEDIAN, a quantile::ExactQuantile for PERCENTILE_CONT and
+ * PERCENTILE_DISC.
+ */
+inline bool is_quantile_agg(const SQLAgg& agg_kind) {
+  return agg_kind == kAPPROX_MEDIAN || agg_kind == kPERCENTILE_CONT ||
+         agg_kind == kPERCENTILE_DISC;
+}
+
 template <class PointerType>
 inline TargetInfo get_target_info(const PointerType target_expr,
                                   const bool bigint_count) {
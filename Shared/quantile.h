@@ -31,8 +31,11 @@
 #include "gpu_enabled.h"
 
 #ifndef __CUDACC__
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <ostream>
+#include <vector>
 #endif
 
 #include <limits>
@@ -189,6 +192,9 @@ class TDigest {
   IndexType const buf_allocate_{0};
   IndexType const centroids_allocate_{0};
 
+  // Quantile returned by quantile() with no argument, e.g. 0.5 for APPROX_MEDIAN.
+  RealType const q_{0.5};
+
   DEVICE RealType max() const { return centroids_.max_; }
   DEVICE RealType min() const { return centroids_.min_; }
 
@@ -216,12 +222,14 @@ class TDigest {
     centroids_.clear();
   }
 
-  DEVICE TDigest(SimpleAllocator* simple_allocator,
+  DEVICE TDigest(RealType q,
+                 SimpleAllocator* simple_allocator,
                  IndexType buf_allocate,
                  IndexType centroids_allocate)
       : simple_allocator_(simple_allocator)
       , buf_allocate_(buf_allocate)
-      , centroids_allocate_(centroids_allocate) {}
+      , centroids_allocate_(centroids_allocate)
+      , q_(q) {}
 
   DEVICE Centroids<RealType, IndexType>& centroids() { return centroids_; }
 
@@ -242,6 +250,9 @@ class TDigest {
     mergeCentroids(t_digest.centroids_);
   }
 
+  // Uses buf_ as scratch space.
+  DEVICE RealType quantile() { return quantile(q_); }
+
   // Uses buf_ as scratch space.
   DEVICE RealType quantile(RealType const q) {
     assert(centroids_.size() <= buf_.capacity());
@@ -817,4 +828,58 @@ DEVICE RealType TDigest<RealType, IndexType>::slope(IndexType idx1, IndexType id
 
 using TDigest = detail::TDigest<double, size_t>;
 
+#ifndef __CUDACC__
+
+// Exact quantiles of PERCENTILE_CONT and PERCENTILE_DISC. Every value of the group is
+// kept, so memory grows with the group unlike the TDigest, and the quantile is selected
+// with std::nth_element instead of sorting the values.
+class ExactQuantile {
+  std::vector<double> values_;
+  double const q_;
+  bool const interpolate_;  // PERCENTILE_CONT, otherwise PERCENTILE_DISC
+
+ public:
+  ExactQuantile(double const q, bool const interpolate)
+      : q_(q), interpolate_(interpolate) {}
+
+  void add(double const value) { values_.push_back(value); }
+
+  void merge(ExactQuantile const& that) {
+    values_.insert(values_.end(), that.values_.begin(), that.values_.end());
+  }
+
+  // Returns NaN if there are no values. Reorders the values.
+  double quantile();
+
+  size_t size() const { return values_.size(); }
+};
+
+inline double ExactQuantile::quantile() {
+  if (values_.empty()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  size_t const n = values_.size();
+  if (interpolate_) {
+    // Linear interpolation between the values around position q * (n - 1).
+    double const pos = q_ * (n - 1);
+    auto const lo = values_.begin() + static_cast<size_t>(std::floor(pos));
+    std::nth_element(values_.begin(), lo, values_.end());
+    double const frac = pos - std::floor(pos);
+    if (frac == 0 || lo + 1 == values_.end()) {
+      return *lo;
+    }
+    // nth_element leaves every value after lo not less than it.
+    double const hi = *std::min_element(lo + 1, values_.end());
+    return *lo + frac * (hi - *lo);
+  } else {
+    // The first value whose cumulative distribution is at least q.
+    size_t const idx = std::max(static_cast<size_t>(std::ceil(q_ * n)), size_t(1)) - 1;
+    auto const nth = values_.begin() + std::min(idx, n - 1);
+    std::nth_element(values_.begin(), nth, values_.end());
+    return *nth;
+  }
+}
+
+#endif
+
 }  // namespace quantile
@@ -77,7 +77,9 @@ enum SQLAgg {
   kAPPROX_COUNT_DISTINCT,
   kAPPROX_MEDIAN,
   kSAMPLE,
-  kSINGLE_VALUE
+  kSINGLE_VALUE,
+  kPERCENTILE_CONT,
+  kPERCENTILE_DISC
 };
 
 enum class SqlWindowFunctionKind {
@@ -132,6 +134,10 @@ inline std::string toString(const SQLAgg& kind) {
       return "SAMPLE";
     case kSINGLE_VALUE:
       return "SINGLE_VALUE";
+    case kPERCENTILE_CONT:
+      return "PERCENTILE_CONT";
+    case kPERCENTILE_DISC:
+      return "PERCENTILE_DISC";
   }
   LOG(FATAL) << "Invalid aggregate kind: " << kind;
   return "";
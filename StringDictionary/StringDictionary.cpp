@@ -77,6 +77,38 @@ const uint64_t round_up_p2(const uint64_t num) {
   return in;
 }
 
+// Layout of the hash index file: the header, the hash table and, if the hashes are
+// materialized, the hashes of the strings covered by the index.
+struct HashIndexHeader {
+  uint64_t magic;
+  uint64_t str_count;         // strings covered by the index, in storage order
+  uint64_t payload_file_off;  // payload bytes of those strings
+  uint64_t hash_table_size;
+  uint32_t version;
+  uint32_t materialize_hashes;
+};
+
+constexpr uint64_t HASH_INDEX_MAGIC{0x5844495348534944};
+constexpr uint32_t HASH_INDEX_VERSION{1};
+
+size_t hash_index_file_size(const HashIndexHeader& header) {
+  return sizeof(header) + header.hash_table_size * sizeof(int32_t) +
+         (header.materialize_hashes ? header.str_count * sizeof(string_dict_hash_t) : 0);
+}
+
+bool write_all(const int fd, const void* data, size_t size) {
+  auto ptr = static_cast<const char*>(data);
+  while (size) {
+    const auto written = write(fd, ptr, size);
+    if (written <= 0) {
+      return false;
+    }
+    ptr += written;
+    size -= written;
+  }
+  return true;
+}
+
 string_dict_hash_t hash_string(const std::string_view& str) {
   string_dict_hash_t str_hash = 1;
   // rely on fact that unsigned overflow is defined and wraps
@@ -121,6 +153,13 @@ StringDictionary::StringDictionary(const std::string& folder,
     offsets_path_ = (storage_path / boost::filesystem::path("DictOffsets")).string();
     const auto payload_path =
         (storage_path / boost::filesystem::path("DictPayload")).string();
+    hash_index_path_ =
+        (storage_path / boost::filesystem::path("DictHashIndex")).string();
+    if (!recover) {
+      // the storage files are truncated below, an index left behind would be stale
+      boost::system::error_code ec;
+      boost::filesystem::remove(hash_index_path_, ec);
+    }
     payload_fd_ = checked_open(payload_path.c_str(), recover);
     offset_fd_ = checked_open(offsets_path_.c_str(), recover);
     payload_file_size_ = omnisci::file_size(payload_fd_);
@@ -164,8 +203,10 @@ StringDictionary::StringDictionary(const std::string& folder,
         return;
       }
 
-      unsigned string_id = 0;
       mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+      // Only the strings added after the hash index was written need to be hashed.
+      loadHashIndex(str_count);
+      unsigned string_id = str_count_;
 
       uint32_t thread_inits = 0;
       const auto thread_count = std::thread::hardware_concurrency();
@@ -173,7 +214,7 @@ StringDictionary::StringDictionary(const std::string& folder,
           2000, std::min<uint32_t>(200000, (str_count / thread_count) + 1));
       std::vector<std::future<std::vector<std::pair<string_dict_hash_t, unsigned int>>>>
           dictionary_futures;
-      for (string_id = 0; string_id < str_count; string_id += items_per_thread) {
+      for (; string_id < str_count; string_id += items_per_thread) {
         dictionary_futures.emplace_back(std::async(
             std::launch::async, [string_id, str_count, items_per_thread, this] {
               std::vector<std::pair<string_dict_hash_t, unsigned int>> hashVec;
@@ -230,6 +271,74 @@ void StringDictionary::processDictionaryFutures(
   dictionary_futures.clear();
 }
 
+/**
+ * Loads the hash table persisted by writeHashIndex() if it covers a prefix of the
+ * strings in storage and the table has room for all of them.
+ * @param storage_str_count number of strings in storage
+ * @return true if the hash index was loaded, str_count_ is then the number of strings
+ * it covers
+ */
+bool StringDictionary::loadHashIndex(const size_t storage_str_count) noexcept {
+  const auto fd = omnisci::open(hash_index_path_.c_str(), O_RDWR, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  const auto file_size = omnisci::file_size(fd);
+  HashIndexHeader header{};
+  bool valid = file_size >= sizeof(header);
+  char* index_map{nullptr};
+  if (valid) {
+    index_map = reinterpret_cast<char*>(omnisci::checked_mmap(fd, file_size));
+    memcpy(&header, index_map, sizeof(header));
+    valid = header.magic == HASH_INDEX_MAGIC && header.version == HASH_INDEX_VERSION &&
+            static_cast<bool>(header.materialize_hashes) == materialize_hashes_ &&
+            header.str_count <= storage_str_count &&
+            header.hash_table_size > 2 * storage_str_count &&
+            !(header.hash_table_size & (header.hash_table_size - 1)) &&
+            hash_index_file_size(header) == file_size;
+  }
+  if (valid && header.str_count) {
+    // the index must end where the payload of its last string ends
+    const auto last_str = getStringFromStorage(header.str_count - 1);
+    valid = !last_str.canary &&
+            last_str.c_str_ptr + last_str.size == payload_map_ + header.payload_file_off;
+  }
+  if (valid) {
+    const auto hash_table =
+        reinterpret_cast<const int32_t*>(index_map + sizeof(header));
+    std::vector<int32_t> new_str_ids(hash_table, hash_table + header.hash_table_size);
+    for (const auto str_id : new_str_ids) {
+      if (str_id != INVALID_STR_ID &&
+          (str_id < 0 || static_cast<size_t>(str_id) >= header.str_count)) {
+        valid = false;
+        break;
+      }
+    }
+    if (valid) {
+      string_id_string_dict_hash_table_.swap(new_str_ids);
+      if (materialize_hashes_) {
+        const auto hashes = reinterpret_cast<const string_dict_hash_t*>(
+            hash_table + header.hash_table_size);
+        hash_cache_.assign(header.hash_table_size / 2, 0);
+        std::copy(hashes, hashes + header.str_count, hash_cache_.begin());
+      }
+      str_count_ = header.str_count;
+      payload_file_off_ = header.payload_file_off;
+      hash_index_str_count_ = header.str_count;
+      hash_index_table_size_ = header.hash_table_size;
+    }
+  }
+  if (index_map) {
+    omnisci::checked_munmap(index_map, file_size);
+  }
+  omnisci::close(fd);
+  if (!valid) {
+    VLOG(1) << "String dictionary hash index " << hash_index_path_
+            << " doesn't match the storage, rebuilding the hash table";
+  }
+  return valid;
+}
+
 /**
  * Method to retrieve number of strings in storage via a binary search for the first
  * canary
@@ -770,18 +879,12 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
           auto a_str = this->getStringFromStorage(a);
           return string_lt(a_str.c_str_ptr, a_str.size, b.c_str(), b.size());
         });
-
-    if (cache_itr == sorted_cache.end()) {
-      cache_index->index = sorted_cache.size() - 1;
-      cache_index->diff = 1;
-    } else {
+    cache_index->index = cache_itr - sorted_cache.begin();
+    cache_index->diff = 1;
+    if (cache_itr != sorted_cache.end()) {
       const auto cache_str = getStringFromStorage(*cache_itr);
-      if (!string_eq(
+      if (string_eq(
               cache_str.c_str_ptr, cache_str.size, pattern.c_str(), pattern.size())) {
-        cache_index->index = cache_itr - sorted_cache.begin() - 1;
-        cache_index->diff = 1;
-      } else {
-        cache_index->index = cache_itr - sorted_cache.begin();
         cache_index->diff = 0;
       }
     }
@@ -789,108 +892,61 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
     compare_cache_.put(pattern, cache_index);
   }
 
-  // since we have a cache in form of vector of ints which is sorted according to
-  // corresponding strings in the dictionary all we need is the index of the element
-  // which equal to the pattern that we are trying to match or the index of “biggest”
-  // element smaller than the pattern, to perform all the comparison operators over
-  // string. The search function guarantees we have such index so now it is just the
-  // matter to include all the elements in the result vector.
-
-  // For < operator if the index that we have points to the element which is equal to
-  // the pattern that we are searching for we simply get all the elements less than the
-  // index. If the element pointed by the index is not equal to the pattern we are
-  // comparing with we also need to include that index in result vector, except when the
-  // index points to 0 and the pattern is lesser than the smallest value in the string
-  // dictionary.
-
+  // Every operator selects a contiguous range of positions in the sorted cache: the
+  // strings before the lower bound of the pattern are less than it and the string at the
+  // lower bound is equal to it if diff is zero. Since sorted_ranks_ holds the position of
+  // every string id, the ids are then found by comparing their rank against the range,
+  // in id order and without going over the strings added after the generation.
+  const int32_t lower_bound = cache_index->index;
+  const int32_t upper_bound = lower_bound + (cache_index->diff ? 0 : 1);
+  const int32_t rank_count = sorted_cache.size();
+  int32_t begin_rank{0};
+  int32_t end_rank{rank_count};
+  bool negate{false};
   if (comp_operator == "<") {
-    size_t idx = cache_index->index;
-    if (cache_index->diff) {
-      idx = cache_index->index + 1;
-      if (cache_index->index == 0 && cache_index->diff > 0) {
-        idx = cache_index->index;
-      }
-    }
-    for (size_t i = 0; i < idx; i++) {
-      ret.push_back(sorted_cache[i]);
-    }
-
-    // For <= operator if the index that we have points to the element which is equal to
-    // the pattern that we are searching for we want to include the element pointed by
-    // the index in the result set. If the element pointed by the index is not equal to
-    // the pattern we are comparing with we just want to include all the ids with index
-    // less than the index that is cached, except when pattern that we are searching for
-    // is smaller than the smallest string in the dictionary.
-
+    end_rank = lower_bound;
   } else if (comp_operator == "<=") {
-    size_t idx = cache_index->index + 1;
-    if (cache_index == 0 && cache_index->diff > 0) {
-      idx = cache_index->index;
-    }
-    for (size_t i = 0; i < idx; i++) {
-      ret.push_back(sorted_cache[i]);
-    }
-
-    // For > operator we want to get all the elements with index greater than the index
-    // that we have except, when the pattern we are searching for is lesser than the
-    // smallest string in the dictionary we also want to include the id of the index
-    // that we have.
-
+    end_rank = upper_bound;
   } else if (comp_operator == ">") {
-    size_t idx = cache_index->index + 1;
-    if (cache_index->index == 0 && cache_index->diff > 0) {
-      idx = cache_index->index;
-    }
-    for (size_t i = idx; i < sorted_cache.size(); i++) {
-      ret.push_back(sorted_cache[i]);
-    }
-
-    // For >= operator when the indexed element that we have points to element which is
-    // equal to the pattern we are searching for we want to include that in the result
-    // vector. If the index that we have does not point to the string which is equal to
-    // the pattern we are searching we don’t want to include that id into the result
-    // vector except when the index is 0.
-
+    begin_rank = upper_bound;
   } else if (comp_operator == ">=") {
-    size_t idx = cache_index->index;
-    if (cache_index->diff) {
-      idx = cache_index->index + 1;
-      if (cache_index->index == 0 && cache_index->diff > 0) {
-        idx = cache_index->index;
-      }
-    }
-    for (size_t i = idx; i < sorted_cache.size(); i++) {
-      ret.push_back(sorted_cache[i]);
-    }
+    begin_rank = lower_bound;
   } else if (comp_operator == "=") {
-    if (!cache_index->diff) {
-      ret.push_back(sorted_cache[cache_index->index]);
-    }
-
-    // For <> operator it is simple matter of not including id of string which is equal
-    // to pattern we are searching for.
+    begin_rank = lower_bound;
+    end_rank = upper_bound;
   } else if (comp_operator == "<>") {
-    if (!cache_index->diff) {
-      size_t idx = cache_index->index;
-      for (size_t i = 0; i < idx; i++) {
-        ret.push_back(sorted_cache[i]);
-      }
-      ++idx;
-      for (size_t i = idx; i < sorted_cache.size(); i++) {
-        ret.push_back(sorted_cache[i]);
-      }
-    } else {
-      for (size_t i = 0; i < sorted_cache.size(); i++) {
-        ret.insert(ret.begin(), sorted_cache.begin(), sorted_cache.end());
-      }
-    }
-
+    begin_rank = lower_bound;
+    end_rank = upper_bound;
+    negate = true;
   } else {
-    std::runtime_error("Unsupported string comparison operator");
+    throw std::runtime_error("Unsupported string comparison operator");
+  }
+  CHECK(sorted_ranks_);
+  const auto& ranks = *sorted_ranks_;
+  const size_t id_count = std::min(generation, str_count_);
+  for (size_t string_id = 0; string_id < id_count; ++string_id) {
+    const auto rank = ranks[string_id];
+    if ((rank >= begin_rank && rank < end_rank) != negate) {
+      ret.push_back(string_id);
+    }
   }
   return ret;
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionary::getSortedRanks() {
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  if (client_) {
+    return nullptr;
+  }
+  if (sorted_cache.size() < str_count_) {
+    buildSortedCache();
+  }
+  if (!sorted_ranks_) {
+    sorted_ranks_ = std::make_shared<std::vector<int32_t>>();
+  }
+  return sorted_ranks_;
+}
+
 namespace {
 
 bool is_regexp_like(const std::string& str,
@@ -1395,9 +1451,77 @@ bool StringDictionary::checkpoint() noexcept {
         (omnisci::msync((void*)payload_map_, payload_file_size_, /*async=*/false) == 0);
   ret = ret && (omnisci::fsync(offset_fd_) == 0);
   ret = ret && (omnisci::fsync(payload_fd_) == 0);
+  // The hash index only saves hashing the strings again on open, the dictionary is
+  // durable without it. writeHashIndex() logs its failures.
+  writeHashIndex();
   return ret;
 }
 
+/**
+ * Persists the hash table next to the storage files, so that opening the dictionary
+ * doesn't need to hash all its strings again. The strings added after the index was
+ * written are hashed on open, so the index is only rewritten once they are a sizable
+ * part of the dictionary or the hash table was resized. The tables are copied under the
+ * write lock and written out after releasing it, lookups and inserts don't wait on disk.
+ */
+bool StringDictionary::writeHashIndex() noexcept {
+  std::lock_guard<std::mutex> hash_index_lock(hash_index_mutex_);
+  HashIndexHeader header;
+  std::vector<int32_t> hash_table;
+  std::vector<string_dict_hash_t> hashes;
+  try {
+    mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+    if (fillRateIsHigh(str_count_)) {
+      // the next string would resize the hash table, an index of it couldn't be loaded
+      increaseHashTableCapacity();
+    }
+    if (string_id_string_dict_hash_table_.size() == hash_index_table_size_ &&
+        str_count_ - hash_index_str_count_ <= hash_index_str_count_ / 8) {
+      return true;
+    }
+    header = {HASH_INDEX_MAGIC,
+              str_count_,
+              payload_file_off_,
+              string_id_string_dict_hash_table_.size(),
+              HASH_INDEX_VERSION,
+              materialize_hashes_};
+    hash_table = string_id_string_dict_hash_table_;
+    if (materialize_hashes_) {
+      hashes.assign(hash_cache_.begin(), hash_cache_.begin() + str_count_);
+    }
+  } catch (const std::bad_alloc&) {
+    LOG(WARNING) << "Not enough memory to write string dictionary hash index "
+                 << hash_index_path_;
+    return false;
+  }
+  // write a new file and move it over the old one, a crash leaves either of them
+  const auto tmp_path = hash_index_path_ + ".tmp";
+  const auto fd = omnisci::open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Could not write string dictionary hash index " << tmp_path;
+    return false;
+  }
+  bool ret =
+      write_all(fd, &header, sizeof(header)) &&
+      write_all(fd, hash_table.data(), hash_table.size() * sizeof(int32_t)) &&
+      write_all(fd, hashes.data(), hashes.size() * sizeof(string_dict_hash_t));
+  ret = ret && (omnisci::fsync(fd) == 0);
+  omnisci::close(fd);
+  boost::system::error_code ec;
+  if (ret) {
+    boost::filesystem::rename(tmp_path, hash_index_path_, ec);
+    ret = !ec;
+  }
+  if (!ret) {
+    LOG(WARNING) << "Could not write string dictionary hash index " << hash_index_path_;
+    boost::filesystem::remove(tmp_path, ec);
+    return false;
+  }
+  hash_index_str_count_ = header.str_count;
+  hash_index_table_size_ = header.hash_table_size;
+  return true;
+}
+
 void StringDictionary::buildSortedCache() {
   // This method is not thread-safe.
   const auto cur_cache_size = sorted_cache.size();
@@ -1426,12 +1550,15 @@ void StringDictionary::mergeSortedCache(std::vector<int32_t>& temp_sorted_cache)
   // this method is not thread safe
   std::vector<int32_t> updated_cache(temp_sorted_cache.size() + sorted_cache.size());
   size_t t_idx = 0, s_idx = 0, idx = 0;
+  // the positions before the first new string keep their string
+  size_t first_moved_idx = sorted_cache.size();
   for (; t_idx < temp_sorted_cache.size() && s_idx < sorted_cache.size(); idx++) {
     auto t_string = getStringFromStorage(temp_sorted_cache[t_idx]);
     auto s_string = getStringFromStorage(sorted_cache[s_idx]);
     const auto insert_from_temp_cache =
         string_lt(t_string.c_str_ptr, t_string.size, s_string.c_str_ptr, s_string.size);
     if (insert_from_temp_cache) {
+      first_moved_idx = std::min(first_moved_idx, idx);
       updated_cache[idx] = temp_sorted_cache[t_idx++];
     } else {
       updated_cache[idx] = sorted_cache[s_idx++];
@@ -1444,6 +1571,18 @@ void StringDictionary::mergeSortedCache(std::vector<int32_t>& temp_sorted_cache)
     updated_cache[idx++] = sorted_cache[s_idx++];
   }
   sorted_cache.swap(updated_cache);
+
+  // Only the ranks from the first new string onwards have changed.
+  if (!sorted_ranks_) {
+    sorted_ranks_ = std::make_shared<std::vector<int32_t>>();
+  } else if (sorted_ranks_.use_count() > 1) {
+    sorted_ranks_ = std::make_shared<std::vector<int32_t>>(*sorted_ranks_);
+  }
+  auto& ranks = *sorted_ranks_;
+  ranks.resize(sorted_cache.size());
+  for (size_t rank = first_moved_idx; rank < sorted_cache.size(); ++rank) {
+    ranks[sorted_cache[rank]] = rank;
+  }
 }
 
 void StringDictionary::populate_string_ids(
@@ -1473,6 +1612,59 @@ void StringDictionary::populate_string_ids(
   dest_dict->getOrAddBulk(strings, &dest_ids[0]);
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionary::getTranslationMap(
+    const std::shared_ptr<StringDictionary>& source_dict,
+    const std::shared_ptr<StringDictionary>& dest_dict,
+    const int32_t dest_dict_id,
+    const size_t source_id_count) {
+  CHECK(source_dict);
+  CHECK(dest_dict);
+  std::lock_guard<std::mutex> translation_maps_lock(source_dict->translation_maps_mutex_);
+  auto& translation_map = source_dict->translation_maps_[dest_dict_id];
+  if (!translation_map.ids || translation_map.dest_dict.lock() != dest_dict) {
+    // first translation to dest_dict, or the id was given to a new dictionary
+    translation_map = {dest_dict, 0, std::make_shared<std::vector<int32_t>>()};
+  }
+  const size_t dest_str_count = dest_dict->storageEntryCount();
+  const size_t translated_count = translation_map.ids->size();
+  const size_t source_str_count = std::max(
+      translated_count, std::min(source_dict->storageEntryCount(), source_id_count));
+  if (translated_count == source_str_count &&
+      translation_map.dest_str_count == dest_str_count) {
+    return translation_map.ids;
+  }
+  if (translation_map.ids.use_count() > 1) {
+    translation_map.ids = std::make_shared<std::vector<int32_t>>(*translation_map.ids);
+  }
+  auto& ids = *translation_map.ids;
+  ids.resize(source_str_count, INVALID_STR_ID);
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(translated_count, source_str_count),
+      [&ids, &source_dict, &dest_dict](const tbb::blocked_range<size_t>& r) {
+        for (size_t source_id = r.begin(); source_id != r.end(); ++source_id) {
+          ids[source_id] = dest_dict->getIdOfString(source_dict->getString(source_id));
+        }
+      });
+  // The strings added to dest_dict since the last call can only translate source ids
+  // which had no translation so far, look them up the other way around.
+  for (size_t dest_id = translation_map.dest_str_count;
+       translated_count && dest_id < dest_str_count;
+       ++dest_id) {
+    const auto source_id = source_dict->getIdOfString(dest_dict->getString(dest_id));
+    if (source_id != INVALID_STR_ID &&
+        static_cast<size_t>(source_id) < translated_count) {
+      ids[source_id] = dest_id;
+    }
+  }
+  translation_map.dest_str_count = dest_str_count;
+  return translation_map.ids;
+}
+
+void StringDictionary::eraseTranslationMap(const int32_t dest_dict_id) {
+  std::lock_guard<std::mutex> translation_maps_lock(translation_maps_mutex_);
+  translation_maps_.erase(dest_dict_id);
+}
+
 void StringDictionary::populate_string_array_ids(
     std::vector<std::vector<int32_t>>& dest_array_ids,
     StringDictionary* dest_dict,
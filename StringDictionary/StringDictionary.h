@@ -24,6 +24,8 @@
 
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -74,6 +76,12 @@ class StringDictionary {
                                   const std::string& comp_operator,
                                   const size_t generation);
 
+  // Returns the rank of every string id in the lexicographic order of the strings, so
+  // that comparing the ranks of two ids compares their strings. The ranks cover all the
+  // strings at the time of the call and aren't changed by later additions. Returns null
+  // for dictionaries served by a remote server.
+  std::shared_ptr<const std::vector<int32_t>> getSortedRanks();
+
   std::vector<int32_t> getRegexpLike(const std::string& pattern,
                                      const char escape,
                                      const size_t generation) const;
@@ -106,6 +114,31 @@ class StringDictionary {
       const StringDictionary* source_dict,
       const std::map<int32_t, std::string> transient_mapping = {});
 
+  /**
+   * @brief Returns the ids of the strings of \p source_dict in \p dest_dict
+   *
+   * Element i of the returned vector is the id in \p dest_dict of the string with id i
+   * in \p source_dict, or INVALID_STR_ID if \p dest_dict doesn't have that string. The
+   * translation is cached in \p source_dict, so that later calls only translate the
+   * strings which either dictionary added since. Vectors returned before aren't changed.
+   * The vector covers at least the first \p source_id_count ids, strings added to
+   * \p source_dict past them are only translated once a caller needs them.
+   *
+   * @param source_dict - dictionary of the ids to translate
+   * @param dest_dict - dictionary to translate the ids to
+   * @param dest_dict_id - id of \p dest_dict, the key of the cached translation
+   * @param source_id_count - number of source ids the caller needs, its generation
+   */
+  static std::shared_ptr<const std::vector<int32_t>> getTranslationMap(
+      const std::shared_ptr<StringDictionary>& source_dict,
+      const std::shared_ptr<StringDictionary>& dest_dict,
+      const int32_t dest_dict_id,
+      const size_t source_id_count);
+
+  // Drops the cached translation to the dictionary with the given id, see
+  // getTranslationMap(). Called when that dictionary is dropped.
+  void eraseTranslationMap(const int32_t dest_dict_id);
+
   static void populate_string_array_ids(
       std::vector<std::vector<int32_t>>& dest_array_ids,
       StringDictionary* dest_dict,
@@ -122,15 +155,22 @@ class StringDictionary {
     uint64_t size : 16;
   };
 
-  // In the compare_cache_value_t index represents the index of the sorted cache.
-  // The diff component represents whether the index the cache is pointing to is equal to
-  // the pattern it is cached for. We want to use diff so we don't have compare string
-  // again when we are retrieving it from the cache.
+  // In the compare_cache_value_t index is the number of strings which sort before the
+  // pattern it is cached for, i.e. its lower bound in the sorted cache. The diff
+  // component represents whether the string at that index differs from the pattern. We
+  // want to use diff so we don't have compare string again when we are retrieving it
+  // from the cache.
   struct compare_cache_value_t {
     int32_t index;
     int32_t diff;
   };
 
+  struct TranslationMap {
+    std::weak_ptr<StringDictionary> dest_dict;
+    size_t dest_str_count;  // strings of dest_dict already looked up in source ids
+    std::shared_ptr<std::vector<int32_t>> ids;
+  };
+
   struct PayloadString {
     char* c_str_ptr;
     size_t size;
@@ -141,6 +181,8 @@ class StringDictionary {
       std::vector<std::future<std::vector<std::pair<string_dict_hash_t, unsigned int>>>>&
           dictionary_futures);
   size_t getNumStringsFromStorage(const size_t storage_slots) const noexcept;
+  bool loadHashIndex(const size_t storage_str_count) noexcept;
+  bool writeHashIndex() noexcept;
   bool fillRateIsHigh(const size_t num_strings) const noexcept;
   void increaseHashTableCapacity() noexcept;
   template <class String>
@@ -208,9 +250,18 @@ class StringDictionary {
   std::vector<int32_t> string_id_string_dict_hash_table_;
   std::vector<string_dict_hash_t> hash_cache_;
   std::vector<int32_t> sorted_cache;
+  // sorted_ranks_[id] is the position of id in sorted_cache, copied on write while
+  // shared with the callers of getSortedRanks()
+  std::shared_ptr<std::vector<int32_t>> sorted_ranks_;
   bool isTemp_;
   bool materialize_hashes_;
   std::string offsets_path_;
+  std::string hash_index_path_;
+  // strings and hash table size covered by the hash index on disk
+  size_t hash_index_str_count_{0};
+  size_t hash_index_table_size_{0};
+  // serializes writeHashIndex(), which writes without holding rw_mutex_
+  std::mutex hash_index_mutex_;
   int payload_fd_;
   int offset_fd_;
   StringIdxEntry* offset_map_;
@@ -225,6 +276,9 @@ class StringDictionary {
   mutable std::map<std::string, int32_t> equal_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
+  // translations to other dictionaries, see getTranslationMap()
+  std::map<int32_t, TranslationMap> translation_maps_;
+  std::mutex translation_maps_mutex_;
   std::unique_ptr<StringDictionaryClient> client_;
   std::unique_ptr<StringDictionaryClient> client_no_timeout_;
 
@@ -16,6 +16,7 @@
 
 #include "StringDictionary/StringDictionaryProxy.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "Logger/Logger.h"
@@ -178,6 +179,63 @@ std::vector<int32_t> StringDictionaryProxy::getCompare(
   return result;
 }
 
+std::shared_ptr<const std::vector<int32_t>> StringDictionaryProxy::getSortedRanks()
+    const {
+  return string_dict_->getSortedRanks();
+}
+
+const int32_t* StringDictionaryProxy::getTranslationMap(
+    const StringDictionaryProxy* dest_proxy,
+    const int32_t dest_dict_id) const {
+  CHECK(dest_proxy);
+  CHECK_GE(generation_, 0);
+  CHECK_GE(dest_proxy->generation_, 0);
+  std::lock_guard<std::mutex> translation_maps_lock(translation_maps_mutex_);
+  std::map<int32_t, std::string> transient_int_to_str;
+  std::map<int32_t, std::string> dest_transient_int_to_str;
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    transient_int_to_str = transient_int_to_str_;
+  }
+  {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(dest_proxy->rw_mutex_);
+    dest_transient_int_to_str = dest_proxy->transient_int_to_str_;
+  }
+  const auto key = std::make_tuple(
+      dest_proxy, transient_int_to_str.size(), dest_transient_int_to_str.size());
+  // Transient ids start at -2, the entry at offset - 1 is never used.
+  const size_t offset = transient_int_to_str.size() + 1;
+  auto it = translation_maps_.find(key);
+  if (it == translation_maps_.end()) {
+    const auto dict_translation = StringDictionary::getTranslationMap(
+        string_dict_,
+        dest_proxy->string_dict_,
+        dest_dict_id,
+        static_cast<size_t>(generation_));
+    const auto id_count =
+        std::min(static_cast<size_t>(generation_), dict_translation->size());
+    std::vector<int32_t> translation(offset + id_count, StringDictionary::INVALID_STR_ID);
+    for (size_t id = 0; id < id_count; ++id) {
+      translation[offset + id] =
+          truncate_to_generation((*dict_translation)[id], dest_proxy->generation_);
+    }
+    // Strings which the destination dictionary doesn't have up to its generation can
+    // still be transient strings of the destination proxy.
+    for (const auto& [dest_id, str] : dest_transient_int_to_str) {
+      const auto id = truncate_to_generation(string_dict_->getIdOfString(str), id_count);
+      if (id != StringDictionary::INVALID_STR_ID &&
+          translation[offset + id] == StringDictionary::INVALID_STR_ID) {
+        translation[offset + id] = dest_id;
+      }
+    }
+    for (const auto& [id, str] : transient_int_to_str) {
+      translation[offset + id] = dest_proxy->getIdOfString(str);
+    }
+    it = translation_maps_.emplace(key, std::move(translation)).first;
+  }
+  return it->second.data() + offset;
+}
+
 namespace {
 
 bool is_regexp_like(const std::string& str,
@@ -21,6 +21,7 @@
 #include "StringDictionary.h"
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -50,6 +51,17 @@ class StringDictionaryProxy {
   std::vector<int32_t> getCompare(const std::string& pattern,
                                   const std::string& comp_operator) const;
 
+  // Ranks of the dictionary strings in sorted order, see StringDictionary. Transient ids
+  // aren't covered.
+  std::shared_ptr<const std::vector<int32_t>> getSortedRanks() const;
+
+  // Translation of ids of this proxy to ids of dest_proxy: map[id] is the same as
+  // dest_proxy->getIdOfString(getString(id)). Transient ids are negative, they index
+  // the entries before the returned pointer. The map stays valid as long as the proxy.
+  // dest_dict_id is the id of the dictionary of dest_proxy.
+  const int32_t* getTranslationMap(const StringDictionaryProxy* dest_proxy,
+                                   const int32_t dest_dict_id) const;
+
   std::vector<int32_t> getRegexpLike(const std::string& pattern, const char escape) const;
 
   const std::map<int32_t, std::string> getTransientMapping() const {
@@ -62,5 +74,10 @@ class StringDictionaryProxy {
   std::map<std::string, int32_t> transient_str_to_int_;
   int64_t generation_;
   mutable mapd_shared_mutex rw_mutex_;
+  // keyed by the destination and the transient string counts of both proxies
+  mutable std::map<std::tuple<const StringDictionaryProxy*, size_t, size_t>,
+                   std::vector<int32_t>>
+      translation_maps_;
+  mutable std::mutex translation_maps_mutex_;
 };
 #endif  // STRINGDICTIONARY_STRINGDICTIONARYPROXY_H
@@ -0,0 +1,420 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TableArchiver/NativeArchive.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <tuple>
+
+#include "Logger/Logger.h"
+#include "Shared/Compressor.h"
+#include "Shared/measure.h"
+#include "Shared/scope.h"
+#include "Shared/thread_count.h"
+
+namespace native_archive {
+
+namespace {
+
+// Archive layout (host byte order, like the page headers of data files):
+//   magic[8] block_size:u32
+//   { type:u8 name_size:u32 name[name_size]
+//     [file only] file_size:u64 { codec:u8 stored_size:u32 data[stored_size] }* }*
+//   end:u8
+// A file has ceil(file_size / block_size) blocks; only the last one is short.
+constexpr static char archive_magic[8] = {'O', 'M', 'N', 'I', 'A', 'R', 'C', '1'};
+constexpr static uint32_t archive_block_size = 16 * 1024 * 1024;
+
+enum class EntryType : uint8_t { End = 0, Directory = 1, File = 2 };
+enum class BlockCodec : uint8_t { Raw = 0, Blosc = 1 };
+
+inline auto simple_file_closer = [](std::FILE* f) { std::fclose(f); };
+using FilePtr = std::unique_ptr<std::FILE, decltype(simple_file_closer)>;
+
+FilePtr open_file(const std::string& path, const char* mode) {
+  FilePtr fp(std::fopen(path.c_str(), mode), simple_file_closer);
+  if (!fp) {
+    throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+  }
+  return fp;
+}
+
+struct Entry {
+  EntryType type;
+  std::string name;
+  std::string full_path;  // empty for inline files
+  const std::string* inline_data{nullptr};
+  size_t file_size{0};
+};
+
+struct Block {
+  BlockCodec codec;
+  std::vector<uint8_t> data;
+};
+
+class ArchiveWriter {
+ public:
+  ArchiveWriter(const std::string& path) : path_(path), fp_(open_file(path, "wb")) {}
+
+  template <typename T>
+  void write(const T& val) {
+    write(&val, sizeof(T));
+  }
+
+  void write(const void* data, const size_t size) {
+    if (size && std::fwrite(data, 1, size, fp_.get()) != size) {
+      throw std::runtime_error("Failed to write archive " + path_ + ": " +
+                               std::strerror(errno));
+    }
+  }
+
+  void writeString(const std::string& str) {
+    write(static_cast<uint32_t>(str.size()));
+    write(str.data(), str.size());
+  }
+
+  void close() {
+    if (std::fclose(fp_.release())) {
+      throw std::runtime_error("Failed to close archive " + path_ + ": " +
+                               std::strerror(errno));
+    }
+  }
+
+ private:
+  const std::string path_;
+  FilePtr fp_;
+};
+
+class ArchiveReader {
+ public:
+  ArchiveReader(const std::string& path) : path_(path), fp_(open_file(path, "rb")) {
+    char magic[sizeof archive_magic];
+    read(magic, sizeof magic);
+    if (std::memcmp(magic, archive_magic, sizeof magic)) {
+      throw std::runtime_error("Archive " + path_ + " is not a native table archive.");
+    }
+    block_size_ = read<uint32_t>();
+    if (!block_size_) {
+      throw std::runtime_error("Corrupted archive " + path_);
+    }
+  }
+
+  template <typename T>
+  T read() {
+    T val;
+    read(&val, sizeof(T));
+    return val;
+  }
+
+  void read(void* data, const size_t size) {
+    if (size && std::fread(data, 1, size, fp_.get()) != size) {
+      throw std::runtime_error("Failed to read archive " + path_ + ": " +
+                               (std::feof(fp_.get()) ? "unexpected end of file"
+                                                     : std::strerror(errno)));
+    }
+  }
+
+  std::string readString() {
+    std::string str(read<uint32_t>(), '\0');
+    read(&str[0], str.size());
+    return str;
+  }
+
+  void skip(const size_t size) {
+    if (std::fseek(fp_.get(), size, SEEK_CUR)) {
+      throw std::runtime_error("Failed to seek archive " + path_ + ": " +
+                               std::strerror(errno));
+    }
+  }
+
+  size_t blockSize() const { return block_size_; }
+
+ private:
+  const std::string path_;
+  FilePtr fp_;
+  size_t block_size_;
+};
+
+Block compress_block(const Entry& entry, const size_t offset, const size_t size) {
+  std::vector<uint8_t> raw(size);
+  if (entry.inline_data) {
+    std::memcpy(raw.data(), entry.inline_data->data() + offset, size);
+  } else {
+    auto fp = open_file(entry.full_path, "rb");
+    if (std::fseek(fp.get(), offset, SEEK_SET) ||
+        std::fread(raw.data(), 1, size, fp.get()) != size) {
+      throw std::runtime_error("Failed to read " + entry.full_path + ": " +
+                               std::strerror(errno));
+    }
+  }
+  // store the block as is unless blosc makes it smaller
+  std::vector<uint8_t> compressed(size);
+  try {
+    const auto compressed_size = BloscCompressor::getCompressor()->compressBlock(
+        raw.data(), size, compressed.data(), compressed.size());
+    if (compressed_size > 0 && static_cast<size_t>(compressed_size) < size) {
+      compressed.resize(compressed_size);
+      return {BlockCodec::Blosc, std::move(compressed)};
+    }
+  } catch (const CompressionFailedError&) {
+  }
+  return {BlockCodec::Raw, std::move(raw)};
+}
+
+void decompress_block(const std::string& file_path,
+                      const size_t offset,
+                      const size_t size,
+                      const BlockCodec codec,
+                      const std::vector<uint8_t>& stored) {
+  std::vector<uint8_t> raw;
+  const uint8_t* data = stored.data();
+  if (BlockCodec::Blosc == codec) {
+    raw.resize(size);
+    BloscCompressor::getCompressor()->decompressBlock(stored.data(), raw.data(), size);
+    data = raw.data();
+  } else if (stored.size() != size) {
+    throw std::runtime_error("Corrupted block in archived file " + file_path);
+  }
+  auto fp = open_file(file_path, "r+b");
+  if (std::fseek(fp.get(), offset, SEEK_SET) ||
+      std::fwrite(data, 1, size, fp.get()) != size) {
+    throw std::runtime_error("Failed to write " + file_path + ": " +
+                             std::strerror(errno));
+  }
+}
+
+void collect_entries(std::vector<Entry>& entries,
+                     const boost::filesystem::path& base_path,
+                     const std::string& relative_path) {
+  const auto full_path = base_path / relative_path;
+  if (boost::filesystem::is_regular_file(full_path)) {
+    entries.push_back({EntryType::File,
+                       relative_path,
+                       full_path.string(),
+                       nullptr,
+                       boost::filesystem::file_size(full_path)});
+  } else if (boost::filesystem::is_directory(full_path)) {
+    entries.push_back({EntryType::Directory, relative_path, full_path.string()});
+    boost::filesystem::directory_iterator end_it;
+    for (boost::filesystem::directory_iterator fit(full_path); fit != end_it; ++fit) {
+      collect_entries(
+          entries, base_path, relative_path + "/" + fit->path().filename().string());
+    }
+  } else {
+    throw std::runtime_error("Failed to archive " + full_path.string() +
+                             ": no such file or directory");
+  }
+}
+
+// Entry names are relative paths below the restore directory; anything that could
+// resolve outside of it is rejected before a file is created.
+boost::filesystem::path get_entry_path(const boost::filesystem::path& dest_path,
+                                       const std::string& name,
+                                       const std::string& archive_path) {
+  const boost::filesystem::path entry_path(name);
+  bool valid = !name.empty() && !entry_path.has_root_path();
+  for (const auto& component : entry_path) {
+    valid = valid && component != "..";
+  }
+  if (!valid) {
+    throw std::runtime_error("Invalid entry name " + name + " in archive " +
+                             archive_path);
+  }
+  return dest_path / entry_path;
+}
+
+}  // namespace
+
+bool is_native_archive(const std::string& archive_path) {
+  std::unique_ptr<std::FILE, decltype(simple_file_closer)> fp(
+      std::fopen(archive_path.c_str(), "rb"), simple_file_closer);
+  char magic[sizeof archive_magic];
+  return fp && std::fread(magic, 1, sizeof magic, fp.get()) == sizeof magic &&
+         !std::memcmp(magic, archive_magic, sizeof magic);
+}
+
+void create_archive(const std::string& archive_path,
+                    const std::string& base_path,
+                    const std::vector<std::pair<std::string, std::string>>& inline_files,
+                    const std::vector<std::string>& relative_paths) {
+  std::vector<Entry> entries;
+  for (const auto& [name, data] : inline_files) {
+    entries.push_back({EntryType::File, name, "", &data, data.size()});
+  }
+  for (const auto& relative_path : relative_paths) {
+    collect_entries(entries, base_path, relative_path);
+  }
+  // flatten blocks of all files so that small files don't serialize the pipeline
+  std::vector<std::tuple<size_t, size_t, size_t>> block_specs;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    for (size_t offset = 0; offset < entries[i].file_size;
+         offset += archive_block_size) {
+      block_specs.emplace_back(
+          i, offset, std::min<size_t>(archive_block_size, entries[i].file_size - offset));
+    }
+  }
+  // a failed dump must not leave a truncated archive behind
+  bool archived = false;
+  ScopeGuard remove_partial_archive = [&archive_path, &archived]() {
+    if (!archived) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(archive_path, ec);
+    }
+  };
+  const auto time_ms = measure<>::execution([&]() {
+    ArchiveWriter writer(archive_path);
+    writer.write(archive_magic, sizeof archive_magic);
+    writer.write(archive_block_size);
+    // read and compress up to cpu_threads() blocks ahead of the sequential writer
+    const size_t max_pending = std::max(cpu_threads(), 1);
+    std::deque<std::future<Block>> pending;
+    size_t next_spec = 0;
+    auto fill_pending = [&]() {
+      while (pending.size() < max_pending && next_spec < block_specs.size()) {
+        const auto [entry_idx, offset, size] = block_specs[next_spec++];
+        pending.push_back(std::async(std::launch::async,
+                                     compress_block,
+                                     std::cref(entries[entry_idx]),
+                                     offset,
+                                     size));
+      }
+    };
+    fill_pending();
+    for (const auto& entry : entries) {
+      writer.write(entry.type);
+      writer.writeString(entry.name);
+      if (EntryType::File != entry.type) {
+        continue;
+      }
+      writer.write(static_cast<uint64_t>(entry.file_size));
+      for (size_t offset = 0; offset < entry.file_size; offset += archive_block_size) {
+        CHECK(!pending.empty());
+        const auto block = pending.front().get();
+        pending.pop_front();
+        fill_pending();
+        writer.write(block.codec);
+        writer.write(static_cast<uint32_t>(block.data.size()));
+        writer.write(block.data.data(), block.data.size());
+      }
+    }
+    CHECK(pending.empty());
+    writer.write(EntryType::End);
+    writer.close();
+    archived = true;
+  });
+  VLOG(3) << "archived " << entries.size() << " entries in " << block_specs.size()
+          << " blocks to " << archive_path << ": " << time_ms << " ms";
+}
+
+std::string read_file(const std::string& archive_path, const std::string& file_name) {
+  ArchiveReader reader(archive_path);
+  while (true) {
+    const auto type = reader.read<EntryType>();
+    if (EntryType::End == type) {
+      break;
+    }
+    const auto name = reader.readString();
+    if (EntryType::File != type) {
+      continue;
+    }
+    const auto file_size = reader.read<uint64_t>();
+    const bool found = name == file_name;
+    std::string content(found ? file_size : 0, '\0');
+    for (size_t offset = 0; offset < file_size; offset += reader.blockSize()) {
+      const auto size = std::min<size_t>(reader.blockSize(), file_size - offset);
+      const auto codec = reader.read<BlockCodec>();
+      const auto stored_size = reader.read<uint32_t>();
+      if (!found) {
+        reader.skip(stored_size);
+        continue;
+      }
+      std::vector<uint8_t> stored(stored_size);
+      reader.read(stored.data(), stored_size);
+      if (BlockCodec::Blosc == codec) {
+        BloscCompressor::getCompressor()->decompressBlock(
+            stored.data(), reinterpret_cast<uint8_t*>(&content[offset]), size);
+      } else if (stored_size == size) {
+        std::memcpy(&content[offset], stored.data(), size);
+      } else {
+        throw std::runtime_error("Corrupted block in archived file " + name);
+      }
+    }
+    if (found) {
+      return content;
+    }
+  }
+  throw std::runtime_error("File " + file_name + " not found in archive " +
+                           archive_path);
+}
+
+void extract_archive(const std::string& archive_path, const std::string& dest_dir) {
+  const auto time_ms = measure<>::execution([&]() {
+    ArchiveReader reader(archive_path);
+    const boost::filesystem::path dest_path(dest_dir);
+    // decompress and write up to cpu_threads() blocks behind the sequential reader
+    const size_t max_pending = std::max(cpu_threads(), 1);
+    std::deque<std::future<void>> pending;
+    while (true) {
+      const auto type = reader.read<EntryType>();
+      if (EntryType::End == type) {
+        break;
+      }
+      const auto name = reader.readString();
+      const auto full_path = get_entry_path(dest_path, name, archive_path);
+      if (EntryType::Directory == type) {
+        boost::filesystem::create_directories(full_path);
+        continue;
+      }
+      if (EntryType::File != type) {
+        throw std::runtime_error("Corrupted entry " + name + " in archive " +
+                                 archive_path);
+      }
+      boost::filesystem::create_directories(full_path.parent_path());
+      const auto file_path = full_path.string();
+      open_file(file_path, "wb");
+      const auto file_size = reader.read<uint64_t>();
+      for (size_t offset = 0; offset < file_size; offset += reader.blockSize()) {
+        const auto size = std::min<size_t>(reader.blockSize(), file_size - offset);
+        const auto codec = reader.read<BlockCodec>();
+        std::vector<uint8_t> stored(reader.read<uint32_t>());
+        reader.read(stored.data(), stored.size());
+        if (pending.size() >= max_pending) {
+          pending.front().get();
+          pending.pop_front();
+        }
+        pending.push_back(std::async(
+            std::launch::async,
+            [file_path, offset, size, codec, stored = std::move(stored)]() {
+              decompress_block(file_path, offset, size, codec, stored);
+            }));
+      }
+    }
+    for (auto& future : pending) {
+      future.get();
+    }
+  });
+  VLOG(3) << "extracted " << archive_path << " to " << dest_dir << ": " << time_ms
+          << " ms";
+}
+
+}  // namespace native_archive
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    NativeArchive.h
+ * @brief   In-process archive format for DUMP/RESTORE TABLE.
+ *
+ * Files are stored as a sequence of fixed size blocks, each of which is
+ * compressed independently through BloscCompressor. Blocks are read and
+ * compressed (or decompressed and written) on multiple threads, so neither
+ * dump nor restore has to shell out to tar and a single-threaded compressor.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace native_archive {
+
+constexpr static char const* compression_name = "blosc";
+
+// Returns true if archive_path starts with the native archive magic.
+bool is_native_archive(const std::string& archive_path);
+
+// Creates archive_path from the in-memory files in inline_files followed by the
+// files and directories in relative_paths, which are relative to base_path.
+void create_archive(const std::string& archive_path,
+                    const std::string& base_path,
+                    const std::vector<std::pair<std::string, std::string>>& inline_files,
+                    const std::vector<std::string>& relative_paths);
+
+// Returns the content of file_name in the archive. Blocks of other files are
+// skipped without decompression.
+std::string read_file(const std::string& archive_path, const std::string& file_name);
+
+// Extracts all files of the archive into dest_dir.
+void extract_archive(const std::string& archive_path, const std::string& dest_dir);
+
+}  // namespace native_archive
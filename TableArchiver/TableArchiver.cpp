@@ -41,6 +41,7 @@
 #include "Shared/ThreadController.h"
 #include "Shared/measure.h"
 #include "Shared/thread_count.h"
+#include "TableArchiver/NativeArchive.h"
 
 extern bool g_cluster;
 bool g_test_rollback_dump_restore{false};
@@ -124,11 +125,28 @@ inline std::string run(const std::string& cmd, const std::string& chdir = "") {
   return output;
 }
 
+// Native archives are recognized by content, so that RESTORE does not need to be
+// told how a table was dumped.
+inline bool use_native_archive(const std::string& archive_path,
+                               const std::string& compression) {
+  if (native_archive::is_native_archive(archive_path)) {
+    return true;
+  }
+  if (compression == native_archive::compression_name) {
+    throw std::runtime_error("Archive " + archive_path +
+                             " is not a native table archive.");
+  }
+  return false;
+}
+
 inline std::string simple_file_cat(const std::string& archive_path,
                                    const std::string& file_name,
                                    const std::string& compression) {
   ddl_utils::validate_allowed_file_path(archive_path,
                                         ddl_utils::DataTransferType::IMPORT);
+  if (use_native_archive(archive_path, compression)) {
+    return native_archive::read_file(archive_path, file_name);
+  }
 #if defined(__APPLE__)
   constexpr static auto opt_occurrence = "--fast-read";
 #else
@@ -257,10 +275,18 @@ void TableArchiver::dumpTable(const TableDescriptor* td,
   }
   // collect paths of files to archive
   const auto global_file_mgr = cat_->getDataMgr().getGlobalFileMgr();
+  const bool native = compression == native_archive::compression_name;
   std::vector<std::string> file_paths;
-  auto file_writer = [&file_paths, global_file_mgr](const std::string& file_name,
-                                                    const std::string& file_type,
-                                                    const std::string& file_data) {
+  std::vector<std::pair<std::string, std::string>> inline_files;
+  auto file_writer = [&file_paths, &inline_files, native, global_file_mgr](
+                         const std::string& file_name,
+                         const std::string& file_type,
+                         const std::string& file_data) {
+    // native archives take generated files from memory
+    if (native) {
+      inline_files.emplace_back(file_name, file_data);
+      return;
+    }
     const auto file_path = abs_path(global_file_mgr) + "/" + file_name;
     std::unique_ptr<FILE, decltype(simple_file_closer)> fp(
         std::fopen(file_path.c_str(), "w"), simple_file_closer);
@@ -306,6 +332,11 @@ void TableArchiver::dumpTable(const TableDescriptor* td,
     file_paths.insert(file_paths.end(), dict_file_dirs.begin(), dict_file_dirs.end());
     // tar takes time. release cat lock to yield the cat to concurrent CREATE statements.
   }
+  if (native) {
+    native_archive::create_archive(
+        archive_path, abs_path(global_file_mgr), inline_files, file_paths);
+    return;
+  }
   // run tar to archive the files ... this may take a while !!
   run("tar " + compression + " -cvf " + get_quoted_string(archive_path) + " " +
           boost::algorithm::join(file_paths, " "),
@@ -444,7 +475,12 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
   // otherwise will corrupt table in case any bad thing happens in the middle.
   run("rm -rf " + temp_data_dir);
   run("mkdir -p " + temp_data_dir);
-  run("tar " + compression + " -xvf " + get_quoted_string(archive_path), temp_data_dir);
+  if (use_native_archive(archive_path, compression)) {
+    native_archive::extract_archive(archive_path, temp_data_dir);
+  } else {
+    run("tar " + compression + " -xvf " + get_quoted_string(archive_path),
+        temp_data_dir);
+  }
   // if table was ever altered after it was created, update column ids in chunk headers.
   if (was_table_altered) {
     const auto time_ms = measure<>::execution(
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/CompressedBitmap.h"
+#include "Tests/TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+std::vector<int64_t> to_vector(const CompressedBitmap& bitmap) {
+  std::vector<int64_t> values;
+  bitmap.forEach([&values](const int64_t val) { values.push_back(val); });
+  return values;
+}
+
+std::vector<int64_t> to_vector(const std::set<int64_t>& set) {
+  return std::vector<int64_t>(set.begin(), set.end());
+}
+
+}  // namespace
+
+TEST(CompressedBitmap, AddContains) {
+  CompressedBitmap bitmap;
+  EXPECT_TRUE(bitmap.empty());
+  const std::vector<int64_t> values{std::numeric_limits<int64_t>::min(),
+                                    -65536,
+                                    -1,
+                                    0,
+                                    1,
+                                    65535,
+                                    65536,
+                                    std::numeric_limits<int64_t>::max()};
+  for (const auto val : values) {
+    EXPECT_TRUE(bitmap.add(val));
+    EXPECT_FALSE(bitmap.add(val));
+  }
+  EXPECT_EQ(values.size(), bitmap.size());
+  for (const auto val : values) {
+    EXPECT_TRUE(bitmap.contains(val));
+  }
+  EXPECT_FALSE(bitmap.contains(2));
+  EXPECT_FALSE(bitmap.contains(-2));
+  EXPECT_EQ(values, to_vector(bitmap));
+}
+
+TEST(CompressedBitmap, DenseContainer) {
+  CompressedBitmap bitmap;
+  std::set<int64_t> expected;
+  // Enough values in one container to switch it from array to bitmap form.
+  for (int64_t val = 0; val < 3 * int64_t(CompressedBitmap::kMaxArraySize); val += 2) {
+    EXPECT_TRUE(bitmap.add(val));
+    expected.insert(val);
+  }
+  EXPECT_EQ(expected.size(), bitmap.size());
+  EXPECT_TRUE(bitmap.contains(4094));
+  EXPECT_FALSE(bitmap.contains(4095));
+  EXPECT_EQ(to_vector(expected), to_vector(bitmap));
+}
+
+TEST(CompressedBitmap, Union) {
+  std::mt19937_64 rng(42);
+  for (int iter = 0; iter < 10; ++iter) {
+    CompressedBitmap lhs;
+    CompressedBitmap rhs;
+    std::set<int64_t> expected;
+    for (int i = 0; i < 20000; ++i) {
+      int64_t val;
+      switch (rng() % 3) {
+        case 0:
+          val = static_cast<int64_t>(rng());  // sparse
+          break;
+        case 1:
+          val = static_cast<int64_t>(rng() % 100000) - 50000;  // dense
+          break;
+        default:
+          val = (int64_t(1) << 40) + 3 * static_cast<int64_t>(rng() % 5000);
+      }
+      auto& bitmap = rng() % 2 ? lhs : rhs;
+      bitmap.add(val);
+      expected.insert(val);
+    }
+    lhs.unionWith(rhs);
+    EXPECT_EQ(expected.size(), lhs.size());
+    EXPECT_EQ(to_vector(expected), to_vector(lhs));
+    for (const auto val : expected) {
+      ASSERT_TRUE(lhs.contains(val));
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
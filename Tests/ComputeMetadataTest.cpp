@@ -29,6 +29,8 @@
 #define BASE_PATH "./tmp"
 #endif
 
+extern size_t g_vacuum_fragments_per_commit;
+
 using QR = QueryRunner::QueryRunner;
 
 namespace {
@@ -221,6 +223,27 @@ class MultiFragMetadataUpdate : public ::testing::Test {
   }
 };
 
+TEST_F(MultiFragMetadataUpdate, VacuumFragmentsPerCommit) {
+  // Commit every vacuumed fragment on its own.
+  const auto fragments_per_commit = g_vacuum_fragments_per_commit;
+  g_vacuum_fragments_per_commit = 1;
+  const auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable(g_table_name, /*populateFragmenter=*/true);
+
+  // Every fragment loses rows, only the odd y values are kept.
+  run_multiple_agg("DELETE FROM " + g_table_name + " WHERE MOD(y, 2) = 0;",
+                   ExecutorDeviceType::CPU);
+  vacuum_and_recompute_metadata(td, *cat);
+  g_vacuum_fragments_per_commit = fragments_per_commit;
+
+  size_t num_tuples{0};
+  run_op_per_fragment(td, [&num_tuples](const auto& fragment) {
+    num_tuples += fragment.getPhysicalNumTuples();
+  });
+  EXPECT_EQ(num_tuples, size_t(9));
+  run_op_per_fragment(td, check_fragment_metadata(-1, false, false, false));
+}
+
 TEST_F(MultiFragMetadataUpdate, NoChanges) {
   std::vector<ChunkMetadataMap> metadata_for_fragments;
   {
@@ -1390,6 +1390,119 @@ TEST(Itas, UnsupportedDateTime) {
   run_ddl_statement("DROP TABLE ITAS_SOURCE;");
 }
 
+namespace {
+
+int64_t count_rows(const std::string& table_name, const std::string& filter) {
+  const auto rows = run_multiple_agg(
+      "SELECT COUNT(*) FROM " + table_name + " WHERE " + filter + ";",
+      ExecutorDeviceType::CPU);
+  return v<int64_t>(rows->getRowAt(0, 0, true));
+}
+
+void create_ctas_source() {
+  run_ddl_statement(
+      "CREATE TABLE CTAS_SOURCE (i int, b bigint, d double, f float, t timestamp(0), dc "
+      "decimal(10, 2), bo boolean);");
+  run_multiple_agg(
+      "INSERT INTO CTAS_SOURCE VALUES(1, 10, 1.5, 2.5, '2020-01-01 00:00:00', 1.25, "
+      "'t');",
+      ExecutorDeviceType::CPU);
+  run_multiple_agg(
+      "INSERT INTO CTAS_SOURCE VALUES(NULL, NULL, NULL, NULL, NULL, NULL, NULL);",
+      ExecutorDeviceType::CPU);
+  run_multiple_agg(
+      "INSERT INTO CTAS_SOURCE VALUES(3, NULL, 3.5, NULL, '2020-01-03 00:00:00', NULL, "
+      "'f');",
+      ExecutorDeviceType::CPU);
+}
+
+// Checks the rows of create_ctas_source, copied the given number of times.
+void check_copied_rows(const std::string& table_name, const int64_t copies) {
+  EXPECT_EQ(3 * copies, count_rows(table_name, "TRUE"));
+  EXPECT_EQ(copies,
+            count_rows(table_name,
+                       "i = 1 AND b = 10 AND d = 1.5 AND f = 2.5 AND t = '2020-01-01 "
+                       "00:00:00' AND dc = 1.25 AND bo"));
+  EXPECT_EQ(copies,
+            count_rows(table_name,
+                       "i IS NULL AND b IS NULL AND d IS NULL AND f IS NULL AND t IS "
+                       "NULL AND dc IS NULL AND bo IS NULL"));
+  EXPECT_EQ(copies,
+            count_rows(table_name,
+                       "i = 3 AND b IS NULL AND d = 3.5 AND f IS NULL AND t = "
+                       "'2020-01-03 00:00:00' AND dc IS NULL AND NOT bo"));
+}
+
+}  // namespace
+
+// Nullable, unencoded numbers, booleans and timestamps are inserted column-wise.
+TEST(Itas, ColumnarInsertWithNulls) {
+  run_ddl_statement("DROP TABLE IF EXISTS CTAS_SOURCE;");
+  run_ddl_statement("DROP TABLE IF EXISTS CTAS_TARGET;");
+  run_ddl_statement("DROP TABLE IF EXISTS ITAS_TARGET;");
+
+  create_ctas_source();
+
+  run_ddl_statement("CREATE TABLE CTAS_TARGET AS SELECT * FROM CTAS_SOURCE;");
+  check_copied_rows("CTAS_TARGET", 1);
+
+  run_ddl_statement(
+      "CREATE TABLE ITAS_TARGET (i int, b bigint, d double, f float, t timestamp(0), dc "
+      "decimal(10, 2), bo boolean);");
+  run_ddl_statement("INSERT INTO ITAS_TARGET SELECT * FROM CTAS_SOURCE;");
+  run_ddl_statement("INSERT INTO ITAS_TARGET SELECT * FROM CTAS_TARGET;");
+  check_copied_rows("ITAS_TARGET", 2);
+
+  run_ddl_statement("DROP TABLE CTAS_SOURCE;");
+  run_ddl_statement("DROP TABLE CTAS_TARGET;");
+  run_ddl_statement("DROP TABLE ITAS_TARGET;");
+}
+
+// A result bigger than an insert package of 64K rows is inserted in several packages.
+TEST(Itas, ColumnarInsertMultiplePackages) {
+  run_ddl_statement("DROP TABLE IF EXISTS CTAS_SOURCE;");
+  run_ddl_statement("DROP TABLE IF EXISTS CTAS_TARGET;");
+
+  create_ctas_source();
+  // 3 * 2^15 rows, one full package and a partial one
+  int64_t copies = 1;
+  for (int i = 0; i < 15; ++i) {
+    run_ddl_statement("INSERT INTO CTAS_SOURCE SELECT * FROM CTAS_SOURCE;");
+    copies *= 2;
+  }
+  check_copied_rows("CTAS_SOURCE", copies);
+
+  run_ddl_statement("CREATE TABLE CTAS_TARGET AS SELECT * FROM CTAS_SOURCE;");
+  check_copied_rows("CTAS_TARGET", copies);
+
+  run_ddl_statement("DROP TABLE CTAS_SOURCE;");
+  run_ddl_statement("DROP TABLE CTAS_TARGET;");
+}
+
+// Dictionary encoded, fixed encoded and NOT NULL targets go through the converters.
+TEST(Itas, ConvertedInsertWithNulls) {
+  run_ddl_statement("DROP TABLE IF EXISTS ITAS_SOURCE;");
+  run_ddl_statement("DROP TABLE IF EXISTS ITAS_TARGET;");
+
+  run_ddl_statement("CREATE TABLE ITAS_SOURCE (id int, val bigint, str text);");
+  run_ddl_statement(
+      "CREATE TABLE ITAS_TARGET (id int not null, val bigint encoding fixed(32), str "
+      "text encoding dict(32));");
+  run_multiple_agg("INSERT INTO ITAS_SOURCE VALUES(1, 10, 'a');",
+                   ExecutorDeviceType::CPU);
+  run_multiple_agg("INSERT INTO ITAS_SOURCE VALUES(2, NULL, NULL);",
+                   ExecutorDeviceType::CPU);
+
+  run_ddl_statement("INSERT INTO ITAS_TARGET SELECT * FROM ITAS_SOURCE;");
+  EXPECT_EQ(int64_t(2), count_rows("ITAS_TARGET", "TRUE"));
+  EXPECT_EQ(int64_t(1), count_rows("ITAS_TARGET", "id = 1 AND val = 10 AND str = 'a'"));
+  EXPECT_EQ(int64_t(1),
+            count_rows("ITAS_TARGET", "id = 2 AND val IS NULL AND str IS NULL"));
+
+  run_ddl_statement("DROP TABLE ITAS_SOURCE;");
+  run_ddl_statement("DROP TABLE ITAS_TARGET;");
+}
+
 void itasTestBody(std::vector<std::shared_ptr<TestColumnDescriptor>>& columnDescriptors,
                   std::string sourcePartitionScheme = ")",
                   std::string targetPartitionScheme = ")",
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file DBEngineTest.cpp
+ * @brief Test suite for the Arrow API of the embedded database
+ */
+
+#include <gtest/gtest.h>
+
+#include "Embedded/DBEngine.h"
+#include "Shared/ArrowUtil.h"
+#include "TestHelpers.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using namespace EmbeddedDatabase;
+
+namespace {
+
+DBEngine* g_dbe{nullptr};
+
+}  // namespace
+
+class DBEngineArrowTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    g_dbe->executeDDL("DROP TABLE IF EXISTS dbe_arrow_test;");
+    g_dbe->executeDDL("CREATE TABLE dbe_arrow_test (i INTEGER, d DOUBLE);");
+    g_dbe->executeDML("INSERT INTO dbe_arrow_test VALUES (1, 1.5);");
+    g_dbe->executeDML("INSERT INTO dbe_arrow_test VALUES (2, 2.5);");
+    g_dbe->executeDML("INSERT INTO dbe_arrow_test VALUES (3, 3.5);");
+  }
+
+  void TearDown() override { g_dbe->executeDDL("DROP TABLE IF EXISTS dbe_arrow_test;"); }
+};
+
+TEST_F(DBEngineArrowTest, RecordBatch) {
+  auto record_batch =
+      g_dbe->executeDMLToArrowRecordBatch("SELECT i, d FROM dbe_arrow_test ORDER BY i;");
+  ASSERT_TRUE(record_batch);
+  ASSERT_EQ(record_batch->num_rows(), int64_t(3));
+  ASSERT_EQ(record_batch->num_columns(), 2);
+  EXPECT_EQ(record_batch->schema()->field(0)->name(), "i");
+  EXPECT_EQ(record_batch->schema()->field(1)->name(), "d");
+
+  const auto ints = std::static_pointer_cast<arrow::Int32Array>(record_batch->column(0));
+  const auto doubles =
+      std::static_pointer_cast<arrow::DoubleArray>(record_batch->column(1));
+  for (int64_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(ints->Value(i), i + 1);
+    EXPECT_DOUBLE_EQ(doubles->Value(i), i + 1.5);
+  }
+}
+
+TEST_F(DBEngineArrowTest, RecordBatchOutlivesNextQuery) {
+  auto first =
+      g_dbe->executeDMLToArrowRecordBatch("SELECT i FROM dbe_arrow_test ORDER BY i;");
+  auto second = g_dbe->executeDMLToArrowRecordBatch(
+      "SELECT i FROM dbe_arrow_test ORDER BY i DESC;");
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  ASSERT_EQ(first->num_rows(), int64_t(3));
+  ASSERT_EQ(second->num_rows(), int64_t(3));
+
+  const auto first_ints = std::static_pointer_cast<arrow::Int32Array>(first->column(0));
+  const auto second_ints =
+      std::static_pointer_cast<arrow::Int32Array>(second->column(0));
+  for (int64_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(first_ints->Value(i), i + 1);
+    EXPECT_EQ(second_ints->Value(i), 3 - i);
+  }
+}
+
+TEST_F(DBEngineArrowTest, Table) {
+  auto table = g_dbe->executeDMLToArrowTable(
+      "SELECT i, d FROM dbe_arrow_test WHERE i > 1 ORDER BY i;");
+  ASSERT_TRUE(table);
+  ASSERT_EQ(table->num_rows(), int64_t(2));
+  ASSERT_EQ(table->num_columns(), 2);
+
+  const auto ints = table->column(0);
+  ASSERT_EQ(ints->num_chunks(), 1);
+  const auto chunk = std::static_pointer_cast<arrow::Int32Array>(ints->chunk(0));
+  EXPECT_EQ(chunk->Value(0), 2);
+  EXPECT_EQ(chunk->Value(1), 3);
+}
+
+TEST_F(DBEngineArrowTest, ImportTable) {
+  auto table = g_dbe->executeDMLToArrowTable("SELECT i, d FROM dbe_arrow_test;");
+  ASSERT_TRUE(table);
+
+  g_dbe->importArrowTable("dbe_arrow_import_test", table);
+  auto cursor = g_dbe->executeDML(
+      "SELECT COUNT(*), SUM(i), MAX(d) FROM dbe_arrow_import_test;");
+  ASSERT_TRUE(cursor);
+  ASSERT_EQ(cursor->getRowCount(), size_t(1));
+  auto row = cursor->getNextRow();
+  EXPECT_EQ(row.getInt(0), 3);
+  EXPECT_EQ(row.getInt(1), 6);
+  EXPECT_DOUBLE_EQ(row.getDouble(2), 3.5);
+  g_dbe->executeDDL("DROP TABLE dbe_arrow_import_test;");
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  g_dbe = DBEngine::create(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  g_dbe->reset();
+  return err;
+}
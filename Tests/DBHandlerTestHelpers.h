@@ -160,6 +160,13 @@ class DBHandlerTestFixture : public testing::Test {
     po::variables_map vm;
     po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
     po::notify(vm);
+
+    if (!cluster_config_file_path_.empty()) {
+      db_leaves_ =
+          LeafHostInfo::parseClusterConfig(cluster_config_file_path_, 0, 0, 0, "");
+      system_parameters_.aggregator = true;
+      g_cluster = true;
+    }
   }
 
   static void initTestArgs(const std::vector<LeafHostInfo>& string_servers,
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file DistributedQueryTest.cpp
+ * @brief Test suite for queries run by an aggregator over its leaves. Start the leaves
+ * with --leaf and pass the cluster configuration with --cluster, the tests are skipped
+ * otherwise.
+ */
+
+#include <gtest/gtest.h>
+
+#include "DBHandlerTestHelpers.h"
+#include "TestHelpers.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+class DistributedQueryTest : public DBHandlerTestFixture {
+ protected:
+  void SetUp() override {
+    if (!isDistributedMode()) {
+      GTEST_SKIP() << "Test requires an aggregator and its leaves.";
+    }
+    DBHandlerTestFixture::SetUp();
+    sql("DROP TABLE IF EXISTS dist_test;");
+    sql("CREATE TABLE dist_test (i INTEGER, d DOUBLE, s TEXT ENCODING DICT(32));");
+    // The aggregator sends every INSERT to the next leaf.
+    for (int i = 1; i <= 6; ++i) {
+      sql("INSERT INTO dist_test VALUES (" + std::to_string(i) + ", " +
+          std::to_string(i) + ".5, 'str" + std::to_string(i % 2) + "');");
+    }
+  }
+
+  void TearDown() override {
+    if (isDistributedMode()) {
+      sql("DROP TABLE IF EXISTS dist_test;");
+    }
+    DBHandlerTestFixture::TearDown();
+  }
+};
+
+TEST_F(DistributedQueryTest, Aggregate) {
+  sqlAndCompareResult("SELECT COUNT(*), SUM(i), MIN(i), MAX(i) FROM dist_test;",
+                      {{i(6), i(21), i(1), i(6)}});
+  sqlAndCompareResult("SELECT AVG(d) FROM dist_test;", {{4.0}});
+  sqlAndCompareResult("SELECT COUNT(DISTINCT i % 3) FROM dist_test;", {{i(3)}});
+}
+
+TEST_F(DistributedQueryTest, GroupBy) {
+  sqlAndCompareResult(
+      "SELECT i % 2 AS k, COUNT(*), SUM(i) FROM dist_test GROUP BY k ORDER BY k;",
+      {{i(0), i(3), i(12)}, {i(1), i(3), i(9)}});
+  sqlAndCompareResult(
+      "SELECT i % 3 AS k, MAX(d) FROM dist_test GROUP BY k HAVING COUNT(*) > 1 ORDER "
+      "BY k DESC LIMIT 2;",
+      {{i(2), 5.5}, {i(1), 4.5}});
+}
+
+TEST_F(DistributedQueryTest, Projection) {
+  sqlAndCompareResult("SELECT i FROM dist_test WHERE i > 3 ORDER BY i;",
+                      {{i(4)}, {i(5)}, {i(6)}});
+  sqlAndCompareResult("SELECT i, d FROM dist_test ORDER BY i DESC LIMIT 2;",
+                      {{i(6), 6.5}, {i(5), 5.5}});
+  sqlAndCompareResult("SELECT i FROM dist_test WHERE i > 10;", {});
+}
+
+TEST_F(DistributedQueryTest, AggregateOfEmptyInput) {
+  sqlAndCompareResult("SELECT COUNT(*), SUM(i) FROM dist_test WHERE i > 10;",
+                      {{i(0), Null}});
+}
+
+TEST_F(DistributedQueryTest, UnsupportedQueries) {
+  queryAndAssertException(
+      "SELECT COUNT(*) FROM dist_test a, dist_test b WHERE a.i = b.i;",
+      "Joins are not supported in distributed mode yet");
+  queryAndAssertException(
+      "SELECT s, COUNT(*) FROM dist_test GROUP BY s;",
+      "Dictionary encoded strings in the first query step are not supported in "
+      "distributed mode yet");
+  queryAndAssertException("SELECT COUNT(*) FROM dist_test GROUP BY s;",
+                          "Dictionary encoded strings in the first query step are not "
+                          "supported in distributed mode yet");
+  queryAndAssertException("UPDATE dist_test SET i = 0;",
+                          "Statement not supported in distributed mode yet");
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  DBHandlerTestFixture::initTestArgs(argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
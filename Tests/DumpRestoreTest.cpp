@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <fstream>
 #include <limits>
 #include <vector>
 
@@ -28,6 +29,8 @@
 
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+#include "TableArchiver/NativeArchive.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
@@ -190,6 +193,8 @@ void dump_restore(const bool migrate, const bool alter, const bool rollback) {
     dump_restore(migrate, alter, rollback, {});  // lz4
     dump_restore(migrate, alter, rollback, {"compression='gzip'"});
   }
+  // native archive needs no external program
+  dump_restore(migrate, alter, rollback, {"compression='blosc'"});
 }
 
 using DumpRestoreTest_Unsharded = DumpRestoreTest<1>;
@@ -376,6 +381,52 @@ TEST_F(DumpAndRestoreTest, TextArray) {
   sqlAndCompareArrayResult("SELECT * FROM test_table_2;", expected_result);
 }
 
+namespace {
+
+// writes a native archive holding one empty file entry with the given name
+void write_native_archive(const std::string& archive_path, const std::string& name) {
+  std::ofstream archive(archive_path, std::ios::binary);
+  const uint32_t block_size = 1024;
+  const uint8_t file_type = 2;
+  const uint32_t name_size = name.size();
+  const uint64_t file_size = 0;
+  const uint8_t end_type = 0;
+  archive.write("OMNIARC1", 8);
+  archive.write(reinterpret_cast<const char*>(&block_size), sizeof(block_size));
+  archive.write(reinterpret_cast<const char*>(&file_type), sizeof(file_type));
+  archive.write(reinterpret_cast<const char*>(&name_size), sizeof(name_size));
+  archive.write(name.data(), name.size());
+  archive.write(reinterpret_cast<const char*>(&file_size), sizeof(file_size));
+  archive.write(reinterpret_cast<const char*>(&end_type), sizeof(end_type));
+}
+
+}  // namespace
+
+TEST_F(DumpAndRestoreTest, NativeArchive_RejectsEntriesOutsideDestination) {
+  const auto dest_dir = boost::filesystem::temp_directory_path() /
+                        boost::filesystem::unique_path("_Orz_dest_%%%%-%%%%");
+  ScopeGuard remove_dirs = [&dest_dir] {
+    boost::filesystem::remove_all(dest_dir);
+    boost::filesystem::remove(dest_dir.string() + "_escaped");
+  };
+  boost::filesystem::create_directories(dest_dir / "sub");
+  for (const auto& name : {"../" + dest_dir.filename().string() + "_escaped",
+                           "sub/../../" + dest_dir.filename().string() + "_escaped",
+                           dest_dir.string() + "_escaped",
+                           std::string()}) {
+    write_native_archive(tar_ball_path, name);
+    ASSERT_TRUE(native_archive::is_native_archive(tar_ball_path));
+    EXPECT_THROW(native_archive::extract_archive(tar_ball_path, dest_dir.string()),
+                 std::runtime_error)
+        << name;
+    EXPECT_FALSE(boost::filesystem::exists(dest_dir.string() + "_escaped")) << name;
+  }
+  // a well formed entry is still extracted
+  write_native_archive(tar_ball_path, "sub/table_file");
+  native_archive::extract_archive(tar_ball_path, dest_dir.string());
+  EXPECT_TRUE(boost::filesystem::exists(dest_dir / "sub" / "table_file"));
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
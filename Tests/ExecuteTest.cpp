@@ -21,7 +21,9 @@
 #include "../QueryEngine/ArrowResultSet.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
+#include "../QueryEngine/LiteralSpecializationTracker.h"
 #include "../QueryEngine/ResultSetReductionJIT.h"
+#include "../QueryEngine/SortedResultCache.h"
 #include "../QueryRunner/QueryRunner.h"
 #include "../Shared/DateConverters.h"
 #include "../Shared/StringTransform.h"
@@ -2339,6 +2341,93 @@ TEST(Select, ApproxMedianLargeInts) {
   }
 }
 
+TEST(Select, ApproxQuantileSanity) {
+  if (g_aggregator) {
+    LOG(WARNING) << "Skipping ApproxQuantileSanity tests in distributed mode.";
+  } else {
+    auto dt = ExecutorDeviceType::CPU;
+    auto approx_quantile = [dt](std::string const col, std::string const q) {
+      std::string const query =
+          "SELECT APPROX_QUANTILE(" + col + ", " + q + ") FROM test;";
+      return v<double>(run_simple_agg(query, dt));
+    };
+    for (std::string const col : {"w", "x", "y", "z", "t", "d"}) {
+      auto const min_query = "SELECT CAST(MIN(" + col + ") AS DOUBLE) FROM test;";
+      auto const max_query = "SELECT CAST(MAX(" + col + ") AS DOUBLE) FROM test;";
+      auto const median_query = "SELECT APPROX_MEDIAN(" + col + ") FROM test;";
+      EXPECT_EQ(v<double>(run_simple_agg(min_query, dt)), approx_quantile(col, "0"));
+      EXPECT_EQ(v<double>(run_simple_agg(max_query, dt)), approx_quantile(col, "1"));
+      EXPECT_EQ(v<double>(run_simple_agg(median_query, dt)),
+                approx_quantile(col, "0.5"));
+    }
+    EXPECT_EQ(NULL_DOUBLE, approx_quantile("u", "0.9"));
+    // Different quantiles of the same column are separate targets.
+    auto const rows = run_multiple_agg(
+        "SELECT APPROX_QUANTILE(x, 0), APPROX_QUANTILE(x, 1) FROM test;", dt);
+    auto const row = rows->getNextRow(true, true);
+    ASSERT_EQ(row.size(), 2u);
+    EXPECT_LT(v<double>(row[0]), v<double>(row[1]));
+    EXPECT_THROW(approx_quantile("x", "1.5"), std::runtime_error);
+    EXPECT_THROW(approx_quantile("x", "-0.1"), std::runtime_error);
+  }
+}
+
+TEST(Select, PercentileExact) {
+  if (g_aggregator) {
+    LOG(WARNING) << "Skipping PercentileExact tests in distributed mode.";
+  } else {
+    auto const dt = ExecutorDeviceType::CPU;
+    run_ddl_statement("DROP TABLE IF EXISTS test_percentile;");
+    // Small fragments so the per group values are merged by the reduction.
+    run_ddl_statement(
+        "CREATE TABLE test_percentile (g INT, x INT) WITH (fragment_size=2);");
+    for (auto const& values :
+         {"1, 3", "2, 10", "1, 1", "3, NULL", "1, 4", "2, NULL", "1, 2"}) {
+      run_multiple_agg(
+          "INSERT INTO test_percentile VALUES (" + std::string(values) + ");", dt);
+    }
+    auto percentile = [dt](std::string const agg, std::string const q) {
+      std::string const query =
+          "SELECT " + agg + "(x, " + q + ") FROM test_percentile;";
+      return v<double>(run_simple_agg(query, dt));
+    };
+    // The values are 1, 2, 3, 4 and 10.
+    EXPECT_EQ(1.0, percentile("PERCENTILE_CONT", "0"));
+    EXPECT_EQ(2.0, percentile("PERCENTILE_CONT", "0.25"));
+    EXPECT_DOUBLE_EQ(2.2, percentile("PERCENTILE_CONT", "0.3"));
+    EXPECT_EQ(3.0, percentile("PERCENTILE_CONT", "0.5"));
+    EXPECT_EQ(10.0, percentile("PERCENTILE_CONT", "1"));
+    EXPECT_EQ(1.0, percentile("PERCENTILE_DISC", "0"));
+    EXPECT_EQ(2.0, percentile("PERCENTILE_DISC", "0.3"));
+    EXPECT_EQ(3.0, percentile("PERCENTILE_DISC", "0.5"));
+    EXPECT_EQ(4.0, percentile("PERCENTILE_DISC", "0.8"));
+    EXPECT_EQ(10.0, percentile("PERCENTILE_DISC", "1"));
+    // Every fragment is skipped by its g stats.
+    EXPECT_EQ(NULL_DOUBLE,
+              v<double>(run_simple_agg(
+                  "SELECT PERCENTILE_DISC(x, 0.5) FROM test_percentile WHERE g > 3;",
+                  dt)));
+    EXPECT_THROW(percentile("PERCENTILE_CONT", "1.5"), std::runtime_error);
+    EXPECT_THROW(percentile("PERCENTILE_DISC", "-0.1"), std::runtime_error);
+
+    auto const rows = run_multiple_agg(
+        "SELECT g, PERCENTILE_CONT(x, 0.5) pc, PERCENTILE_DISC(x, 0.5) FROM "
+        "test_percentile GROUP BY g ORDER BY pc DESC NULLS LAST;",
+        dt);
+    ASSERT_EQ(rows->rowCount(), 3u);
+    std::vector<std::tuple<int64_t, double, double>> const expected{
+        {2, 10.0, 10.0}, {1, 2.5, 2.0}, {3, NULL_DOUBLE, NULL_DOUBLE}};
+    for (auto const& [g, cont, disc] : expected) {
+      auto const row = rows->getNextRow(true, true);
+      ASSERT_EQ(row.size(), 3u);
+      EXPECT_EQ(g, v<int64_t>(row[0]));
+      EXPECT_EQ(cont, v<double>(row[1])) << g;
+      EXPECT_EQ(disc, v<double>(row[2])) << g;
+    }
+    run_ddl_statement("DROP TABLE test_percentile;");
+  }
+}
+
 TEST(Select, ApproxMedianSort) {
   if (g_aggregator) {
     LOG(WARNING) << "Skipping ApproxMedianSort tests in distributed mode.";
@@ -2600,6 +2689,74 @@ TEST(Select, OrderBy) {
   }
 }
 
+TEST(Select, OrderByMultipleKeys) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT str, fn, dn, x FROM test ORDER BY str DESC, fn ASC NULLS FIRST, dn DESC "
+      "NULLS LAST, x;",
+      "SELECT str, fn, dn, x FROM test ORDER BY str DESC, fn ASC, dn DESC, x;",
+      dt);
+    c("SELECT null_str, smallint_nulls, z FROM test ORDER BY null_str ASC NULLS FIRST, "
+      "smallint_nulls DESC NULLS LAST, z;",
+      "SELECT null_str, smallint_nulls, z FROM test ORDER BY null_str ASC, "
+      "smallint_nulls DESC, z;",
+      dt);
+    c("SELECT x, d, f, COUNT(*) AS n FROM test GROUP BY x, d, f ORDER BY n DESC, d, f "
+      "DESC, x;",
+      dt);
+    c("SELECT str, MAX(t) AS m, MIN(dd) AS mn FROM test GROUP BY str ORDER BY mn DESC, "
+      "m, str LIMIT 2 OFFSET 1;",
+      dt);
+  }
+}
+
+TEST(Select, OrderByDictionaryRanks) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const std::string drop_old_test{"DROP TABLE IF EXISTS dict_rank_test;"};
+  run_ddl_statement(drop_old_test);
+  g_sqlite_comparator.query(drop_old_test);
+  ScopeGuard drop_table = [&drop_old_test] {
+    run_ddl_statement(drop_old_test);
+    g_sqlite_comparator.query(drop_old_test);
+  };
+  run_ddl_statement("CREATE TABLE dict_rank_test (x INT, str TEXT ENCODING DICT);");
+  g_sqlite_comparator.query("CREATE TABLE dict_rank_test (x INT, str TEXT);");
+  auto insert = [](const int x, const std::string& str) {
+    const std::string insert_query{"INSERT INTO dict_rank_test VALUES(" +
+                                   std::to_string(x) + ", " + str + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  };
+  int x{0};
+  for (const auto& str : {"'pear'", "'apple'", "NULL", "'fig'", "'pear'"}) {
+    insert(x++, str);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT str, x FROM dict_rank_test ORDER BY str NULLS FIRST, x;",
+      "SELECT str, x FROM dict_rank_test ORDER BY str, x;",
+      dt);
+    c("SELECT x FROM dict_rank_test WHERE str > 'banana' ORDER BY x;", dt);
+  }
+  // strings added later sort between the ones ranked before
+  for (const auto& str : {"'banana'", "'zucchini'", "'cherry'", "'apple'"}) {
+    insert(x++, str);
+  }
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT str, x FROM dict_rank_test ORDER BY str DESC NULLS LAST, x;",
+      "SELECT str, x FROM dict_rank_test ORDER BY str DESC, x;",
+      dt);
+    c("SELECT str, COUNT(*) AS n FROM dict_rank_test WHERE str IS NOT NULL GROUP BY str "
+      "ORDER BY n DESC, str LIMIT 3;",
+      dt);
+    c("SELECT x FROM dict_rank_test WHERE str >= 'banana' AND str < 'fig' ORDER BY x;",
+      dt);
+    c("SELECT x FROM dict_rank_test WHERE str <> 'pear' ORDER BY x;", dt);
+  }
+}
+
 TEST(Select, VariableLengthOrderBy) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -2625,6 +2782,134 @@ TEST(Select, TopKHeap) {
   }
 }
 
+TEST(Select, TopKHeapMultiKey) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const std::string drop_old_test{"DROP TABLE IF EXISTS top_k_multi_key_test;"};
+  run_ddl_statement(drop_old_test);
+  g_sqlite_comparator.query(drop_old_test);
+  const auto enable_columnar_output = g_enable_columnar_output;
+  ScopeGuard reset = [&drop_old_test, enable_columnar_output] {
+    g_enable_columnar_output = enable_columnar_output;
+    run_ddl_statement(drop_old_test);
+    g_sqlite_comparator.query(drop_old_test);
+  };
+  run_ddl_statement(
+      "CREATE TABLE top_k_multi_key_test (x INT, y BIGINT, f DOUBLE, str TEXT ENCODING "
+      "DICT) WITH (fragment_size=3);");
+  g_sqlite_comparator.query(
+      "CREATE TABLE top_k_multi_key_test (x INT, y BIGINT, f DOUBLE, str TEXT);");
+  const std::vector<std::string> strs{"'pear'", "'apple'", "NULL", "'fig'", "'kiwi'"};
+  for (int i = 0; i < 20; ++i) {
+    // later fragments hold bigger values of y, so that the top rows by y skip them
+    const std::string insert_query{
+        "INSERT INTO top_k_multi_key_test VALUES(" + std::to_string(i % 4) + ", " +
+        std::to_string(i / 3 * 10 + i % 3) + ", " + std::to_string(i % 6 * 0.5) + ", " +
+        strs[i % strs.size()] + ");"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  for (const bool columnar_output : {false, true}) {
+    g_enable_columnar_output = columnar_output;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT str, y FROM top_k_multi_key_test ORDER BY str NULLS FIRST, y DESC "
+        "LIMIT 5;",
+        "SELECT str, y FROM top_k_multi_key_test ORDER BY str, y DESC LIMIT 5;",
+        dt);
+      c("SELECT str, x, y FROM top_k_multi_key_test ORDER BY str DESC NULLS LAST, x, y "
+        "LIMIT 4 OFFSET 2;",
+        "SELECT str, x, y FROM top_k_multi_key_test ORDER BY str DESC, x, y LIMIT 4 "
+        "OFFSET 2;",
+        dt);
+      c("SELECT x, f, y FROM top_k_multi_key_test ORDER BY x DESC, f, y LIMIT 6;", dt);
+      c("SELECT y, x FROM top_k_multi_key_test WHERE x > 0 ORDER BY y LIMIT 3;", dt);
+      c("SELECT y, str FROM top_k_multi_key_test ORDER BY y DESC LIMIT 2;", dt);
+      if (dt == ExecutorDeviceType::CPU) {
+        // The rows above come from the heaps, not from sorting the whole projection.
+        const std::vector<std::string> heap_queries{
+            "SELECT str, y FROM top_k_multi_key_test ORDER BY str, y DESC LIMIT 5;",
+            "SELECT x, f, y FROM top_k_multi_key_test ORDER BY x DESC, f, y LIMIT 6;"};
+        for (const auto& query : heap_queries) {
+          const auto rows = run_multiple_agg(query, dt);
+          EXPECT_TRUE(rows->getQueryMemDesc().useStreamingTopN()) << query;
+        }
+      }
+    }
+  }
+}
+
+TEST(Select, SortedResultCache) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto sorted_result_cache_size = g_sorted_result_cache_size;
+  const auto sorted_result_cache_max_bytes = g_sorted_result_cache_max_bytes;
+  ScopeGuard reset_sorted_result_cache_size = [&sorted_result_cache_size,
+                                               &sorted_result_cache_max_bytes] {
+    g_sorted_result_cache_size = sorted_result_cache_size;
+    g_sorted_result_cache_max_bytes = sorted_result_cache_max_bytes;
+    SortedResultCache::getCacheInvalidator()();
+  };
+  g_sorted_result_cache_size = 4;
+  SortedResultCache::getCacheInvalidator()();
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (size_t offset = 0; offset <= 25; offset += 5) {
+      c("SELECT x, y, COUNT(*) FROM test GROUP BY x, y ORDER BY x DESC, y LIMIT 5 "
+        "OFFSET " +
+            std::to_string(offset) + ";",
+        dt);
+    }
+    c("SELECT x, y, COUNT(*) FROM test GROUP BY x, y ORDER BY x DESC, y OFFSET 1;",
+      "SELECT x, y, COUNT(*) FROM test GROUP BY x, y ORDER BY x DESC, y LIMIT -1 "
+      "OFFSET 1;",
+      dt);
+    c("SELECT x, COUNT(*) AS n FROM test GROUP BY x ORDER BY n DESC, x LIMIT 1 OFFSET 1;",
+      dt);
+  }
+
+  const auto dt = ExecutorDeviceType::CPU;
+  run_ddl_statement("DROP TABLE IF EXISTS sorted_result_cache_test;");
+  run_ddl_statement("CREATE TABLE sorted_result_cache_test (x INT, y INT);");
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS sorted_result_cache_test;");
+  };
+  for (int x = 1; x <= 3; ++x) {
+    run_multiple_agg("INSERT INTO sorted_result_cache_test VALUES(" + std::to_string(x) +
+                         ", " + std::to_string(10 * x) + ");",
+                     dt);
+  }
+  auto page = [dt](const size_t offset) {
+    return v<int64_t>(
+        run_simple_agg("SELECT SUM(y) AS s FROM sorted_result_cache_test GROUP BY x "
+                       "ORDER BY s LIMIT 1 OFFSET " +
+                           std::to_string(offset) + ";",
+                       dt));
+  };
+  SortedResultCache::getCacheInvalidator()();
+  EXPECT_EQ(10, page(0));
+  EXPECT_EQ(size_t(1), SortedResultCache::size());
+  EXPECT_EQ(20, page(1));
+  EXPECT_EQ(30, page(2));
+  EXPECT_EQ(size_t(1), SortedResultCache::size());
+  // appending rows changes the cache key
+  run_multiple_agg("INSERT INTO sorted_result_cache_test VALUES(4, 5);", dt);
+  EXPECT_EQ(5, page(0));
+  EXPECT_EQ(20, page(2));
+  // updates invalidate the cache
+  run_multiple_agg("UPDATE sorted_result_cache_test SET y = y + 100 WHERE x = 4;", dt);
+  EXPECT_EQ(size_t(0), SortedResultCache::size());
+  EXPECT_EQ(10, page(0));
+  EXPECT_EQ(105, page(3));
+  // results over the byte cap are not cached
+  g_sorted_result_cache_max_bytes = 1;
+  SortedResultCache::getCacheInvalidator()();
+  EXPECT_EQ(10, page(0));
+  EXPECT_EQ(20, page(1));
+  EXPECT_EQ(size_t(0), SortedResultCache::size());
+}
+
 TEST(Select, ComplexQueries) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -5518,6 +5803,115 @@ TEST(Select, In) {
   }
 }
 
+TEST(Select, LiteralSpecialization) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto literal_specialization_threshold = g_literal_specialization_threshold;
+  ScopeGuard reset_threshold = [&literal_specialization_threshold] {
+    g_literal_specialization_threshold = literal_specialization_threshold;
+    LiteralSpecializationTracker::clear();
+  };
+  g_literal_specialization_threshold = 2;
+  LiteralSpecializationTracker::clear();
+
+  // runs the query often enough for its steps to get hot and returns the number of
+  // executions which used a kernel with the literals inlined
+  const auto count_specialized = [](const std::string& query,
+                                    const ExecutorDeviceType dt) {
+    const auto specialized_before =
+        LiteralSpecializationTracker::getSpecializedExecutionCount();
+    // the first runs are counted, the following ones use the specialized kernel
+    for (size_t i = 0; i < 4; ++i) {
+      c(query, dt);
+    }
+    return LiteralSpecializationTracker::getSpecializedExecutionCount() -
+           specialized_before;
+  };
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const auto& query : std::vector<std::string>{
+             "SELECT COUNT(*) FROM test WHERE x > 7 AND str = 'foo';",
+             "SELECT x, SUM(y) FROM test WHERE y < 44 AND d > 1.5 GROUP BY x ORDER BY "
+             "x;",
+             "SELECT x * 3 + 1, CASE WHEN str = 'bar' THEN 1 ELSE 0 END AS b FROM test "
+             "ORDER BY x, b LIMIT 5;"}) {
+      const auto specialized = count_specialized(query, dt);
+      if (g_hoist_literals) {
+        EXPECT_GT(specialized, size_t(0)) << query;
+      }
+    }
+    // needs its IN list hoisted, never specialized
+    EXPECT_EQ(
+        size_t(0),
+        count_specialized("SELECT COUNT(*) FROM test WHERE x IN (7, 8, 9, 10, 11);", dt));
+    if (dt == ExecutorDeviceType::GPU) {
+      // count distinct buffers on GPU need hoisting as well
+      EXPECT_EQ(
+          size_t(0),
+          count_specialized("SELECT COUNT(DISTINCT x) FROM test WHERE y > 41;", dt));
+    }
+  }
+  if (g_hoist_literals) {
+    EXPECT_GT(LiteralSpecializationTracker::size(), size_t(0));
+  }
+}
+
+TEST(Select, InValuesHashSet) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test WHERE t IN (1001, 1002, 5000000000, 9000000000, "
+      "-7000000000);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE t IN (1002, 5000000000, 9000000000, "
+      "-7000000000);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE t NOT IN (1001, 5000000000, 9000000000, "
+      "-7000000000);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE t NOT IN (1001, 5000000000, 9000000000, "
+      "-7000000000, NULL);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE ofq IN (-1, 5000000000, 9000000000, "
+      "-7000000000);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE d IN (2.2, 3.3, 4.4, 5.5, -0.0);", dt);
+    c("SELECT COUNT(*) FROM test WHERE d IN (2.4, 3.3, 4.4, 5.5, 6.6);", dt);
+    c("SELECT COUNT(*) FROM test WHERE d NOT IN (2.2, 3.3, 4.4, 5.5, 6.6);", dt);
+    c("SELECT COUNT(*) FROM test WHERE dn IN (-2002.4, 3.3, 4.4, 5.5, 6.6);", dt);
+    c("SELECT COUNT(*) FROM test WHERE dn NOT IN (-2002.4, 3.3, 4.4, 5.5, 6.6);", dt);
+    c("SELECT COUNT(*) FROM test WHERE dn NOT IN (2.2, 3.3, 4.4, 5.5, NULL);", dt);
+    c("SELECT x FROM proj_top WHERE str IN ('a', 'c', 'x', 'yy', 'zzz') ORDER BY x;",
+      dt);
+    c("SELECT x FROM proj_top WHERE str NOT IN ('a', 'cc', 'x', 'yy', '') ORDER BY x;",
+      dt);
+    c("SELECT COUNT(*) FROM proj_top WHERE str NOT IN ('a', 'cc', 'x', 'yy', NULL);",
+      dt);
+  }
+}
+
+TEST(Select, CommonSubexpressions) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT x + y, COUNT(*) FROM test WHERE x + y > 49 GROUP BY x + y ORDER BY x + y;",
+      dt);
+    c("SELECT x * y, SUM(x * y), AVG(x * y) FROM test GROUP BY x * y ORDER BY x * y;",
+      dt);
+    // values generated in a branch must not be reused past it
+    c("SELECT CASE WHEN x > 7 THEN y * 2 ELSE 0 END AS a, y * 2 AS b FROM test ORDER "
+      "BY a, b;",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE (x > 7 AND y * 2 > 84) OR y * 2 < 86;", dt);
+    c("SELECT COUNT(*) FROM test WHERE str LIKE 'f%' OR (str LIKE 'f%' AND x > 7);", dt);
+    ASSERT_EQ(v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE EXTRACT(day FROM m) = 13;", dt)),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE DATE_TRUNC(day, m) >= DATE_TRUNC(day, "
+                  "m) AND EXTRACT(day FROM DATE_TRUNC(day, m)) = 13;",
+                  dt)));
+  }
+}
+
 TEST(Select, DivByZero) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -7330,6 +7724,95 @@ TEST(Select, ArrayUnnest) {
   }
 }
 
+TEST(Select, ArrayUnnestProjection) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT x, UNNEST(arr_i32) AS a FROM array_test WHERE x = 7 ORDER BY a;", dt);
+      ASSERT_EQ(size_t(3), rows->rowCount());
+      for (size_t i = 0; i < 3; ++i) {
+        const auto row = rows->getNextRow(true, true);
+        ASSERT_EQ(size_t(2), row.size());
+        ASSERT_EQ(int64_t(7), v<int64_t>(row[0]));
+        ASSERT_EQ(int64_t(10 * (i + 1)), v<int64_t>(row[1]));
+      }
+    }
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT UNNEST(arr3_i32) AS a FROM array_test WHERE x = 8 ORDER BY a;", dt);
+      ASSERT_EQ(size_t(3), rows->rowCount());
+      for (size_t i = 0; i < 3; ++i) {
+        const auto row = rows->getNextRow(true, true);
+        ASSERT_EQ(int64_t(10 * (i + 2)), v<int64_t>(row[0]));
+      }
+    }
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT UNNEST(arr_str) AS a FROM array_test WHERE x = 7 ORDER BY a;", dt);
+      ASSERT_EQ(size_t(3), rows->rowCount());
+      for (const std::string expected : {"aa", "bb", "cc"}) {
+        const auto row = rows->getNextRow(true, true);
+        ASSERT_EQ(expected, boost::get<std::string>(v<NullableString>(row[0])));
+      }
+    }
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT UNNEST(arr_i32) AS a FROM array_test ORDER BY a DESC LIMIT 2;", dt);
+      ASSERT_EQ(size_t(2), rows->rowCount());
+      ASSERT_EQ(int64_t(220), v<int64_t>(rows->getRowAt(0, 0, true)));
+      ASSERT_EQ(int64_t(210), v<int64_t>(rows->getRowAt(1, 0, true)));
+    }
+    {
+      const auto rows =
+          run_multiple_agg("SELECT UNNEST(arr_i32) FROM array_test;", dt);
+      ASSERT_EQ(g_array_test_row_count * 3, rows->rowCount());
+    }
+    ASSERT_EQ(int64_t(6900),
+              v<int64_t>(run_simple_agg("SELECT SUM(UNNEST(arr_i32)) FROM array_test;",
+                                        dt)));
+    // The output buffer of a join is sized by the cardinalities of the joined rows.
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT b.y, UNNEST(a.arr_i32) AS u FROM array_test a JOIN test_inner b ON a.x "
+          "= b.x ORDER BY u;",
+          dt);
+      ASSERT_EQ(size_t(3), rows->rowCount());
+      for (size_t i = 0; i < 3; ++i) {
+        const auto row = rows->getNextRow(true, true);
+        ASSERT_EQ(size_t(2), row.size());
+        ASSERT_EQ(int64_t(43), v<int64_t>(row[0]));
+        ASSERT_EQ(int64_t(10 * (i + 1)), v<int64_t>(row[1]));
+      }
+    }
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT UNNEST(a.arr_i32) FROM array_test a JOIN test b ON a.x = b.x;", dt);
+      ASSERT_EQ(g_num_rows * 2 * 3, rows->rowCount());
+    }
+    {
+      const auto rows = run_multiple_agg(
+          "SELECT b.y, UNNEST(a.arr_i32) FROM array_test a JOIN test b ON a.x = b.x "
+          "WHERE b.y = 42;",
+          dt);
+      ASSERT_EQ(g_num_rows * 3, rows->rowCount());
+    }
+    {
+      // The filter leaves no array to count.
+      const auto rows = run_multiple_agg(
+          "SELECT UNNEST(a.arr_i32) FROM array_test a JOIN test_inner b ON a.x = b.x "
+          "WHERE b.x < 0;",
+          dt);
+      ASSERT_EQ(size_t(0), rows->rowCount());
+    }
+    ASSERT_EQ(static_cast<int64_t>(g_num_rows * 60),
+              v<int64_t>(run_simple_agg(
+                  "SELECT SUM(UNNEST(a.arr_i32)) FROM array_test a JOIN test b ON a.x = "
+                  "b.x WHERE b.y = 42;",
+                  dt)));
+  }
+}
+
 TEST(Select, ArrayIndex) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -7636,6 +8119,34 @@ TEST(Select, GroupByPerfectHash) {
         "BY x DESC;",
         dt);
       c("SELECT y, SUM(fn), AVG(ff), MAX(f) from test GROUP BY y ORDER BY y DESC;", dt);
+      c("SELECT MOD(x, 3) AS k, COUNT(*) FROM test GROUP BY k ORDER BY k;", dt);
+      c("SELECT MOD(w, -5) AS k, COUNT(*) FROM test GROUP BY k ORDER BY k;", dt);
+      c("SELECT -y AS k, SUM(x) FROM test GROUP BY k ORDER BY k;", dt);
+      {
+        const auto rows = run_multiple_agg(
+            "SELECT EXTRACT(DAY FROM m) AS k, COUNT(*) FROM test GROUP BY k ORDER BY k;",
+            dt);
+        ASSERT_EQ(size_t(2), rows->rowCount());
+        ASSERT_EQ(int64_t(13), v<int64_t>(rows->getRowAt(0, 0, true)));
+        ASSERT_EQ(int64_t(14), v<int64_t>(rows->getRowAt(1, 0, true)));
+      }
+      {
+        // the filter keeps a single day, the hours range from the earliest value to the
+        // bound of the filter
+        const auto rows = run_multiple_agg(
+            "SELECT EXTRACT(HOUR FROM m) AS k, COUNT(*) FROM test WHERE m <= "
+            "'2014-12-13 23:59:59' GROUP BY k;",
+            dt);
+        ASSERT_EQ(size_t(1), rows->rowCount());
+        ASSERT_EQ(int64_t(22), v<int64_t>(rows->getRowAt(0, 0, true)));
+        ASSERT_EQ(static_cast<int64_t>(g_num_rows + g_num_rows / 2),
+                  v<int64_t>(rows->getRowAt(0, 1, true)));
+        const auto& query_mem_desc = rows->getQueryMemDesc();
+        ASSERT_EQ(QueryDescriptionType::GroupByPerfectHash,
+                  query_mem_desc.getQueryDescriptionType());
+        ASSERT_EQ(int64_t(22), query_mem_desc.getMinVal());
+        ASSERT_EQ(int64_t(23), query_mem_desc.getMaxVal());
+      }
 
       {
         // all these key columns are small ranged to force perfect hash
@@ -7758,6 +8269,110 @@ TEST(Select, GroupByConstrainedByInQueryRewrite) {
   }
 }
 
+TEST(Select, GroupByKeyPacking) {
+  const auto enable_group_key_packing = g_enable_group_key_packing;
+  ScopeGuard reset = [enable_group_key_packing] {
+    g_enable_group_key_packing = enable_group_key_packing;
+  };
+  run_ddl_statement("DROP TABLE IF EXISTS group_key_packing_test;");
+  run_ddl_statement(
+      "CREATE TABLE group_key_packing_test (x INT, y BIGINT, s TEXT ENCODING DICT(32), "
+      "d DATE);");
+  for (const std::string values : {"1, 10, 'a', '2020-01-01'",
+                                   "1, 10, 'a', '2020-01-01'",
+                                   "5000, 10, 'b', '2020-01-01'",
+                                   "5000, 900000, 'b', '2020-06-01'",
+                                   "NULL, 900000, NULL, NULL"}) {
+    run_multiple_agg("INSERT INTO group_key_packing_test VALUES (" + values + ");",
+                     ExecutorDeviceType::CPU);
+  }
+  run_ddl_statement("DROP TABLE IF EXISTS group_key_packing_unnest_test;");
+  run_ddl_statement("CREATE TABLE group_key_packing_unnest_test (x INT, arr INT[]);");
+  for (const std::string values :
+       {"1, {10, 900000}", "1, {10}", "5000, {10, 20}", "5000, {}"}) {
+    run_multiple_agg(
+        "INSERT INTO group_key_packing_unnest_test VALUES (" + values + ");",
+        ExecutorDeviceType::CPU);
+  }
+  for (const bool packing : {false, true}) {
+    g_enable_group_key_packing = packing;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      {
+        const auto rows = run_multiple_agg(
+            "SELECT x, y, COUNT(*) AS n FROM group_key_packing_test WHERE x IS NOT NULL "
+            "GROUP BY x, y ORDER BY x, y;",
+            dt);
+        ASSERT_EQ(size_t(3), rows->rowCount());
+        const std::vector<std::vector<int64_t>> expected{
+            {1, 10, 2}, {5000, 10, 1}, {5000, 900000, 1}};
+        for (const auto& expected_row : expected) {
+          const auto row = rows->getNextRow(true, true);
+          ASSERT_EQ(size_t(3), row.size());
+          for (size_t i = 0; i < row.size(); ++i) {
+            ASSERT_EQ(expected_row[i], v<int64_t>(row[i]));
+          }
+        }
+      }
+      ASSERT_EQ(4L,
+                v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM (SELECT x, y FROM "
+                                          "group_key_packing_test GROUP BY x, y);",
+                                          dt)));
+      {
+        // five rows leave the packed range sparse, so its single key goes through the
+        // baseline hash
+        const auto rows = run_multiple_agg(
+            "SELECT x, y, COUNT(*) FROM group_key_packing_test GROUP BY x, y;", dt);
+        ASSERT_EQ(size_t(4), rows->rowCount());
+        const auto& query_mem_desc = rows->getQueryMemDesc();
+        ASSERT_EQ(QueryDescriptionType::GroupByBaselineHash,
+                  query_mem_desc.getQueryDescriptionType());
+        ASSERT_EQ(packing ? size_t(1) : size_t(2), query_mem_desc.getGroupbyColCount());
+      }
+      {
+        const auto rows = run_multiple_agg(
+            "SELECT s, x, COUNT(*) AS n FROM group_key_packing_test WHERE s IS NOT NULL "
+            "GROUP BY s, d, x ORDER BY n DESC, x;",
+            dt);
+        ASSERT_EQ(size_t(3), rows->rowCount());
+        const std::vector<std::tuple<std::string, int64_t, int64_t>> expected{
+            {"a", 1, 2}, {"b", 5000, 1}, {"b", 5000, 1}};
+        for (const auto& expected_row : expected) {
+          const auto row = rows->getNextRow(true, true);
+          ASSERT_EQ(size_t(3), row.size());
+          ASSERT_EQ(std::get<0>(expected_row),
+                    boost::get<std::string>(v<NullableString>(row[0])));
+          ASSERT_EQ(std::get<1>(expected_row), v<int64_t>(row[1]));
+          ASSERT_EQ(std::get<2>(expected_row), v<int64_t>(row[2]));
+        }
+      }
+      ASSERT_EQ(4L,
+                v<int64_t>(run_simple_agg("SELECT COUNT(*) FROM (SELECT s, d, x FROM "
+                                          "group_key_packing_test GROUP BY s, d, x);",
+                                          dt)));
+      {
+        // an UNNEST key must stay a key of its own
+        const auto rows = run_multiple_agg(
+            "SELECT x, UNNEST(arr) AS a, COUNT(*) AS n FROM group_key_packing_unnest_test "
+            "GROUP BY x, a ORDER BY x, a;",
+            dt);
+        ASSERT_EQ(size_t(4), rows->rowCount());
+        const std::vector<std::vector<int64_t>> expected{
+            {1, 10, 2}, {1, 900000, 1}, {5000, 10, 1}, {5000, 20, 1}};
+        for (const auto& expected_row : expected) {
+          const auto row = rows->getNextRow(true, true);
+          ASSERT_EQ(size_t(3), row.size());
+          for (size_t i = 0; i < row.size(); ++i) {
+            ASSERT_EQ(expected_row[i], v<int64_t>(row[i]));
+          }
+        }
+      }
+    }
+  }
+  run_ddl_statement("DROP TABLE group_key_packing_test;");
+  run_ddl_statement("DROP TABLE group_key_packing_unnest_test;");
+}
+
 TEST(Select, RedundantGroupBy) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -8560,6 +9175,42 @@ TEST(Select, Joins_InnerJoin_TwoTables) {
   }
 }
 
+TEST(Select, Joins_EagerAggregation) {
+  const auto enable_eager_aggregation = g_enable_eager_aggregation;
+  ScopeGuard reset = [enable_eager_aggregation] {
+    g_enable_eager_aggregation = enable_eager_aggregation;
+  };
+  for (const bool eager_aggregation : {false, true}) {
+    g_enable_eager_aggregation = eager_aggregation;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT test_inner.str, SUM(test.y), COUNT(*), COUNT(test.ofd), MIN(test.z), "
+        "MAX(test.t) FROM test JOIN test_inner ON test.x = test_inner.x GROUP BY "
+        "test_inner.str ORDER BY test_inner.str;",
+        dt);
+      c("SELECT b.y, SUM(a.z) AS s FROM test a, test_inner b WHERE a.x = b.x AND b.y > 0 "
+        "GROUP BY b.y ORDER BY b.y;",
+        dt);
+      c("SELECT a.y, b.str, COUNT(*) AS n, SUM(a.x * a.z) AS s FROM test a JOIN "
+        "test_inner b ON a.x = b.x GROUP BY a.y, b.str ORDER BY a.y, b.str;",
+        dt);
+      c("SELECT b.str, SUM(b.y) AS s FROM test a JOIN test_inner b ON a.x = b.x GROUP BY "
+        "b.str ORDER BY b.str;",
+        dt);
+      c("SELECT b.x, SUM(a.y) AS s, COUNT(*) AS n FROM test a JOIN test_inner b ON "
+        "a.str = b.str GROUP BY b.x ORDER BY b.x;",
+        dt);
+      // The none encoded string read above the join can't key the partial aggregate.
+      c("SELECT b.x, SUM(a.y) AS s FROM test a JOIN test_inner b ON a.str = b.str WHERE "
+        "a.real_str LIKE 'real_%' GROUP BY b.x ORDER BY b.x;",
+        dt);
+      c("SELECT a.real_str, b.str, COUNT(*) AS n FROM test a JOIN test_inner b ON "
+        "a.x = b.x GROUP BY a.real_str, b.str ORDER BY a.real_str, b.str;",
+        dt);
+    }
+  }
+}
+
 namespace {
 
 void validate_shard_agg(const ResultSet& rows,
@@ -14373,6 +15024,56 @@ TEST(Select, ExtractFromNegativeTimes) {
   }
 }
 
+TEST(Select, DateTimeFromMetadataRange) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    run_ddl_statement("DROP TABLE IF EXISTS datetime_range_test;");
+    run_ddl_statement("CREATE TABLE datetime_range_test (ts TIMESTAMP(0), d DATE);");
+    run_multiple_agg(
+        "INSERT INTO datetime_range_test VALUES ('2020-03-05 10:11:12', '2020-03-05');",
+        dt);
+    run_multiple_agg(
+        "INSERT INTO datetime_range_test VALUES ('2020-03-17 23:59:59', '2020-03-17');",
+        dt);
+    run_multiple_agg(
+        "INSERT INTO datetime_range_test VALUES ('2020-03-28 00:00:00', '2020-03-28');",
+        dt);
+    run_multiple_agg("INSERT INTO datetime_range_test VALUES (NULL, NULL);", dt);
+    // all the values are in the same month
+    ASSERT_EQ(3L,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM datetime_range_test WHERE DATE_TRUNC(month, ts) "
+                  "= TIMESTAMP '2020-03-01 00:00:00';",
+                  dt)));
+    ASSERT_EQ(3L,
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(DATE_TRUNC(year, d)) FROM datetime_range_test;", dt)));
+    ASSERT_EQ(6060L,
+              v<int64_t>(run_simple_agg(
+                  "SELECT SUM(EXTRACT(YEAR FROM ts)) FROM datetime_range_test;", dt)));
+    ASSERT_EQ(50L,
+              v<int64_t>(run_simple_agg(
+                  "SELECT SUM(EXTRACT(DAY FROM ts)) FROM datetime_range_test;", dt)));
+    ASSERT_EQ(230L,
+              v<int64_t>(run_simple_agg(
+                  "SELECT SUM(EXTRACT(DOY FROM d)) FROM datetime_range_test;", dt)));
+    run_multiple_agg(
+        "INSERT INTO datetime_range_test VALUES ('2020-04-02 01:00:00', '2020-04-02');",
+        dt);
+    ASSERT_EQ(2L,
+              v<int64_t>(run_simple_agg("SELECT COUNT(DISTINCT DATE_TRUNC(month, ts)) "
+                                        "FROM datetime_range_test;",
+                                        dt)));
+    ASSERT_EQ(52L,
+              v<int64_t>(run_simple_agg(
+                  "SELECT SUM(EXTRACT(DAY FROM ts)) FROM datetime_range_test;", dt)));
+    ASSERT_EQ(323L,
+              v<int64_t>(run_simple_agg(
+                  "SELECT SUM(EXTRACT(DOY FROM d)) FROM datetime_range_test;", dt)));
+    run_ddl_statement("DROP TABLE datetime_range_test;");
+  }
+}
+
 // Week 1 always includes Jan 4. There are 3*4*7 = 84 tests below:
 //  * 3 for WEEK, WEEK_SUNDAY, WEEK_SATURDAY
 //  * 4 for:
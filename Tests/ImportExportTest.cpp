@@ -2305,13 +2305,17 @@ TEST_F(ExportTest, CSV_Zip_Unimplemented) {
   RUN_TEST_ON_ALL_GEO_TYPES();
 }
 
-TEST_F(ExportTest, CSV_GZip_Unimplemented) {
+TEST_F(ExportTest, CSV_GZip) {
   SKIP_ALL_ON_AGGREGATOR();
   doCreateAndImport();
   auto run_test = [&](const std::string& geo_type) {
-    std::string exp_file = "query_export_test_geojson_" + geo_type + ".geojson";
-    EXPECT_THROW(doExport(exp_file, "CSV", "GZip", geo_type, WITH_ARRAYS, DEFAULT_SRID),
-                 std::runtime_error);
+    std::string req_file = "query_export_test_csv_" + geo_type + ".csv";
+    std::string exp_file = req_file + ".gz";
+    ASSERT_NO_THROW(
+        doExport(req_file, "CSV", "GZip", geo_type, WITH_ARRAYS, DEFAULT_SRID));
+    ASSERT_NO_THROW(doCompareText(exp_file, GZIPPED));
+    doImportAgainAndCompare(exp_file, "CSV", geo_type, WITH_ARRAYS);
+    removeExportedFile(exp_file);
   };
   RUN_TEST_ON_ALL_GEO_TYPES();
 }
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/NormalizedKeySort.h"
+#include "Tests/TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace normalized_key_sort;
+
+namespace {
+
+std::vector<uint32_t> reference_sort(
+    const std::vector<std::vector<uint64_t>>& key_words,
+    const size_t key_count) {
+  std::vector<uint32_t> order(key_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [&key_words](const uint32_t lhs, const uint32_t rhs) {
+        for (const auto& column : key_words) {
+          if (column[lhs] != column[rhs]) {
+            return column[lhs] < column[rhs];
+          }
+        }
+        return false;
+      });
+  return order;
+}
+
+}  // namespace
+
+TEST(NormalizedKeySort, EncodeInt) {
+  const std::vector<int64_t> values{std::numeric_limits<int64_t>::min(),
+                                    -65536,
+                                    -1,
+                                    0,
+                                    1,
+                                    65536,
+                                    std::numeric_limits<int64_t>::max()};
+  for (size_t i = 1; i < values.size(); ++i) {
+    EXPECT_LT(encode_int(values[i - 1]), encode_int(values[i]));
+  }
+}
+
+TEST(NormalizedKeySort, EncodeFp) {
+  const std::vector<double> values{-std::numeric_limits<double>::infinity(),
+                                   std::numeric_limits<double>::lowest(),
+                                   -1.5,
+                                   -std::numeric_limits<double>::min(),
+                                   -0.0,
+                                   0.0,
+                                   std::numeric_limits<double>::min(),
+                                   1.5,
+                                   std::numeric_limits<double>::max(),
+                                   std::numeric_limits<double>::infinity()};
+  for (size_t i = 1; i < values.size(); ++i) {
+    EXPECT_LT(encode_fp(values[i - 1]), encode_fp(values[i]));
+  }
+}
+
+TEST(NormalizedKeySort, MatchesStableSort) {
+  std::mt19937_64 rng(42);
+  for (const size_t key_count : {size_t(0), size_t(1), size_t(7), size_t(100000)}) {
+    for (const size_t thread_count : {size_t(1), size_t(4), size_t(16)}) {
+      std::vector<std::vector<uint64_t>> key_words(3);
+      for (auto& column : key_words) {
+        column.resize(key_count);
+      }
+      for (size_t i = 0; i < key_count; ++i) {
+        // few distinct values, a narrow range and words where all the bytes vary
+        key_words[0][i] = rng() % 3;
+        key_words[1][i] = encode_int(static_cast<int64_t>(rng() % 1000) - 500);
+        key_words[2][i] = rng();
+      }
+      EXPECT_EQ(reference_sort(key_words, key_count),
+                sort_keys(key_words, key_count, thread_count));
+    }
+  }
+}
+
+TEST(NormalizedKeySort, Stable) {
+  // All keys equal, the order must not change.
+  const size_t key_count{1000};
+  std::vector<std::vector<uint64_t>> key_words{std::vector<uint64_t>(key_count, 42)};
+  std::vector<uint32_t> identity(key_count);
+  std::iota(identity.begin(), identity.end(), 0);
+  EXPECT_EQ(identity, sort_keys(key_words, key_count, 4));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+
+  return err;
+}
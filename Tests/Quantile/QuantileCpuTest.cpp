@@ -376,6 +376,49 @@ TEST(Quantile, SmallDataSetsAndMemory) {
   }
 }
 
+TEST(ExactQuantile, Empty) {
+  quantile::ExactQuantile cont(0.5, true), disc(0.5, false);
+  EXPECT_TRUE(std::isnan(cont.quantile()));
+  EXPECT_TRUE(std::isnan(disc.quantile()));
+}
+
+TEST(ExactQuantile, Cont) {
+  std::vector<std::pair<double, double>> const quantiles{
+      {0, 1}, {0.25, 2}, {0.5, 3}, {0.6, 3.4}, {1, 5}};
+  for (auto const& [q, expected] : quantiles) {
+    quantile::ExactQuantile exact_quantile(q, true);
+    for (double const x : {5, 1, 4, 2, 3}) {
+      exact_quantile.add(x);
+    }
+    EXPECT_DOUBLE_EQ(expected, exact_quantile.quantile()) << q;
+  }
+}
+
+TEST(ExactQuantile, Disc) {
+  std::vector<std::pair<double, double>> const quantiles{
+      {0, 10}, {0.25, 10}, {0.5, 20}, {0.51, 30}, {1, 40}};
+  for (auto const& [q, expected] : quantiles) {
+    quantile::ExactQuantile exact_quantile(q, false);
+    for (double const x : {40, 20, 10, 30}) {
+      exact_quantile.add(x);
+    }
+    EXPECT_EQ(expected, exact_quantile.quantile()) << q;
+  }
+}
+
+TEST(ExactQuantile, Merge) {
+  quantile::ExactQuantile exact_quantile0(0.5, true), exact_quantile1(0.5, true);
+  exact_quantile0.add(1);
+  exact_quantile0.add(2);
+  exact_quantile1.add(10);
+  exact_quantile1.add(3);
+  exact_quantile0.merge(exact_quantile1);
+  EXPECT_EQ(4u, exact_quantile0.size());
+  EXPECT_EQ(2.5, exact_quantile0.quantile());
+  // The values are only reordered, so the quantile can be read again.
+  EXPECT_EQ(2.5, exact_quantile0.quantile());
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
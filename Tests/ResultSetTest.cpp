@@ -30,6 +30,7 @@
 #include "QueryEngine/RuntimeFunctions.h"
 #include "StringDictionary/StringDictionary.h"
 #include "Tests/TestHelpers.h"
+#include "gen-cpp/serialized_result_set_types.h"
 
 #include <gtest/gtest.h>
 #include <algorithm>
@@ -3068,6 +3069,82 @@ TEST(ReduceRandomGroups, BaselineHashColumnar_Large_NullVal_0075) {
       target_infos, query_mem_desc, gen1, gen2, prct1, prct2, silent, 2);
 }
 
+TEST(Serialize, ReduceUnserialized) {
+  std::vector<TargetInfo> target_infos;
+  SQLTypeInfo bigint_ti(kBIGINT, false);
+  SQLTypeInfo null_ti(kNULLT, false);
+  target_infos.push_back(TargetInfo{false, kMIN, bigint_ti, null_ti, true, false});
+  target_infos.push_back(TargetInfo{true, kCOUNT, bigint_ti, null_ti, true, false});
+  auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 7, 9);
+  query_mem_desc.setHasKeylessHash(false);
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  const auto rs1 = std::make_unique<ResultSet>(target_infos,
+                                               ExecutorDeviceType::CPU,
+                                               query_mem_desc,
+                                               row_set_mem_owner,
+                                               nullptr,
+                                               0,
+                                               0);
+  const auto storage1 = rs1->allocateStorage();
+  const auto rs2 = std::make_unique<ResultSet>(target_infos,
+                                               ExecutorDeviceType::CPU,
+                                               query_mem_desc,
+                                               row_set_mem_owner,
+                                               nullptr,
+                                               0,
+                                               0);
+  const auto storage2 = rs2->allocateStorage();
+  {
+    auto buff1 = reinterpret_cast<int64_t*>(storage1->getUnderlyingBuffer());
+    buff1[0 * 3] = 7;
+    buff1[1 * 3] = EMPTY_KEY_64;
+    buff1[2 * 3] = 9;
+    buff1[0 * 3 + 1] = 7;
+    buff1[1 * 3 + 1] = 0;
+    buff1[2 * 3 + 1] = 9;
+    buff1[0 * 3 + 2] = 15;
+    buff1[1 * 3 + 2] = 0;
+    buff1[2 * 3 + 2] = 3;
+  }
+  {
+    auto buff2 = reinterpret_cast<int64_t*>(storage2->getUnderlyingBuffer());
+    buff2[0 * 3] = EMPTY_KEY_64;
+    buff2[1 * 3] = EMPTY_KEY_64;
+    buff2[2 * 3] = 9;
+    buff2[0 * 3 + 1] = 0;
+    buff2[1 * 3 + 1] = 0;
+    buff2[2 * 3 + 1] = 9;
+    buff2[0 * 3 + 2] = 0;
+    buff2[1 * 3 + 2] = 0;
+    buff2[2 * 3 + 2] = 5;
+  }
+  TSerializedRows serialized_rows;
+  rs2->serialize(serialized_rows);
+  ASSERT_EQ(size_t(1), serialized_rows.buffers.size());
+  const auto rs2_remote = ResultSet::unserialize(serialized_rows, nullptr);
+  ASSERT_EQ(query_mem_desc, rs2_remote->getQueryMemDesc());
+  ResultSetManager rs_manager;
+  std::vector<ResultSet*> storage_set{rs1.get(), rs2_remote.get()};
+  auto result_rs = rs_manager.reduce(storage_set);
+  {
+    const auto row = result_rs->getNextRow(false, false);
+    CHECK_EQ(size_t(2), row.size());
+    ASSERT_EQ(7, v<int64_t>(row[0]));
+    ASSERT_EQ(15, v<int64_t>(row[1]));
+  }
+  {
+    const auto row = result_rs->getNextRow(false, false);
+    CHECK_EQ(size_t(2), row.size());
+    ASSERT_EQ(9, v<int64_t>(row[0]));
+    ASSERT_EQ(8, v<int64_t>(row[1]));
+  }
+  {
+    const auto row = result_rs->getNextRow(false, false);
+    ASSERT_EQ(size_t(0), row.size());
+  }
+}
+
 int main(int argc, char** argv) {
   g_is_test_env = true;
 
@@ -17,8 +17,11 @@
 #include "TestHelpers.h"
 
 #include "../StringDictionary/StringDictionary.h"
+#include "../StringDictionary/StringDictionaryProxy.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <cstdlib>
+#include <fstream>
 #include <limits>
 
 #ifndef BASE_PATH
@@ -101,6 +104,138 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, RecoverFromHashIndex) {
+  const int extra_count{1000};
+  {
+    StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+    ASSERT_TRUE(string_dict.checkpoint());
+    ASSERT_TRUE(boost::filesystem::exists(BASE_PATH "/DictHashIndex"));
+    // strings added after the checkpoint aren't covered by the hash index
+    for (int i = g_op_count; i < g_op_count + extra_count; ++i) {
+      CHECK_EQ(i, string_dict.getOrAdd(std::to_string(i)));
+    }
+  }
+  StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+  ASSERT_EQ(static_cast<size_t>(g_op_count + extra_count),
+            string_dict.storageEntryCount());
+  for (int i = 0; i < g_op_count + extra_count; ++i) {
+    CHECK_EQ(i, string_dict.getIdOfString(std::to_string(i)));
+  }
+  ASSERT_EQ(g_op_count + extra_count, string_dict.getOrAdd("foo bar"));
+}
+
+TEST(StringDictionary, RecoverFromInvalidHashIndex) {
+  {
+    std::ofstream hash_index(BASE_PATH "/DictHashIndex", std::ios::trunc);
+    hash_index << "not a hash index";
+  }
+  StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+  const int str_count = string_dict.storageEntryCount();
+  ASSERT_GT(str_count, g_op_count);
+  for (int i = 0; i < g_op_count; ++i) {
+    CHECK_EQ(i, string_dict.getIdOfString(std::to_string(i)));
+  }
+  ASSERT_EQ(str_count - 1, string_dict.getIdOfString("foo bar"));
+}
+
+TEST(StringDictionary, SortedRanks) {
+  StringDictionary string_dict("", true, false, g_cache_string_hash);
+  for (const auto& str : {"pear", "apple", "fig"}) {
+    string_dict.getOrAdd(str);
+  }
+  const auto ranks = string_dict.getSortedRanks();
+  ASSERT_TRUE(ranks);
+  ASSERT_EQ(std::vector<int32_t>({2, 0, 1}), *ranks);
+  for (const auto& str : {"banana", "zucchini", "cherry"}) {
+    string_dict.getOrAdd(str);
+  }
+  // snapshots taken before new strings were merged in stay unchanged
+  ASSERT_EQ(std::vector<int32_t>({2, 0, 1}), *ranks);
+  const auto merged_ranks = string_dict.getSortedRanks();
+  ASSERT_EQ(std::vector<int32_t>({4, 0, 3, 1, 5, 2}), *merged_ranks);
+}
+
+TEST(StringDictionary, GetCompare) {
+  StringDictionary string_dict("", true, false, g_cache_string_hash);
+  for (const auto& str : {"pear", "apple", "fig", "banana"}) {
+    string_dict.getOrAdd(str);
+  }
+  const size_t generation{4};
+  ASSERT_EQ(std::vector<int32_t>({1, 3}), string_dict.getCompare("cat", "<", generation));
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3}),
+            string_dict.getCompare("fig", "<=", generation));
+  ASSERT_EQ(std::vector<int32_t>({0}), string_dict.getCompare("fig", ">", generation));
+  ASSERT_EQ(std::vector<int32_t>({0, 2}),
+            string_dict.getCompare("fig", ">=", generation));
+  ASSERT_EQ(std::vector<int32_t>({2}), string_dict.getCompare("fig", "=", generation));
+  ASSERT_EQ(std::vector<int32_t>({0, 1, 3}),
+            string_dict.getCompare("fig", "<>", generation));
+  ASSERT_EQ(std::vector<int32_t>({0, 1, 2, 3}),
+            string_dict.getCompare("kiwi", "<>", generation));
+  ASSERT_TRUE(string_dict.getCompare("aardvark", "<", generation).empty());
+  ASSERT_EQ(std::vector<int32_t>({0, 1, 2, 3}),
+            string_dict.getCompare("zebra", "<", generation));
+  // strings added after the generation aren't returned
+  string_dict.getOrAdd("avocado");
+  ASSERT_EQ(std::vector<int32_t>({1, 3}), string_dict.getCompare("cat", "<", generation));
+  ASSERT_EQ(std::vector<int32_t>({1, 3, 4}),
+            string_dict.getCompare("cat", "<", generation + 1));
+}
+
+TEST(StringDictionary, TranslationMap) {
+  auto source_dict =
+      std::make_shared<StringDictionary>("", true, false, g_cache_string_hash);
+  auto dest_dict = std::make_shared<StringDictionary>("", true, false, g_cache_string_hash);
+  for (const auto& str : {"pear", "apple", "fig"}) {
+    source_dict->getOrAdd(str);
+  }
+  for (const auto& str : {"fig", "kiwi", "pear"}) {
+    dest_dict->getOrAdd(str);
+  }
+  const int32_t dest_dict_id{2};
+  const auto inv = StringDictionary::INVALID_STR_ID;
+  // only the ids up to the generation of the caller are translated
+  ASSERT_EQ(
+      std::vector<int32_t>({2, inv}),
+      *StringDictionary::getTranslationMap(source_dict, dest_dict, dest_dict_id, 2));
+  const auto translation =
+      StringDictionary::getTranslationMap(source_dict, dest_dict, dest_dict_id, 3);
+  ASSERT_EQ(std::vector<int32_t>({2, inv, 0}), *translation);
+  source_dict->getOrAdd("kiwi");
+  dest_dict->getOrAdd("apple");
+  // maps returned before stay unchanged, new strings on both sides are translated
+  ASSERT_EQ(std::vector<int32_t>({2, inv, 0}), *translation);
+  ASSERT_EQ(
+      std::vector<int32_t>({2, 3, 0, 1}),
+      *StringDictionary::getTranslationMap(source_dict, dest_dict, dest_dict_id, 4));
+  // a smaller generation gets the cached map, the caller only reads its own ids
+  ASSERT_EQ(size_t(4),
+            StringDictionary::getTranslationMap(source_dict, dest_dict, dest_dict_id, 1)
+                ->size());
+
+  StringDictionaryProxy source_proxy(source_dict, 3);
+  StringDictionaryProxy dest_proxy(dest_dict, 3);
+  const auto source_transient_id = source_proxy.getOrAddTransient("plum");
+  const auto dest_transient_id = dest_proxy.getOrAddTransient("plum");
+  const auto apple_transient_id = dest_proxy.getOrAddTransient("apple");
+  const auto proxy_translation =
+      source_proxy.getTranslationMap(&dest_proxy, dest_dict_id);
+  ASSERT_EQ(2, proxy_translation[0]);
+  ASSERT_EQ(apple_transient_id, proxy_translation[1]);
+  ASSERT_EQ(0, proxy_translation[2]);
+  ASSERT_EQ(dest_transient_id, proxy_translation[source_transient_id]);
+  ASSERT_EQ(proxy_translation, source_proxy.getTranslationMap(&dest_proxy, dest_dict_id));
+
+  // once the destination is dropped, its id can translate to another dictionary
+  source_dict->eraseTranslationMap(dest_dict_id);
+  auto other_dest_dict =
+      std::make_shared<StringDictionary>("", true, false, g_cache_string_hash);
+  other_dest_dict->getOrAdd("apple");
+  ASSERT_EQ(std::vector<int32_t>({inv, 0, inv, inv}),
+            *StringDictionary::getTranslationMap(
+                source_dict, other_dest_dict, dest_dict_id, 4));
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -91,6 +91,10 @@ std::string get_udf_ast_filename() {
   return udf_file_name_base + ".ast";
 }
 
+std::string get_udf_hash_filename() {
+  return udf_file_name_base + "_udf.hash";
+}
+
 bool skip_tests(const ExecutorDeviceType device_type) {
 #ifdef HAVE_CUDA
   return device_type == ExecutorDeviceType::GPU && !QR::get()->gpusPresent();
@@ -150,6 +154,11 @@ class SQLTestEnv : public ::testing::Environment {
       boost::filesystem::remove(udf_ast_file);
     }
 
+    boost::filesystem::path udf_hash_file(get_udf_hash_filename());
+    if (boost::filesystem::exists(udf_hash_file)) {
+      boost::filesystem::remove(udf_hash_file);
+    }
+
     QR::reset();
   }
 };
@@ -213,6 +222,21 @@ TEST_F(UDFCompilerTest, CompilerPathTest) {
   EXPECT_EQ(compile_result, 0);
 }
 
+TEST_F(UDFCompilerTest, CompilationCache) {
+  UdfCompiler compiler(getUdfFileName(), g_device_arch);
+  ASSERT_EQ(compiler.compileUdf(), 0);
+
+  UdfCompiler cached_compiler(getUdfFileName(), g_device_arch);
+  ASSERT_EQ(cached_compiler.compileUdf(), 0);
+  EXPECT_TRUE(cached_compiler.usedCachedCompilation());
+
+  std::vector<std::string> udf_compiler_options{std::string("-D UDF_COMPILER_OPTION")};
+  UdfCompiler option_compiler(
+      getUdfFileName(), g_device_arch, std::string(""), udf_compiler_options);
+  ASSERT_EQ(option_compiler.compileUdf(), 0);
+  EXPECT_FALSE(option_compiler.usedCachedCompilation());
+}
+
 TEST_F(UDFCompilerTest, CalciteRegistration) {
   UdfCompiler compiler(getUdfFileName(), g_device_arch);
   auto compile_result = compiler.compileUdf();
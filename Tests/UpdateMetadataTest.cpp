@@ -1425,6 +1425,106 @@ TEST_F(MetadataUpdate, MetadataSmallIntEncodedNotNull) {
   });
 };
 
+TEST_F(MetadataUpdate, MetadataMultiColumnNull) {
+  // Fixed width columns updated together from column-wise update results. The filter
+  // leaves only part of the touched fragments in the projection, and the untouched
+  // fragment must keep its stats.
+  TableCycler("drop table if exists multi_column_table;",
+              "create table multi_column_table (x int, y double, z boolean) with "
+              "(fragment_size=2);",
+              "drop table multi_column_table;")([&] {
+    query("insert into multi_column_table values (10, 1.5, true);");
+    query("insert into multi_column_table values (20, 2.5, true);");
+    query("insert into multi_column_table values (30, NULL, true);");
+    query("insert into multi_column_table values (40, 4.5, true);");
+    query("insert into multi_column_table values (50, 5.5, true);");
+
+    query(
+        "update multi_column_table set x = x * 2, y = y + 10, z = false where x >= 20 "
+        "and x <= 30;");
+
+    {
+      auto result = run_multiple_agg(
+          "select sum(x), sum(y), count(*) from multi_column_table where not z;",
+          ExecutorDeviceType::CPU);
+      const auto row = result->getNextRow(false, false);
+      ASSERT_EQ(row.size(), size_t(3));
+      ASSERT_EQ(TestHelpers::v<int64_t>(row[0]), int64_t(100));
+      ASSERT_DOUBLE_EQ(TestHelpers::v<double>(row[1]), 12.5);
+      ASSERT_EQ(TestHelpers::v<int64_t>(row[2]), int64_t(2));
+    }
+
+    // Fragment 0 holds (10, 40), fragment 1 holds (60, 40) and fragment 2 is untouched
+    auto x_metadata = get_metadata_vec("multi_column_table", "x");
+    ASSERT_EQ(x_metadata.size(), 3U);
+    ASSERT_EQ(x_metadata[0].second->chunkStats.min.intval, 10);
+    ASSERT_EQ(x_metadata[0].second->chunkStats.max.intval, 40);
+    ASSERT_EQ(x_metadata[0].second->chunkStats.has_nulls, false);
+    ASSERT_EQ(x_metadata[1].second->chunkStats.min.intval, 30);
+    ASSERT_EQ(x_metadata[1].second->chunkStats.max.intval, 60);
+    ASSERT_EQ(x_metadata[1].second->chunkStats.has_nulls, false);
+    ASSERT_EQ(x_metadata[2].second->chunkStats.min.intval, 50);
+    ASSERT_EQ(x_metadata[2].second->chunkStats.max.intval, 50);
+
+    auto y_metadata = get_metadata_vec("multi_column_table", "y");
+    ASSERT_EQ(y_metadata.size(), 3U);
+    ASSERT_DOUBLE_EQ(y_metadata[0].second->chunkStats.min.doubleval, 1.5);
+    ASSERT_DOUBLE_EQ(y_metadata[0].second->chunkStats.max.doubleval, 12.5);
+    ASSERT_EQ(y_metadata[0].second->chunkStats.has_nulls, false);
+    ASSERT_DOUBLE_EQ(y_metadata[1].second->chunkStats.min.doubleval, 4.5);
+    ASSERT_DOUBLE_EQ(y_metadata[1].second->chunkStats.max.doubleval, 4.5);
+    ASSERT_EQ(y_metadata[1].second->chunkStats.has_nulls, true);
+    ASSERT_DOUBLE_EQ(y_metadata[2].second->chunkStats.min.doubleval, 5.5);
+    ASSERT_DOUBLE_EQ(y_metadata[2].second->chunkStats.max.doubleval, 5.5);
+
+    auto z_metadata = get_metadata_vec("multi_column_table", "z");
+    ASSERT_EQ(z_metadata.size(), 3U);
+    ASSERT_EQ(z_metadata[0].second->chunkStats.min.tinyintval, int8_t(0));
+    ASSERT_EQ(z_metadata[0].second->chunkStats.max.tinyintval, int8_t(1));
+    ASSERT_EQ(z_metadata[1].second->chunkStats.min.tinyintval, int8_t(0));
+    ASSERT_EQ(z_metadata[1].second->chunkStats.max.tinyintval, int8_t(1));
+    ASSERT_EQ(z_metadata[2].second->chunkStats.min.tinyintval, int8_t(1));
+    ASSERT_EQ(z_metadata[2].second->chunkStats.max.tinyintval, int8_t(1));
+  });
+}
+
+TEST_F(MetadataUpdate, MetadataNoneEncodedStringInPlace) {
+  // Updated none encoded strings are rewritten within their fragment
+  make_table_cycler("none_encoded_string_table", "text encoding none")([&] {
+    query("insert into none_encoded_string_table values ('a');");
+    query("insert into none_encoded_string_table values ('bb');");
+    query("insert into none_encoded_string_table values ('ccc');");
+
+    query("update none_encoded_string_table set x = 'longer value' where x = 'bb';");
+    query("update none_encoded_string_table set x = NULL where x = 'a';");
+
+    {
+      auto result = run_multiple_agg(
+          "select x from none_encoded_string_table where x is not null order by x;",
+          ExecutorDeviceType::CPU);
+      ASSERT_EQ(result->rowCount(), size_t(2));
+      for (const auto expected : {"ccc", "longer value"}) {
+        const auto row = result->getNextRow(false, false);
+        ASSERT_EQ(row.size(), size_t(1));
+        const auto nullable_str = TestHelpers::v<NullableString>(row[0]);
+        const auto str = boost::get<std::string>(&nullable_str);
+        ASSERT_TRUE(str);
+        ASSERT_EQ(*str, expected);
+      }
+    }
+
+    auto x_metadata = get_metadata_vec("none_encoded_string_table");
+    ASSERT_EQ(x_metadata.size(), 1U);
+    ASSERT_EQ(x_metadata[0].second->numElements, 3U);
+    ASSERT_EQ(x_metadata[0].second->chunkStats.has_nulls, true);
+
+    auto deleted_metadata = get_metadata_vec("none_encoded_string_table", "$deleted$");
+    ASSERT_EQ(deleted_metadata.size(), 1U);
+    ASSERT_EQ(deleted_metadata[0].second->numElements, 3U);
+    ASSERT_EQ(deleted_metadata[0].second->chunkStats.max.tinyintval, int8_t(0));
+  });
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   namespace po = boost::program_options;
@@ -45,6 +45,9 @@ extern bool g_enable_calcite_ddl_parser;
 extern bool g_enable_seconds_refresh;
 extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
+extern size_t g_sorted_result_cache_size;
+extern size_t g_sorted_result_cache_max_bytes;
+extern size_t g_literal_specialization_threshold;
 
 namespace Catalog_Namespace {
 extern bool g_log_user_id;
@@ -92,6 +95,14 @@ void CommandLineOptions::fillOptions() {
                                 ->default_value(system_parameters.calcite_port),
                             "Calcite port number.");
   }
+  help_desc.add_options()(
+      "cluster",
+      po::value<std::string>(&cluster_file),
+      "Path to the JSON list of database leaves, makes this server their aggregator.");
+  help_desc.add_options()(
+      "leaf",
+      po::value<bool>(&leaf)->default_value(leaf)->implicit_value(true),
+      "Run as a database leaf of an aggregator.");
   help_desc.add_options()("config",
                           po::value<std::string>(&system_parameters.config_file),
                           "Path to server configuration file.");
@@ -274,6 +285,22 @@ void CommandLineOptions::fillOptions() {
       po::value<size_t>(&g_max_import_threads)->default_value(g_max_import_threads),
       "Max number of default import threads to use (num hardware threads will be used "
       "instead if lower). Can be overriden with copy statement threads option).");
+  help_desc.add_options()(
+      "max-vacuum-threads",
+      po::value<size_t>(&g_max_vacuum_threads)->default_value(g_max_vacuum_threads),
+      "Max number of threads used to compact the columns of a fragment when deleted "
+      "rows are vacuumed (0 uses all hardware threads).");
+  help_desc.add_options()(
+      "vacuum-fragments-per-commit",
+      po::value<size_t>(&g_vacuum_fragments_per_commit)
+          ->default_value(g_vacuum_fragments_per_commit),
+      "Number of vacuumed fragments checkpointed together, which bounds the chunks "
+      "vacuum holds in the buffer pool.");
+  help_desc.add_options()(
+      "vacuum-pause-ms",
+      po::value<size_t>(&g_vacuum_pause_ms)->default_value(g_vacuum_pause_ms),
+      "Pause between the committed fragment batches of a vacuum, in milliseconds, to "
+      "throttle it on a busy server.");
   help_desc.add_options()(
       "overlaps-max-table-size-bytes",
       po::value<size_t>(&g_overlaps_max_table_size_bytes)
@@ -450,6 +477,18 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_enable_smem_non_grouped_agg)
           ->implicit_value(true),
       "Enable using GPU shared memory for non-grouped aggregate queries.");
+  developer_desc.add_options()("enable-group-key-packing",
+                               po::value<bool>(&g_enable_group_key_packing)
+                                   ->default_value(g_enable_group_key_packing)
+                                   ->implicit_value(true),
+                               "Group by a single key combining the keys of multi-column "
+                               "group bys too wide for the multi-column perfect hash.");
+  developer_desc.add_options()("enable-eager-aggregation",
+                               po::value<bool>(&g_enable_eager_aggregation)
+                                   ->default_value(g_enable_eager_aggregation)
+                                   ->implicit_value(true),
+                               "Pre-aggregate the fact side of inner joins by the join "
+                               "keys when grouping by columns of the other side.");
   developer_desc.add_options()("enable-direct-columnarization",
                                po::value<bool>(&g_enable_direct_columnarization)
                                    ->default_value(g_enable_direct_columnarization)
@@ -649,6 +688,24 @@ void CommandLineOptions::fillAdvancedOptions() {
   developer_desc.add_options()("approx_quantile_centroids",
                                po::value<size_t>(&g_approx_quantile_centroids)
                                    ->default_value(g_approx_quantile_centroids));
+  developer_desc.add_options()(
+      "sorted-result-cache-size",
+      po::value<size_t>(&g_sorted_result_cache_size)
+          ->default_value(g_sorted_result_cache_size),
+      "Number of sorted query results kept to serve further LIMIT / OFFSET pages "
+      "without re-running the query. Zero disables the cache.");
+  developer_desc.add_options()(
+      "sorted-result-cache-max-bytes",
+      po::value<size_t>(&g_sorted_result_cache_max_bytes)
+          ->default_value(g_sorted_result_cache_max_bytes),
+      "Memory held by the sorted query results in the cache, in bytes. Results which "
+      "don't fit are not cached.");
+  developer_desc.add_options()(
+      "literal-specialization-threshold",
+      po::value<size_t>(&g_literal_specialization_threshold)
+          ->default_value(g_literal_specialization_threshold),
+      "Number of runs of a query step with the same literals after which it is "
+      "compiled with the literals inlined instead of hoisted. Zero disables it.");
   developer_desc.add_options()(
       "bitmap-memory-limit",
       po::value<int64_t>(&g_bitmap_memory_limit)->default_value(g_bitmap_memory_limit),
@@ -943,6 +1000,36 @@ boost::optional<int> CommandLineOptions::parse_command_line(
     return 1;
   }
 
+  if (vm.count("cluster")) {
+    if (leaf) {
+      std::cerr << "A server can't be both an aggregator and a leaf." << std::endl;
+      return 1;
+    }
+    boost::algorithm::trim_if(cluster_file, boost::is_any_of("\"'"));
+    try {
+      db_leaves = LeafHostInfo::parseClusterConfig(
+          cluster_file, 0, 0, 0, system_parameters.ssl_trust_ca_file);
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    for (const auto& leaf_host : db_leaves) {
+      if (leaf_host.getRole() != NodeRole::DbLeaf) {
+        std::cerr << "String dictionary servers are not supported yet." << std::endl;
+        return 1;
+      }
+      LOG(INFO) << " Database leaf " << leaf_host.getHost() << ":"
+                << leaf_host.getPort();
+    }
+    if (db_leaves.empty()) {
+      std::cerr << "The cluster configuration " << cluster_file << " has no leaves."
+                << std::endl;
+      return 1;
+    }
+  }
+  // The aggregator and the leaves must agree on the layout of the partial results.
+  g_cluster = leaf || !db_leaves.empty();
+
   if (g_hll_precision_bits < 1 || g_hll_precision_bits > 16) {
     std::cerr << "hll-precision-bits must be between 1 and 16." << std::endl;
     return 1;
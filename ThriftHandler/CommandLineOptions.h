@@ -58,6 +58,7 @@ class CommandLineOptions {
   bool allow_multifrag = true;
   bool read_only = false;
   bool allow_loop_joins = false;
+  bool leaf = false;
   bool enable_legacy_syntax = true;
   bool log_user_origin = true;
   AuthMetadata authMetadata;
@@ -166,6 +167,8 @@ extern size_t g_overlaps_max_table_size_bytes;
 extern double g_overlaps_target_entries_per_bin;
 extern bool g_strip_join_covered_quals;
 extern size_t g_constrained_by_in_threshold;
+extern bool g_enable_group_key_packing;
+extern bool g_enable_eager_aggregation;
 extern size_t g_big_group_threshold;
 extern bool g_enable_window_functions;
 extern bool g_enable_table_functions;
@@ -196,3 +199,6 @@ extern bool g_enable_union;
 extern bool g_use_tbb_pool;
 extern bool g_enable_filter_function;
 extern size_t g_max_import_threads;
+extern size_t g_max_vacuum_threads;
+extern size_t g_vacuum_fragments_per_commit;
+extern size_t g_vacuum_pause_ms;
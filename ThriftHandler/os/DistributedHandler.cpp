@@ -0,0 +1,318 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DistributedHandler.h"
+#include "PendingExecutionClosure.h"
+
+#include "LockMgr/LegacyLockMgr.h"
+#include "LockMgr/LockMgr.h"
+#include "Parser/ParserWrapper.h"
+#include "Parser/parser.h"
+#include "QueryEngine/ResultSet.h"
+#include "Shared/StringTransform.h"
+#include "Shared/measure.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace {
+
+bool starts_with_any(const std::string& query_str,
+                     const std::vector<std::string>& keywords) {
+  for (const auto& keyword : keywords) {
+    if (boost::istarts_with(query_str, keyword)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Statements which need the data of the leaves to be moved or read on the aggregator.
+bool is_unsupported_in_cluster(const std::string& query_str, const ParserWrapper& pw) {
+  return pw.is_ctas || pw.is_itas || pw.is_copy || pw.is_optimize || pw.is_validate ||
+         (pw.getDMLType() != ParserWrapper::DMLType::NotDML &&
+          pw.getDMLType() != ParserWrapper::DMLType::Insert) ||
+         starts_with_any(query_str, {"ARCHIVE", "DUMP", "REFRESH", "RESTORE"});
+}
+
+// Statements which change the catalog, every node needs to run them.
+bool is_schema_change(const std::string& query_str) {
+  return starts_with_any(query_str,
+                         {"ALTER", "CREATE", "DROP", "GRANT", "REVOKE", "TRUNCATE"});
+}
+
+}  // namespace
+
+MapDAggHandler::MapDAggHandler(DBHandler* mapd_handler) : mapd_handler_(mapd_handler) {
+  CHECK(mapd_handler_);
+  CHECK_GT(mapd_handler_->leaf_aggregator_.leafCount(), size_t(0));
+}
+
+void MapDAggHandler::cluster_execute(TQueryResult& _return,
+                                     QueryStateProxy query_state_proxy,
+                                     const std::string& query_str,
+                                     const bool column_format,
+                                     const std::string& nonce,
+                                     const int32_t first_n,
+                                     const int32_t at_most_n,
+                                     const SystemParameters& system_parameters) {
+  const auto query = strip(query_str);
+  const auto session_ptr = query_state_proxy.getQueryState().getConstSessionInfo();
+  ParserWrapper pw{query};
+  if (pw.getExplainType() != ParserWrapper::ExplainType::None) {
+    // The plan is the same on all nodes, the aggregator can explain it.
+    mapd_handler_->sql_execute_impl(_return,
+                                    query_state_proxy,
+                                    column_format,
+                                    nonce,
+                                    session_ptr->get_executor_device_type(),
+                                    first_n,
+                                    at_most_n);
+    return;
+  }
+  if (is_unsupported_in_cluster(query, pw)) {
+    throw std::runtime_error("Statement not supported in distributed mode yet: " +
+                             query);
+  }
+  if (pw.getDMLType() == ParserWrapper::DMLType::Insert) {
+    executeInsert(_return, query_state_proxy, query);
+    return;
+  }
+  if (pw.is_ddl) {
+    mapd_handler_->sql_execute_impl(_return,
+                                    query_state_proxy,
+                                    column_format,
+                                    nonce,
+                                    session_ptr->get_executor_device_type(),
+                                    first_n,
+                                    at_most_n);
+    if (is_schema_change(query)) {
+      _return.execution_time_ms += measure<>::execution([&]() {
+        mapd_handler_->leaf_aggregator_.forwardQueryToLeaves(*session_ptr, query);
+      });
+    }
+    return;
+  }
+  executeSelect(_return,
+                query_state_proxy,
+                query,
+                column_format,
+                first_n,
+                at_most_n,
+                system_parameters);
+}
+
+void MapDAggHandler::executeSelect(TQueryResult& _return,
+                                   QueryStateProxy query_state_proxy,
+                                   const std::string& query_str,
+                                   const bool column_format,
+                                   const int32_t first_n,
+                                   const int32_t at_most_n,
+                                   const SystemParameters& system_parameters) {
+  _return.query_type = TQueryType::READ;
+  const auto session_ptr = query_state_proxy.getQueryState().getConstSessionInfo();
+  mapd_shared_lock<mapd_shared_mutex> execute_read_lock(
+      *legacylockmgr::LockMgr<mapd_shared_mutex, bool>::getMutex(
+          legacylockmgr::ExecutorOuterLock, true));
+  TPlanResult plan;
+  lockmgr::LockedTableDescriptors locks;
+  _return.execution_time_ms += measure<>::execution([&]() {
+    std::tie(plan, locks) = mapd_handler_->parse_to_ra(
+        query_state_proxy, query_str, {}, true, system_parameters);
+  });
+  const ExecutionOptions eo = {g_enable_columnar_output,
+                               mapd_handler_->allow_multifrag_,
+                               false,
+                               mapd_handler_->allow_loop_joins_,
+                               g_enable_watchdog,
+                               mapd_handler_->jit_debug_,
+                               false,
+                               g_enable_dynamic_watchdog,
+                               g_dynamic_watchdog_time_limit,
+                               false,
+                               false,
+                               system_parameters.gpu_input_mem_limit,
+                               false,
+                               g_pending_query_interrupt_freq};
+  std::shared_ptr<ResultSet> rows;
+  std::vector<TargetMetaInfo> targets_meta;
+  _return.execution_time_ms += measure<>::execution([&]() {
+    auto result = mapd_handler_->leaf_aggregator_.execute(
+        *session_ptr, plan.plan_result, eo, false);
+    rows = result.rs;
+    targets_meta = result.targets_meta;
+  });
+  mapd_handler_->convert_rows(
+      _return, query_state_proxy, targets_meta, *rows, column_format, first_n, at_most_n);
+}
+
+void MapDAggHandler::executeInsert(TQueryResult& _return,
+                                   QueryStateProxy query_state_proxy,
+                                   const std::string& query_str) {
+  _return.query_type = TQueryType::WRITE;
+  mapd_handler_->check_read_only("INSERT");
+  const auto session_ptr = query_state_proxy.getQueryState().getConstSessionInfo();
+  const auto& cat = session_ptr->getCatalog();
+  std::list<std::unique_ptr<Parser::Stmt>> parse_trees;
+  DBHandler::parser_with_error_handler(query_str, parse_trees);
+  if (parse_trees.size() != 1) {
+    throw std::runtime_error("Can only run one INSERT INTO query at a time.");
+  }
+  const auto insert_stmt =
+      dynamic_cast<const Parser::InsertValuesStmt*>(parse_trees.front().get());
+  if (!insert_stmt) {
+    throw std::runtime_error(
+        "Only INSERT INTO ... VALUES is supported in distributed mode");
+  }
+  const auto& table_name = *insert_stmt->get_table();
+  const auto td_with_lock =
+      lockmgr::TableSchemaLockContainer<lockmgr::ReadLock>::acquireTableDescriptor(
+          cat, table_name, false);
+  const auto td = td_with_lock();
+  if (!td || !mapd_handler_->user_can_access_table(
+                 *session_ptr, td, AccessPrivileges::INSERT_INTO_TABLE)) {
+    throw std::runtime_error("Table " + table_name + " does not exist.");
+  }
+  // The checkpoint below covers the rows of concurrent inserts into the table too.
+  const auto insert_lock =
+      lockmgr::TableInsertLockContainer<lockmgr::WriteLock>::acquire(cat.getDatabaseId(),
+                                                                     td);
+  auto& leaf_aggregator = mapd_handler_->leaf_aggregator_;
+  const size_t leaf_idx = next_insert_leaf_++ % leaf_aggregator.leafCount();
+  _return.execution_time_ms += measure<>::execution([&]() {
+    leaf_aggregator.forwardQueryToLeaf(*session_ptr, query_str, leaf_idx);
+    // The leaves don't checkpoint the inserts of the aggregator themselves.
+    leaf_aggregator.checkpointLeafShardsWithAutoRollback(
+        *session_ptr, cat.getDatabaseId(), td->tableId);
+  });
+}
+
+MapDLeafHandler::MapDLeafHandler(DBHandler* mapd_handler) : mapd_handler_(mapd_handler) {
+  CHECK(mapd_handler_);
+  CHECK(g_cluster);
+}
+
+MapDLeafHandler::~MapDLeafHandler() {}
+
+int64_t MapDLeafHandler::query_get_outer_fragment_count(const TSessionId& session,
+                                                        const std::string& select_query) {
+  throw std::runtime_error(
+      "Outer fragment counts are not supported in distributed mode yet");
+}
+
+void MapDLeafHandler::check_table_consistency(TTableMeta& _return,
+                                              const TSessionId& session,
+                                              const int32_t table_id) {
+  throw std::runtime_error(
+      "Table consistency checks are not supported in distributed mode yet");
+}
+
+void MapDLeafHandler::start_query(TPendingQuery& _return,
+                                  const TSessionId& leaf_session,
+                                  const TSessionId& parent_session,
+                                  const std::string& query_ra,
+                                  const bool just_explain,
+                                  const std::vector<int64_t>& outer_fragment_indices) {
+  if (just_explain) {
+    throw std::runtime_error("Queries are explained on the aggregator");
+  }
+  if (!outer_fragment_indices.empty()) {
+    throw std::runtime_error(
+        "Outer fragment indices are not supported in distributed mode yet");
+  }
+  auto session_ptr = mapd_handler_->get_session_ptr(leaf_session);
+  // Lazy fetch would leave the projected columns on the leaf, the serialized rows
+  // must hold the values themselves.
+  const CompilationOptions co = {session_ptr->get_executor_device_type(),
+                                 /*hoist_literals=*/true,
+                                 ExecutorOptLevel::Default,
+                                 g_enable_dynamic_watchdog,
+                                 /*allow_lazy_fetch=*/false,
+                                 /*filter_on_deleted_column=*/true,
+                                 ExecutorExplainType::Default,
+                                 mapd_handler_->intel_jit_profile_};
+  // The aggregator appends the projected rows of the leaves, which only works for
+  // row-wise buffers.
+  const ExecutionOptions eo = {/*output_columnar_hint=*/false,
+                               mapd_handler_->allow_multifrag_,
+                               false,
+                               mapd_handler_->allow_loop_joins_,
+                               g_enable_watchdog,
+                               mapd_handler_->jit_debug_,
+                               false,
+                               g_enable_dynamic_watchdog,
+                               g_dynamic_watchdog_time_limit,
+                               false,
+                               false,
+                               mapd_handler_->system_parameters_.gpu_input_mem_limit,
+                               false,
+                               g_pending_query_interrupt_freq};
+  int64_t query_id;
+  {
+    std::lock_guard<std::mutex> lock(pending_queries_mutex_);
+    query_id = next_query_id_++;
+  }
+  auto closure =
+      std::make_unique<PendingExecutionClosure>(session_ptr, query_ra, query_id, co, eo);
+  {
+    mapd_shared_lock<mapd_shared_mutex> execute_read_lock(
+        *legacylockmgr::LockMgr<mapd_shared_mutex, bool>::getMutex(
+            legacylockmgr::ExecutorOuterLock, true));
+    _return = closure->startQuery(parent_session);
+  }
+  std::lock_guard<std::mutex> lock(pending_queries_mutex_);
+  auto it_ok = session_queries_.emplace(leaf_session, query_id);
+  if (!it_ok.second) {
+    pending_queries_.erase(it_ok.first->second);
+    it_ok.first->second = query_id;
+  }
+  pending_queries_.emplace(query_id, std::move(closure));
+}
+
+void MapDLeafHandler::execute_query_step(TStepResult& _return,
+                                         const TPendingQuery& pending_query,
+                                         const TSubqueryId subquery_id) {
+  if (subquery_id) {
+    throw std::runtime_error("Subqueries are not supported in distributed mode yet");
+  }
+  std::unique_ptr<PendingExecutionClosure> closure;
+  {
+    std::lock_guard<std::mutex> lock(pending_queries_mutex_);
+    const auto it = pending_queries_.find(pending_query.id);
+    if (it == pending_queries_.end()) {
+      throw std::runtime_error("Query " + std::to_string(pending_query.id) +
+                               " hasn't been started on this leaf");
+    }
+    closure = std::move(it->second);
+    pending_queries_.erase(it);
+    const auto session_it =
+        session_queries_.find(closure->getSessionInfo().get_session_id());
+    if (session_it != session_queries_.end() && session_it->second == pending_query.id) {
+      session_queries_.erase(session_it);
+    }
+  }
+  mapd_shared_lock<mapd_shared_mutex> execute_read_lock(
+      *legacylockmgr::LockMgr<mapd_shared_mutex, bool>::getMutex(
+          legacylockmgr::ExecutorOuterLock, true));
+  _return = closure->executeQueryStep(pending_query);
+}
+
+void MapDLeafHandler::broadcast_serialized_rows(const TSerializedRows& serialized_rows,
+                                                const TRowDescriptor& row_desc,
+                                                const TQueryId query_id,
+                                                const TSubqueryId subquery_id,
+                                                const bool is_final_subquery_result) {
+  throw std::runtime_error("Subqueries are not supported in distributed mode yet");
+}
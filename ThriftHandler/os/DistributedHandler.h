@@ -25,12 +25,20 @@
 
 #include "../DBHandler.h"
 
+#include <atomic>
+#include <map>
+#include <mutex>
+
+class PendingExecutionClosure;
+
+// Runs the statements of the aggregator: queries over the leaves through the leaf
+// aggregator, DDL on the aggregator and all leaves, INSERT on one leaf at a time.
 class MapDAggHandler {
  public:
   ~MapDAggHandler() {}
 
  private:
-  MapDAggHandler(DBHandler* mapd_handler) { CHECK(false); }
+  MapDAggHandler(DBHandler* mapd_handler);
 
   void cluster_execute(TQueryResult& _return,
                        QueryStateProxy,
@@ -39,55 +47,68 @@ class MapDAggHandler {
                        const std::string& nonce,
                        const int32_t first_n,
                        const int32_t at_most_n,
-                       const SystemParameters& system_parameters) {
-    CHECK(false);
-  }
+                       const SystemParameters& system_parameters);
+
+  void executeSelect(TQueryResult& _return,
+                     QueryStateProxy query_state_proxy,
+                     const std::string& query_str,
+                     const bool column_format,
+                     const int32_t first_n,
+                     const int32_t at_most_n,
+                     const SystemParameters& system_parameters);
+
+  void executeInsert(TQueryResult& _return,
+                     QueryStateProxy query_state_proxy,
+                     const std::string& query_str);
+
+  DBHandler* mapd_handler_;
+  std::atomic<size_t> next_insert_leaf_{0};
+
   friend class DBHandler;
 };
 
+// Runs the first step of the queries of the aggregator on the rows of this leaf.
 class MapDLeafHandler {
  public:
-  ~MapDLeafHandler() {}
+  ~MapDLeafHandler();
 
  private:
-  MapDLeafHandler(DBHandler* mapd_handler) { CHECK(false); }
+  MapDLeafHandler(DBHandler* mapd_handler);
 
   int64_t query_get_outer_fragment_count(const TSessionId& session,
-                                         const std::string& select_query) {
-    CHECK(false);
-    return -1;
-  };
+                                         const std::string& select_query);
 
   void check_table_consistency(TTableMeta& _return,
                                const TSessionId& session,
-                               const int32_t table_id) {
-    CHECK(false);
-  };
+                               const int32_t table_id);
 
   void start_query(TPendingQuery& _return,
                    const TSessionId& leaf_session,
                    const TSessionId& parent_session,
                    const std::string& query_ra,
                    const bool just_explain,
-                   const std::vector<int64_t>& outer_fragment_indices) {
-    CHECK(false);
-  }
+                   const std::vector<int64_t>& outer_fragment_indices);
 
   void execute_query_step(TStepResult& _return,
                           const TPendingQuery& pending_query,
-                          const TSubqueryId subquery_id) {
-    CHECK(false);
-  }
+                          const TSubqueryId subquery_id);
 
   void broadcast_serialized_rows(const TSerializedRows& serialized_rows,
                                  const TRowDescriptor& row_desc,
                                  const TQueryId query_id,
                                  const TSubqueryId subquery_id,
-                                 const bool is_final_subquery_result) {
-    CHECK(false);
-  }
+                                 const bool is_final_subquery_result);
+
+  // Every step runs synchronously, there is never anything to flush.
+  void flush_queue() {}
 
-  void flush_queue() { CHECK(false); }
+  DBHandler* mapd_handler_;
+  std::mutex pending_queries_mutex_;
+  std::map<int64_t, std::unique_ptr<PendingExecutionClosure>> pending_queries_;
+  // A session runs one query at a time, a new query drops the one left behind by a
+  // failed aggregator call.
+  std::map<TSessionId, int64_t> session_queries_;
+  int64_t next_query_id_{0};
 
   friend class DBHandler;
 };
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PendingExecutionClosure.h"
+
+#include "LockMgr/LockMgr.h"
+#include "QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
+#include "QueryEngine/QueryPhysicalInputsCollector.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryEngine/ThriftSerializers.h"
+#include "Shared/scope.h"
+
+#include <set>
+
+namespace {
+
+bool is_dict_encoded_string(const SQLTypeInfo& ti) {
+  return (ti.is_string() || (ti.is_array() && ti.get_elem_type().is_string())) &&
+         ti.get_compression() == kENCODING_DICT;
+}
+
+}  // namespace
+
+PendingExecutionClosure::PendingExecutionClosure(
+    std::shared_ptr<const Catalog_Namespace::SessionInfo> session,
+    const std::string& query_ra,
+    const int64_t id,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo)
+    : session_(std::move(session))
+    , executor_(Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID))
+    , id_(id)
+    , co_(co)
+    , eo_(eo) {
+  ra_executor_ =
+      std::make_unique<RelAlgExecutor>(executor_.get(), session_->getCatalog(), query_ra);
+}
+
+TPendingQuery PendingExecutionClosure::startQuery(const TSessionId& parent_session) {
+  mapd_unique_lock<mapd_shared_mutex> execute_lock(Executor::execute_mutex_);
+  executor_->setCatalog(&session_->getCatalog());
+  ScopeGuard restore_metainfo_cache = [this] { executor_->clearMetaInfoCache(); };
+  TPendingQuery pending_query;
+  pending_query.id = id_;
+  pending_query.column_ranges =
+      ThriftSerializers::column_ranges_to_thrift(ra_executor_->computeColRangesCache());
+  pending_query.dictionary_generations =
+      ThriftSerializers::string_dictionary_generations_to_thrift(
+          ra_executor_->computeStringDictionaryGenerations());
+  pending_query.table_generations = ThriftSerializers::table_generations_to_thrift(
+      ra_executor_->computeTableGenerations());
+  pending_query.parent_session_id = parent_session;
+  return pending_query;
+}
+
+TStepResult PendingExecutionClosure::executeQueryStep(
+    const TPendingQuery& pending_query) {
+  CHECK_EQ(pending_query.id, id_);
+  const auto& cat = session_->getCatalog();
+  // Lock in table id order, like the single node path, to avoid deadlocks.
+  const auto table_ids_unordered =
+      get_physical_table_inputs(&ra_executor_->getRootRelAlgNode());
+  const std::set<int> table_ids(table_ids_unordered.begin(), table_ids_unordered.end());
+  lockmgr::LockedTableDescriptors locks;
+  for (const auto table_id : table_ids) {
+    locks.emplace_back(
+        std::make_unique<lockmgr::TableSchemaLockContainer<lockmgr::ReadLock>>(
+            lockmgr::TableSchemaLockContainer<lockmgr::ReadLock>::acquireTableDescriptor(
+                cat, table_id)));
+    locks.emplace_back(
+        std::make_unique<lockmgr::TableDataLockContainer<lockmgr::ReadLock>>(
+            lockmgr::TableDataLockContainer<lockmgr::ReadLock>::acquire(
+                cat.getDatabaseId(), (*locks.back())())));
+  }
+
+  mapd_unique_lock<mapd_shared_mutex> execute_lock(Executor::execute_mutex_);
+  executor_->setCatalog(&cat);
+  ScopeGuard cleanup_post_execution = [this] {
+    ra_executor_->cleanupPostExecution();
+    executor_->clearMetaInfoCache();
+  };
+  ra_executor_->prepareLeafExecution(
+      ThriftSerializers::column_ranges_from_thrift(pending_query.column_ranges),
+      ThriftSerializers::string_dictionary_generations_from_thrift(
+          pending_query.dictionary_generations),
+      ThriftSerializers::table_generations_from_thrift(pending_query.table_generations));
+  const auto step_result = [this] {
+    try {
+      return executeFirstStep(co_);
+    } catch (const QueryMustRunOnCpu&) {
+      if (!g_allow_cpu_retry) {
+        throw;
+      }
+    }
+    LOG(INFO) << "Query unable to run in GPU mode, retrying on CPU";
+    return executeFirstStep(CompilationOptions::makeCpuOnly(co_));
+  }();
+  checkNoDictionaryEncodedStrings(step_result);
+
+  TStepResult thrift_step_result;
+  step_result.result.getRows()->serialize(thrift_step_result.serialized_rows);
+  thrift_step_result.execution_finished = true;
+  thrift_step_result.merge_type = step_result.merge_type == MergeType::Reduce
+                                      ? TMergeType::REDUCE
+                                      : TMergeType::UNION;
+  thrift_step_result.sharded = false;
+  thrift_step_result.row_desc =
+      ThriftSerializers::target_meta_infos_to_thrift(step_result.result.getTargetsMeta());
+  thrift_step_result.node_id = step_result.node_id;
+  return thrift_step_result;
+}
+
+QueryStepExecutionResult PendingExecutionClosure::executeFirstStep(
+    const CompilationOptions& co) {
+  ra_executor_->query_dag_->resetQueryExecutionState();
+  executor_->temporary_tables_ = &ra_executor_->temporary_tables_;
+  return ra_executor_->executeRelAlgQuerySingleStep(
+      RaExecutionSequence(&ra_executor_->getRootRelAlgNode()), 0, co, eo_, nullptr);
+}
+
+void PendingExecutionClosure::checkNoDictionaryEncodedStrings(
+    const QueryStepExecutionResult& step_result) {
+  const auto unsupported = [] {
+    return std::runtime_error(
+        "Dictionary encoded strings in the first query step are not supported in "
+        "distributed mode yet");
+  };
+  for (const auto& target_meta : step_result.result.getTargetsMeta()) {
+    if (is_dict_encoded_string(target_meta.get_type_info())) {
+      throw unsupported();
+    }
+  }
+  for (const auto& target_info : step_result.result.getRows()->getTargetInfos()) {
+    if (target_info.is_agg && is_dict_encoded_string(target_info.agg_arg_type)) {
+      throw unsupported();
+    }
+  }
+  if (step_result.merge_type != MergeType::Reduce) {
+    return;
+  }
+  // The group by keys of a reduced step don't have to be targets.
+  RaExecutionSequence seq(&ra_executor_->getRootRelAlgNode());
+  const RelAlgNode* node = seq.getDescriptor(0)->getBody();
+  if (node->getId() != step_result.node_id) {
+    CHECK(dynamic_cast<const RelSort*>(node));
+    node = node->getInput(0);
+    CHECK_EQ(node->getId(), step_result.node_id);
+  }
+  const auto work_unit = ra_executor_->createWorkUnit(
+      node, {{}, SortAlgorithm::Default, 0, 0}, eo_);
+  for (const auto& groupby_expr : work_unit.exe_unit.groupby_exprs) {
+    if (groupby_expr && is_dict_encoded_string(groupby_expr->get_type_info())) {
+      throw unsupported();
+    }
+  }
+}
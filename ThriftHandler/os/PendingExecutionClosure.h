@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Catalog/SessionInfo.h"
+#include "QueryEngine/CompilationOptions.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/RelAlgExecutor.h"
+#include "gen-cpp/OmniSci.h"
+
+#include <memory>
+
+// The part of a query the aggregator runs on a leaf, between start_query and
+// execute_query_step. The leaf first reports the metadata of its share of the tables
+// and then runs the first query step with the metadata merged over all leaves, so that
+// the partial results of all leaves have the same layout.
+class PendingExecutionClosure {
+ public:
+  PendingExecutionClosure(std::shared_ptr<const Catalog_Namespace::SessionInfo> session,
+                          const std::string& query_ra,
+                          const int64_t id,
+                          const CompilationOptions& co,
+                          const ExecutionOptions& eo);
+
+  const Catalog_Namespace::SessionInfo& getSessionInfo() const { return *session_; }
+
+  // Returns the column ranges, dictionary generations and table generations of the
+  // tables the query reads.
+  TPendingQuery startQuery(const TSessionId& parent_session);
+
+  TStepResult executeQueryStep(const TPendingQuery& pending_query);
+
+ private:
+  QueryStepExecutionResult executeFirstStep(const CompilationOptions& co);
+
+  // The dictionaries of the leaves assign different ids to the same string, the partial
+  // results can't be merged if they contain any.
+  void checkNoDictionaryEncodedStrings(const QueryStepExecutionResult& step_result);
+
+  std::shared_ptr<const Catalog_Namespace::SessionInfo> session_;
+  std::shared_ptr<Executor> executor_;
+  std::unique_ptr<RelAlgExecutor> ra_executor_;
+  const int64_t id_;
+  const CompilationOptions co_;
+  const ExecutionOptions eo_;
+};
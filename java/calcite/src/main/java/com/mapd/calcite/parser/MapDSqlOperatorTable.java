@@ -96,7 +96,8 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
 
   static {
     try {
-      // some nasty bit to remove the std APPROX_COUNT_DISTINCT function definition
+      // some nasty bit to remove the std APPROX_COUNT_DISTINCT function definition, and
+      // the WITHIN GROUP forms of PERCENTILE_CONT and PERCENTILE_DISC
       {
         Field f = ReflectiveSqlOperatorTable.class.getDeclaredField(
                 "caseSensitiveOperators");
@@ -106,6 +107,8 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
           Map.Entry entry = (Map.Entry) i.next();
           if (entry.getValue() == SqlStdOperatorTable.APPROX_COUNT_DISTINCT
                   || entry.getValue() == SqlStdOperatorTable.AVG
+                  || entry.getValue() == SqlStdOperatorTable.PERCENTILE_CONT
+                  || entry.getValue() == SqlStdOperatorTable.PERCENTILE_DISC
                   || entry.getValue() == SqlStdOperatorTable.ARRAY_VALUE_CONSTRUCTOR) {
             i.remove();
           }
@@ -121,6 +124,8 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
           Map.Entry entry = (Map.Entry) i.next();
           if (entry.getValue() == SqlStdOperatorTable.APPROX_COUNT_DISTINCT
                   || entry.getValue() == SqlStdOperatorTable.AVG
+                  || entry.getValue() == SqlStdOperatorTable.PERCENTILE_CONT
+                  || entry.getValue() == SqlStdOperatorTable.PERCENTILE_DISC
                   || entry.getValue() == SqlStdOperatorTable.ARRAY_VALUE_CONSTRUCTOR) {
             i.remove();
           }
@@ -231,6 +236,9 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     opTab.addOperator(new OffsetInFragment());
     opTab.addOperator(new ApproxCountDistinct());
     opTab.addOperator(new ApproxMedian());
+    opTab.addOperator(new ApproxQuantile());
+    opTab.addOperator(new PercentileCont());
+    opTab.addOperator(new PercentileDisc());
     opTab.addOperator(new MapDAvg());
     opTab.addOperator(new Sample());
     opTab.addOperator(new LastSample());
@@ -1745,6 +1753,69 @@ public class MapDSqlOperatorTable extends ChainedSqlOperatorTable {
     }
   }
 
+  static class ApproxQuantile extends SqlAggFunction {
+    ApproxQuantile() {
+      super("APPROX_QUANTILE",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.NUMERIC, SqlTypeFamily.NUMERIC),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.DOUBLE);
+    }
+  }
+
+  static class PercentileCont extends SqlAggFunction {
+    PercentileCont() {
+      super("PERCENTILE_CONT",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.NUMERIC, SqlTypeFamily.NUMERIC),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.DOUBLE);
+    }
+  }
+
+  static class PercentileDisc extends SqlAggFunction {
+    PercentileDisc() {
+      super("PERCENTILE_DISC",
+              null,
+              SqlKind.OTHER_FUNCTION,
+              null,
+              null,
+              OperandTypes.family(SqlTypeFamily.NUMERIC, SqlTypeFamily.NUMERIC),
+              SqlFunctionCategory.SYSTEM,
+              false,
+              false,
+              Optionality.FORBIDDEN);
+    }
+
+    @Override
+    public RelDataType inferReturnType(SqlOperatorBinding opBinding) {
+      final RelDataTypeFactory typeFactory = opBinding.getTypeFactory();
+      return typeFactory.createSqlType(SqlTypeName.DOUBLE);
+    }
+  }
+
   static class MapDAvg extends SqlAggFunction {
     MapDAvg() {
       super("AVG",